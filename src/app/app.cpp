@@ -22,6 +22,7 @@
 #include "search/create_controller.h"
 #include "search/heuristics.h"
 #include "search/search.h"
+#include "search/search_proto.h"
 #include "search/search_tree.h"
 #include "search/ta_adapter.h"
 #include "visualization/interactive_tree_to_graphviz.h"
@@ -117,6 +118,18 @@ Launcher::parse_command_line(int argc, const char *const argv[])
      "Generate a compact controller dot graph without node labels")
     ("output,o", value(&controller_proto_path), "Save the resulting controller as pbtxt")
     ("heuristic", value(&heuristic)->default_value("composite"), "The heuristic to use (one of 'composite', 'time', 'bfs', 'dfs', 'random')")
+    ("antichain-pruning", bool_switch()->default_value(false),
+     "Label nodes that are dominated by a labeled node anywhere in the search graph without expanding them")
+    ("stop-on-verdict", bool_switch()->default_value(false),
+     "Stop the search as soon as the initial node is labeled, without expanding the remaining nodes")
+    ("successor-cache-budget", value(&successor_cache_budget)->default_value(64),
+     "The memory budget of the cache of successors in MiB")
+    ("memory-budget", value(&memory_budget)->default_value(0),
+     "Release the words of settled search nodes if the resident memory exceeds this budget in MiB, 0 for no limit")
+    ("snapshot", value(&snapshot_path), "Periodically write a snapshot of the search to this file")
+    ("snapshot-interval", value(&snapshot_interval)->default_value(600),
+     "The time between two snapshots of the search in seconds")
+    ("resume", value(&resume_path), "Resume the search from a snapshot written with --snapshot")
     ;
 	// clang-format on
 
@@ -133,6 +146,8 @@ Launcher::parse_command_line(int argc, const char *const argv[])
 	debug                  = variables["debug"].as<bool>();
 	multi_threaded         = !variables["single-threaded"].as<bool>();
 	hide_controller_labels = variables["hide-controller-labels"].as<bool>();
+	antichain_pruning      = variables["antichain-pruning"].as<bool>();
+	stop_on_verdict        = variables["stop-on-verdict"].as<bool>();
 	if (verbose) {
 		spdlog::set_level(spdlog::level::debug);
 	}
@@ -204,9 +219,34 @@ Launcher::run()
 	                          true,
 	                          true,
 	                          create_heuristic(heuristic, environment_actions));
+	search.set_antichain_pruning(antichain_pruning);
+	search.set_stop_on_verdict(stop_on_verdict);
+	search.set_successor_cache_budget(successor_cache_budget << 20);
+	search.set_memory_budget(memory_budget << 20);
+	if (!resume_path.empty()) {
+		SPDLOG_INFO("Resuming search from snapshot '{}'", resume_path.c_str());
+		search.restore_snapshot(search::read_snapshot_from_file(resume_path));
+	}
+	if (!snapshot_path.empty()) {
+		SPDLOG_INFO("Writing snapshots to '{}' every {}s", snapshot_path.c_str(), snapshot_interval);
+		const auto write_snapshot = [this](search::ProductSearchSnapshot &&snapshot) {
+			search::write_snapshot_to_file(snapshot, snapshot_path);
+			SPDLOG_DEBUG("Wrote snapshot with {} nodes to '{}'",
+			             snapshot.nodes.size(),
+			             snapshot_path.c_str());
+		};
+		search.set_snapshot_handler(std::chrono::duration<double>{snapshot_interval}, write_snapshot);
+	}
 	SPDLOG_INFO("Running search {}", multi_threaded ? "multi-threaded" : "single-threaded");
 	search.build_tree(multi_threaded);
-	search.label();
+	const auto search_times = search.get_search_times();
+	if (search_times.time_to_verdict) {
+		SPDLOG_INFO("Verdict after {:.3f}s", search_times.time_to_verdict->count());
+	}
+	SPDLOG_INFO("Search {} after {:.3f}s",
+	            search_times.stopped_at_verdict ? "stopped" : "exhausted",
+	            search_times.time_to_exhaustion.count());
+	search.label(nullptr, multi_threaded ? 0 : 1);
 	SPDLOG_INFO("Search complete!");
 	if (debug) {
 		if (tree_dot_graph.empty()) {
@@ -225,7 +265,9 @@ Launcher::run()
 	auto controller = controller_synthesis::create_controller(search.get_root(),
 	                                                          controller_actions,
 	                                                          environment_actions,
-	                                                          K);
+	                                                          K,
+	                                                          true,
+	                                                          &search.get_time_successor_cache());
 	if (!controller_dot_path.empty()) {
 		SPDLOG_INFO("Writing controller to '{}'", controller_dot_path.c_str());
 		visualization::ta_to_graphviz(controller, !hide_controller_labels)
@@ -236,6 +278,30 @@ Launcher::run()
 		std::ofstream fs(controller_proto_path);
 		fs << automata::ta::ta_to_proto(controller).DebugString();
 	}
+	const auto time_successor_statistics = search.get_time_successor_cache().get_statistics();
+	SPDLOG_INFO("Time successor cache: {} hits, {} misses, hit rate {:.2f}",
+	            time_successor_statistics.num_hits,
+	            time_successor_statistics.num_misses,
+	            time_successor_statistics.get_hit_rate());
+	const auto successor_statistics = search.get_successor_cache_statistics();
+	SPDLOG_INFO("Successor cache: {} hits, {} misses, {} evictions, hit rate {:.2f}",
+	            successor_statistics.num_hits,
+	            successor_statistics.num_misses,
+	            successor_statistics.num_evictions,
+	            successor_statistics.get_hit_rate());
+	const auto minimal_model_statistics = ata.get_minimal_model_cache_statistics();
+	SPDLOG_INFO("Minimal model cache: {} hits, {} misses, hit rate {:.2f}",
+	            minimal_model_statistics.num_hits,
+	            minimal_model_statistics.num_misses,
+	            minimal_model_statistics.get_hit_rate());
+	if (memory_budget > 0) {
+		const auto memory_statistics = search.get_memory_statistics();
+		SPDLOG_INFO("Memory: {} MiB resident, released the words of {} nodes in {} passes, about {} MiB",
+		            memory_statistics.resident_memory >> 20,
+		            memory_statistics.num_released_nodes,
+		            memory_statistics.num_releases,
+		            memory_statistics.released_memory >> 20);
+	}
 }
 
 } // namespace tacos::app
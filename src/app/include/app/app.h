@@ -38,12 +38,19 @@ private:
 	std::filesystem::path controller_proto_path;
 	std::filesystem::path plant_dot_graph;
 	std::filesystem::path tree_dot_graph;
+	std::filesystem::path snapshot_path;
+	std::filesystem::path resume_path;
 	bool                  show_help{false};
 	bool                  multi_threaded{true};
 	bool                  debug{false};
 	bool                  hide_controller_labels{false};
+	bool                  antichain_pruning{false};
+	bool                  stop_on_verdict{false};
 	std::set<std::string> controller_actions;
 	std::string           heuristic;
+	std::size_t           successor_cache_budget;
+	std::size_t           memory_budget;
+	double                snapshot_interval;
 };
 
 /** @brief Read a protobuf message from a file.
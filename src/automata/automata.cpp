@@ -16,6 +16,12 @@ is_satisfied(const ClockConstraint &constraint, const Time &valuation)
 	return std::visit([&](auto &&c) { return c.is_satisfied(valuation); }, constraint);
 }
 
+bool
+is_satisfied_in_region(const ClockConstraint &constraint, RegionIndex region_index)
+{
+	return std::visit([&](auto &&c) { return c.is_satisfied_in_region(region_index); }, constraint);
+}
+
 std::ostream &
 operator<<(std::ostream &os, const automata::ClockConstraint &constraint)
 {
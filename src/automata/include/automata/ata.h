@@ -9,14 +9,22 @@
 #ifndef SRC_AUTOMATA_INCLUDE_AUTOMATA_ATA_H
 #define SRC_AUTOMATA_INCLUDE_AUTOMATA_ATA_H
 
+#include "ata_compiled_formula.h"
 #include "ata_formula.h"
+#include "ata_model_cache.h"
 #include "automata.h"
 
 #include <fmt/ostream.h>
 
+#include <cstddef>
 #include <experimental/iterator>
+#include <map>
+#include <memory>
+#include <optional>
+#include <set>
 #include <stdexcept>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 /// Alternating timed automata
@@ -56,6 +64,10 @@ public:
 template <typename LocationT>
 using Configuration = std::set<State<LocationT>>;
 
+/** An ATA configuration whose clock valuations are only known up to their regions. */
+template <typename LocationT>
+using RegionConfiguration = std::set<RegionState<LocationT>>;
+
 /** A single step in a run of an ATA. */
 template <typename SymbolT>
 using RunStep = std::variant<SymbolT, Time>;
@@ -194,6 +206,19 @@ public:
 	std::set<Configuration<LocationT>> make_symbol_step(const Configuration<LocationT> &start_states,
 	                                                    const SymbolT                  &symbol) const;
 
+	/** Compute the resulting configurations after making a symbol step from a region configuration.
+	 * Whether a transition formula is satisfied only depends on the region of the clock valuation.
+	 * Hence, this computes the same successors as make_symbol_step for any configuration that the
+	 * region configuration represents, without looking at the clock valuations themselves. A reset
+	 * state has region index 0 and fractional rank 0.
+	 * @param start_states The starting configuration
+	 * @param symbol The symbol to read
+	 * @return The region configurations after making the symbol step
+	 */
+	std::set<RegionConfiguration<LocationT>>
+	make_region_symbol_step(const RegionConfiguration<LocationT> &start_states,
+	                        const SymbolT                        &symbol) const;
+
 	/** Compute the resulting run after reading a symbol.
 	 * @param runs The valid runs resulting from reading previous symbols
 	 * @param symbol The symbol to read
@@ -232,6 +257,13 @@ public:
 	 */
 	[[nodiscard]] bool accepts_word(const TimedATAWord<SymbolT> &word) const;
 
+	/** Get the statistics of the cache of minimal models of the transition formulas. */
+	[[nodiscard]] utilities::CacheStatistics
+	get_minimal_model_cache_statistics() const
+	{
+		return minimal_models_.get_statistics();
+	}
+
 	/** Print an AlternatingTimedAutomaton to an ostream
 	 * @param os The ostream to print to
 	 * @param ata The AlternatingTimedAutomaton to print
@@ -246,11 +278,42 @@ private:
 	std::set<std::set<State<LocationT>>> get_minimal_models(Formula<LocationT> *formula,
 	                                                        ClockValuation      v) const;
 
+	/** Combine the minimal models of each start state to the successor configurations.
+	 * @param models The minimal models of the transition formula of each start state
+	 * @param sink_state The state to go to if some start state does not have a model
+	 * @return All configurations that consist of one minimal model of each start state
+	 */
+	template <typename StateT>
+	static std::set<std::set<StateT>>
+	combine_models(const std::vector<std::shared_ptr<const std::set<std::set<StateT>>>> &models,
+	               const std::optional<StateT>                                          &sink_state);
+
+	/** Build the transition table from the transitions. */
+	void build_transition_table();
+
+	/** Look up the compiled formula of the transition with the given source and symbol.
+	 * @param source The source location of the transition
+	 * @param symbol_id The ID of the symbol of the transition
+	 * @return The compiled formula of the transition, or nullptr if there is no such transition
+	 */
+	const CompiledFormula<LocationT> *find_transition_formula(const LocationT &source,
+	                                                          std::size_t      symbol_id) const;
+
 	const std::set<SymbolT>                        alphabet_;
 	const LocationT                                initial_location_;
 	const std::set<LocationT>                      final_locations_;
 	const std::set<Transition<LocationT, SymbolT>> transitions_;
 	const std::optional<LocationT>                 sink_location_;
+	/// The IDs of all source locations of the transitions
+	std::unordered_map<LocationT, std::size_t> location_ids_;
+	/// The IDs of all symbols of the transitions
+	std::map<SymbolT, std::size_t> symbol_ids_;
+	/// The compiled transition formulas, referenced by the transition table
+	std::vector<CompiledFormula<LocationT>> compiled_formulas_;
+	/// The compiled transition formula for each (location ID, symbol ID) pair, in row-major order
+	std::vector<const CompiledFormula<LocationT> *> transition_table_;
+	/// The minimal models of the transition formulas, shared by all symbol steps
+	mutable MinimalModelCache<LocationT, CompiledFormula<LocationT>> minimal_models_;
 };
 
 } // namespace tacos::automata::ata
@@ -144,6 +144,51 @@ AlternatingTimedAutomaton<LocationT, SymbolT>::AlternatingTimedAutomaton(
 			}
 		}
 	}
+	build_transition_table();
+}
+
+template <typename LocationT, typename SymbolT>
+void
+AlternatingTimedAutomaton<LocationT, SymbolT>::build_transition_table()
+{
+	for (const auto &transition : transitions_) {
+		location_ids_.emplace(transition.source_, location_ids_.size());
+		symbol_ids_.emplace(transition.symbol_, symbol_ids_.size());
+	}
+	std::vector<const Formula<LocationT> *> formulas(location_ids_.size() * symbol_ids_.size(),
+	                                                 nullptr);
+	for (const auto &transition : transitions_) {
+		auto &formula = formulas[location_ids_.at(transition.source_) * symbol_ids_.size()
+		                         + symbol_ids_.at(transition.symbol_)];
+		// If there are multiple transitions with the same source and symbol, use the first one.
+		if (formula == nullptr) {
+			formula = transition.formula_.get();
+		}
+	}
+	// Compile all formulas first, the table points into the compiled formulas.
+	compiled_formulas_.reserve(transitions_.size());
+	transition_table_.reserve(formulas.size());
+	for (const auto formula : formulas) {
+		if (formula == nullptr) {
+			transition_table_.push_back(nullptr);
+		} else {
+			compiled_formulas_.emplace_back(*formula);
+			transition_table_.push_back(&compiled_formulas_.back());
+			minimal_models_.add_formula(&compiled_formulas_.back());
+		}
+	}
+}
+
+template <typename LocationT, typename SymbolT>
+const CompiledFormula<LocationT> *
+AlternatingTimedAutomaton<LocationT, SymbolT>::find_transition_formula(const LocationT &source,
+                                                                       std::size_t symbol_id) const
+{
+	const auto location_id = location_ids_.find(source);
+	if (location_id == std::end(location_ids_)) {
+		return nullptr;
+	}
+	return transition_table_[location_id->second * symbol_ids_.size() + symbol_id];
 }
 
 template <typename LocationT, typename SymbolT>
@@ -161,29 +206,72 @@ AlternatingTimedAutomaton<LocationT, SymbolT>::make_symbol_step(
 {
 	// A vector of a set of target configurations that are reached when following a transition.
 	// One entry for each start state
-	std::vector<std::set<Configuration<LocationT>>> models;
+	std::vector<std::shared_ptr<const std::set<Configuration<LocationT>>>> models;
 	// If the start states are empty, we know that the empty set of states is
 	// a minimal model of the last transition step.
 	if (start_states.empty()) {
-		models = {{{}}};
+		models.push_back(std::make_shared<const std::set<Configuration<LocationT>>>(
+		  std::set<Configuration<LocationT>>{{}}));
 	}
-	for (const auto &state : start_states) {
-		auto t = std::find_if(transitions_.cbegin(), transitions_.cend(), [&](const auto &t) {
-			return t.source_ == state.location && t.symbol_ == symbol;
-		});
-		if (t == transitions_.end()) {
-			continue;
+	// If no transition reads the symbol, no state has a transition.
+	if (const auto symbol_id = symbol_ids_.find(symbol); symbol_id != std::end(symbol_ids_)) {
+		for (const auto &state : start_states) {
+			const auto formula = find_transition_formula(state.location, symbol_id->second);
+			if (formula == nullptr) {
+				continue;
+			}
+			models.push_back(minimal_models_.get_minimal_models(formula, state.clock_valuation));
+		}
+	}
+	if (sink_location_.has_value()) {
+		return combine_models(models, std::optional{State<LocationT>{sink_location_.value(), 0}});
+	}
+	return combine_models(models, std::optional<State<LocationT>>{});
+}
+
+template <typename LocationT, typename SymbolT>
+std::set<RegionConfiguration<LocationT>>
+AlternatingTimedAutomaton<LocationT, SymbolT>::make_region_symbol_step(
+  const RegionConfiguration<LocationT> &start_states,
+  const SymbolT                        &symbol) const
+{
+	std::vector<std::shared_ptr<const std::set<RegionConfiguration<LocationT>>>> models;
+	if (start_states.empty()) {
+		models.push_back(std::make_shared<const std::set<RegionConfiguration<LocationT>>>(
+		  std::set<RegionConfiguration<LocationT>>{{}}));
+	}
+	if (const auto symbol_id = symbol_ids_.find(symbol); symbol_id != std::end(symbol_ids_)) {
+		for (const auto &state : start_states) {
+			const auto formula = find_transition_formula(state.location, symbol_id->second);
+			if (formula == nullptr) {
+				continue;
+			}
+			models.push_back(minimal_models_.get_minimal_models_in_region(formula,
+			                                                              state.region_index,
+			                                                              state.fractional_rank));
 		}
-		const auto new_states = get_minimal_models(t->formula_.get(), state.clock_valuation);
-		models.push_back(new_states);
 	}
+	if (sink_location_.has_value()) {
+		return combine_models(models,
+		                      std::optional{RegionState<LocationT>{sink_location_.value(), 0, 0}});
+	}
+	return combine_models(models, std::optional<RegionState<LocationT>>{});
+}
+
+template <typename LocationT, typename SymbolT>
+template <typename StateT>
+std::set<std::set<StateT>>
+AlternatingTimedAutomaton<LocationT, SymbolT>::combine_models(
+  const std::vector<std::shared_ptr<const std::set<std::set<StateT>>>> &models,
+  const std::optional<StateT>                                          &sink_state)
+{
 	// We were not able to make any transition.
 	if (models.empty() || std::any_of(std::begin(models), std::end(models), [](const auto &model) {
-		    return model.empty();
+		    return model->empty();
 	    })) {
 		// We have a sink location, the next configuration is the singleton {(sink, 0)}.
-		if (sink_location_.has_value()) {
-			return {{State<LocationT>{sink_location_.value(), 0}}};
+		if (sink_state.has_value()) {
+			return {{*sink_state}};
 		} else {
 			// No sink location, return the empty set. The ATA is incomplete.
 			return {};
@@ -191,19 +279,19 @@ AlternatingTimedAutomaton<LocationT, SymbolT>::make_symbol_step(
 	}
 	// The resulting configurations after computing the cartesian product of all target
 	// configurations of each state
-	std::set<Configuration<LocationT>> configurations;
+	std::set<std::set<StateT>> configurations;
 	// The vector models now contains in each element all minimal models for one start state.
 	// Transform the vector such that in each entry, we have one minimal model
 	// for each start state.
 	//
 	// Populate the configurations by splitting the first configuration in all minimal models
 	// { { m1, m2, m3 } } -> { { m1 }, { m2 }, { m3 } }
-	ranges::for_each(models[0],
+	ranges::for_each(*models[0],
 	                 [&](const auto &state_model) { configurations.insert({state_model}); });
 	// Add models from the other configurations
 	std::for_each(std::next(models.begin()), models.end(), [&](const auto &state_models) {
-		std::set<Configuration<LocationT>> expanded_configurations;
-		ranges::for_each(state_models, [&](const auto &state_model) {
+		std::set<std::set<StateT>> expanded_configurations;
+		ranges::for_each(*state_models, [&](const auto &state_model) {
 			ranges::for_each(configurations, [&](const auto &configuration) {
 				auto expanded_configuration = configuration;
 				expanded_configuration.insert(state_model.begin(), state_model.end());
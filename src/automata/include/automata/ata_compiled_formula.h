@@ -0,0 +1,475 @@
+/***************************************************************************
+ *  ata_compiled_formula.h - ATA formulas compiled to flat instruction arrays
+ *
+ *  Created:   Sun 18 Oct 14:26:09 CEST 2026
+ *  Copyright  2026  Till Hofmann <hofmann@kbsg.rwth-aachen.de>
+ *  SPDX-License-Identifier: LGPL-3.0-or-later
+ ****************************************************************************/
+
+#pragma once
+
+#include "ata_formula.h"
+#include "automata.h"
+#include "utilities/types.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <set>
+#include <stdexcept>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+namespace tacos::automata::ata {
+
+/** The reusable memory for evaluating a CompiledFormula.
+ * A buffer may be used for any number of evaluations, but not by multiple threads at once. After
+ * the first few evaluations, the buffer usually has enough capacity such that evaluating a formula
+ * does not allocate any memory except for the final result.
+ */
+class EvaluationBuffer
+{
+	template <typename LocationT>
+	friend class CompiledFormula;
+
+	/** A state during the evaluation, i.e., a location index and whether the clock is reset. */
+	using StateId = std::uint32_t;
+	/** A range [first, second) in another array of the buffer. */
+	using Range = std::pair<std::uint32_t, std::uint32_t>;
+
+	void
+	clear()
+	{
+		values.clear();
+		states.clear();
+		models.clear();
+		model_sets.clear();
+	}
+
+	/// The stack of truth values
+	std::vector<char> values;
+	/// The states of all models, each model is sorted
+	std::vector<StateId> states;
+	/// The models, as ranges in states
+	std::vector<Range> models;
+	/// The stack of model sets, as ranges in models
+	std::vector<Range> model_sets;
+	/// Scratch space for combining two model sets
+	std::vector<Range> scratch;
+};
+
+/** @brief An ATA formula compiled to a flat instruction array.
+ *
+ * The formula tree is lowered into an array of instructions in postfix order, which is evaluated
+ * by a non-virtual interpreter with an explicit stack. Clock resets are resolved during the
+ * compilation by marking each location and clock constraint that is below a reset. During the
+ * evaluation of minimal models, a state is represented by the index of its location and a flag
+ * whether its clock is reset. The indexes are ordered like the locations, so the models are ordered
+ * like the models of the formula tree and both forms produce the same minimal models.
+ */
+template <typename LocationT>
+class CompiledFormula
+{
+public:
+	/** Compile a formula.
+	 * @param formula The formula to compile
+	 */
+	explicit CompiledFormula(const Formula<LocationT> &formula)
+	: largest_constant_(formula.get_largest_clock_constant())
+	{
+		std::set<LocationT> locations;
+		collect_locations(formula, locations);
+		locations_.assign(std::begin(locations), std::end(locations));
+		compile(formula, false);
+	}
+
+	/** Check if the formula is satisfied by a configuration and a clock valuation.
+	 * @param states The configuration to check
+	 * @param v The clock valuation to check
+	 * @return true if the formula is satisfied
+	 */
+	[[nodiscard]] bool
+	is_satisfied(const std::set<State<LocationT>> &states, const ClockValuation &v) const
+	{
+		thread_local EvaluationBuffer buffer;
+		buffer.clear();
+		auto &values = buffer.values;
+		for (const auto &instruction : instructions_) {
+			const ClockValuation valuation = instruction.reset ? ClockValuation{0} : v;
+			switch (instruction.op_code) {
+			case OpCode::CONSTANT_TRUE: values.push_back(true); break;
+			case OpCode::CONSTANT_FALSE: values.push_back(false); break;
+			case OpCode::LOCATION:
+				values.push_back(states.count({locations_[instruction.operand], valuation}) > 0);
+				break;
+			case OpCode::CLOCK_CONSTRAINT:
+				values.push_back(automata::is_satisfied(constraints_[instruction.operand], valuation));
+				break;
+			case OpCode::CONJUNCTION:
+			case OpCode::DISJUNCTION: {
+				const bool second = values.back();
+				values.pop_back();
+				if (instruction.op_code == OpCode::CONJUNCTION) {
+					values.back() = values.back() && second;
+				} else {
+					values.back() = values.back() || second;
+				}
+				break;
+			}
+			}
+		}
+		return values.back();
+	}
+
+	/** Compute the minimal models of the formula.
+	 * @param v The clock valuation to evaluate the formula against
+	 * @return a set of minimal models, where each minimal model consists of a set of states
+	 */
+	std::set<std::set<State<LocationT>>>
+	get_minimal_models(const ClockValuation &v) const
+	{
+		thread_local EvaluationBuffer buffer;
+		return get_minimal_models(v, buffer);
+	}
+
+	/** Compute the minimal models of the formula using the given buffer.
+	 * @param v The clock valuation to evaluate the formula against
+	 * @param buffer The buffer to use for the evaluation
+	 * @return a set of minimal models, where each minimal model consists of a set of states
+	 */
+	std::set<std::set<State<LocationT>>>
+	get_minimal_models(const ClockValuation &v, EvaluationBuffer &buffer) const
+	{
+		evaluate_minimal_models(
+		  [v](const ClockConstraint &constraint, bool reset) {
+			  return automata::is_satisfied(constraint, reset ? ClockValuation{0} : v);
+		  },
+		  v == 0,
+		  buffer);
+		return get_models(buffer, [this, v](StateId id) {
+			return State<LocationT>{locations_[id / 2], id % 2 == 0 ? ClockValuation{0} : v};
+		});
+	}
+
+	/** Compute the minimal models of the formula for all clock valuations in a region.
+	 * A state of a model either has the region index and fractional rank of the evaluated clock
+	 * valuation, or its clock is reset, i.e., it has region index 0 and fractional rank 0.
+	 * @param region_index The region index of the clock valuations to evaluate the formula against
+	 * @param fractional_rank The rank of the fractional part of the clock valuations
+	 * @return a set of minimal models, where each minimal model consists of a set of region states
+	 */
+	std::set<std::set<RegionState<LocationT>>>
+	get_minimal_models_in_region(RegionIndex region_index, std::size_t fractional_rank) const
+	{
+		thread_local EvaluationBuffer buffer;
+		return get_minimal_models_in_region(region_index, fractional_rank, buffer);
+	}
+
+	/** Compute the minimal models of the formula for all clock valuations in a region.
+	 * @param region_index The region index of the clock valuations to evaluate the formula against
+	 * @param fractional_rank The rank of the fractional part of the clock valuations
+	 * @param buffer The buffer to use for the evaluation
+	 * @return a set of minimal models, where each minimal model consists of a set of region states
+	 */
+	std::set<std::set<RegionState<LocationT>>>
+	get_minimal_models_in_region(RegionIndex       region_index,
+	                             std::size_t       fractional_rank,
+	                             EvaluationBuffer &buffer) const
+	{
+		evaluate_minimal_models(
+		  [region_index](const ClockConstraint &constraint, bool reset) {
+			  return automata::is_satisfied_in_region(constraint, reset ? RegionIndex{0} : region_index);
+		  },
+		  region_index == 0,
+		  buffer);
+		return get_models(buffer, [this, region_index, fractional_rank](StateId id) {
+			if (id % 2 == 0) {
+				return RegionState<LocationT>{locations_[id / 2], 0, 0};
+			}
+			return RegionState<LocationT>{locations_[id / 2], region_index, fractional_rank};
+		});
+	}
+
+	/** Get the largest constant that the clock is compared to in the formula. */
+	[[nodiscard]] Endpoint
+	get_largest_clock_constant() const
+	{
+		return largest_constant_;
+	}
+
+	/** Get the number of instructions of the compiled formula. */
+	[[nodiscard]] std::size_t
+	size() const
+	{
+		return instructions_.size();
+	}
+
+private:
+	enum class OpCode : std::uint8_t {
+		CONSTANT_TRUE,
+		CONSTANT_FALSE,
+		LOCATION,
+		CLOCK_CONSTRAINT,
+		CONJUNCTION,
+		DISJUNCTION,
+	};
+
+	struct Instruction
+	{
+		OpCode op_code;
+		/// True if the instruction is evaluated with a reset clock
+		bool reset;
+		/// The index of the location or clock constraint
+		std::uint32_t operand;
+	};
+
+	using StateId = EvaluationBuffer::StateId;
+	using Range   = EvaluationBuffer::Range;
+
+	/** Evaluate the minimal models of the formula into the buffer.
+	 * @param is_constraint_satisfied A Callable that checks whether a clock constraint is satisfied,
+	 * given the constraint and whether the clock is reset
+	 * @param is_zero True if the clock valuation is 0, such that a reset does not change a state
+	 * @param buffer The buffer to evaluate into
+	 */
+	template <typename IsConstraintSatisfied>
+	void
+	evaluate_minimal_models(IsConstraintSatisfied &&is_constraint_satisfied,
+	                        bool                    is_zero,
+	                        EvaluationBuffer       &buffer) const
+	{
+		buffer.clear();
+		for (const auto &instruction : instructions_) {
+			switch (instruction.op_code) {
+			case OpCode::CONSTANT_TRUE: push_true(buffer); break;
+			case OpCode::CONSTANT_FALSE: push_false(buffer); break;
+			case OpCode::LOCATION: {
+				const bool reset = instruction.reset || is_zero;
+				push_true(buffer);
+				buffer.states.push_back(2 * instruction.operand + (reset ? 0 : 1));
+				buffer.models.back().second++;
+				break;
+			}
+			case OpCode::CLOCK_CONSTRAINT:
+				if (is_constraint_satisfied(constraints_[instruction.operand], instruction.reset)) {
+					push_true(buffer);
+				} else {
+					push_false(buffer);
+				}
+				break;
+			case OpCode::CONJUNCTION: combine_conjunction(buffer); break;
+			case OpCode::DISJUNCTION: combine_disjunction(buffer); break;
+			}
+		}
+	}
+
+	/** Convert the evaluated models in the buffer to sets of states.
+	 * @param buffer The buffer that contains the evaluated models
+	 * @param get_state A Callable that converts a state ID to a state
+	 */
+	template <typename GetState>
+	static auto
+	get_models(const EvaluationBuffer &buffer, GetState &&get_state)
+	{
+		using StateT = std::invoke_result_t<GetState, StateId>;
+		std::set<std::set<StateT>> res;
+		const auto [first_model, last_model] = buffer.model_sets.back();
+		for (auto model = first_model; model < last_model; ++model) {
+			std::set<StateT> states;
+			const auto [first_state, last_state] = buffer.models[model];
+			for (auto state = first_state; state < last_state; ++state) {
+				states.insert(std::end(states), get_state(buffer.states[state]));
+			}
+			res.insert(std::end(res), std::move(states));
+		}
+		return res;
+	}
+
+	void
+	collect_locations(const Formula<LocationT> &formula, std::set<LocationT> &locations) const
+	{
+		if (typeid(formula) == typeid(LocationFormula<LocationT>)) {
+			locations.insert(static_cast<const LocationFormula<LocationT> &>(formula).location_);
+		} else if (typeid(formula) == typeid(ConjunctionFormula<LocationT>)) {
+			const auto &conjunction = static_cast<const ConjunctionFormula<LocationT> &>(formula);
+			collect_locations(*conjunction.conjunct1_, locations);
+			collect_locations(*conjunction.conjunct2_, locations);
+		} else if (typeid(formula) == typeid(DisjunctionFormula<LocationT>)) {
+			const auto &disjunction = static_cast<const DisjunctionFormula<LocationT> &>(formula);
+			collect_locations(*disjunction.disjunct1_, locations);
+			collect_locations(*disjunction.disjunct2_, locations);
+		} else if (typeid(formula) == typeid(ResetClockFormula<LocationT>)) {
+			collect_locations(*static_cast<const ResetClockFormula<LocationT> &>(formula).sub_formula_,
+			                  locations);
+		}
+	}
+
+	void
+	compile(const Formula<LocationT> &formula, bool reset)
+	{
+		if (typeid(formula) == typeid(TrueFormula<LocationT>)) {
+			instructions_.push_back({OpCode::CONSTANT_TRUE, reset, 0});
+		} else if (typeid(formula) == typeid(FalseFormula<LocationT>)) {
+			instructions_.push_back({OpCode::CONSTANT_FALSE, reset, 0});
+		} else if (typeid(formula) == typeid(LocationFormula<LocationT>)) {
+			const auto &location = static_cast<const LocationFormula<LocationT> &>(formula).location_;
+			const auto  position =
+			  std::lower_bound(std::begin(locations_), std::end(locations_), location);
+			instructions_.push_back({OpCode::LOCATION,
+			                         reset,
+			                         static_cast<std::uint32_t>(
+			                           std::distance(std::begin(locations_), position))});
+		} else if (typeid(formula) == typeid(ClockConstraintFormula<LocationT>)) {
+			constraints_.push_back(
+			  static_cast<const ClockConstraintFormula<LocationT> &>(formula).constraint_);
+			instructions_.push_back({OpCode::CLOCK_CONSTRAINT,
+			                         reset,
+			                         static_cast<std::uint32_t>(constraints_.size() - 1)});
+		} else if (typeid(formula) == typeid(ConjunctionFormula<LocationT>)) {
+			const auto &conjunction = static_cast<const ConjunctionFormula<LocationT> &>(formula);
+			compile(*conjunction.conjunct1_, reset);
+			compile(*conjunction.conjunct2_, reset);
+			instructions_.push_back({OpCode::CONJUNCTION, reset, 0});
+		} else if (typeid(formula) == typeid(DisjunctionFormula<LocationT>)) {
+			const auto &disjunction = static_cast<const DisjunctionFormula<LocationT> &>(formula);
+			compile(*disjunction.disjunct1_, reset);
+			compile(*disjunction.disjunct2_, reset);
+			instructions_.push_back({OpCode::DISJUNCTION, reset, 0});
+		} else if (typeid(formula) == typeid(ResetClockFormula<LocationT>)) {
+			compile(*static_cast<const ResetClockFormula<LocationT> &>(formula).sub_formula_, true);
+		} else {
+			throw std::logic_error("Unexpected formula type in compilation");
+		}
+	}
+
+	/** Push a model set that only contains the empty model. */
+	static void
+	push_true(EvaluationBuffer &buffer)
+	{
+		const auto num_states = static_cast<std::uint32_t>(buffer.states.size());
+		const auto num_models = static_cast<std::uint32_t>(buffer.models.size());
+		buffer.models.push_back({num_states, num_states});
+		buffer.model_sets.push_back({num_models, num_models + 1});
+	}
+
+	/** Push an empty model set. */
+	static void
+	push_false(EvaluationBuffer &buffer)
+	{
+		const auto num_models = static_cast<std::uint32_t>(buffer.models.size());
+		buffer.model_sets.push_back({num_models, num_models});
+	}
+
+	static bool
+	includes(const EvaluationBuffer &buffer, const Range &superset, const Range &subset)
+	{
+		const auto states = std::begin(buffer.states);
+		return std::includes(states + superset.first,
+		                     states + superset.second,
+		                     states + subset.first,
+		                     states + subset.second);
+	}
+
+	/** Replace the two model sets on top of the stack by the models in the scratch space. */
+	static void
+	replace_top_model_sets(EvaluationBuffer &buffer)
+	{
+		auto &scratch = buffer.scratch;
+		std::sort(std::begin(scratch), std::end(scratch), [&buffer](const Range &a, const Range &b) {
+			const auto states = std::begin(buffer.states);
+			return std::lexicographical_compare(states + a.first,
+			                                    states + a.second,
+			                                    states + b.first,
+			                                    states + b.second);
+		});
+		scratch.erase(std::unique(std::begin(scratch),
+		                          std::end(scratch),
+		                          [&buffer](const Range &a, const Range &b) {
+			                          const auto states = std::begin(buffer.states);
+			                          return std::equal(states + a.first,
+			                                            states + a.second,
+			                                            states + b.first,
+			                                            states + b.second);
+		                          }),
+		              std::end(scratch));
+		buffer.model_sets.pop_back();
+		auto &model_set = buffer.model_sets.back();
+		buffer.models.resize(model_set.first);
+		buffer.models.insert(std::end(buffer.models), std::begin(scratch), std::end(scratch));
+		model_set.second = static_cast<std::uint32_t>(buffer.models.size());
+	}
+
+	/** Combine the two model sets on top of the stack to the models of their conjunction.
+	 * Each model of the conjunction is the union of one model of each conjunct.
+	 */
+	static void
+	combine_conjunction(EvaluationBuffer &buffer)
+	{
+		const auto second = buffer.model_sets.back();
+		const auto first  = buffer.model_sets[buffer.model_sets.size() - 2];
+		buffer.scratch.clear();
+		for (auto model1 = first.first; model1 < first.second; ++model1) {
+			for (auto model2 = second.first; model2 < second.second; ++model2) {
+				const auto [first1, last1] = buffer.models[model1];
+				const auto [first2, last2] = buffer.models[model2];
+				const auto begin           = static_cast<std::uint32_t>(buffer.states.size());
+				// Merge both sorted models. The states may be reallocated, so access them by index.
+				for (auto i = first1, j = first2; i < last1 || j < last2;) {
+					StateId state;
+					if (j == last2 || (i < last1 && buffer.states[i] < buffer.states[j])) {
+						state = buffer.states[i++];
+					} else if (i == last1 || buffer.states[j] < buffer.states[i]) {
+						state = buffer.states[j++];
+					} else {
+						state = buffer.states[i++];
+						++j;
+					}
+					buffer.states.push_back(state);
+				}
+				buffer.scratch.push_back({begin, static_cast<std::uint32_t>(buffer.states.size())});
+			}
+		}
+		replace_top_model_sets(buffer);
+	}
+
+	/** Combine the two model sets on top of the stack to the minimal models of their disjunction.
+	 * This follows DisjunctionFormula::get_minimal_models: first, each model of the first disjunct
+	 * that is a superset of a model of the second disjunct is removed. Then, each model of the
+	 * second disjunct is added if it is not a superset of a model that was kept or added before.
+	 */
+	static void
+	combine_disjunction(EvaluationBuffer &buffer)
+	{
+		const auto  second  = buffer.model_sets.back();
+		const auto  first   = buffer.model_sets[buffer.model_sets.size() - 2];
+		auto       &scratch = buffer.scratch;
+		scratch.clear();
+		for (auto model1 = first.first; model1 < first.second; ++model1) {
+			bool is_superset = false;
+			for (auto model2 = second.first; model2 < second.second && !is_superset; ++model2) {
+				is_superset = includes(buffer, buffer.models[model1], buffer.models[model2]);
+			}
+			if (!is_superset) {
+				scratch.push_back(buffer.models[model1]);
+			}
+		}
+		for (auto model2 = second.first; model2 < second.second; ++model2) {
+			if (std::none_of(std::begin(scratch), std::end(scratch), [&](const Range &model) {
+				    return includes(buffer, buffer.models[model2], model);
+			    })) {
+				scratch.push_back(buffer.models[model2]);
+			}
+		}
+		replace_top_model_sets(buffer);
+	}
+
+	Endpoint                     largest_constant_;
+	std::vector<LocationT>       locations_;
+	std::vector<ClockConstraint> constraints_;
+	std::vector<Instruction>     instructions_;
+};
+
+} // namespace tacos::automata::ata
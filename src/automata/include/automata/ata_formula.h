@@ -14,9 +14,11 @@
 #include <fmt/ostream.h>
 
 #include <algorithm>
+#include <cstddef>
 #include <memory>
 #include <range/v3/algorithm.hpp>
 #include <range/v3/view.hpp>
+#include <tuple>
 #include <type_traits>
 #include <utility>
 
@@ -60,11 +62,60 @@ operator==(const State<LocationT> &s1, const State<LocationT> &s2)
 	return !(s1 < s2) && !(s2 < s1);
 }
 
+/** @brief A state of an ATA whose clock valuation is only known up to its region.
+ *
+ * The region index does not determine how the fractional part of the clock valuation relates to
+ * the fractional parts of other clocks. Therefore, a region state also has the rank of its
+ * fractional part among all clocks: states with the same region index and fractional rank have the
+ * same clock valuation. The fractional rank is 0 if and only if the fractional part is 0.
+ * @tparam The location type
+ */
+template <typename LocationT>
+struct RegionState
+{
+	/** The location of the state */
+	LocationT location;
+	/** The region index of the clock valuation of the state */
+	RegionIndex region_index;
+	/** The rank of the fractional part of the clock valuation */
+	std::size_t fractional_rank;
+};
+
+/** Compare two region states lexicographically. */
+template <typename LocationT>
+bool
+operator<(const RegionState<LocationT> &s1, const RegionState<LocationT> &s2)
+{
+	return std::tie(s1.location, s1.region_index, s1.fractional_rank)
+	       < std::tie(s2.location, s2.region_index, s2.fractional_rank);
+}
+
+/** Check two region states for equality. */
+template <typename LocationT>
+bool
+operator==(const RegionState<LocationT> &s1, const RegionState<LocationT> &s2)
+{
+	return !(s1 < s2) && !(s2 < s1);
+}
+
+/** Print a RegionState to an ostream. */
+template <typename LocationT>
+std::ostream &
+operator<<(std::ostream &os, const RegionState<LocationT> &state)
+{
+	os << "(" << state.location << ", " << state.region_index << ", " << state.fractional_rank
+	   << ")";
+	return os;
+}
+
 // using State = std::pair<LocationT, ClockValuation>;
 
 template <typename LocationT>
 class Formula;
 
+template <typename LocationT>
+class CompiledFormula;
+
 /** Compare two ATA formulas. */
 template <typename LocationT>
 bool operator<(const Formula<LocationT> &, const Formula<LocationT> &);
@@ -116,6 +167,14 @@ public:
 	 */
 	virtual std::set<std::set<State<LocationT>>>
 	get_minimal_models(const ClockValuation &v) const = 0;
+	/** Get the largest constant that the clock is compared to in the formula.
+	 * @return The largest constant of all clock constraints in the formula, 0 if there is none
+	 */
+	[[nodiscard]] virtual Endpoint
+	get_largest_clock_constant() const
+	{
+		return 0;
+	}
 
 	// clang-format off
 	friend std::ostream & operator<< <>(std::ostream &os, const Formula &formula);
@@ -168,6 +227,7 @@ class LocationFormula : public Formula<LocationT>
 	// clang-format off
 	friend bool operator< <>(const Formula<LocationT> &, const Formula<LocationT> &);
 	// clang-format on
+	friend class CompiledFormula<LocationT>;
 
 public:
 	/** Constructor.
@@ -195,6 +255,7 @@ class ClockConstraintFormula : public Formula<LocationT>
 	// clang-format off
 	friend bool operator< <>(const Formula<LocationT> &, const Formula<LocationT> &);
 	// clang-format on
+	friend class CompiledFormula<LocationT>;
 
 public:
 	/** Constructor.
@@ -205,6 +266,7 @@ public:
 	}
 	bool is_satisfied(const std::set<State<LocationT>> &, const ClockValuation &v) const override;
 	std::set<std::set<State<LocationT>>> get_minimal_models(const ClockValuation &v) const override;
+	Endpoint                             get_largest_clock_constant() const override;
 
 protected:
 	/** Print a ClockConstraintFormula to an ostream
@@ -223,6 +285,7 @@ class ConjunctionFormula : public Formula<LocationT>
 	// clang-format off
 	friend bool operator< <>(const Formula<LocationT> &, const Formula<LocationT> &);
 	// clang-format on
+	friend class CompiledFormula<LocationT>;
 
 public:
 	/** Constructor.
@@ -240,6 +303,8 @@ public:
 
 	std::set<std::set<State<LocationT>>> get_minimal_models(const ClockValuation &v) const override;
 
+	Endpoint get_largest_clock_constant() const override;
+
 protected:
 	/** Print a ConjunctionFormula to an ostream
 	 * @param os The ostream to print to
@@ -258,6 +323,7 @@ class DisjunctionFormula : public Formula<LocationT>
 	// clang-format off
 	friend bool operator< <>(const Formula<LocationT> &, const Formula<LocationT> &);
 	// clang-format on
+	friend class CompiledFormula<LocationT>;
 
 public:
 	/** Constructor.
@@ -273,6 +339,7 @@ public:
 	bool                                 is_satisfied(const std::set<State<LocationT>> &states,
 	                                                  const ClockValuation             &v) const override;
 	std::set<std::set<State<LocationT>>> get_minimal_models(const ClockValuation &v) const override;
+	Endpoint                             get_largest_clock_constant() const override;
 
 protected:
 	/** Print a DisjunctionFormula to an ostream
@@ -292,6 +359,7 @@ class ResetClockFormula : public Formula<LocationT>
 	// clang-format off
 	friend bool operator< <>(const Formula<LocationT> &, const Formula<LocationT> &);
 	// clang-format on
+	friend class CompiledFormula<LocationT>;
 
 public:
 	/** Constructor.
@@ -304,6 +372,7 @@ public:
 	bool                                 is_satisfied(const std::set<State<LocationT>> &states,
 	                                                  const ClockValuation &) const override;
 	std::set<std::set<State<LocationT>>> get_minimal_models(const ClockValuation &) const override;
+	Endpoint                             get_largest_clock_constant() const override;
 
 protected:
 	/** Print a ResetClockFormula to an ostream
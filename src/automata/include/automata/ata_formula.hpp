@@ -119,6 +119,14 @@ ClockConstraintFormula<LocationT>::get_minimal_models(const ClockValuation &v) c
 	}
 }
 
+template <typename LocationT>
+Endpoint
+ClockConstraintFormula<LocationT>::get_largest_clock_constant() const
+{
+	return std::visit([](const auto &atomic_constraint) { return atomic_constraint.get_comparand(); },
+	                  constraint_);
+}
+
 template <typename LocationT>
 void
 ClockConstraintFormula<LocationT>::print_to_ostream(std::ostream &os) const
@@ -150,6 +158,14 @@ ConjunctionFormula<LocationT>::get_minimal_models(const ClockValuation &v) const
 	return res;
 }
 
+template <typename LocationT>
+Endpoint
+ConjunctionFormula<LocationT>::get_largest_clock_constant() const
+{
+	return std::max(conjunct1_->get_largest_clock_constant(),
+	                conjunct2_->get_largest_clock_constant());
+}
+
 template <typename LocationT>
 void
 ConjunctionFormula<LocationT>::print_to_ostream(std::ostream &os) const
@@ -202,6 +218,14 @@ DisjunctionFormula<LocationT>::get_minimal_models(const ClockValuation &v) const
 	return disjunct1_models;
 }
 
+template <typename LocationT>
+Endpoint
+DisjunctionFormula<LocationT>::get_largest_clock_constant() const
+{
+	return std::max(disjunct1_->get_largest_clock_constant(),
+	                disjunct2_->get_largest_clock_constant());
+}
+
 template <typename LocationT>
 void
 DisjunctionFormula<LocationT>::print_to_ostream(std::ostream &os) const
@@ -224,6 +248,13 @@ ResetClockFormula<LocationT>::get_minimal_models(const ClockValuation &) const
 	return sub_formula_->get_minimal_models(0);
 }
 
+template <typename LocationT>
+Endpoint
+ResetClockFormula<LocationT>::get_largest_clock_constant() const
+{
+	return sub_formula_->get_largest_clock_constant();
+}
+
 template <typename LocationT>
 void
 ResetClockFormula<LocationT>::print_to_ostream(std::ostream &os) const
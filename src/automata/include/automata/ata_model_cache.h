@@ -0,0 +1,228 @@
+/***************************************************************************
+ *  ata_model_cache.h - A cache of minimal models of ATA formulas
+ *
+ *  Created:   Sun 18 Oct 11:03:52 CEST 2026
+ *  Copyright  2026  Till Hofmann <hofmann@kbsg.rwth-aachen.de>
+ *  SPDX-License-Identifier: LGPL-3.0-or-later
+ ****************************************************************************/
+
+#pragma once
+
+#include "ata_formula.h"
+#include "utilities/clock_cache.h"
+#include "utilities/types.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <set>
+#include <unordered_map>
+#include <utility>
+
+namespace tacos::automata::ata {
+
+/** @brief A bounded, thread-safe cache of the minimal models of ATA formulas.
+ *
+ * The minimal models of a formula only contain states with the clock valuation that the formula is
+ * evaluated against or with a reset clock. Whether a clock constraint of the formula is satisfied
+ * only depends on the region of the clock valuation with respect to the formula's constants.
+ * Hence, the minimal models for one clock valuation can be reused for any other clock valuation in
+ * the same region by replacing the clock valuation of each state that is not reset.
+ *
+ * The cache stores the minimal models for each pair of formula and region. A formula must be added
+ * to the cache before its minimal models are cached, formulas that have not been added are
+ * evaluated without the cache.
+ * @tparam LocationT The location type of the formulas
+ * @tparam FormulaT The type of the formulas, either a Formula or a CompiledFormula
+ * @see utilities::ClockCache
+ */
+template <typename LocationT, typename FormulaT = Formula<LocationT>>
+class MinimalModelCache
+{
+public:
+	/** The minimal models of a formula. */
+	using Models = std::set<std::set<State<LocationT>>>;
+	/** The minimal models of a formula for a region. */
+	using RegionModels = std::set<std::set<RegionState<LocationT>>>;
+	/** The default maximal number of cached model sets. */
+	static constexpr std::size_t default_capacity = std::size_t{1} << 16;
+
+	/** Construct the cache.
+	 * @param capacity The maximal number of cached model sets
+	 */
+	explicit MinimalModelCache(std::size_t capacity = default_capacity)
+	: models_(capacity), region_models_(capacity)
+	{
+	}
+
+	/** Add a formula to the cache.
+	 * This must not be called concurrently with any other member function.
+	 * @param formula The formula to add, must outlive the cache
+	 */
+	void
+	add_formula(const FormulaT *formula)
+	{
+		largest_constants_[formula] = formula->get_largest_clock_constant();
+	}
+
+	/** Get the minimal models of a formula, compute them if they are not cached.
+	 * If the models were cached for the same clock valuation or if they do not depend on the clock
+	 * valuation, the cached models are returned without copying them.
+	 * @param formula The formula to get the minimal models of
+	 * @param v The clock valuation to evaluate the formula against
+	 * @return A pointer to the minimal models of the formula
+	 */
+	std::shared_ptr<const Models>
+	get_minimal_models(const FormulaT *formula, ClockValuation v)
+	{
+		const auto largest_constant = largest_constants_.find(formula);
+		if (largest_constant == std::end(largest_constants_)) {
+			return std::make_shared<const Models>(formula->get_minimal_models(v));
+		}
+		const auto cached = models_.get_or_compute(
+		  {formula, get_region_index(v, largest_constant->second)},
+		  [formula, v] { return compute_models(formula, v); });
+		if (cached->clock_valuation == v || !cached->depends_on_clock_valuation) {
+			return std::shared_ptr<const Models>(cached, &cached->models);
+		}
+		auto models = std::make_shared<Models>();
+		for (const auto &cached_model : cached->models) {
+			std::set<State<LocationT>> model;
+			for (const auto &state : cached_model) {
+				model.insert(std::end(model),
+				             State<LocationT>{state.location,
+				                              state.clock_valuation == 0 ? ClockValuation{0} : v});
+			}
+			models->insert(std::end(*models), std::move(model));
+		}
+		return models;
+	}
+
+	/** Get the minimal models of a formula for a region, compute them if they are not cached.
+	 * This is only available if the formula type can be evaluated on regions.
+	 * @param formula The formula to get the minimal models of
+	 * @param region_index The region index to evaluate the formula against
+	 * @param fractional_rank The rank of the fractional part of the clock valuations in the region
+	 * @return A pointer to the minimal models of the formula
+	 * @see CompiledFormula::get_minimal_models_in_region
+	 */
+	std::shared_ptr<const RegionModels>
+	get_minimal_models_in_region(const FormulaT *formula,
+	                             RegionIndex     region_index,
+	                             std::size_t     fractional_rank)
+	{
+		const auto largest_constant = largest_constants_.find(formula);
+		if (largest_constant == std::end(largest_constants_)) {
+			return std::make_shared<const RegionModels>(
+			  formula->get_minimal_models_in_region(region_index, fractional_rank));
+		}
+		// All regions above the largest constant of the formula have the same models.
+		const auto cached = region_models_.get_or_compute(
+		  {formula, std::min(region_index, 2 * largest_constant->second + 1)},
+		  [formula, region_index, fractional_rank] {
+			  return CachedRegionModels{region_index,
+			                            fractional_rank,
+			                            formula->get_minimal_models_in_region(region_index,
+			                                                                  fractional_rank)};
+		  });
+		if (cached->region_index == region_index && cached->fractional_rank == fractional_rank) {
+			return std::shared_ptr<const RegionModels>(cached, &cached->models);
+		}
+		auto models = std::make_shared<RegionModels>();
+		for (const auto &cached_model : cached->models) {
+			std::set<RegionState<LocationT>> model;
+			for (const auto &state : cached_model) {
+				if (state.region_index == 0 && state.fractional_rank == 0) {
+					model.insert(std::end(model), state);
+				} else {
+					model.insert(std::end(model),
+					             RegionState<LocationT>{state.location, region_index, fractional_rank});
+				}
+			}
+			models->insert(std::end(*models), std::move(model));
+		}
+		return models;
+	}
+
+	/** Get the statistics of the cache, combined for clock valuations and regions. */
+	utilities::CacheStatistics
+	get_statistics() const
+	{
+		auto       statistics        = models_.get_statistics();
+		const auto region_statistics = region_models_.get_statistics();
+		statistics.num_hits += region_statistics.num_hits;
+		statistics.num_misses += region_statistics.num_misses;
+		statistics.num_evictions += region_statistics.num_evictions;
+		statistics.size += region_statistics.size;
+		statistics.cost += region_statistics.cost;
+		return statistics;
+	}
+
+private:
+	/** The minimal models of a formula for some clock valuation in the region. */
+	struct CachedModels
+	{
+		/** The clock valuation that the models were computed for. */
+		ClockValuation clock_valuation;
+		/** The minimal models. */
+		Models models;
+		/** True if some state of the models has the (non-zero) clock valuation. */
+		bool depends_on_clock_valuation;
+	};
+
+	/** The minimal models of a formula for some region state with the same key. */
+	struct CachedRegionModels
+	{
+		/** The region index that the models were computed for. */
+		RegionIndex region_index;
+		/** The fractional rank that the models were computed for. */
+		std::size_t fractional_rank;
+		/** The minimal models. */
+		RegionModels models;
+	};
+
+	using Key = std::pair<const FormulaT *, RegionIndex>;
+
+	struct KeyHash
+	{
+		std::size_t
+		operator()(const Key &key) const
+		{
+			return std::hash<const void *>{}(key.first)
+			       ^ (std::size_t{key.second} * 0x9e3779b97f4a7c15);
+		}
+	};
+
+	static CachedModels
+	compute_models(const FormulaT *formula, ClockValuation v)
+	{
+		CachedModels cached{v, formula->get_minimal_models(v), false};
+		for (const auto &model : cached.models) {
+			for (const auto &state : model) {
+				if (state.clock_valuation != 0) {
+					cached.depends_on_clock_valuation = true;
+				}
+			}
+		}
+		return cached;
+	}
+
+	/** Get the region index of a clock valuation with respect to the largest constant. */
+	static RegionIndex
+	get_region_index(ClockValuation v, Endpoint largest_constant)
+	{
+		if (v > largest_constant) {
+			return 2 * largest_constant + 1;
+		}
+		const Time integer_part = std::floor(v);
+		return 2 * static_cast<RegionIndex>(integer_part) + (v == integer_part ? 0 : 1);
+	}
+
+	std::unordered_map<const FormulaT *, Endpoint>          largest_constants_;
+	utilities::ClockCache<Key, CachedModels, KeyHash>       models_;
+	utilities::ClockCache<Key, CachedRegionModels, KeyHash> region_models_;
+};
+
+} // namespace tacos::automata::ata
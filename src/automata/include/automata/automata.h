@@ -124,6 +124,20 @@ public:
 template <class Comp>
 class AtomicClockConstraintT;
 
+namespace details {
+/** The comparison operator on region indexes that corresponds to a comparison operator on time. */
+template <typename Comp>
+struct RegionComparator;
+
+/** Replace the argument type of a standard comparison operator by the region index type. */
+template <template <typename> typename Comp>
+struct RegionComparator<Comp<Time>>
+{
+	/** The comparison operator on region indexes. */
+	using type = Comp<RegionIndex>;
+};
+} // namespace details
+
 /// An atomic clock constraint.
 /**
  * This is a templated atomic constraint, where the template parameter is the comparison operator,
@@ -157,6 +171,21 @@ public:
 		return Comp()(valuation, comparand_);
 	}
 
+	/** Check if the clock constraint is satisfied by all clock valuations in a region.
+	 * The region index 2k represents the valuation k and the region index 2k+1 represents the
+	 * interval (k, k+1). As the comparand is an integer, comparing the region index against twice the
+	 * comparand gives the same result as comparing any valuation of the region against the
+	 * comparand. This is also true for the maximal region if the comparand is at most the largest
+	 * constant of the region set.
+	 * @param region_index The region index of a clock
+	 * @return true if the constraint is satisfied
+	 */
+	constexpr bool
+	is_satisfied_in_region(RegionIndex region_index) const
+	{
+		return typename details::RegionComparator<Comp>::type()(region_index, 2 * comparand_);
+	}
+
 	/**
 	 * @brief Get the comparand
 	 * @return const Time&
@@ -183,6 +212,9 @@ private:
 /** Check if the given clock constraints is satisfied by the given clock valuation. */
 bool is_satisfied(const ClockConstraint &constraint, const ClockValuation &valuation);
 
+/** Check if the given clock constraint is satisfied by all clock valuations in the given region. */
+bool is_satisfied_in_region(const ClockConstraint &constraint, RegionIndex region_index);
+
 /** Get an index corresponding to the operator of the clock constraint. This is useful to compare
  * clock constraints. */
 inline std::optional<std::size_t>
@@ -18,6 +18,7 @@
 #include <algorithm>
 #include <functional>
 #include <map>
+#include <memory>
 #include <set>
 #include <string>
 #include <tuple>
@@ -172,11 +173,31 @@ public:
 		return clock_resets_;
 	}
 
+	/** Resolve the clocks of the guards and resets to their IDs in the given registry.
+	 * Clock valuations over this registry are then evaluated by clock ID instead of clock name.
+	 * @param registry The registry of the automaton's clocks, must contain all clocks of the
+	 * transition
+	 */
+	void resolve_clocks(std::shared_ptr<const ClockRegistry> registry);
+
 	Location<LocationT>                         source_;            ///< source location
 	Location<LocationT>                         target_;            ///< target location
 	AP                                          symbol_;            ///< transition label
 	std::multimap<std::string, ClockConstraint> clock_constraints_; ///< guards
 	std::set<std::string>                       clock_resets_;      ///< resets
+
+private:
+	/** Check if the clock IDs of the transition refer to the registry of the given valuation. */
+	bool
+	is_resolved_for(const ClockSetValuation &clock_vals) const
+	{
+		return clock_registry_ && clock_vals.get_registry() == clock_registry_;
+	}
+
+	/** The registry that the clock IDs of the guards and resets refer to. */
+	std::shared_ptr<const ClockRegistry>                            clock_registry_;
+	std::vector<std::pair<ClockRegistry::ClockId, ClockConstraint>> guard_ids_;
+	std::vector<ClockRegistry::ClockId>                             reset_ids_;
 };
 
 /** Compare two TA transitions. */
@@ -215,7 +236,7 @@ public:
 
 private:
 	std::vector<std::tuple<AP, Time, Location<LocationT>>> sequence_;
-	std::map<std::string, Clock>                           clock_valuations_;
+	ClockSetValuation                                      clock_valuations_;
 	Location<LocationT>                                    current_location_;
 	Time                                                   tick_;
 };
@@ -309,6 +330,28 @@ public:
 		}
 	}
 
+	/** Copy constructor.
+	 * The transition index of the copy refers to the copied transitions.
+	 * @param other The automaton to copy
+	 */
+	TimedAutomaton(const TimedAutomaton &other)
+	: alphabet_(other.alphabet_),
+	  locations_(other.locations_),
+	  initial_location_(other.initial_location_),
+	  final_locations_(other.final_locations_),
+	  clocks_(other.clocks_),
+	  transitions_(other.transitions_)
+	{
+		for (const auto &[source, transition] : transitions_) {
+			transition_index_[source][transition.symbol_].push_back(&transition);
+		}
+	}
+
+	/** Move constructor.
+	 * Moving the transitions does not move the transitions in memory, so the index stays valid.
+	 */
+	TimedAutomaton(TimedAutomaton &&) = default;
+
 	/** Get the alphabet
 	 * @return A reference to the set of symbols used by the TimedAutomaton
 	 */
@@ -397,7 +440,13 @@ public:
 	void
 	add_clock(const std::string &name)
 	{
-		clocks_.insert(name);
+		if (!clocks_.insert(name).second) {
+			return;
+		}
+		const auto registry = ClockRegistry::get(clocks_);
+		for (auto &[source, transition] : transitions_) {
+			transition.resolve_clocks(registry);
+		}
 	}
 	/** Add a set of locations to the TA
 	 * @param locations the locations to add
@@ -410,6 +459,8 @@ public:
 		}
 	}
 	/** Add a transition to the TA.
+	 * The clocks of the transition are resolved to their IDs in the registry of the TA's clocks, so
+	 * guards and resets on the TA's configurations do not look up clock names.
 	 * @param transition The transition to add, must only mention clocks and locations that are
 	 * already part of the TA.
 	 */
@@ -420,6 +471,15 @@ public:
 	std::set<TAConfiguration<LocationT>>
 	make_symbol_step(const TAConfiguration<LocationT> &configuration, const AP &symbol) const;
 
+	/** Compute the resulting configurations after making a symbol step for each symbol.
+	 * This only visits the transitions of the configuration's location, and thus it is cheaper than
+	 * calling make_symbol_step for each symbol of the alphabet.
+	 * @param configuration The configuration to compute the successors of
+	 * @return The successors of the configuration for each symbol that has at least one successor
+	 */
+	std::map<AP, std::set<TAConfiguration<LocationT>>>
+	make_symbol_steps(const TAConfiguration<LocationT> &configuration) const;
+
 	/// Let the TA make a transition on the given symbol at the given time.
 	/** Check if there is a transition that can be enabled on the given symbol at the given time,
 	 * starting with the given path. If so, modify the given path, i.e., apply the transition by
@@ -444,6 +504,17 @@ public:
 	/// Get the enabled transitions in a given configuration.
 	std::vector<Transition> get_enabled_transitions(const TAConfiguration<LocationT> &configuration);
 
+	/** Get the transitions that are enabled for all clock valuations in the given clock regions.
+	 * Guards are evaluated on the region indexes, so no clock valuation is needed.
+	 * @param location The location to get the outgoing transitions of
+	 * @param get_region_index A Callable that returns the region index of a clock, given its name
+	 * @return Pointers to the enabled transitions, ordered by symbol
+	 */
+	template <typename GetRegionIndex>
+	std::vector<const Transition *>
+	get_enabled_transitions_in_region(const Location &location,
+	                                  GetRegionIndex &&get_region_index) const;
+
 	/**
 	 * @brief Get the largest constant any clock is compared to.
 	 * @return Time
@@ -463,12 +534,19 @@ public:
 	is_accepting_configuration(const TAConfiguration<LocationT> &configuration) const;
 
 private:
+	/** Get the configuration that is reached by following the transition from the configuration. */
+	static TAConfiguration<LocationT>
+	get_target_configuration(const Transition                 &transition,
+	                         const TAConfiguration<LocationT> &configuration);
+
 	std::set<AP>                        alphabet_;
 	std::set<Location>                  locations_;
 	const Location                      initial_location_;
 	std::set<Location>                  final_locations_;
 	std::set<std::string>               clocks_;
 	std::multimap<Location, Transition> transitions_;
+	/** The transitions of each location, grouped by symbol and ordered as in transitions_. */
+	std::map<Location, std::map<AP, std::vector<const Transition *>>> transition_index_;
 };
 
 /** Print a multimap of transitions. */
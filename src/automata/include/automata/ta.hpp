@@ -76,6 +76,13 @@ Transition<LocationT, AP>::is_enabled(const AP &symbol, const ClockSetValuation
 	if (symbol != symbol_) {
 		return false;
 	}
+	if (is_resolved_for(clock_vals)) {
+		return std::all_of(std::begin(guard_ids_),
+		                   std::end(guard_ids_),
+		                   [&clock_vals](const auto &constraint) {
+			                   return is_satisfied(constraint.second, clock_vals.at(constraint.first));
+		                   });
+	}
 	return std::all_of(std::begin(clock_constraints_),
 	                   std::end(clock_constraints_),
 	                   [&clock_vals](const auto &constraint) {
@@ -83,6 +90,21 @@ Transition<LocationT, AP>::is_enabled(const AP &symbol, const ClockSetValuation
 	                   });
 }
 
+template <typename LocationT, typename AP>
+void
+Transition<LocationT, AP>::resolve_clocks(std::shared_ptr<const ClockRegistry> registry)
+{
+	guard_ids_.clear();
+	reset_ids_.clear();
+	for (const auto &[clock_name, constraint] : clock_constraints_) {
+		guard_ids_.emplace_back(registry->find(clock_name).value(), constraint);
+	}
+	for (const auto &clock_name : clock_resets_) {
+		reset_ids_.push_back(registry->find(clock_name).value());
+	}
+	clock_registry_ = std::move(registry);
+}
+
 template <typename LocationT, typename AP>
 bool
 operator==(const Transition<LocationT, AP> &lhs, const Transition<LocationT, AP> &rhs)
@@ -144,11 +166,8 @@ operator>(const Transition<LocationT, AP> &lhs, const Transition<LocationT, AP>
 
 template <typename LocationT, typename AP>
 Path<LocationT, AP>::Path(LocationT initial_location, std::set<std::string> clocks)
-: current_location_(initial_location), tick_(0)
+: clock_valuations_(ClockRegistry::get(clocks)), current_location_(initial_location), tick_(0)
 {
-	for (const auto &clock : clocks) {
-		clock_valuations_.emplace(std::make_pair(clock, Clock()));
-	}
 }
 
 template <typename LocationT, typename AP>
@@ -174,7 +193,9 @@ TimedAutomaton<LocationT, AP>::add_transition(const Transition &transition)
 			throw InvalidClockException(clock_name);
 		};
 	}
-	transitions_.insert({transition.source_, transition});
+	const auto inserted = transitions_.insert({transition.source_, transition});
+	inserted->second.resolve_clocks(ClockRegistry::get(clocks_));
+	transition_index_[transition.source_][transition.symbol_].push_back(&inserted->second);
 }
 
 template <typename LocationT, typename AP>
@@ -182,27 +203,66 @@ std::set<TAConfiguration<LocationT>>
 TimedAutomaton<LocationT, AP>::make_symbol_step(const TAConfiguration<LocationT> &configuration,
                                                 const AP                         &symbol) const
 {
+	const auto location_transitions = transition_index_.find(configuration.location);
+	if (location_transitions == std::end(transition_index_)) {
+		return {};
+	}
+	const auto symbol_transitions = location_transitions->second.find(symbol);
+	if (symbol_transitions == std::end(location_transitions->second)) {
+		return {};
+	}
 	std::set<TAConfiguration<LocationT>> res;
-	// TODO This may cause an issue if the transitions are not sorted as expected, because
-	// equal_range returns a sub-sequence
-	auto [first, last] = transitions_.equal_range(configuration.location);
-	while (first != last) {
-		auto trans = std::find_if(first, last, [&](const auto &trans) {
-			return trans.second.is_enabled(symbol, configuration.clock_valuations);
-		});
-		if (trans == last) {
-			return res;
+	for (const Transition *transition : symbol_transitions->second) {
+		if (transition->is_enabled(symbol, configuration.clock_valuations)) {
+			res.insert(get_target_configuration(*transition, configuration));
+		}
+	}
+	return res;
+}
+
+template <typename LocationT, typename AP>
+std::map<AP, std::set<TAConfiguration<LocationT>>>
+TimedAutomaton<LocationT, AP>::make_symbol_steps(
+  const TAConfiguration<LocationT> &configuration) const
+{
+	const auto location_transitions = transition_index_.find(configuration.location);
+	if (location_transitions == std::end(transition_index_)) {
+		return {};
+	}
+	std::map<AP, std::set<TAConfiguration<LocationT>>> res;
+	for (const auto &[symbol, transitions] : location_transitions->second) {
+		std::set<TAConfiguration<LocationT>> successors;
+		for (const Transition *transition : transitions) {
+			if (transition->is_enabled(symbol, configuration.clock_valuations)) {
+				successors.insert(get_target_configuration(*transition, configuration));
+			}
 		}
-		first                         = std::next(trans);
-		ClockSetValuation next_clocks = configuration.clock_valuations;
-		for (const auto &name : trans->second.clock_resets_) {
-			next_clocks[name].reset();
+		if (!successors.empty()) {
+			res.emplace_hint(std::end(res), symbol, std::move(successors));
 		}
-		res.insert(TAConfiguration<LocationT>{trans->second.target_, next_clocks});
 	}
 	return res;
 }
 
+template <typename LocationT, typename AP>
+TAConfiguration<LocationT>
+TimedAutomaton<LocationT, AP>::get_target_configuration(
+  const Transition                 &transition,
+  const TAConfiguration<LocationT> &configuration)
+{
+	TAConfiguration<LocationT> target{transition.target_, configuration.clock_valuations};
+	if (transition.is_resolved_for(target.clock_valuations)) {
+		for (const auto id : transition.reset_ids_) {
+			target.clock_valuations.at(id).reset();
+		}
+		return target;
+	}
+	for (const auto &name : transition.clock_resets_) {
+		target.clock_valuations[name].reset();
+	}
+	return target;
+}
+
 template <typename LocationT, typename AP>
 std::set<Path<LocationT, AP>>
 TimedAutomaton<LocationT, AP>::make_transition(Path<LocationT, AP> path,
@@ -212,9 +272,7 @@ TimedAutomaton<LocationT, AP>::make_transition(Path<LocationT, AP> path,
 	if (path.tick_ > time) {
 		return {};
 	}
-	for (auto &[name, clock] : path.clock_valuations_) {
-		clock.tick(time - path.tick_);
-	}
+	path.clock_valuations_.tick(time - path.tick_);
 	path.tick_ = time;
 	std::set<Path<LocationT, AP>> paths;
 	TAConfiguration<LocationT>    start_configuration = path.get_current_configuration();
@@ -257,11 +315,41 @@ std::vector<Transition<LocationT, AP>>
 TimedAutomaton<LocationT, AP>::get_enabled_transitions(
   const TAConfiguration<LocationT> &configuration)
 {
+	const auto location_transitions = transition_index_.find(configuration.location);
+	if (location_transitions == std::end(transition_index_)) {
+		return {};
+	}
 	std::vector<Transition> res;
-	for (const auto &symbol : alphabet_) {
-		for (const auto &[source, transition] : transitions_) {
-			if (source == configuration.location
-			    && transition.is_enabled(symbol, configuration.clock_valuations)) {
+	for (const auto &[symbol, transitions] : location_transitions->second) {
+		for (const Transition *transition : transitions) {
+			if (transition->is_enabled(symbol, configuration.clock_valuations)) {
+				res.push_back(*transition);
+			}
+		}
+	}
+	return res;
+}
+
+template <typename LocationT, typename AP>
+template <typename GetRegionIndex>
+std::vector<const Transition<LocationT, AP> *>
+TimedAutomaton<LocationT, AP>::get_enabled_transitions_in_region(
+  const Location &location,
+  GetRegionIndex &&get_region_index) const
+{
+	const auto location_transitions = transition_index_.find(location);
+	if (location_transitions == std::end(transition_index_)) {
+		return {};
+	}
+	std::vector<const Transition *> res;
+	for (const auto &[symbol, transitions] : location_transitions->second) {
+		for (const Transition *transition : transitions) {
+			if (std::all_of(std::begin(transition->clock_constraints_),
+			                std::end(transition->clock_constraints_),
+			                [&get_region_index](const auto &constraint) {
+				                return is_satisfied_in_region(constraint.second,
+				                                              get_region_index(constraint.first));
+			                })) {
 				res.push_back(transition);
 			}
 		}
@@ -290,11 +378,7 @@ template <typename LocationT, typename AP>
 TAConfiguration<LocationT>
 TimedAutomaton<LocationT, AP>::get_initial_configuration() const
 {
-	ClockSetValuation clock_valuations;
-	for (const auto &clock_name : clocks_) {
-		clock_valuations[clock_name] = 0;
-	}
-	return {initial_location_, clock_valuations};
+	return {initial_location_, ClockSetValuation{ClockRegistry::get(clocks_)}};
 }
 
 template <typename LocationT, typename AP>
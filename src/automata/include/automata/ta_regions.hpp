@@ -17,16 +17,20 @@ template <typename LocationT>
 TAConfiguration<LocationT>
 get_region_candidate(const RegionalizedConfiguration<LocationT> &regionalized_configuration)
 {
-	TAConfiguration<LocationT> res;
-	res.location = regionalized_configuration.first;
-	std::transform(std::begin(regionalized_configuration.second),
-	               std::end(regionalized_configuration.second),
-	               std::inserter(res.clock_valuations, res.clock_valuations.end()),
-	               [&](const std::pair<std::string, RegionIndex> &clock_region) {
-		               const std::string &clock_name = clock_region.first;
-		               const RegionIndex &region     = clock_region.second;
-		               return std::make_pair(clock_name, static_cast<ClockValuation>(region) / 2);
-	               });
+	const auto              &regions = regionalized_configuration.second;
+	std::vector<std::string> clocks;
+	clocks.reserve(regions.size());
+	for (const auto &[clock_name, region] : regions) {
+		clocks.push_back(clock_name);
+	}
+	TAConfiguration<LocationT> res{regionalized_configuration.first,
+	                               ClockSetValuation{ClockRegistry::get(std::begin(clocks),
+	                                                                    std::end(clocks))}};
+	// The regions are ordered by clock name, so the i-th region belongs to the clock with ID i.
+	ClockRegistry::ClockId id = 0;
+	for (const auto &[clock_name, region] : regions) {
+		res.clock_valuations.at(id++) = static_cast<ClockValuation>(region) / 2;
+	}
 	return res;
 }
 
@@ -51,6 +51,21 @@ operator<(const GologLocation &first, const GologLocation &second)
 	return first.satisfied_fluents < second.satisfied_fluents;
 }
 
+std::size_t
+hash_golog_location(const GologLocation &location)
+{
+	std::size_t hash = 0;
+	if (location.remaining_program) {
+		// Equal terms are printed in the same way, so the printed program is a fingerprint of the term.
+		hash = std::hash<std::string>{}(
+		  gologpp::ReadylogContext::instance().to_string(*location.remaining_program));
+	}
+	for (const auto &fluent : location.satisfied_fluents) {
+		hash = hash * 31 + std::hash<std::string>{}(fluent);
+	}
+	return hash;
+}
+
 namespace details {
 std::map<std::string, double>
 get_clock_values(const ClockSetValuation &clock_valuations)
@@ -8,6 +8,8 @@
 
 #pragma once
 
+#include <cstddef>
+#include <functional>
 #include <memory>
 #include <set>
 #include <string>
@@ -51,6 +53,10 @@ using GologConfiguration = tacos::PlantConfiguration<GologLocation>;
 /** Compare two Golog locations. */
 bool operator<(const GologLocation &, const GologLocation &);
 
+/** Compute a fingerprint of a Golog location that is consistent with its order, i.e., it only
+ * depends on the remaining program and the satisfied fluents. */
+std::size_t hash_golog_location(const GologLocation &);
+
 /** @brief Wrapper for a Golog++ program.
  *
  * This class manages a Golog++ program and provides additional functionality
@@ -156,3 +162,19 @@ private:
 };
 
 } // namespace tacos::search
+
+namespace std {
+/** Hash a Golog location. */
+template <>
+struct hash<tacos::search::GologLocation>
+{
+	/** Get the fingerprint of the location.
+	 * @see tacos::search::hash_golog_location
+	 */
+	std::size_t
+	operator()(const tacos::search::GologLocation &location) const
+	{
+		return tacos::search::hash_golog_location(location);
+	}
+};
+} // namespace std
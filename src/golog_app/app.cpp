@@ -119,6 +119,8 @@ Launcher::parse_command_line(int argc, const char *const argv[])
 	("controller-action,c", value<std::vector<std::string>>(), "The actions controlled by the controller")
 	("environment-action,e", value<std::vector<std::string>>(), "The actions controlled by the environment")
     ("heuristic", value(&heuristic)->default_value("dfs"), "The heuristic to use (one of 'time', 'bfs', 'dfs')")
+    ("successor-cache-budget", value(&successor_cache_budget)->default_value(64),
+     "The memory budget of the cache of successors in MiB")
 	;
 	// clang-format on
 	boost::program_options::variables_map variables;
@@ -239,6 +241,7 @@ Launcher::run()
 	                  true,
 	                  true,
 	                  create_heuristic(heuristic));
+	search.set_successor_cache_budget(successor_cache_budget << 20);
 	search.build_tree(false);
 	search.label();
 	SPDLOG_INFO("Search complete!");
@@ -261,7 +264,9 @@ Launcher::run()
 	auto controller = controller_synthesis::create_controller(search.get_root(),
 	                                                          controller_actions,
 	                                                          environment_actions,
-	                                                          K);
+	                                                          K,
+	                                                          true,
+	                                                          &search.get_time_successor_cache());
 	if (!controller_dot_path.empty()) {
 		SPDLOG_INFO("Writing controller to '{}'", controller_dot_path.c_str());
 		visualization::ta_to_graphviz(controller, !hide_controller_labels)
@@ -272,6 +277,22 @@ Launcher::run()
 		std::ofstream fs(controller_proto_path);
 		fs << automata::ta::ta_to_proto(controller).SerializeAsString();
 	}
+	const auto time_successor_statistics = search.get_time_successor_cache().get_statistics();
+	SPDLOG_INFO("Time successor cache: {} hits, {} misses, hit rate {:.2f}",
+	            time_successor_statistics.num_hits,
+	            time_successor_statistics.num_misses,
+	            time_successor_statistics.get_hit_rate());
+	const auto successor_statistics = search.get_successor_cache_statistics();
+	SPDLOG_INFO("Successor cache: {} hits, {} misses, {} evictions, hit rate {:.2f}",
+	            successor_statistics.num_hits,
+	            successor_statistics.num_misses,
+	            successor_statistics.num_evictions,
+	            successor_statistics.get_hit_rate());
+	const auto minimal_model_statistics = ata.get_minimal_model_cache_statistics();
+	SPDLOG_INFO("Minimal model cache: {} hits, {} misses, hit rate {:.2f}",
+	            minimal_model_statistics.num_hits,
+	            minimal_model_statistics.num_misses,
+	            minimal_model_statistics.get_hit_rate());
 }
 
 } // namespace tacos::golog_app
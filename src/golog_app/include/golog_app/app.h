@@ -45,6 +45,7 @@ private:
 	std::set<std::string> controller_actions;
 	std::set<std::string> environment_actions;
 	std::string           heuristic;
+	std::size_t           successor_cache_budget;
 };
 
 void read_proto_from_file(const std::filesystem::path &path, google::protobuf::Message *output);
@@ -15,11 +15,17 @@
 #include <fmt/ostream.h>
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <functional>
 #include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <set>
 #include <string>
+#include <tuple>
 #include <type_traits>
 #include <vector>
 
@@ -134,6 +140,10 @@ private:
 /**
  * @brief Class representing an MTL-formula with the usual operators.
  *
+ * Formulas are hash-consed: each structurally distinct (sub-)formula is stored exactly once in a
+ * shared, immutable DAG, and an MTLFormula is only a handle to a node of this DAG. Copying a formula
+ * is therefore as cheap as copying a pointer and two formulas are equal if and only if they refer to
+ * the same node.
  */
 template <typename APType>
 class MTLFormula
@@ -206,9 +216,25 @@ public:
 	/// timed dual_until operator (binary)
 	MTLFormula dual_until(const MTLFormula &rhs, const TimeInterval &duration = TimeInterval()) const;
 
-	/// less operator
+	/// less operator, compares the formulas structurally
 	bool operator<(const MTLFormula &rhs) const;
 
+	/** @brief Compare formulas in constant time by the order in which they have been created.
+	 *
+	 * The order is consistent with equality, but it is neither structural nor stable across runs.
+	 * Use it for containers on hot paths that are neither printed nor exchanged with other
+	 * processes, and the structural operator< otherwise.
+	 */
+	struct CreationOrder
+	{
+		/** Check whether lhs has been created before rhs. */
+		bool
+		operator()(const MTLFormula &lhs, const MTLFormula &rhs) const
+		{
+			return lhs.node_->id < rhs.node_->id;
+		}
+	};
+
 	/// larger operator
 	bool
 	operator>(const MTLFormula &rhs) const
@@ -233,7 +259,8 @@ public:
 	bool
 	operator==(const MTLFormula &rhs) const
 	{
-		return !(*this < rhs) && !(rhs < *this);
+		// Formulas are hash-consed, so structurally equal formulas share the same node.
+		return node_ == rhs.node_;
 	}
 	/// not-equal operator
 	bool
@@ -259,13 +286,13 @@ public:
 	const std::vector<MTLFormula> &
 	get_operands() const
 	{
-		return operands_;
+		return node_->operands;
 	}
 	/// getter for the logical operator
 	LOP
 	get_operator() const
 	{
-		return operator_;
+		return node_->op;
 	}
 	/**
 	 * @brief getter for the duration
@@ -275,7 +302,7 @@ public:
 	TimeInterval
 	get_interval() const
 	{
-		return duration_.value_or(TimeInterval{});
+		return node_->duration.value_or(TimeInterval{});
 	}
 
 	/**
@@ -286,10 +313,23 @@ public:
 	AtomicProposition<APType>
 	get_atomicProposition() const
 	{
-		assert(ap_.has_value());
-		return ap_.value();
+		assert(node_->ap.has_value());
+		return node_->ap.value();
+	}
+
+	/** Get the unique ID of the formula.
+	 * Two formulas have the same ID if and only if they are equal. IDs are assigned in the order in
+	 * which the formulas are first created, they are not stable across different runs.
+	 */
+	std::size_t
+	get_id() const
+	{
+		return node_->id;
 	}
 
+	/** Get the number of distinct formulas that have been created so far. */
+	static std::size_t get_num_formulas();
+
 	/** Get the value of the largest constant occurring in the formula.  */
 	Endpoint get_largest_constant() const;
 
@@ -302,17 +342,55 @@ public:
 	}
 
 private:
-	bool
-	is_consistent() const
+	/** A node in the DAG of all formulas. Nodes are immutable and live until the end of the
+	 * program. */
+	struct Node
+	{
+		std::optional<AtomicProposition<APType>> ap;
+		LOP                                      op;
+		std::optional<TimeInterval>              duration;
+		std::vector<MTLFormula>                  operands;
+		std::size_t                              id;
+		/** The positive normal form of the formula, computed on first use. */
+		mutable std::atomic<const Node *> positive_normal_form{nullptr};
+	};
+
+	/** The factory that owns all nodes and makes sure each formula is only created once. */
+	class Factory
+	{
+	public:
+		const Node *get_node(const std::optional<AtomicProposition<APType>> &ap,
+		                     LOP                                             op,
+		                     const std::optional<TimeInterval>              &duration,
+		                     std::vector<MTLFormula>                         operands);
+		std::size_t size() const;
+
+	private:
+		using Key = std::tuple<LOP,
+		                       std::optional<AtomicProposition<APType>>,
+		                       std::optional<TimeInterval>,
+		                       std::vector<const Node *>>;
+		mutable std::mutex                    mutex_;
+		std::map<Key, std::unique_ptr<Node>> nodes_;
+	};
+
+	static Factory &get_factory();
+
+	MTLFormula compute_positive_normal_form() const;
+
+	explicit MTLFormula(const Node *node) : node_(node)
 	{
-		return (ap_.has_value() == (operator_ == LOP::AP));
 	}
 
 	template <class It>
 	MTLFormula(LOP op, It first, It last, const TimeInterval &duration = TimeInterval())
-	: operator_(op), duration_(duration), operands_(first, last)
+	: node_(get_factory().get_node(std::nullopt,
+	                               op,
+	                               op == LOP::LUNTIL || op == LOP::LDUNTIL
+	                                 ? std::optional<TimeInterval>{duration}
+	                                 : std::nullopt,
+	                               std::vector<MTLFormula>(first, last)))
 	{
-		assert(is_consistent());
 	}
 
 	MTLFormula(LOP                               op,
@@ -322,10 +400,7 @@ private:
 	{
 	}
 
-	std::optional<AtomicProposition<APType>> ap_;
-	LOP                                      operator_;
-	std::optional<TimeInterval>              duration_;
-	std::vector<MTLFormula<APType>>          operands_;
+	const Node *node_;
 };
 
 /// Logical AND
@@ -388,6 +463,20 @@ std::ostream &operator<<(std::ostream &out, const logic::MTLFormula<APType> &f);
 
 } // namespace tacos::logic
 
+namespace std {
+/** Hash an MTLFormula by its unique ID. */
+template <typename APType>
+struct hash<tacos::logic::MTLFormula<APType>>
+{
+	/** Get the hash of the formula. */
+	std::size_t
+	operator()(const tacos::logic::MTLFormula<APType> &formula) const
+	{
+		return std::hash<std::size_t>{}(formula.get_id());
+	}
+};
+} // namespace std
+
 namespace fmt {
 
 template <typename APType>
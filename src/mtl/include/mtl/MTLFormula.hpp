@@ -113,7 +113,7 @@ MTLWord<APType>::satisfies_at(const MTLFormula<APType> &phi, std::size_t i) cons
 	if (i >= this->word_.size())
 		return false;
 
-	switch (phi.operator_) {
+	switch (phi.get_operator()) {
 	case LOP::TRUE: return true;
 	case LOP::FALSE: return false;
 	case LOP::AP:
@@ -121,29 +121,29 @@ MTLWord<APType>::satisfies_at(const MTLFormula<APType> &phi, std::size_t i) cons
 		       != word_[i].first.end();
 		break;
 	case LOP::LAND:
-		return std::all_of(phi.operands_.begin(), phi.operands_.end(), [this, i](const auto &subf) {
-			return satisfies_at(subf, i);
-		});
+		return std::all_of(phi.get_operands().begin(),
+		                   phi.get_operands().end(),
+		                   [this, i](const auto &subf) { return satisfies_at(subf, i); });
 		break;
 	case LOP::LOR:
-		return std::any_of(phi.operands_.begin(), phi.operands_.end(), [this, i](const auto &subf) {
-			return satisfies_at(subf, i);
-		});
+		return std::any_of(phi.get_operands().begin(),
+		                   phi.get_operands().end(),
+		                   [this, i](const auto &subf) { return satisfies_at(subf, i); });
 		break;
 	case LOP::LNEG:
-		return std::none_of(phi.operands_.begin(), phi.operands_.end(), [this, i](const auto &subf) {
-			return satisfies_at(subf, i);
-		});
+		return std::none_of(phi.get_operands().begin(),
+		                    phi.get_operands().end(),
+		                    [this, i](const auto &subf) { return satisfies_at(subf, i); });
 		break;
 	case LOP::LUNTIL:
 		for (std::size_t j = i + 1; j < word_.size(); ++j) {
 			// check if termination condition is satisfied, in time.
-			if (satisfies_at(phi.operands_.back(), j)) {
-				assert(phi.duration_.has_value());
-				return phi.duration_.value().contains(word_[j].second - word_[i].second);
+			if (satisfies_at(phi.get_operands().back(), j)) {
+				assert(phi.node_->duration.has_value());
+				return phi.node_->duration.value().contains(word_[j].second - word_[i].second);
 			} else {
 				// check whether first part is satisfied continuously.
-				if (!satisfies_at(phi.operands_.front(), j)) {
+				if (!satisfies_at(phi.get_operands().front(), j)) {
 					return false;
 				}
 			}
@@ -152,17 +152,18 @@ MTLWord<APType>::satisfies_at(const MTLFormula<APType> &phi, std::size_t i) cons
 		return false;
 		break;
 	case LOP::LDUNTIL:
-		assert(phi.duration_.has_value());
+		assert(phi.node_->duration.has_value());
 		// using  p DU q <=> !(!p U !q) (also called RELEASE operator)
 		// satisfied if:
 		// * q holds always, or
 		// * q holds until (and including this point in time) p becomes true
 		for (std::size_t j = i + 1; j < word_.size(); ++j) {
-			if (satisfies_at(phi.operands_.front(), j) and satisfies_at(phi.operands_.back(), j)) {
-				return phi.duration_.value().contains(word_[j].second - word_[i].second);
+			if (satisfies_at(phi.get_operands().front(), j)
+			    and satisfies_at(phi.get_operands().back(), j)) {
+				return phi.node_->duration.value().contains(word_[j].second - word_[i].second);
 			} else {
 				// check whether q is satisfied (probably indefinitely)
-				if (!satisfies_at(phi.operands_.back(), j)) {
+				if (!satisfies_at(phi.get_operands().back(), j)) {
 					return false;
 				}
 			}
@@ -183,16 +184,68 @@ MTLWord<APType>::satisfies(const MTLFormula<APType> &phi) const
 }
 
 template <typename APType>
-MTLFormula<APType>::MTLFormula(const AtomicProposition<APType> &ap) : ap_(ap), operator_(LOP::AP)
+typename MTLFormula<APType>::Factory &
+MTLFormula<APType>::get_factory()
+{
+	// Intentionally never destroyed, so formulas stay valid during static destruction.
+	static Factory *factory = new Factory();
+	return *factory;
+}
+
+template <typename APType>
+const typename MTLFormula<APType>::Node *
+MTLFormula<APType>::Factory::get_node(const std::optional<AtomicProposition<APType>> &ap,
+                                      LOP                                             op,
+                                      const std::optional<TimeInterval>              &duration,
+                                      std::vector<MTLFormula>                         operands)
+{
+	assert(ap.has_value() == (op == LOP::AP));
+	std::vector<const Node *> operand_nodes;
+	operand_nodes.reserve(operands.size());
+	for (const auto &operand : operands) {
+		operand_nodes.push_back(operand.node_);
+	}
+	Key             key{op, ap, duration, std::move(operand_nodes)};
+	std::lock_guard lock{mutex_};
+	if (auto it = nodes_.find(key); it != std::end(nodes_)) {
+		return it->second.get();
+	}
+	auto node       = std::make_unique<Node>();
+	node->ap        = ap;
+	node->op        = op;
+	node->duration  = duration;
+	node->operands  = std::move(operands);
+	node->id        = nodes_.size();
+	const Node *res = node.get();
+	nodes_.emplace(std::move(key), std::move(node));
+	return res;
+}
+
+template <typename APType>
+std::size_t
+MTLFormula<APType>::Factory::size() const
+{
+	std::lock_guard lock{mutex_};
+	return nodes_.size();
+}
+
+template <typename APType>
+std::size_t
+MTLFormula<APType>::get_num_formulas()
+{
+	return get_factory().size();
+}
+
+template <typename APType>
+MTLFormula<APType>::MTLFormula(const AtomicProposition<APType> &ap)
+: node_(get_factory().get_node(ap, LOP::AP, std::nullopt, {}))
 {
-	assert(is_consistent());
 }
 
 template <typename APType>
 MTLFormula<APType>
 MTLFormula<APType>::operator&&(const MTLFormula &rhs) const
 {
-	assert(is_consistent());
 	return MTLFormula(LOP::LAND, {*this, rhs});
 }
 
@@ -200,7 +253,6 @@ template <typename APType>
 MTLFormula<APType>
 MTLFormula<APType>::operator||(const MTLFormula &rhs) const
 {
-	assert(is_consistent());
 	return MTLFormula(LOP::LOR, {*this, rhs});
 }
 
@@ -208,7 +260,6 @@ template <typename APType>
 MTLFormula<APType>
 MTLFormula<APType>::operator!() const
 {
-	assert(is_consistent());
 	return MTLFormula(LOP::LNEG, {*this});
 }
 
@@ -216,7 +267,6 @@ template <typename APType>
 MTLFormula<APType>
 MTLFormula<APType>::until(const MTLFormula &rhs, const TimeInterval &duration) const
 {
-	assert(is_consistent());
 	return MTLFormula(LOP::LUNTIL, {*this, rhs}, duration);
 }
 
@@ -224,7 +274,6 @@ template <typename APType>
 MTLFormula<APType>
 MTLFormula<APType>::dual_until(const MTLFormula &rhs, const TimeInterval &duration) const
 {
-	assert(is_consistent());
 	return MTLFormula(LOP::LDUNTIL, {*this, rhs}, duration);
 }
 
@@ -232,6 +281,11 @@ template <typename APType>
 bool
 MTLFormula<APType>::operator<(const MTLFormula &rhs) const
 {
+	// Shared sub-formulas are identical, so we do not need to descend into them.
+	if (node_ == rhs.node_) {
+		return false;
+	}
+
 	// compare operation
 	if (this->get_operator() != rhs.get_operator()) {
 		return this->get_operator() < rhs.get_operator();
@@ -244,11 +298,11 @@ MTLFormula<APType>::operator<(const MTLFormula &rhs) const
 	}
 
 	// Compare intervals before operands.
-	if (operator_ == LOP::LUNTIL || operator_ == LOP::LDUNTIL) {
-		if (duration_ < rhs.duration_) {
+	if (node_->op == LOP::LUNTIL || node_->op == LOP::LDUNTIL) {
+		if (node_->duration < rhs.node_->duration) {
 			return true;
 		}
-		if (rhs.duration_ < duration_) {
+		if (rhs.node_->duration < node_->duration) {
 			return false;
 		}
 	}
@@ -258,30 +312,46 @@ MTLFormula<APType>::operator<(const MTLFormula &rhs) const
 	                                    rhs.get_operands().begin(),
 	                                    rhs.get_operands().end());
 }
+
 template <typename APType>
 MTLFormula<APType>
 MTLFormula<APType>::to_positive_normal_form() const
 {
-	switch (operator_) {
+	// Each node only computes its positive normal form once. If two threads race, they both compute
+	// the same (hash-consed) formula, so it does not matter which one wins.
+	if (const Node *cached = node_->positive_normal_form.load(std::memory_order_acquire)) {
+		return MTLFormula{cached};
+	}
+	const MTLFormula res = compute_positive_normal_form();
+	node_->positive_normal_form.store(res.node_, std::memory_order_release);
+	return res;
+}
+
+template <typename APType>
+MTLFormula<APType>
+MTLFormula<APType>::compute_positive_normal_form() const
+{
+	const auto &operands = get_operands();
+	switch (get_operator()) {
 	case LOP::TRUE:
 	case LOP::FALSE:
 	case LOP::AP: return *this; break;
 	case LOP::LNEG: {
-		switch (operands_.front().get_operator()) {
+		switch (operands.front().get_operator()) {
 		case LOP::TRUE:
 		case LOP::FALSE:
 		case LOP::AP: return *this; break; // negation in front of ap is conformant
 		case LOP::LNEG:
-			return MTLFormula(operands_.front().get_operands().front())
+			return MTLFormula(operands.front().get_operands().front())
 			  .to_positive_normal_form(); // remove duplicate negations
 			break;
 		case LOP::LAND:
 		case LOP::LOR: {
 			std::vector<MTLFormula<APType>> normalized;
-			for (const auto &op : operands_.front().get_operands()) {
+			for (const auto &op : operands.front().get_operands()) {
 				normalized.push_back(MTLFormula(LOP::LNEG, {op}).to_positive_normal_form());
 			}
-			return MTLFormula(dual(operands_.front().get_operator()),
+			return MTLFormula(dual(operands.front().get_operator()),
 			                  std::begin(normalized),
 			                  std::end(normalized));
 		} break;
@@ -289,12 +359,12 @@ MTLFormula<APType>::to_positive_normal_form() const
 		case LOP::LDUNTIL: {
 			// binary operators: negate operands, use dual operator
 			auto neglhs =
-			  MTLFormula(LOP::LNEG, {operands_.front().get_operands().front()}).to_positive_normal_form();
+			  MTLFormula(LOP::LNEG, {operands.front().get_operands().front()}).to_positive_normal_form();
 			auto negrhs =
-			  MTLFormula(LOP::LNEG, {operands_.front().get_operands().back()}).to_positive_normal_form();
-			return MTLFormula(dual(operands_.front().get_operator()),
+			  MTLFormula(LOP::LNEG, {operands.front().get_operands().back()}).to_positive_normal_form();
+			return MTLFormula(dual(operands.front().get_operator()),
 			                  {neglhs, negrhs},
-			                  operands_.front().get_interval());
+			                  operands.front().get_interval());
 		} break;
 		}
 	} break;
@@ -303,12 +373,10 @@ MTLFormula<APType>::to_positive_normal_form() const
 	case LOP::LUNTIL:
 	case LOP::LDUNTIL: {
 		std::vector<MTLFormula<APType>> normalized;
-		for (const auto &op : operands_) {
+		for (const auto &op : operands) {
 			normalized.push_back(op.to_positive_normal_form());
 		}
-		auto res      = MTLFormula(operator_, std::begin(normalized), std::end(normalized));
-		res.duration_ = duration_;
-		return res;
+		return MTLFormula(get_operator(), std::begin(normalized), std::end(normalized), get_interval());
 	} break;
 	}
 	throw std::logic_error("Error in to_positive_normal_form: should have returned.");
@@ -332,16 +400,22 @@ std::set<MTLFormula<APType>>
 MTLFormula<APType>::get_subformulas_of_type(LOP op) const
 {
 	std::set<MTLFormula> res;
-
-	if (get_operator() == op) {
-		res.insert(*this);
+	// Sub-formulas may be shared, visit each node of the DAG only once.
+	std::set<const Node *>          visited;
+	std::vector<const MTLFormula *> open{this};
+	while (!open.empty()) {
+		const MTLFormula *formula = open.back();
+		open.pop_back();
+		if (!visited.insert(formula->node_).second) {
+			continue;
+		}
+		if (formula->get_operator() == op) {
+			res.insert(*formula);
+		}
+		for (const auto &operand : formula->get_operands()) {
+			open.push_back(&operand);
+		}
 	}
-
-	std::for_each(operands_.begin(), operands_.end(), [&res, op](const MTLFormula &o) {
-		auto tmp = o.get_subformulas_of_type(op);
-		res.insert(tmp.begin(), tmp.end());
-	});
-
 	return res;
 }
 
@@ -349,30 +423,32 @@ template <typename APType>
 Endpoint
 MTLFormula<APType>::get_largest_constant() const
 {
-	Endpoint largest_constant = 0;
-	switch (operator_) {
+	Endpoint    largest_constant = 0;
+	const auto &operands         = get_operands();
+	const auto &duration         = node_->duration;
+	switch (get_operator()) {
 	case LOP::AP:
 	case LOP::TRUE:
 	case LOP::FALSE: largest_constant = 0; break;
-	case LOP::LNEG: largest_constant = operands_[0].get_largest_constant(); break;
+	case LOP::LNEG: largest_constant = operands[0].get_largest_constant(); break;
 	case LOP::LAND:
 	case LOP::LOR:
-		for (const auto &sub_formula : operands_) {
+		for (const auto &sub_formula : operands) {
 			largest_constant = std::max(0u, sub_formula.get_largest_constant());
 		}
 		break;
 	case LOP::LUNTIL:
 	case LOP::LDUNTIL: {
-		if (duration_) {
-			if (duration_->upperBoundType() != utilities::arithmetic::BoundType::INFTY) {
-				largest_constant = std::max(largest_constant, duration_->upper());
+		if (duration) {
+			if (duration->upperBoundType() != utilities::arithmetic::BoundType::INFTY) {
+				largest_constant = std::max(largest_constant, duration->upper());
 			}
-			if (duration_->lowerBoundType() != utilities::arithmetic::BoundType::INFTY) {
-				largest_constant = std::max(largest_constant, duration_->lower());
+			if (duration->lowerBoundType() != utilities::arithmetic::BoundType::INFTY) {
+				largest_constant = std::max(largest_constant, duration->lower());
 			}
 		}
 		largest_constant = std::max(
-		  {largest_constant, operands_[0].get_largest_constant(), operands_[1].get_largest_constant()});
+		  {largest_constant, operands[0].get_largest_constant(), operands[1].get_largest_constant()});
 		break;
 	}
 	}
@@ -1,5 +1,5 @@
 /***************************************************************************
- *  mtl_proto.h - Protobuf importer for MTLFormulas
+ *  mtl_proto.h - Protobuf import/export for MTLFormulas
  *
  *  Created:   Sat 20 Mar 21:52:29 CET 2021
  *  Copyright  2021  Till Hofmann <hofmann@kbsg.rwth-aachen.de>
@@ -20,4 +20,10 @@ namespace tacos::logic {
  */
 MTLFormula<std::string> parse_proto(const proto::MTLFormula &mtl_formula);
 
+/// Convert an MTLFormula to a proto.
+/** @param mtl_formula The formula to convert
+ * @return The proto representation of the formula
+ */
+proto::MTLFormula to_proto(const MTLFormula<std::string> &mtl_formula);
+
 } // namespace tacos::logic
@@ -1,5 +1,5 @@
 /***************************************************************************
- *  mtl_proto.cpp - Protobuf importer for MTLFormulas
+ *  mtl_proto.cpp - Protobuf import/export for MTLFormulas
  *
  *  Created:   Sat 20 Mar 18:46:10 CET 2021
  *  Copyright  2021  Till Hofmann <hofmann@kbsg.rwth-aachen.de>
@@ -47,6 +47,39 @@ parse_interval(const proto::MTLFormula::Interval &interval_proto)
 	return interval;
 }
 
+proto::MTLFormula::Interval::Endpoint
+interval_endpoint_to_proto(utilities::arithmetic::BoundType bound_type, Endpoint value)
+{
+	proto::MTLFormula::Interval::Endpoint endpoint;
+	endpoint.set_value(value);
+	switch (bound_type) {
+	case utilities::arithmetic::BoundType::WEAK:
+		endpoint.set_bound_type(proto::MTLFormula_Interval_BoundType_WEAK);
+		break;
+	case utilities::arithmetic::BoundType::STRICT:
+		endpoint.set_bound_type(proto::MTLFormula_Interval_BoundType_STRICT);
+		break;
+	case utilities::arithmetic::BoundType::INFTY:
+		throw std::invalid_argument("Cannot convert an infinite interval endpoint to a proto");
+	}
+	return endpoint;
+}
+
+proto::MTLFormula::Interval
+interval_to_proto(const TimeInterval &interval)
+{
+	proto::MTLFormula::Interval interval_proto;
+	if (interval.lowerBoundType() != utilities::arithmetic::BoundType::INFTY) {
+		*interval_proto.mutable_lower() =
+		  interval_endpoint_to_proto(interval.lowerBoundType(), interval.lower());
+	}
+	if (interval.upperBoundType() != utilities::arithmetic::BoundType::INFTY) {
+		*interval_proto.mutable_upper() =
+		  interval_endpoint_to_proto(interval.upperBoundType(), interval.upper());
+	}
+	return interval_proto;
+}
+
 } // namespace
 
 MTLFormula<std::string>
@@ -147,4 +180,49 @@ parse_proto(const proto::MTLFormula &mtl_formula)
 	throw std::invalid_argument("Unknown formula type in proto " + mtl_formula.ShortDebugString());
 }
 
+proto::MTLFormula
+to_proto(const MTLFormula<std::string> &mtl_formula)
+{
+	proto::MTLFormula mtl_proto;
+	switch (mtl_formula.get_operator()) {
+	case LOP::TRUE:
+		mtl_proto.mutable_constant()->set_value(proto::MTLFormula_ConstantValue_TRUE);
+		break;
+	case LOP::FALSE:
+		mtl_proto.mutable_constant()->set_value(proto::MTLFormula_ConstantValue_FALSE);
+		break;
+	case LOP::AP:
+		mtl_proto.mutable_atomic()->set_symbol(mtl_formula.get_atomicProposition().ap_);
+		break;
+	case LOP::LAND:
+		for (const auto &sub_formula : mtl_formula.get_operands()) {
+			*mtl_proto.mutable_conjunction()->add_conjuncts() = to_proto(sub_formula);
+		}
+		break;
+	case LOP::LOR:
+		for (const auto &sub_formula : mtl_formula.get_operands()) {
+			*mtl_proto.mutable_disjunction()->add_disjuncts() = to_proto(sub_formula);
+		}
+		break;
+	case LOP::LNEG:
+		*mtl_proto.mutable_negation()->mutable_formula() = to_proto(mtl_formula.get_operands().front());
+		break;
+	case LOP::LUNTIL: {
+		auto &until = *mtl_proto.mutable_until();
+		*until.mutable_front()    = to_proto(mtl_formula.get_operands().front());
+		*until.mutable_back()     = to_proto(mtl_formula.get_operands().back());
+		*until.mutable_interval() = interval_to_proto(mtl_formula.get_interval());
+		break;
+	}
+	case LOP::LDUNTIL: {
+		auto &dual_until = *mtl_proto.mutable_dual_until();
+		*dual_until.mutable_front()    = to_proto(mtl_formula.get_operands().front());
+		*dual_until.mutable_back()     = to_proto(mtl_formula.get_operands().back());
+		*dual_until.mutable_interval() = interval_to_proto(mtl_formula.get_interval());
+		break;
+	}
+	}
+	return mtl_proto;
+}
+
 } // namespace tacos::logic
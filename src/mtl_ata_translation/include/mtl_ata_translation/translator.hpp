@@ -177,7 +177,7 @@ init(const MTLFormula<ConstraintSymbolT> &formula,
 				return std::make_unique<FalseFormula<ConstraintSymbolT>>();
 			}
 		} else {
-			if (formula == ap) {
+			if (formula.get_atomicProposition() == ap) {
 				// init(b, a) = TRUE if b == a
 				return std::make_unique<TrueFormula<ConstraintSymbolT>>();
 			} else {
@@ -204,7 +204,7 @@ init(const MTLFormula<ConstraintSymbolT> &formula,
 					return std::make_unique<TrueFormula<ConstraintSymbolT>>();
 				}
 			} else {
-				if (formula.get_operands().front() == ap) {
+				if (formula.get_operands().front().get_atomicProposition() == ap) {
 					// init(b, a) = TRUE if b == a
 					return std::make_unique<FalseFormula<ConstraintSymbolT>>();
 				} else {
@@ -312,9 +312,6 @@ translate(const MTLFormula<ConstraintSymbolT> &input_formula,
 	}
 	const auto alphabet = input_alphabet;
 	// const auto alphabet = compute_alphabet<state_based, ConstraintSymbolT>(input_alphabet);
-	// S = cl(phi) U {l0}
-	auto locations = get_closure(formula);
-	locations.insert(get_l0<ConstraintSymbolT>());
 	const auto untils              = formula.get_subformulas_of_type(LOP::LUNTIL);
 	const auto dual_untils         = formula.get_subformulas_of_type(LOP::LDUNTIL);
 	const auto accepting_locations = dual_untils;
@@ -0,0 +1,159 @@
+/***************************************************************************
+ *  antichain_store.h - A store of labeled nodes for pruning by monotonic domination
+ *
+ *  Created:   Sat 17 Oct 16:12:48 CEST 2026
+ *  Copyright  2026  Till Hofmann <hofmann@kbsg.rwth-aachen.de>
+ *  SPDX-License-Identifier: LGPL-3.0-or-later
+ ****************************************************************************/
+
+#pragma once
+
+#include "domination_signature.h"
+#include "operators.h"
+#include "search_tree.h"
+#include "utilities/sharded_hash_map.h"
+#include "word_interning.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+namespace tacos::search {
+
+/** Statistics about the nodes that were labeled by an AntichainStore. */
+struct AntichainStatistics
+{
+	/** The number of nodes that are currently stored. */
+	std::size_t num_stored_nodes{0};
+	/** The number of nodes that were labeled TOP because a TOP node dominates them. */
+	std::size_t num_top_prunings{0};
+	/** The number of nodes that were labeled BOTTOM because they dominate a BOTTOM node. */
+	std::size_t num_bottom_prunings{0};
+};
+
+/** @brief A store of labeled search nodes that labels other nodes by monotonic domination.
+ *
+ * If a node is monotonically dominated by a node labeled TOP, then it can also be labeled TOP.
+ * Conversely, if a node monotonically dominates a node labeled BOTTOM, then it can also be labeled
+ * BOTTOM. Monotonic domination implies that both nodes have the same reg_a, so the nodes are grouped
+ * by their (interned) reg_a. For each reg_a, the store keeps the TOP nodes and the BOTTOM nodes
+ * as antichains, i.e., a TOP node that is dominated by another TOP node is not stored, and
+ * a BOTTOM node that dominates another BOTTOM node is not stored. The store is thread-safe.
+ *
+ * @tparam Node The search node type
+ */
+template <typename Node>
+class AntichainStore
+{
+public:
+	/** Add a labeled node to the store.
+	 * @param key The interned reg_a of the node's words
+	 * @param node The node to add
+	 * @param label The label of the node, either TOP or BOTTOM
+	 */
+	void
+	insert(WordId key, Node *node, NodeLabel label)
+	{
+		assert(label == NodeLabel::TOP || label == NodeLabel::BOTTOM);
+		buckets_.get_or_insert(
+		  key, [] { return Bucket{}; }, [this, node, label](Bucket &bucket) {
+			  if (label == NodeLabel::TOP) {
+				  insert_maximal(bucket.top, node);
+			  } else {
+				  // A BOTTOM antichain keeps the minimal elements, i.e., the maximal ones in reverse.
+				  insert_maximal(bucket.bottom, node, true);
+			  }
+		  });
+	}
+
+	/** Find the label of a node by comparing it against the stored nodes.
+	 * @param key The interned reg_a of the node's words
+	 * @param node The node to label
+	 * @return TOP if the node is dominated by a stored TOP node, BOTTOM if the node dominates a
+	 * stored BOTTOM node, UNLABELED otherwise
+	 */
+	NodeLabel
+	find_label(WordId key, const Node &node)
+	{
+		NodeLabel label = NodeLabel::UNLABELED;
+		buckets_.visit(key, [&node, &label](const Bucket &bucket) {
+			if (std::any_of(std::begin(bucket.top), std::end(bucket.top), [&node](const Node *top) {
+				    return is_dominated(node, *top);
+			    })) {
+				label = NodeLabel::TOP;
+			} else if (std::any_of(std::begin(bucket.bottom),
+			                       std::end(bucket.bottom),
+			                       [&node](const Node *bottom) { return is_dominated(*bottom, node); })) {
+				label = NodeLabel::BOTTOM;
+			}
+		});
+		if (label == NodeLabel::TOP) {
+			++num_top_prunings_;
+		} else if (label == NodeLabel::BOTTOM) {
+			++num_bottom_prunings_;
+		}
+		return label;
+	}
+
+	/** Get the statistics of the store. */
+	AntichainStatistics
+	get_statistics() const
+	{
+		AntichainStatistics statistics;
+		statistics.num_stored_nodes    = num_stored_nodes_;
+		statistics.num_top_prunings    = num_top_prunings_;
+		statistics.num_bottom_prunings = num_bottom_prunings_;
+		return statistics;
+	}
+
+private:
+	struct Bucket
+	{
+		std::vector<Node *> top;
+		std::vector<Node *> bottom;
+	};
+
+	/** Check whether the first node is monotonically dominated by the second node. */
+	static bool
+	is_dominated(const Node &node1, const Node &node2)
+	{
+		return may_be_monotonically_dominated(node1.domination_signature, node2.domination_signature)
+		       && is_monotonically_dominated(node1, node2);
+	}
+
+	/** Insert a node into an antichain of maximal elements.
+	 * @param antichain The antichain
+	 * @param node The node to insert
+	 * @param reverse If true, use the reverse domination order
+	 */
+	void
+	insert_maximal(std::vector<Node *> &antichain, Node *node, bool reverse = false)
+	{
+		const auto smaller = [reverse](const Node *node1, const Node *node2) {
+			return reverse ? is_dominated(*node2, *node1) : is_dominated(*node1, *node2);
+		};
+		if (std::any_of(std::begin(antichain), std::end(antichain), [&](const Node *other) {
+			    return smaller(node, other);
+		    })) {
+			return;
+		}
+		const auto new_end =
+		  std::remove_if(std::begin(antichain), std::end(antichain), [&](const Node *other) {
+			  return smaller(other, node);
+		  });
+		num_stored_nodes_ -= static_cast<std::size_t>(std::distance(new_end, std::end(antichain)));
+		antichain.erase(new_end, std::end(antichain));
+		antichain.push_back(node);
+		++num_stored_nodes_;
+	}
+
+	utilities::ShardedHashMap<WordId, Bucket> buckets_;
+	std::atomic_size_t                        num_stored_nodes_{0};
+	std::atomic_size_t                        num_top_prunings_{0};
+	std::atomic_size_t                        num_bottom_prunings_{0};
+};
+
+} // namespace tacos::search
@@ -17,6 +17,11 @@
 #include "utilities/numbers.h"
 #include "utilities/types.h"
 
+#include <algorithm>
+#include <tuple>
+#include <variant>
+#include <vector>
+
 /** Get the regionalized synchronous product of a TA and an ATA. */
 namespace tacos::search {
 
@@ -113,6 +118,8 @@ struct ATARegionState
 };
 
 /** Compare two ATA region states.
+ * The formulas are compared by their creation order, which takes constant time, but is not stable
+ * across runs. Thus, the order of ATA region states in a canonical word may differ between runs.
  * @param s1 The first state
  * @param s2 The second state
  * @return true if s1 is lexicographically smaller than s2
@@ -121,7 +128,10 @@ template <typename LocationT>
 bool
 operator<(const ATARegionState<LocationT> &s1, const ATARegionState<LocationT> &s2)
 {
-	return std::tie(s1.formula, s1.region_index) < std::tie(s2.formula, s2.region_index);
+	if (s1.formula != s2.formula) {
+		return typename logic::MTLFormula<LocationT>::CreationOrder{}(s1.formula, s2.formula);
+	}
+	return s1.region_index < s2.region_index;
 }
 
 /** Check two ATA region states for equality.
@@ -387,15 +397,29 @@ operator<<(std::ostream
 		os << "{}";
 		return os;
 	}
+	// ATA region states are ordered by the creation order of their formulas, which is not stable
+	// across runs. Print them in structural order instead.
+	std::vector<const search::ABRegionSymbol<LocationT, ConstraintSymbolType> *> symbols;
+	for (const auto &symbol : word) {
+		symbols.push_back(&symbol);
+	}
+	std::stable_sort(std::begin(symbols), std::end(symbols), [](const auto *s1, const auto *s2) {
+		const auto *a1 = std::get_if<search::ATARegionState<ConstraintSymbolType>>(s1);
+		const auto *a2 = std::get_if<search::ATARegionState<ConstraintSymbolType>>(s2);
+		if (a1 == nullptr || a2 == nullptr) {
+			return s1->index() < s2->index();
+		}
+		return std::tie(a1->formula, a1->region_index) < std::tie(a2->formula, a2->region_index);
+	});
 	os << "{ ";
 	bool first = true;
-	for (const auto &symbol : word) {
+	for (const auto *symbol : symbols) {
 		if (!first) {
 			os << ", ";
 		} else {
 			first = false;
 		}
-		os << symbol;
+		os << *symbol;
 	}
 	os << " }";
 	return os;
@@ -14,6 +14,7 @@
 #include "automata/ta_regions.h"
 #include "search/canonical_word.h"
 #include "search/synchronous_product.h"
+#include "search/time_successor_cache.h"
 #include "search_tree.h"
 
 #include <spdlog/spdlog.h>
@@ -55,6 +56,7 @@ get_constraints_from_time_successor(const search::CanonicalABWord<LocationT, Act
  * @param canonical_words The canonical words of the node.
  * @param actions The outgoing actions of the node as set of pairs (region increment, action name)
  * @param K The value of the maximal constant occurring anywhere in the input problem
+ * @param cache If not null, the time successors are looked up in this cache
  * @return A multimap, where each entry is a pair (a, c), where c is a multimap of clock constraints
  * necessary when taking action a.
  */
@@ -63,7 +65,8 @@ std::multimap<ActionT, std::multimap<std::string, automata::ClockConstraint>>
 get_constraints_from_outgoing_action(
   const std::set<search::CanonicalABWord<LocationT, ConstraintSymbolT>> canonical_words,
   const std::pair<RegionIndex, ActionT> &                               timed_action,
-  RegionIndex                                                           K)
+  RegionIndex                                                           K,
+  search::TimeSuccessorCache<LocationT, ConstraintSymbolT>             *cache = nullptr)
 {
 	std::map<ActionT, std::set<RegionIndex>> good_actions;
 	// TODO merging of the constraints is broken because we now get only a single action.
@@ -73,6 +76,12 @@ get_constraints_from_outgoing_action(
 	// the first one.
 	assert(reg_a(*std::begin(canonical_words)) == reg_a(*std::rbegin(canonical_words)));
 	const auto node_reg_a = reg_a(*std::begin(canonical_words));
+	const auto get_nth_time_successor = [&](RegionIndex n) {
+		if (cache != nullptr) {
+			return cache->get_nth_time_successor(node_reg_a, n);
+		}
+		return search::get_nth_time_successor(node_reg_a, n, K);
+	};
 
 	std::multimap<ActionT, std::multimap<std::string, automata::ClockConstraint>> res;
 	for (const auto &[action, increments] : good_actions) {
@@ -86,16 +95,16 @@ get_constraints_from_outgoing_action(
 					// They are the same, create both constraints at the same time to obtain a = constraint
 					// for even regions. constraints.merge(
 					constraints.merge(get_constraints_from_time_successor(
-					  search::get_nth_time_successor(node_reg_a, *first_good_increment, K),
+					  get_nth_time_successor(*first_good_increment),
 					  K,
 					  automata::ta::ConstraintBoundType::BOTH));
 				} else {
 					constraints.merge(get_constraints_from_time_successor(
-					  search::get_nth_time_successor(node_reg_a, *first_good_increment, K),
+					  get_nth_time_successor(*first_good_increment),
 					  K,
 					  automata::ta::ConstraintBoundType::LOWER));
 					constraints.merge(get_constraints_from_time_successor(
-					  search::get_nth_time_successor(node_reg_a, *increment, K),
+					  get_nth_time_successor(*increment),
 					  K,
 					  automata::ta::ConstraintBoundType::UPPER));
 				}
@@ -116,7 +125,8 @@ add_node_to_controller(
   RegionIndex                                                                K,
   bool                                                                       minimize_controller,
   automata::ta::TimedAutomaton<std::set<search::CanonicalABWord<LocationT, ConstraintSymbolT>>,
-                               ActionT> *                                    controller)
+                               ActionT> *                                    controller,
+  search::TimeSuccessorCache<LocationT, ConstraintSymbolT>                  *time_successor_cache)
 {
 	using search::NodeLabel;
 	using Transition =
@@ -129,31 +139,35 @@ add_node_to_controller(
 		  "Cannot create a controller for a node that is not labeled with TOP");
 	}
 	assert(std::is_sorted(std::begin(node->get_children()), std::end(node->get_children())));
+	// The words may have been released by a memory-bounded search, so only restore them once.
+	const auto words = node->get_words();
 	for (const auto &[timed_action, successor] : node->get_children()) {
 		if (successor->label != NodeLabel::TOP) {
 			continue;
 		}
-		bool new_location = controller->add_location(Location{successor->words});
-		controller->add_final_location(Location{successor->words});
+		const auto successor_words = successor->get_words();
+		bool       new_location    = controller->add_location(Location{successor_words});
+		controller->add_final_location(Location{successor_words});
 
 		for (const auto &[action, constraints] :
-		     get_constraints_from_outgoing_action(node->words, timed_action, K)) {
+		     get_constraints_from_outgoing_action(words, timed_action, K, time_successor_cache)) {
 			for (const auto &[clock, _constraint] : constraints) {
 				controller->add_clock(clock);
 			}
 			controller->add_action(action);
 			controller->add_transition(
-			  Transition{Location{node->words}, action, Location{successor->words}, constraints, {}});
+			  Transition{Location{words}, action, Location{successor_words}, constraints, {}});
 		}
 		if (new_location) {
 			// To break circles in the search graph, only add the successor if it is actually a new
 			// location.
-			add_node_to_controller(successor.get(),
+			add_node_to_controller(successor,
 			                       controller_actions,
 			                       environment_actions,
 			                       K,
 			                       minimize_controller,
-			                       controller);
+			                       controller,
+			                       time_successor_cache);
 		}
 		if (minimize_controller
 		    && controller_actions.find(timed_action.second) != std::end(controller_actions)) {
@@ -171,7 +185,9 @@ create_controller(const search::SearchTreeNode<LocationT, ActionT, ConstraintSym
                   std::set<ActionT> controller_actions,
                   std::set<ActionT> environment_actions,
                   RegionIndex       K,
-                  bool              minimize_controller = true)
+                  bool              minimize_controller = true,
+                  search::TimeSuccessorCache<LocationT, ConstraintSymbolT> *time_successor_cache =
+                    nullptr)
 {
 	using namespace details;
 	using search::NodeLabel;
@@ -179,9 +195,14 @@ create_controller(const search::SearchTreeNode<LocationT, ActionT, ConstraintSym
 	  automata::ta::Location<std::set<search::CanonicalABWord<LocationT, ConstraintSymbolT>>>;
 	automata::ta::TimedAutomaton<std::set<search::CanonicalABWord<LocationT, ConstraintSymbolT>>,
 	                             ActionT>
-	  controller{{}, Location{root->words}, {}};
-	add_node_to_controller(
-	  root, controller_actions, environment_actions, K, minimize_controller, &controller);
+	  controller{{}, Location{root->get_words()}, {}};
+	add_node_to_controller(root,
+	                       controller_actions,
+	                       environment_actions,
+	                       K,
+	                       minimize_controller,
+	                       &controller,
+	                       time_successor_cache);
 	return controller;
 }
 
@@ -0,0 +1,695 @@
+/***************************************************************************
+ *  distributed_search.h - Distribute the search over multiple processes
+ *
+ *  Created:   Sun 18 Oct 11:26:53 CEST 2026
+ *  Copyright  2026  Till Hofmann <hofmann@kbsg.rwth-aachen.de>
+ *  SPDX-License-Identifier: LGPL-3.0-or-later
+ ****************************************************************************/
+
+#pragma once
+
+#include "search.h"
+#include "search_tree.h"
+#include "utilities/local_transport.h"
+#include "word_codec.h"
+
+#include <fmt/format.h>
+#include <signal.h>
+#include <spdlog/spdlog.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace tacos::search {
+
+/** Statistics about a single worker process of a distributed search. */
+struct DistributedWorkerStatistics
+{
+	/** The number of nodes that belong to the worker. */
+	std::size_t num_nodes{0};
+	/** The number of nodes that the worker found and forwarded to the worker they belong to. */
+	std::size_t num_forwarded_nodes{0};
+	/** The number of messages that the worker sent to other workers. */
+	std::size_t num_sent_messages{0};
+	/** The number of messages that the worker received from other workers. */
+	std::size_t num_received_messages{0};
+};
+
+/** The result of a distributed search. */
+struct DistributedSearchResult
+{
+	/** The final label of the root. */
+	NodeLabel root_label{NodeLabel::UNLABELED};
+	/** The reason for the label of the root. */
+	LabelReason root_label_reason{LabelReason::UNKNOWN};
+	/** Whether the search was stopped as soon as the root was labeled, before all nodes were
+	 * expanded. */
+	bool stopped_at_verdict{false};
+	/** The statistics of each worker, indexed by the worker's ID. */
+	std::vector<DistributedWorkerStatistics> workers;
+};
+
+namespace details {
+
+/** The types of the messages that are exchanged by the processes of a distributed search. */
+enum class DistributedMessageType {
+	/** A worker found a node that belongs to the receiver. */
+	DISCOVER,
+	/** The label of a node that the receiver forwarded with a DISCOVER message. */
+	LABEL,
+	/** The coordinator asks for the message counters as soon as the worker is idle. */
+	PROBE,
+	/** The message counters of an idle worker. */
+	PROBE_REPLY,
+	/** The coordinator asks the workers to label the remaining nodes with the greatest fixpoint. */
+	FIXPOINT,
+	/** The coordinator asks the workers to label the remaining nodes TOP and to report. */
+	FINISH,
+	/** The coordinator asks the workers to stop and to report. */
+	STOP,
+	/** The root owner reports the label of the root. */
+	VERDICT,
+	/** A worker reports its statistics, this is the last message of a worker. */
+	STATISTICS,
+};
+
+/** Get the hash of an encoded value with FNV-1a. The hash only depends on the encoding, so all
+ * processes compute the same hash for the same value. */
+inline std::uint64_t
+get_encoding_hash(std::string_view encoding)
+{
+	std::uint64_t hash = 14695981039346656037ULL;
+	for (const char byte : encoding) {
+		hash ^= static_cast<unsigned char>(byte);
+		hash *= 1099511628211ULL;
+	}
+	return hash;
+}
+
+} // namespace details
+
+/** @brief Distribute a search over multiple worker processes on the same host.
+ *
+ * Each worker is a forked copy of the process that owns a hash partition of the search graph, so
+ * each worker only keeps its own nodes and allocates them without contention with other workers.
+ * A worker expands its own nodes. A child that belongs to another worker is kept as an unexpanded
+ * copy and forwarded to its owner, which reports the child's label back as soon as it is known.
+ * The label is then propagated to the parents of the copy. Domination checks only consider the
+ * ancestors within the same worker, which is sound but prunes fewer nodes than a single search.
+ *
+ * The calling process coordinates the workers and detects termination with two consecutive rounds
+ * of message counters: If no worker has sent or received a message between two rounds and all sent
+ * messages have been received, all workers are idle. After all nodes have been expanded, the
+ * remaining nodes are labeled with the greatest fixpoint in the same way, i.e., a node is labeled
+ * BOTTOM if its children force it to be BOTTOM, and all other nodes are labeled TOP. The search
+ * stops as soon as the root is labeled. The result is only the label of the root, the search graph
+ * of the calling process is not modified, so no controller can be created from it.
+ */
+template <typename Location,
+          typename ActionType,
+          typename ConstraintSymbolType = ActionType,
+          bool use_location_constraints = false,
+          typename Plant =
+            automata::ta::TimedAutomaton<typename Location::UnderlyingType, ActionType>,
+          bool use_set_semantics = false>
+class DistributedSearch
+{
+public:
+	/** The type of the search that is distributed. */
+	using Search = TreeSearch<Location,
+	                          ActionType,
+	                          ConstraintSymbolType,
+	                          use_location_constraints,
+	                          Plant,
+	                          use_set_semantics>;
+	/** The type of the search nodes. */
+	using Node = typename Search::Node;
+
+	/** Initialize the distributed search.
+	 * @param search The search to distribute, it must use incremental labeling without canceling
+	 * children and it must not have been started yet. Each worker works on its own copy of the
+	 * search.
+	 * @param num_workers The number of worker processes
+	 * @param expansion_batch_size The number of nodes a worker expands before it handles messages
+	 * @throw std::invalid_argument if the search does not use incremental labeling or cancels
+	 * children, or if the number of workers or the batch size is zero
+	 */
+	DistributedSearch(Search *search, std::size_t num_workers, std::size_t expansion_batch_size = 16)
+	: search_(search), num_workers_(num_workers), expansion_batch_size_(expansion_batch_size)
+	{
+		if (!search_->can_be_partitioned()) {
+			throw std::invalid_argument(
+			  "A distributed search requires incremental labeling without canceling children");
+		}
+		if (num_workers_ == 0) {
+			throw std::invalid_argument("A distributed search needs at least one worker");
+		}
+		if (expansion_batch_size_ == 0) {
+			throw std::invalid_argument("The expansion batch size must be positive");
+		}
+	}
+
+	/** Run the search with the worker processes and wait until the root is labeled.
+	 * @return The label of the root and the statistics of the workers
+	 * @throw std::runtime_error if a worker process cannot be started or fails
+	 */
+	DistributedSearchResult
+	run()
+	{
+		std::vector<std::vector<utilities::LocalConnection>> peer_connections(num_workers_);
+		for (auto &connections : peer_connections) {
+			connections.resize(num_workers_);
+		}
+		for (std::size_t first = 0; first < num_workers_; ++first) {
+			for (std::size_t second = first + 1; second < num_workers_; ++second) {
+				std::tie(peer_connections[first][second], peer_connections[second][first]) =
+				  utilities::LocalConnection::create_pair();
+			}
+		}
+		std::vector<utilities::LocalConnection> coordinator_connections;
+		std::vector<utilities::LocalConnection> worker_connections;
+		for (std::size_t id = 0; id < num_workers_; ++id) {
+			auto [coordinator_connection, worker_connection] = utilities::LocalConnection::create_pair();
+			coordinator_connections.push_back(std::move(coordinator_connection));
+			worker_connections.push_back(std::move(worker_connection));
+		}
+		// Do not write buffered output twice.
+		std::fflush(nullptr);
+		std::vector<pid_t> workers;
+		try {
+			for (std::size_t id = 0; id < num_workers_; ++id) {
+				const pid_t pid = fork();
+				if (pid < 0) {
+					throw std::runtime_error(fmt::format("Failed to start worker {}", id));
+				}
+				if (pid == 0) {
+					// Only keep the connections of this worker.
+					for (auto &connection : coordinator_connections) {
+						connection.close();
+					}
+					for (std::size_t other = 0; other < num_workers_; ++other) {
+						if (other != id) {
+							worker_connections[other].close();
+							for (auto &connection : peer_connections[other]) {
+								connection.close();
+							}
+						}
+					}
+					int status = 0;
+					try {
+						Worker worker{this,
+						              id,
+						              std::move(peer_connections[id]),
+						              std::move(worker_connections[id])};
+						worker.run();
+					} catch (const std::exception &e) {
+						SPDLOG_ERROR("Worker {} failed: {}", id, e.what());
+						status = 1;
+					}
+					_exit(status);
+				}
+				workers.push_back(pid);
+			}
+			peer_connections.clear();
+			worker_connections.clear();
+			auto result     = coordinate(coordinator_connections);
+			bool has_failed = false;
+			for (const pid_t pid : workers) {
+				int status = 0;
+				waitpid(pid, &status, 0);
+				has_failed = has_failed || !WIFEXITED(status) || WEXITSTATUS(status) != 0;
+			}
+			workers.clear();
+			if (has_failed) {
+				throw std::runtime_error("A worker of the distributed search failed");
+			}
+			return result;
+		} catch (...) {
+			for (const pid_t pid : workers) {
+				kill(pid, SIGKILL);
+				waitpid(pid, nullptr, 0);
+			}
+			throw;
+		}
+	}
+
+private:
+	using MessageType = details::DistributedMessageType;
+
+	/** Get the worker that owns the node with the given encoded words. */
+	std::size_t
+	get_owner(std::string_view encoded_words) const
+	{
+		return details::get_encoding_hash(encoded_words) % num_workers_;
+	}
+
+	/** Wait for the messages of the workers and coordinate the phases of the search until each
+	 * worker has reported its statistics. */
+	DistributedSearchResult
+	coordinate(std::vector<utilities::LocalConnection> &connections)
+	{
+		enum class Phase { EXPLORE, FIXPOINT, FINISH };
+		using Counters = std::pair<std::uint64_t, std::uint64_t>;
+		DistributedSearchResult result;
+		result.workers.resize(num_workers_);
+		std::vector<bool>                    has_statistics(num_workers_, false);
+		std::vector<std::optional<Counters>> counters;
+		std::vector<std::optional<Counters>> previous_counters;
+		std::uint64_t                        round       = 0;
+		Phase                                phase       = Phase::EXPLORE;
+		bool                                 is_stopping = false;
+		const auto broadcast = [&connections](const std::string &message) {
+			for (auto &connection : connections) {
+				connection.send(message);
+			}
+		};
+		const auto start_round = [&] {
+			++round;
+			counters.assign(num_workers_, std::nullopt);
+			WordEncoder message;
+			message.write(MessageType::PROBE);
+			message.write_integer(round);
+			broadcast(message.take_buffer());
+		};
+		const auto send_command = [&broadcast](MessageType type) {
+			WordEncoder message;
+			message.write(type);
+			broadcast(message.take_buffer());
+		};
+		std::vector<utilities::LocalConnection *> connection_pointers;
+		for (auto &connection : connections) {
+			connection_pointers.push_back(&connection);
+		}
+		start_round();
+		while (std::find(std::begin(has_statistics), std::end(has_statistics), false)
+		       != std::end(has_statistics)) {
+			for (auto &connection : connections) {
+				connection.flush();
+			}
+			utilities::wait_for_connections(connection_pointers, -1);
+			for (std::size_t id = 0; id < num_workers_; ++id) {
+				const bool is_open = connections[id].receive();
+				while (const auto message = connections[id].pop_message()) {
+					WordDecoder decoder{*message};
+					switch (decoder.read<MessageType>()) {
+					case MessageType::PROBE_REPLY: {
+						const auto reply_round = decoder.read_integer();
+						const auto sent        = decoder.read_integer();
+						const auto received    = decoder.read_integer();
+						if (reply_round == round) {
+							counters[id] = Counters{sent, received};
+						}
+						break;
+					}
+					case MessageType::VERDICT:
+						result.root_label        = decoder.read<NodeLabel>();
+						result.root_label_reason = decoder.read<LabelReason>();
+						if (!is_stopping) {
+							SPDLOG_DEBUG("Root labeled {}, stopping the workers", result.root_label);
+							result.stopped_at_verdict = phase == Phase::EXPLORE;
+							is_stopping               = true;
+							send_command(MessageType::STOP);
+						}
+						break;
+					case MessageType::STATISTICS: {
+						auto &statistics                 = result.workers[id];
+						statistics.num_nodes             = decoder.read<std::size_t>();
+						statistics.num_forwarded_nodes   = decoder.read<std::size_t>();
+						statistics.num_sent_messages     = decoder.read<std::size_t>();
+						statistics.num_received_messages = decoder.read<std::size_t>();
+						has_statistics[id]               = true;
+						break;
+					}
+					default:
+						throw std::runtime_error(
+						  fmt::format("Unexpected message from worker {}: {}", id, *message));
+					}
+				}
+				if (!is_open && !has_statistics[id]) {
+					throw std::runtime_error(fmt::format("Worker {} terminated unexpectedly", id));
+				}
+			}
+			if (is_stopping
+			    || std::find(std::begin(counters), std::end(counters), std::nullopt)
+			         != std::end(counters)) {
+				continue;
+			}
+			std::uint64_t num_sent     = 0;
+			std::uint64_t num_received = 0;
+			for (const auto &worker_counters : counters) {
+				num_sent += worker_counters->first;
+				num_received += worker_counters->second;
+			}
+			if (counters != previous_counters || num_sent != num_received) {
+				// Some worker has been active since the last round.
+				previous_counters = std::move(counters);
+				start_round();
+			} else if (phase == Phase::EXPLORE) {
+				SPDLOG_DEBUG("All nodes expanded, computing the greatest fixpoint");
+				phase = Phase::FIXPOINT;
+				send_command(MessageType::FIXPOINT);
+				previous_counters.clear();
+				start_round();
+			} else {
+				phase       = Phase::FINISH;
+				is_stopping = true;
+				send_command(MessageType::FINISH);
+			}
+		}
+		return result;
+	}
+
+	/** @brief A worker process of the distributed search.
+	 *
+	 * The worker restricts its copy of the search to the nodes that it owns and exchanges nodes and
+	 * labels with the other workers.
+	 */
+	class Worker
+	{
+	public:
+		/** Initialize the worker.
+		 * @param distributed_search The distributed search that started the worker
+		 * @param id The ID of the worker
+		 * @param peers The connections to all other workers, indexed by their ID
+		 * @param coordinator The connection to the coordinator
+		 */
+		Worker(DistributedSearch                      *distributed_search,
+		       std::size_t                             id,
+		       std::vector<utilities::LocalConnection> peers,
+		       utilities::LocalConnection              coordinator)
+		: distributed_search_(distributed_search),
+		  search_(distributed_search->search_),
+		  id_(id),
+		  peers_(std::move(peers)),
+		  coordinator_(std::move(coordinator))
+		{
+			for (auto &peer : peers_) {
+				connections_.push_back(&peer);
+			}
+			connections_.push_back(&coordinator_);
+		}
+
+		/** Run the worker until the coordinator stops it. */
+		void
+		run()
+		{
+			search_->set_partition([this](Node *node) { return assign_node(node); },
+			                       [this](Node *node) { on_labeled(node); });
+			while (true) {
+				receive_messages();
+				if (is_done_) {
+					break;
+				}
+				const bool has_work = work();
+				report_verdict();
+				bool is_flushed = true;
+				for (auto &peer : peers_) {
+					is_flushed = peer.flush() && is_flushed;
+				}
+				if (!has_work && is_flushed && pending_probe_) {
+					WordEncoder message;
+					message.write(MessageType::PROBE_REPLY);
+					message.write_integer(*pending_probe_);
+					message.write_integer(num_sent_messages_);
+					message.write_integer(num_received_messages_);
+					coordinator_.send(message.get_buffer());
+					pending_probe_.reset();
+				}
+				coordinator_.flush();
+				utilities::wait_for_connections(connections_, has_work ? 0 : -1);
+			}
+			report_verdict();
+			WordEncoder message;
+			message.write(MessageType::STATISTICS);
+			message.write(search_->get_size() - forwarded_nodes_.size() - (id_ == 0 ? 0 : 1));
+			message.write(forwarded_nodes_.size());
+			message.write(num_sent_messages_);
+			message.write(num_received_messages_);
+			coordinator_.send(message.get_buffer());
+			coordinator_.flush_blocking();
+		}
+
+	private:
+		enum class Phase { EXPLORE, FIXPOINT };
+
+		/** Decide whether a new node belongs to this worker and forward it to its owner otherwise. */
+		bool
+		assign_node(Node *node)
+		{
+			if (node == search_->get_root()) {
+				return id_ == 0;
+			}
+			WordEncoder words;
+			words.write(node->words);
+			const std::size_t owner = distributed_search_->get_owner(words.get_buffer());
+			if (owner == id_) {
+				return true;
+			}
+			WordEncoder message;
+			message.write(MessageType::DISCOVER);
+			message.write_integer(forwarded_nodes_.size());
+			message.write(node->min_total_region_increments);
+			forwarded_nodes_.push_back(node);
+			send_to_peer(owner, message.get_buffer() + words.get_buffer());
+			return false;
+		}
+
+		/** Report the label of a node to the workers that forwarded it and, while computing the
+		 * fixpoint, re-evaluate its parents. */
+		void
+		on_labeled(Node *node)
+		{
+			const NodeLabel label = node->label;
+			if (label != NodeLabel::TOP && label != NodeLabel::BOTTOM) {
+				return;
+			}
+			if (const auto remote_parents = remote_parents_.find(node);
+			    remote_parents != std::end(remote_parents_)) {
+				for (const auto &[worker, handle] : remote_parents->second) {
+					send_label(worker, handle, node);
+				}
+				remote_parents_.erase(remote_parents);
+			}
+			if (phase_ == Phase::FIXPOINT) {
+				for (Node *parent : node->parents) {
+					if (parent->label == NodeLabel::UNLABELED) {
+						fixpoint_worklist_.push_back(parent);
+					}
+				}
+			}
+		}
+
+		/** Send the label of a node to the worker that forwarded it with the given handle. */
+		void
+		send_label(std::size_t worker, std::uint64_t handle, const Node *node)
+		{
+			WordEncoder message;
+			message.write(MessageType::LABEL);
+			message.write_integer(handle);
+			message.write(node->label.load());
+			message.write(node->label_reason);
+			send_to_peer(worker, message.get_buffer());
+		}
+
+		void
+		send_to_peer(std::size_t worker, const std::string &message)
+		{
+			peers_.at(worker).send(message);
+			++num_sent_messages_;
+		}
+
+		/** Receive and handle all messages that are available. */
+		void
+		receive_messages()
+		{
+			for (std::size_t worker = 0; worker < peers_.size(); ++worker) {
+				// A peer only closes its connection once it has been stopped.
+				peers_[worker].receive();
+				while (const auto message = peers_[worker].pop_message()) {
+					++num_received_messages_;
+					handle_peer_message(worker, *message);
+				}
+			}
+			const bool is_open = coordinator_.receive();
+			while (const auto message = coordinator_.pop_message()) {
+				WordDecoder decoder{*message};
+				switch (decoder.read<MessageType>()) {
+				case MessageType::PROBE: pending_probe_ = decoder.read_integer(); break;
+				case MessageType::FIXPOINT: start_fixpoint(); break;
+				case MessageType::FINISH:
+					finish();
+					is_done_ = true;
+					return;
+				case MessageType::STOP: is_done_ = true; return;
+				default:
+					throw std::runtime_error(
+					  fmt::format("Unexpected message from the coordinator: {}", *message));
+				}
+			}
+			if (!is_open) {
+				throw std::runtime_error("Lost the connection to the coordinator");
+			}
+		}
+
+		/** Handle a message from another worker. */
+		void
+		handle_peer_message(std::size_t worker, std::string_view message)
+		{
+			WordDecoder decoder{message};
+			switch (decoder.read<MessageType>()) {
+			case MessageType::DISCOVER: {
+				const auto handle                      = decoder.read_integer();
+				const auto min_total_region_increments = decoder.read<RegionIndex>();
+				auto       words = decoder.read<std::set<typename Node::Word>>();
+				Node      *node  = search_->insert_node(std::move(words), min_total_region_increments);
+				if (const NodeLabel label = node->label;
+				    label == NodeLabel::TOP || label == NodeLabel::BOTTOM) {
+					send_label(worker, handle, node);
+				} else {
+					remote_parents_[node].emplace_back(worker, handle);
+				}
+				break;
+			}
+			case MessageType::LABEL: {
+				const auto handle = decoder.read_integer();
+				const auto label  = decoder.read<NodeLabel>();
+				const auto reason = decoder.read<LabelReason>();
+				if (handle >= forwarded_nodes_.size()) {
+					throw std::runtime_error(fmt::format("Invalid node handle {}", handle));
+				}
+				search_->label_remote_node(forwarded_nodes_[handle], label, reason);
+				break;
+			}
+			default:
+				throw std::runtime_error(
+				  fmt::format("Unexpected message from worker {}: {}", worker, message));
+			}
+		}
+
+		/** Do the next batch of work of the current phase.
+		 * @return true if there may be more work left
+		 */
+		bool
+		work()
+		{
+			const std::size_t batch_size = distributed_search_->expansion_batch_size_;
+			if (phase_ == Phase::EXPLORE) {
+				for (std::size_t i = 0; i < batch_size; ++i) {
+					if (!search_->step()) {
+						return false;
+					}
+				}
+				return true;
+			}
+			for (std::size_t i = 0; i < batch_size && !fixpoint_worklist_.empty(); ++i) {
+				Node *node = fixpoint_worklist_.back();
+				fixpoint_worklist_.pop_back();
+				update_fixpoint_label(node);
+			}
+			return !fixpoint_worklist_.empty();
+		}
+
+		/** Start to compute the greatest fixpoint. All nodes of this worker that are not labeled
+		 * yet are assumed to be TOP and are checked whether their children force them to be BOTTOM.
+		 */
+		void
+		start_fixpoint()
+		{
+			phase_ = Phase::FIXPOINT;
+			for (const auto &[key, node] : search_->get_nodes()) {
+				if (node->is_expanded && node->label == NodeLabel::UNLABELED) {
+					fixpoint_worklist_.push_back(node);
+				}
+			}
+		}
+
+		/** Label a node BOTTOM if its children force it to be BOTTOM, assuming that all unlabeled
+		 * nodes are TOP. */
+		void
+		update_fixpoint_label(Node *node)
+		{
+			if (node->label != NodeLabel::UNLABELED || !node->is_expanded) {
+				return;
+			}
+			const auto [label, reason] =
+			  details::compute_label(*node,
+			                         search_->get_controller_actions(),
+			                         search_->get_environment_actions(),
+			                         [](const Node *child) {
+				                         const NodeLabel child_label = child->label;
+				                         return child_label == NodeLabel::UNLABELED ? NodeLabel::TOP
+				                                                                    : child_label;
+			                         });
+			if (label == NodeLabel::BOTTOM) {
+				node->label_reason = reason;
+				node->set_label(NodeLabel::BOTTOM);
+				on_labeled(node);
+			}
+		}
+
+		/** Label all remaining nodes of this worker TOP, as they are not forced to be BOTTOM. */
+		void
+		finish()
+		{
+			for (const auto &[key, node] : search_->get_nodes()) {
+				if (node->is_expanded && node->label == NodeLabel::UNLABELED) {
+					node->label_reason = LabelReason::MONOTONIC_DOMINATION;
+					node->set_label(NodeLabel::TOP);
+				}
+			}
+		}
+
+		/** Report the label of the root to the coordinator as soon as it is known. */
+		void
+		report_verdict()
+		{
+			const Node *root = search_->get_root();
+			if (id_ != 0 || has_reported_verdict_
+			    || (root->label != NodeLabel::TOP && root->label != NodeLabel::BOTTOM)) {
+				return;
+			}
+			WordEncoder message;
+			message.write(MessageType::VERDICT);
+			message.write(root->label.load());
+			message.write(root->label_reason);
+			coordinator_.send(message.get_buffer());
+			has_reported_verdict_ = true;
+		}
+
+		DistributedSearch                        *distributed_search_;
+		Search                                   *search_;
+		const std::size_t                         id_;
+		std::vector<utilities::LocalConnection>   peers_;
+		utilities::LocalConnection                coordinator_;
+		std::vector<utilities::LocalConnection *> connections_;
+		Phase                                     phase_{Phase::EXPLORE};
+		bool                                      is_done_{false};
+		bool                                      has_reported_verdict_{false};
+		std::optional<std::uint64_t>              pending_probe_;
+		std::uint64_t                             num_sent_messages_{0};
+		std::uint64_t                             num_received_messages_{0};
+		/** The nodes that were forwarded to other workers, the index is the handle of the node. */
+		std::vector<Node *> forwarded_nodes_;
+		/** The workers and handles of the forwarded copies of nodes that are not labeled yet. */
+		std::unordered_map<Node *, std::vector<std::pair<std::size_t, std::uint64_t>>>
+		                    remote_parents_;
+		std::vector<Node *> fixpoint_worklist_;
+	};
+
+	Search           *search_;
+	const std::size_t num_workers_;
+	const std::size_t expansion_batch_size_;
+};
+
+} // namespace tacos::search
@@ -0,0 +1,131 @@
+/***************************************************************************
+ *  domination_signature.h - Signatures to quickly reject monotonic domination
+ *
+ *  Created:   Sat 17 Oct 14:05:12 CEST 2026
+ *  Copyright  2026  Till Hofmann <hofmann@kbsg.rwth-aachen.de>
+ *  SPDX-License-Identifier: LGPL-3.0-or-later
+ ****************************************************************************/
+
+#pragma once
+
+#include "canonical_word.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <set>
+#include <string>
+#include <variant>
+
+namespace tacos::search {
+
+/** @brief A Bloom filter over region symbols.
+ *
+ * Each region symbol sets one bit of the signature. The signature of a set of words is the
+ * conjunction of the signatures of its words, i.e., it contains the symbols that occur in every
+ * word. If set1 is monotonically dominated by set2, then every word of set2 contains all symbols of
+ * some word of set1, and thus the signature of set1 is a subset of the signature of set2. The
+ * converse does not hold, so the signature can only be used to reject domination.
+ */
+using DominationSignature = std::uint64_t;
+
+/** Statistics about ancestor domination checks.
+ * @see dominates_ancestor
+ */
+struct DominationStatistics
+{
+	/** The number of ancestors that were compared against a node. */
+	std::size_t num_ancestors{0};
+	/** The number of ancestors that were rejected by their signature. */
+	std::size_t num_signature_rejections{0};
+	/** The number of ancestors for which the exact domination check was run. */
+	std::size_t num_exact_checks{0};
+	/** The number of exact checks that found a dominated ancestor. */
+	std::size_t num_dominations{0};
+
+	/** Add the statistics of another run.
+	 * @param other The statistics to add
+	 * @return A reference to this object
+	 */
+	DominationStatistics &
+	operator+=(const DominationStatistics &other)
+	{
+		num_ancestors += other.num_ancestors;
+		num_signature_rejections += other.num_signature_rejections;
+		num_exact_checks += other.num_exact_checks;
+		num_dominations += other.num_dominations;
+		return *this;
+	}
+};
+
+namespace details {
+
+/** Mix the bits of a hash value so that each bit of the result depends on all input bits. */
+inline std::uint64_t
+mix_signature_hash(std::uint64_t hash)
+{
+	hash ^= hash >> 33;
+	hash *= 0xff51afd7ed558ccdULL;
+	hash ^= hash >> 33;
+	return hash;
+}
+
+} // namespace details
+
+/** Get the signature of a single region symbol.
+ * The location of a plant symbol is not part of the signature, as location types are not
+ * necessarily hashable. This only makes the signature less selective.
+ * @param symbol The symbol
+ * @return A signature with exactly one bit set
+ */
+template <typename LocationT, typename ConstraintSymbolT>
+DominationSignature
+get_domination_signature(const ABRegionSymbol<LocationT, ConstraintSymbolT> &symbol)
+{
+	std::uint64_t hash;
+	if (std::holds_alternative<PlantRegionState<LocationT>>(symbol)) {
+		const auto &state = std::get<PlantRegionState<LocationT>>(symbol);
+		hash = std::hash<std::string>{}(state.clock) * 31 + state.region_index;
+	} else {
+		const auto &state = std::get<ATARegionState<ConstraintSymbolT>>(symbol);
+		hash = (std::hash<logic::MTLFormula<ConstraintSymbolT>>{}(state.formula) * 31
+		        + state.region_index)
+		       ^ 0x9e3779b97f4a7c15ULL;
+	}
+	return DominationSignature{1} << (details::mix_signature_hash(hash) % 64);
+}
+
+/** Get the signature of a set of words, which contains the symbols that occur in all words.
+ * @param words The words of a search node
+ * @return The conjunction of the signatures of all words
+ */
+template <typename LocationT, typename ConstraintSymbolT>
+DominationSignature
+get_domination_signature(const std::set<CanonicalABWord<LocationT, ConstraintSymbolT>> &words)
+{
+	DominationSignature signature = std::numeric_limits<DominationSignature>::max();
+	for (const auto &word : words) {
+		DominationSignature word_signature{0};
+		for (const auto &partition : word) {
+			for (const auto &symbol : partition) {
+				word_signature |= get_domination_signature<LocationT, ConstraintSymbolT>(symbol);
+			}
+		}
+		signature &= word_signature;
+	}
+	return signature;
+}
+
+/** Check whether a set of words may be monotonically dominated by another set of words.
+ * @param signature1 The signature of the set that is to be dominated
+ * @param signature2 The signature of the potentially dominating set
+ * @return false if the first set is definitely not dominated by the second set
+ */
+inline bool
+may_be_monotonically_dominated(DominationSignature signature1, DominationSignature signature2)
+{
+	return (signature1 & ~signature2) == 0;
+}
+
+} // namespace tacos::search
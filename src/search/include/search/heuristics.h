@@ -13,6 +13,7 @@
 
 #include <limits>
 #include <random>
+#include <type_traits>
 
 namespace tacos::search {
 
@@ -35,6 +36,19 @@ public:
 	 * @return The cost of the node
 	 */
 	virtual ValueT compute_cost(NodeT *node) = 0;
+	/** @brief Check whether the costs are integers from a small, dense range.
+	 *
+	 * This is the case if the costs of all nodes that are in the search frontier at the same time
+	 * only differ by a small amount, e.g., because the cost is a small bounded value. A counter is
+	 * not dense, as the frontier may contain nodes from all expansions so far. If the costs are
+	 * dense, the search may use a bucket queue instead of a binary heap for its frontier.
+	 * @return true if the costs are integers from a small range
+	 */
+	virtual bool
+	has_dense_integer_costs() const
+	{
+		return false;
+	}
 	/** Virtual destructor. */
 	virtual ~Heuristic()
 	{
@@ -113,6 +127,13 @@ public:
 	{
 		return node->min_total_region_increments;
 	}
+
+	/** The frontier spans at most 2K+1 region increments past its minimum. */
+	bool
+	has_dense_integer_costs() const override
+	{
+		return std::is_integral_v<ValueT>;
+	}
 };
 
 /** @brief Prefer environment actions over controller actions.
@@ -141,7 +162,7 @@ public:
 	{
 		for (const auto &parent : node->parents) {
 			for (const auto &[timed_action, child] : parent->get_children()) {
-				if (child.get() == node
+				if (child == node
 				    && environment_actions.find(timed_action.second) != std::end(environment_actions)) {
 					return 0;
 				}
@@ -150,6 +171,13 @@ public:
 		return 1;
 	}
 
+	/** The costs are 0 or 1. */
+	bool
+	has_dense_integer_costs() const override
+	{
+		return std::is_integral_v<ValueT>;
+	}
+
 private:
 	std::set<ActionT> environment_actions;
 };
@@ -168,6 +196,13 @@ public:
 	{
 		return node->words.size();
 	}
+
+	/** The costs are word counts, which are bounded by the largest node, not by the expansions. */
+	bool
+	has_dense_integer_costs() const override
+	{
+		return std::is_integral_v<ValueT>;
+	}
 };
 
 /** @brief Compose multiple heuristics.
@@ -201,6 +236,26 @@ public:
 		return res;
 	}
 
+	/** The costs are dense if the costs of all heuristics are dense and the weights are small.
+	 * Each weight multiplies the range of its heuristic's costs, so the sum of all absolute weights
+	 * must not exceed max_dense_weight_sum.
+	 */
+	bool
+	has_dense_integer_costs() const override
+	{
+		ValueT weight_sum = 0;
+		for (const auto &[weight, heuristic] : heuristics) {
+			if (!heuristic->has_dense_integer_costs()) {
+				return false;
+			}
+			weight_sum += weight < 0 ? -weight : weight;
+		}
+		return weight_sum <= max_dense_weight_sum;
+	}
+
+	/** The maximal sum of all absolute weights such that the weighted costs are still dense. */
+	static constexpr ValueT max_dense_weight_sum = 32;
+
 private:
 	std::vector<std::pair<ValueT, std::unique_ptr<Heuristic<ValueT, NodeT>>>> heuristics;
 };
@@ -10,8 +10,15 @@
 #pragma once
 
 #include "canonical_word.h"
+#include "domination_signature.h"
+#include "packed_canonical_word.h"
 
 #include <algorithm>
+#include <iterator>
+#include <optional>
+#include <set>
+#include <unordered_set>
+#include <vector>
 
 namespace tacos::search {
 
@@ -72,52 +79,143 @@ is_monotonically_dominated(const std::set<CanonicalABWord<LocationT, ConstraintS
 	});
 }
 
-/** @brief Check monotonic domination for a node and its ancestors.
+namespace details {
+
+/** @brief Pointers to the packed words of a node.
  *
- * Check if the given words monotonically dominate the given node or one of its ancestors. Note that
- * the recursion relies on the fact that there are no loops in the ancestors. This is guaranteed if
- * a node that monotonically dominates some ancestor is never expanded. If this is not the case,
- * this function may overflow the stack by infinite recursion.
+ * If the node has released its words, the pointers refer to the packed words of the node.
+ * Otherwise, the words of the node are packed with the given table, which must be the table that
+ * the nodes to compare with have been packed with.
+ */
+class PackedNodeWords
+{
+public:
+	/** Get the packed words of a node.
+	 * @param node The node to get the packed words of
+	 * @param symbol_table The table to pack the words with if they have not been released
+	 */
+	template <typename Node>
+	PackedNodeWords(const Node &node, typename Node::SymbolTable &symbol_table)
+	{
+		if (node.has_released_words()) {
+			pointers_ = &node.get_packed_words();
+			return;
+		}
+		packed_words_.reserve(node.words.size());
+		for (const auto &word : node.words) {
+			packed_words_.push_back(symbol_table.pack(word));
+		}
+		for (const auto &word : packed_words_) {
+			own_pointers_.push_back(&word);
+		}
+		pointers_ = &own_pointers_;
+	}
+
+	PackedNodeWords(const PackedNodeWords &)            = delete;
+	PackedNodeWords &operator=(const PackedNodeWords &) = delete;
+
+	/** Get pointers to the packed words. */
+	const std::vector<const PackedCanonicalABWord *> &
+	get() const
+	{
+		return *pointers_;
+	}
+
+private:
+	std::vector<PackedCanonicalABWord>                packed_words_;
+	std::vector<const PackedCanonicalABWord *>        own_pointers_;
+	const std::vector<const PackedCanonicalABWord *> *pointers_;
+};
+
+} // namespace details
+
+/**
+ * @brief Check the powerset order induced by monotonic domination on the words of two nodes.
+ * Released words are compared in their packed form without restoring them. If only one of the
+ * nodes has released its words, the words of the other node are packed for the comparison.
  *
- * @param node Check this node and its ancestors whether its words is monotonically dominated
- * @param words The set of words to compare against the node's words
- * @param seen_nodes A vector of nodes that have already been seen; if the current node has already
- * been seen, the check is aborted.
- * @return true if the given node or one of its ancestors is monotonically dominated
+ * @param node1 The node whose words are to be dominated
+ * @param node2 The node whose words should dominate the words of the first node
+ * @return true if the words of node1 < the words of node2 in the powerset order
  */
 template <typename LocationT, typename ActionT, typename ConstraintSymbolT>
 bool
-ancestor_is_monotonically_dominated(
-  const SearchTreeNode<LocationT, ActionT, ConstraintSymbolT> &               node,
-  const std::set<CanonicalABWord<LocationT, ConstraintSymbolT>> &             words,
-  std::vector<const SearchTreeNode<LocationT, ActionT, ConstraintSymbolT> *> &seen_nodes)
+is_monotonically_dominated(const SearchTreeNode<LocationT, ActionT, ConstraintSymbolT> &node1,
+                           const SearchTreeNode<LocationT, ActionT, ConstraintSymbolT> &node2)
 {
-	if (std::find(std::begin(seen_nodes), std::end(seen_nodes), &node) != std::end(seen_nodes)) {
-		return false;
+	if (!node1.has_released_words() && !node2.has_released_words()) {
+		return is_monotonically_dominated(node1.words, node2.words);
 	}
-	seen_nodes.push_back(&node);
-	return is_monotonically_dominated(node.words, words)
-	       || std::any_of(node.parents.begin(),
-	                      node.parents.end(),
-	                      [&words, &seen_nodes](const auto &parent) {
-		                      return ancestor_is_monotonically_dominated(*parent, words, seen_nodes);
-	                      });
-	return false;
+	auto &symbol_table =
+	  node1.has_released_words() ? node1.get_symbol_table() : node2.get_symbol_table();
+	return is_monotonically_dominated(details::PackedNodeWords{node1, symbol_table}.get(),
+	                                  details::PackedNodeWords{node2, symbol_table}.get());
 }
 
-/** Check if there is an ancestor that monotonally dominates the given node
+/** @brief Check if there is an ancestor that is monotonically dominated by the given node.
+ *
+ * The ancestors are traversed iteratively and each ancestor is visited at most once. Each ancestor
+ * is first compared by its DominationSignature, and only if the signature does not rule out
+ * domination, the exact (and expensive) check is done. The node itself is not compared against
+ * itself, even if it is its own ancestor.
+ *
  * @param node The node to check
+ * @param statistics If not null, the statistics of this check are added to it
+ * @return true if the node monotonically dominates one of its ancestors
  */
 template <typename LocationT, typename ActionT, typename ConstraintSymbolT>
 bool
-dominates_ancestor(SearchTreeNode<LocationT, ActionT, ConstraintSymbolT> *node)
+dominates_ancestor(SearchTreeNode<LocationT, ActionT, ConstraintSymbolT> *node,
+                   DominationStatistics                                  *statistics = nullptr)
 {
-	std::vector<const SearchTreeNode<LocationT, ActionT, ConstraintSymbolT> *> seen_nodes = {node};
-	return std::any_of(node->parents.begin(),
-	                   node->parents.end(),
-	                   [node, &seen_nodes](const auto &parent) {
-		                   return ancestor_is_monotonically_dominated(*parent, node->words, seen_nodes);
-	                   });
+	using Node = SearchTreeNode<LocationT, ActionT, ConstraintSymbolT>;
+	DominationStatistics             local_statistics;
+	std::unordered_set<const Node *> seen_nodes{node};
+	std::vector<const Node *>        open_nodes(std::begin(node->parents), std::end(node->parents));
+	bool                             dominates = false;
+
+	// The packed words of the node, only computed if an ancestor has released its words.
+	std::optional<details::PackedNodeWords> packed_node_words;
+	while (!dominates && !open_nodes.empty()) {
+		const Node *ancestor = open_nodes.back();
+		open_nodes.pop_back();
+		if (!seen_nodes.insert(ancestor).second) {
+			continue;
+		}
+		++local_statistics.num_ancestors;
+		if (!may_be_monotonically_dominated(ancestor->domination_signature,
+		                                    node->domination_signature)) {
+			++local_statistics.num_signature_rejections;
+		} else {
+			++local_statistics.num_exact_checks;
+			if (!ancestor->has_released_words() && !node->has_released_words()) {
+				dominates = is_monotonically_dominated(ancestor->words, node->words);
+			} else {
+				auto &symbol_table = ancestor->has_released_words() ? ancestor->get_symbol_table()
+				                                                    : node->get_symbol_table();
+				// All released words share one table, so the node's words are only packed once.
+				if (!packed_node_words) {
+					packed_node_words.emplace(*node, symbol_table);
+				}
+				dominates =
+				  is_monotonically_dominated(details::PackedNodeWords{*ancestor, symbol_table}.get(),
+				                             packed_node_words->get());
+			}
+		}
+		std::copy_if(std::begin(ancestor->parents),
+		             std::end(ancestor->parents),
+		             std::back_inserter(open_nodes),
+		             [&seen_nodes](const Node *parent) {
+			             return seen_nodes.find(parent) == std::end(seen_nodes);
+		             });
+	}
+	if (dominates) {
+		++local_statistics.num_dominations;
+	}
+	if (statistics != nullptr) {
+		*statistics += local_statistics;
+	}
+	return dominates;
 }
 
 } // namespace tacos::search
@@ -0,0 +1,554 @@
+/***************************************************************************
+ *  packed_canonical_word.h - A compact representation of canonical words
+ *
+ *  Created:   Fri 16 Oct 11:02:17 CEST 2026
+ *  Copyright  2026  Till Hofmann <hofmann@kbsg.rwth-aachen.de>
+ *  SPDX-License-Identifier: LGPL-3.0-or-later
+ ****************************************************************************/
+
+#pragma once
+
+#include "canonical_word.h"
+#include "utilities/types.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace tacos::search {
+
+/** @brief A single symbol of a packed canonical word.
+ *
+ * This is the packed counterpart of an ABRegionSymbol. Instead of the location, the clock name, and
+ * the formula, it only stores IDs, which are resolved with a PackedSymbolTable.
+ */
+struct PackedRegionSymbol
+{
+	/** The kind of the symbol. */
+	enum class Kind : std::uint8_t {
+		PLANT = 0, /**< The symbol is a PlantRegionState */
+		ATA   = 1, /**< The symbol is an ATARegionState */
+	};
+	/** The ID of the location (for plant symbols) or of the formula (for ATA symbols). */
+	std::uint32_t id;
+	/** The region index of the symbol. */
+	RegionIndex region_index;
+	/** The ID of the clock, only used for plant symbols. */
+	std::uint16_t clock;
+	/** The kind of the symbol. */
+	Kind kind;
+};
+
+/** Compare two packed symbols.
+ * Plant symbols are always smaller than ATA symbols, in the same way as in an ABRegionSymbol.
+ * @param s1 The first symbol
+ * @param s2 The second symbol
+ * @return true if s1 is lexicographically smaller than s2
+ */
+inline bool
+operator<(const PackedRegionSymbol &s1, const PackedRegionSymbol &s2)
+{
+	return std::tie(s1.kind, s1.id, s1.clock, s1.region_index)
+	       < std::tie(s2.kind, s2.id, s2.clock, s2.region_index);
+}
+
+/** Check two packed symbols for equality. */
+inline bool
+operator==(const PackedRegionSymbol &s1, const PackedRegionSymbol &s2)
+{
+	return std::tie(s1.kind, s1.id, s1.clock, s1.region_index)
+	       == std::tie(s2.kind, s2.id, s2.clock, s2.region_index);
+}
+
+/** Check two packed symbols for inequality. */
+inline bool
+operator!=(const PackedRegionSymbol &s1, const PackedRegionSymbol &s2)
+{
+	return !(s1 == s2);
+}
+
+/** @brief A canonical word in a packed memory layout.
+ *
+ * All symbols of the word are stored in one contiguous array, sorted within each partition. The
+ * partitions are given by their start offsets into the symbol array. Compared to a CanonicalABWord,
+ * this avoids one heap allocation per symbol and does not copy any formulas.
+ */
+class PackedCanonicalABWord
+{
+public:
+	/** An iterator over the symbols of a partition. */
+	using const_iterator = std::vector<PackedRegionSymbol>::const_iterator;
+
+	/** Get the number of partitions of the word. */
+	std::size_t
+	size() const
+	{
+		return offsets_.size();
+	}
+
+	/** Check whether the word is empty, i.e., whether it has no partition. */
+	bool
+	empty() const
+	{
+		return offsets_.empty();
+	}
+
+	/** Get the start of the ith partition. */
+	const_iterator
+	partition_begin(std::size_t i) const
+	{
+		assert(i < size());
+		return std::begin(symbols_) + offsets_[i];
+	}
+
+	/** Get the end of the ith partition. */
+	const_iterator
+	partition_end(std::size_t i) const
+	{
+		assert(i < size());
+		return i + 1 < size() ? std::begin(symbols_) + offsets_[i + 1] : std::end(symbols_);
+	}
+
+	/** Get all symbols of the word, partition by partition. */
+	const std::vector<PackedRegionSymbol> &
+	get_symbols() const
+	{
+		return symbols_;
+	}
+
+	/** Append a new partition to the word.
+	 * The symbols are sorted and duplicates are removed. Empty partitions are ignored.
+	 * @param first The first symbol of the partition
+	 * @param last The end of the partition
+	 */
+	template <typename InputIt>
+	void
+	add_partition(InputIt first, InputIt last)
+	{
+		if (first == last) {
+			return;
+		}
+		const auto start = symbols_.size();
+		offsets_.push_back(static_cast<std::uint32_t>(start));
+		symbols_.insert(std::end(symbols_), first, last);
+		std::sort(std::begin(symbols_) + start, std::end(symbols_));
+		symbols_.erase(std::unique(std::begin(symbols_) + start, std::end(symbols_)),
+		               std::end(symbols_));
+	}
+
+	/** Release the unused capacity of the word, e.g., before the word is stored for a long time. */
+	void
+	shrink_to_fit()
+	{
+		symbols_.shrink_to_fit();
+		offsets_.shrink_to_fit();
+	}
+
+	/** Estimate the memory that is used by the word, in bytes. */
+	std::size_t
+	estimate_memory() const
+	{
+		return sizeof(*this) + symbols_.capacity() * sizeof(PackedRegionSymbol)
+		       + offsets_.capacity() * sizeof(std::uint32_t);
+	}
+
+	/** Compare two packed words lexicographically. */
+	friend bool
+	operator<(const PackedCanonicalABWord &w1, const PackedCanonicalABWord &w2)
+	{
+		return std::tie(w1.offsets_, w1.symbols_) < std::tie(w2.offsets_, w2.symbols_);
+	}
+
+	/** Check two packed words for equality. */
+	friend bool
+	operator==(const PackedCanonicalABWord &w1, const PackedCanonicalABWord &w2)
+	{
+		return w1.offsets_ == w2.offsets_ && w1.symbols_ == w2.symbols_;
+	}
+
+	/** Check two packed words for inequality. */
+	friend bool
+	operator!=(const PackedCanonicalABWord &w1, const PackedCanonicalABWord &w2)
+	{
+		return !(w1 == w2);
+	}
+
+private:
+	std::vector<PackedRegionSymbol> symbols_;
+	std::vector<std::uint32_t>      offsets_;
+};
+
+/** @brief The table to translate between canonical words and packed canonical words.
+ *
+ * The table assigns a stable ID to each location, clock, and formula that occurs in a packed word.
+ * Words can only be unpacked with the table they have been packed with. The table is thread-safe.
+ */
+template <typename Location, typename ConstraintSymbolType>
+class PackedSymbolTable
+{
+public:
+	/** The unpacked word type. */
+	using Word = CanonicalABWord<Location, ConstraintSymbolType>;
+	/** The formula type of the ATA symbols. */
+	using Formula = logic::MTLFormula<ConstraintSymbolType>;
+
+	/** Pack a canonical word.
+	 * @param word The word to pack
+	 * @return The packed representation of the word
+	 */
+	PackedCanonicalABWord
+	pack(const Word &word)
+	{
+		PackedCanonicalABWord           res;
+		std::vector<PackedRegionSymbol> partition;
+		std::lock_guard                 lock{mutex_};
+		for (const auto &abs_i : word) {
+			partition.clear();
+			for (const auto &symbol : abs_i) {
+				if (std::holds_alternative<PlantRegionState<Location>>(symbol)) {
+					const auto &state = std::get<PlantRegionState<Location>>(symbol);
+					partition.push_back(PackedRegionSymbol{get_id(locations_, state.location),
+					                                       state.region_index,
+					                                       get_clock_id(state.clock),
+					                                       PackedRegionSymbol::Kind::PLANT});
+				} else {
+					const auto &state = std::get<ATARegionState<ConstraintSymbolType>>(symbol);
+					partition.push_back(PackedRegionSymbol{get_id(formulas_, state.formula),
+					                                       state.region_index,
+					                                       0,
+					                                       PackedRegionSymbol::Kind::ATA});
+				}
+			}
+			res.add_partition(std::begin(partition), std::end(partition));
+		}
+		return res;
+	}
+
+	/** Unpack a packed word.
+	 * @param word The packed word, which must have been packed with this table
+	 * @return The canonical word represented by the packed word
+	 */
+	Word
+	unpack(const PackedCanonicalABWord &word) const
+	{
+		Word            res;
+		std::lock_guard lock{mutex_};
+		for (std::size_t i = 0; i < word.size(); ++i) {
+			std::set<ABRegionSymbol<Location, ConstraintSymbolType>> abs_i;
+			for (auto it = word.partition_begin(i); it != word.partition_end(i); ++it) {
+				abs_i.insert(unpack_symbol(*it));
+			}
+			res.push_back(std::move(abs_i));
+		}
+		return res;
+	}
+
+	/** Get the location with the given ID. */
+	const Location &
+	get_location(std::uint32_t id) const
+	{
+		std::lock_guard lock{mutex_};
+		return *locations_.values.at(id);
+	}
+
+	/** Get the clock name with the given ID. */
+	const std::string &
+	get_clock(std::uint16_t id) const
+	{
+		std::lock_guard lock{mutex_};
+		return *clocks_.values.at(id);
+	}
+
+	/** Get the formula with the given ID. */
+	const Formula &
+	get_formula(std::uint32_t id) const
+	{
+		std::lock_guard lock{mutex_};
+		return *formulas_.values.at(id);
+	}
+
+private:
+	template <typename T>
+	struct IdMap
+	{
+		std::map<T, std::uint32_t> ids;
+		std::vector<const T *>     values;
+	};
+
+	template <typename T>
+	static std::uint32_t
+	get_id(IdMap<T> &map, const T &value)
+	{
+		auto [it, is_new] = map.ids.try_emplace(value, static_cast<std::uint32_t>(map.values.size()));
+		if (is_new) {
+			map.values.push_back(&it->first);
+		}
+		return it->second;
+	}
+
+	std::uint16_t
+	get_clock_id(const std::string &clock)
+	{
+		const auto id = get_id(clocks_, clock);
+		if (id > std::numeric_limits<std::uint16_t>::max()) {
+			throw std::invalid_argument("Too many clocks for a packed canonical word");
+		}
+		return static_cast<std::uint16_t>(id);
+	}
+
+	ABRegionSymbol<Location, ConstraintSymbolType>
+	unpack_symbol(const PackedRegionSymbol &symbol) const
+	{
+		if (symbol.kind == PackedRegionSymbol::Kind::PLANT) {
+			return PlantRegionState<Location>{*locations_.values.at(symbol.id),
+			                                  *clocks_.values.at(symbol.clock),
+			                                  symbol.region_index};
+		} else {
+			return ATARegionState<ConstraintSymbolType>{*formulas_.values.at(symbol.id),
+			                                            symbol.region_index};
+		}
+	}
+
+	mutable std::mutex mutex_;
+	IdMap<Location>    locations_;
+	IdMap<std::string> clocks_;
+	IdMap<Formula>     formulas_;
+};
+
+/** Get the time successor of a packed canonical word.
+ * This is the same as get_time_successor on a CanonicalABWord, but directly operates on the packed
+ * representation.
+ * @param word The word for which to compute the time successor
+ * @param K The upper bound for all constants appearing in clock constraints
+ * @return The packed word that directly follows the given word time-wise
+ */
+inline PackedCanonicalABWord
+get_time_successor(const PackedCanonicalABWord &word, RegionIndex K)
+{
+	if (word.empty()) {
+		return {};
+	}
+	const RegionIndex max_region_index = 2 * K + 1;
+	const auto        is_maxed = [max_region_index](const PackedRegionSymbol &symbol) {
+		return symbol.region_index == max_region_index;
+	};
+	const std::size_t               last = word.size() - 1;
+	std::vector<PackedRegionSymbol> new_maxed_partition;
+	// The index of the last nonmaxed partition plus one, so 0 means there is none.
+	std::size_t last_nonmaxed_end = word.size();
+	if (std::all_of(word.partition_begin(last), word.partition_end(last), is_maxed)) {
+		new_maxed_partition.assign(word.partition_begin(last), word.partition_end(last));
+		last_nonmaxed_end = last;
+	}
+	if (last_nonmaxed_end == 0) {
+		// All partitions are maxed, nothing to increment.
+		return word;
+	}
+	const bool has_even_region_index = word.partition_begin(0)->region_index % 2 == 0;
+	// If the region indexes of the first partition are even, increment the first partition.
+	// Otherwise, increment the last nonmaxed partition and move it to the front.
+	const std::size_t incremented_index = has_even_region_index ? 0 : last_nonmaxed_end - 1;
+	std::vector<PackedRegionSymbol> incremented_nonmaxed;
+	for (auto it = word.partition_begin(incremented_index);
+	     it != word.partition_end(incremented_index);
+	     ++it) {
+		auto symbol = *it;
+		if (symbol.region_index < max_region_index) {
+			symbol.region_index += 1;
+		}
+		if (is_maxed(symbol)) {
+			new_maxed_partition.push_back(symbol);
+		} else {
+			incremented_nonmaxed.push_back(symbol);
+		}
+	}
+	PackedCanonicalABWord res;
+	res.add_partition(std::begin(incremented_nonmaxed), std::end(incremented_nonmaxed));
+	const std::size_t first_copied = has_even_region_index ? 1 : 0;
+	const std::size_t last_copied  = has_even_region_index ? last_nonmaxed_end : last_nonmaxed_end - 1;
+	for (std::size_t i = first_copied; i < last_copied; ++i) {
+		res.add_partition(word.partition_begin(i), word.partition_end(i));
+	}
+	res.add_partition(std::begin(new_maxed_partition), std::end(new_maxed_partition));
+	return res;
+}
+
+/** Compute reg_a(w) of a packed word, which is w with all ATA symbols omitted.
+ * @param word The word to compute reg_a(word) of
+ * @return The packed word with only the plant symbols of the given word
+ */
+inline PackedCanonicalABWord
+reg_a(const PackedCanonicalABWord &word)
+{
+	PackedCanonicalABWord res;
+	for (std::size_t i = 0; i < word.size(); ++i) {
+		// The symbols are sorted and plant symbols come first, so we only need to find the first ATA
+		// symbol.
+		const auto first_ata = std::find_if(word.partition_begin(i),
+		                                    word.partition_end(i),
+		                                    [](const PackedRegionSymbol &symbol) {
+			                                    return symbol.kind == PackedRegionSymbol::Kind::ATA;
+		                                    });
+		res.add_partition(word.partition_begin(i), first_ata);
+	}
+	return res;
+}
+
+/** Check if the packed word w1 is monotonically dominated by the packed word w2.
+ * Both words must have been packed with the same table.
+ * @param w1 The word which may be dominated
+ * @param w2 The potentially dominating word
+ * @return true if w2 dominates w1
+ */
+inline bool
+is_monotonically_dominated(const PackedCanonicalABWord &w1, const PackedCanonicalABWord &w2)
+{
+	std::size_t current_w2 = 0;
+	for (std::size_t i = 0; i < w1.size(); ++i) {
+		while (current_w2 < w2.size()
+		       && !std::includes(w2.partition_begin(current_w2),
+		                         w2.partition_end(current_w2),
+		                         w1.partition_begin(i),
+		                         w1.partition_end(i))) {
+			++current_w2;
+		}
+		if (current_w2 == w2.size()) {
+			return false;
+		}
+		++current_w2;
+	}
+	return true;
+}
+
+/** Check the powerset order induced by monotonic domination on two sets of packed words.
+ * Checks if each word of the second set monotonically dominates a word from the first set. All
+ * words must have been packed with the same table.
+ * @param set1 Pointers to the packed words which are to be dominated
+ * @param set2 Pointers to the packed words which should dominate the first set
+ * @return true if set1 < set2, where < is the powerset order induced by monotonic domination
+ */
+inline bool
+is_monotonically_dominated(const std::vector<const PackedCanonicalABWord *> &set1,
+                           const std::vector<const PackedCanonicalABWord *> &set2)
+{
+	return std::all_of(std::begin(set2), std::end(set2), [&set1](const PackedCanonicalABWord *word2) {
+		return std::any_of(std::begin(set1),
+		                   std::end(set1),
+		                   [word2](const PackedCanonicalABWord *word1) {
+			                   return is_monotonically_dominated(*word1, *word2);
+		                   });
+	});
+}
+
+/** Get a concrete candidate for a packed canonical word.
+ * @param word The packed word to get a candidate for
+ * @param table The table that was used to pack the word
+ * @return A pair of plant and ATA configurations which is represented by the word
+ * @see get_candidate(const CanonicalABWord<Location, ConstraintSymbolType> &)
+ */
+template <typename Location, typename ConstraintSymbolType>
+std::pair<PlantConfiguration<Location>, ATAConfiguration<ConstraintSymbolType>>
+get_candidate(const PackedCanonicalABWord                             &word,
+              const PackedSymbolTable<Location, ConstraintSymbolType> &table)
+{
+	PlantConfiguration<Location>           plant_configuration{};
+	ATAConfiguration<ConstraintSymbolType> ata_configuration{};
+	const Time                             time_delta = Time(1) / Time(word.size() + 1);
+	// Collect all clocks first so the valuation does not switch its registry for each clock.
+	std::vector<std::string_view> clocks;
+	for (std::size_t i = 0; i < word.size(); ++i) {
+		for (auto it = word.partition_begin(i); it != word.partition_end(i); ++it) {
+			if (it->kind == PackedRegionSymbol::Kind::PLANT) {
+				clocks.push_back(table.get_clock(it->clock));
+			}
+		}
+	}
+	std::sort(std::begin(clocks), std::end(clocks));
+	clocks.erase(std::unique(std::begin(clocks), std::end(clocks)), std::end(clocks));
+	plant_configuration.clock_valuations =
+	  ClockSetValuation{ClockRegistry::get(std::begin(clocks), std::end(clocks))};
+	for (std::size_t i = 0; i < word.size(); ++i) {
+		for (auto it = word.partition_begin(i); it != word.partition_end(i); ++it) {
+			const Time fractional_part =
+			  it->region_index % 2 == 0 ? 0 : time_delta * static_cast<Time>(i + 1);
+			const Time integral_part = static_cast<RegionIndex>(it->region_index / 2);
+			if (it->kind == PackedRegionSymbol::Kind::PLANT) {
+				plant_configuration.location = table.get_location(it->id);
+				plant_configuration.clock_valuations.at(table.get_clock(it->clock)) =
+				  integral_part + fractional_part;
+			} else {
+				ata_configuration.insert(ATAState<ConstraintSymbolType>{table.get_formula(it->id),
+				                                                        integral_part + fractional_part});
+			}
+		}
+	}
+	return std::make_pair(plant_configuration, ata_configuration);
+}
+
+/** Print a packed symbol with its raw IDs. */
+inline std::ostream &
+operator<<(std::ostream &os, const PackedRegionSymbol &symbol)
+{
+	if (symbol.kind == PackedRegionSymbol::Kind::PLANT) {
+		os << "(l" << symbol.id << ", c" << symbol.clock << ", " << symbol.region_index << ")";
+	} else {
+		os << "(f" << symbol.id << ", " << symbol.region_index << ")";
+	}
+	return os;
+}
+
+/** Print a packed word with the raw IDs of its symbols.
+ * To print the word with the actual locations, clocks, and formulas, unpack it first.
+ */
+inline std::ostream &
+operator<<(std::ostream &os, const PackedCanonicalABWord &word)
+{
+	if (word.empty()) {
+		os << "[]";
+		return os;
+	}
+	os << "[ ";
+	for (std::size_t i = 0; i < word.size(); ++i) {
+		if (i > 0) {
+			os << ", ";
+		}
+		os << "{ ";
+		for (auto it = word.partition_begin(i); it != word.partition_end(i); ++it) {
+			if (it != word.partition_begin(i)) {
+				os << ", ";
+			}
+			os << *it;
+		}
+		os << " }";
+	}
+	os << " ]";
+	return os;
+}
+
+} // namespace tacos::search
+
+namespace fmt {
+
+template <>
+struct formatter<tacos::search::PackedRegionSymbol> : ostream_formatter
+{
+};
+
+template <>
+struct formatter<tacos::search::PackedCanonicalABWord> : ostream_formatter
+{
+};
+
+} // namespace fmt
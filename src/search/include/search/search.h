@@ -9,6 +9,7 @@
 #pragma once
 
 #include "adapter.h"
+#include "antichain_store.h"
 #include "automata/ata.h"
 #include "automata/ta.h"
 #include "canonical_word.h"
@@ -17,21 +18,42 @@
 #include "mtl_ata_translation/translator.h"
 #include "operators.h"
 #include "reg_a.h"
+#include "search_snapshot.h"
 #include "search_tree.h"
+#include "successor_cache.h"
 #include "synchronous_product.h"
+#include "time_successor_cache.h"
+#include "utilities/arena.h"
+#include "utilities/memory.h"
 #include "utilities/priority_thread_pool.h"
+#include "utilities/sharded_hash_map.h"
 #include "utilities/type_traits.h"
 #include "utilities/types.h"
+#include "word_interning.h"
 
 #include <fmt/ranges.h>
 #include <spdlog/spdlog.h>
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
 #include <iterator>
 #include <limits>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <queue>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
 #include <variant>
+#include <vector>
 
 /** @brief The search algorithm.
  *
@@ -50,17 +72,20 @@ bool
 has_satisfiable_ata_configuration(
   const SearchTreeNode<Location, ActionType, ConstraintSymbolType> &node)
 {
-	return !std::all_of(std::begin(node.words), std::end(node.words), [](const auto &word) {
-		return std::any_of(std::begin(word), std::end(word), [](const auto &component) {
-			return std::find_if(
-			         std::begin(component),
-			         std::end(component),
-			         [](const auto &region_symbol) {
-				         return std::holds_alternative<ATARegionState<ConstraintSymbolType>>(region_symbol)
-				                && std::get<ATARegionState<ConstraintSymbolType>>(region_symbol).formula
-				                     == logic::MTLFormula<ConstraintSymbolType>{
-				                       mtl_ata_translation::get_sink<ConstraintSymbolType>()};
-			         })
+	// Formulas are hash-consed, so comparing against the sink is a pointer comparison.
+	const logic::MTLFormula<ConstraintSymbolType> sink{
+	  mtl_ata_translation::get_sink<ConstraintSymbolType>()};
+	return !std::all_of(std::begin(node.words), std::end(node.words), [&sink](const auto &word) {
+		return std::any_of(std::begin(word), std::end(word), [&sink](const auto &component) {
+			return std::find_if(std::begin(component),
+			                    std::end(component),
+			                    [&sink](const auto &region_symbol) {
+				                    return std::holds_alternative<ATARegionState<ConstraintSymbolType>>(
+				                             region_symbol)
+				                           && std::get<ATARegionState<ConstraintSymbolType>>(region_symbol)
+				                                  .formula
+				                                == sink;
+			                    })
 			       != std::end(component);
 		});
 	});
@@ -68,107 +93,433 @@ has_satisfiable_ata_configuration(
 
 namespace details {
 
-template <typename Location, typename ActionType, typename ConstraintSymbolType>
-void
-label_graph(SearchTreeNode<Location, ActionType, ConstraintSymbolType> *node,
-            const std::set<ActionType>                                 &controller_actions,
-            const std::set<ActionType>                                 &environment_actions,
-            std::set<SearchTreeNode<Location, ActionType, ConstraintSymbolType> *> &visited)
+/** Compute the label of a node from the labels of its children.
+ * @param node The node to compute the label for
+ * @param controller_actions The set of actions that the controller can select.
+ * @param environment_actions The set of actions that the environment can select.
+ * @param get_label A function that returns the (possibly assumed) label of a child
+ * @return The label of the node and the reason for the label
+ */
+template <typename Node, typename ActionType, typename GetLabel>
+std::pair<NodeLabel, LabelReason>
+compute_label(const Node                                  &node,
+              const std::set<ActionType>                  &controller_actions,
+              [[maybe_unused]] const std::set<ActionType> &environment_actions,
+              GetLabel                                   &&get_label)
 {
-	if (node->label != NodeLabel::UNLABELED) {
-		return;
-	}
-	if (std::find(std::begin(visited), std::end(visited), node) != std::end(visited)) {
-		// This node was already visited, meaning that we have found a loop. In a loop, there is always
-		// a monotonic domination, because monotonic domination is reflexive.
-		node->label        = NodeLabel::TOP;
-		node->label_reason = LabelReason::MONOTONIC_DOMINATION;
-		return;
+	bool        has_enviroment_step{false};
+	RegionIndex first_good_controller_step{std::numeric_limits<RegionIndex>::max()};
+	RegionIndex first_bad_environment_step{std::numeric_limits<RegionIndex>::max()};
+	for (const auto &[timed_action, child] : node.get_children()) {
+		const auto &[step, action] = timed_action;
+		if (controller_actions.find(action) != std::end(controller_actions)) {
+			assert(environment_actions.find(action) == std::end(environment_actions));
+			if (get_label(child) == NodeLabel::TOP) {
+				first_good_controller_step = std::min(first_good_controller_step, step);
+			}
+		} else {
+			assert(environment_actions.find(action) != std::end(environment_actions));
+			has_enviroment_step = true;
+			if (get_label(child) != NodeLabel::TOP) {
+				first_bad_environment_step = std::min(first_bad_environment_step, step);
+			}
+		}
 	}
-	visited.insert(node);
-	if (node->state == NodeState::GOOD) {
-		node->label_reason = LabelReason::GOOD_NODE;
-		node->set_label(NodeLabel::TOP);
-	} else if (node->state == NodeState::DEAD) {
-		node->label_reason = LabelReason::DEAD_NODE;
-		node->set_label(NodeLabel::TOP);
-	} else if (node->state == NodeState::BAD) {
-		node->label_reason = LabelReason::BAD_NODE;
-		node->set_label(NodeLabel::BOTTOM);
+	// Formally, the controller selects a subset of actions U such that
+	// (1) U is deterministic: it cannot select the same action twice with different clock resets)
+	// (2) U is non-restricting: if there is an environment action at step i, then the controller
+	// must select a controller action at step j < i or it must select the environment action (3) U
+	// is non-blocking: if there is some successor, then U must not be empty. The environment then
+	// selects exactly one element of U.
+	if (first_good_controller_step < first_bad_environment_step) {
+		// The controller can just select the good controller action.
+		return {NodeLabel::TOP, LabelReason::GOOD_CONTROLLER_ACTION_FIRST};
+	} else if (has_enviroment_step
+	           && first_bad_environment_step == std::numeric_limits<RegionIndex>::max()) {
+		// There is an environment action and no environment action is bad
+		// -> the controller can just select all environment actions
+		return {NodeLabel::TOP, LabelReason::NO_BAD_ENV_ACTION};
+	} else if (!has_enviroment_step) {
+		// All controller actions must be bad (otherwise we would be in the first case)
+		// -> no controller strategy
+		assert(first_good_controller_step == std::numeric_limits<RegionIndex>::max());
+		return {NodeLabel::BOTTOM, LabelReason::ALL_CONTROLLER_ACTIONS_BAD};
 	} else {
-		for (const auto &[action, child] : node->get_children()) {
-			if (child.get() != node) {
-				label_graph(child.get(), controller_actions, environment_actions, visited);
-			}
-		}
-		bool        has_enviroment_step{false};
-		RegionIndex first_good_controller_step{std::numeric_limits<RegionIndex>::max()};
-		RegionIndex first_bad_environment_step{std::numeric_limits<RegionIndex>::max()};
-		for (const auto &[timed_action, child] : node->get_children()) {
-			const auto &[step, action] = timed_action;
-			if (controller_actions.find(action) != std::end(controller_actions)) {
-				assert(environment_actions.find(action) == std::end(environment_actions));
-				if (child->label == NodeLabel::TOP) {
-					first_good_controller_step = std::min(first_good_controller_step, step);
-				}
-			} else {
-				assert(environment_actions.find(action) != std::end(environment_actions));
-				has_enviroment_step = true;
-				if (child->label != NodeLabel::TOP) {
-					first_bad_environment_step = std::min(first_bad_environment_step, step);
-				}
+		// There must be an environment action (otherwise case 3) and one of them must be bad
+		// (otherwise case 2).
+		assert(first_bad_environment_step < std::numeric_limits<RegionIndex>::max());
+		return {NodeLabel::BOTTOM, LabelReason::BAD_ENV_ACTION_FIRST};
+	}
+}
+
+/** The strongly connected components of the unlabeled part of a search graph. */
+template <typename Node>
+struct SearchGraphComponents
+{
+	/** The components in reverse topological order, i.e., each component comes after all
+	 * components that contain one of its children. */
+	std::vector<std::vector<Node *>> components;
+	/** The index of the component of each node. */
+	std::unordered_map<const Node *, std::size_t> component_indices;
+};
+
+/** Check whether the node is labeled by its state rather than by its children. */
+template <typename Node>
+bool
+is_labeled_by_state(const Node &node)
+{
+	return node.state == NodeState::GOOD || node.state == NodeState::DEAD
+	       || node.state == NodeState::BAD;
+}
+
+/** Compute the strongly connected components of the unlabeled nodes that are reachable from a
+ * node with an iterative version of Tarjan's algorithm. Labeled nodes and nodes that are labeled
+ * by their state are not expanded.
+ * @param root The node to start from
+ * @return The components in reverse topological order
+ */
+template <typename Node>
+SearchGraphComponents<Node>
+get_search_graph_components(Node *root)
+{
+	struct NodeInfo
+	{
+		std::size_t index;
+		std::size_t low_link;
+		bool        on_stack;
+	};
+	using ChildIterator = typename std::decay_t<decltype(root->get_children())>::const_iterator;
+
+	SearchGraphComponents<Node>                   result;
+	std::unordered_map<const Node *, NodeInfo>    infos;
+	std::vector<Node *>                           component_stack;
+	std::vector<std::pair<Node *, ChildIterator>> call_stack;
+	const auto visit = [&infos, &component_stack, &call_stack](Node *node) {
+		infos.emplace(node, NodeInfo{infos.size(), infos.size(), true});
+		component_stack.push_back(node);
+		call_stack.emplace_back(node, std::begin(node->get_children()));
+	};
+	visit(root);
+	while (!call_stack.empty()) {
+		auto &[node, child_it] = call_stack.back();
+		auto &info             = infos.at(node);
+		if (!is_labeled_by_state(*node) && child_it != std::end(node->get_children())) {
+			Node *child = (child_it++)->second;
+			if (child->label != NodeLabel::UNLABELED) {
+				continue;
 			}
+			if (const auto child_info = infos.find(child); child_info == std::end(infos)) {
+				visit(child);
+			} else if (child_info->second.on_stack) {
+				info.low_link = std::min(info.low_link, child_info->second.index);
+			}
+			continue;
+		}
+		// All children are visited.
+		Node *const       finished_node = node;
+		const std::size_t low_link      = info.low_link;
+		if (low_link == info.index) {
+			auto &component = result.components.emplace_back();
+			Node *member    = nullptr;
+			do {
+				member = component_stack.back();
+				component_stack.pop_back();
+				infos.at(member).on_stack = false;
+				result.component_indices[member] = result.components.size() - 1;
+				component.push_back(member);
+			} while (member != finished_node);
+		}
+		call_stack.pop_back();
+		if (!call_stack.empty()) {
+			auto &parent_info    = infos.at(call_stack.back().first);
+			parent_info.low_link = std::min(parent_info.low_link, low_link);
 		}
-		// Formally, the controller selects a subset of actions U such that
-		// (1) U is deterministic: it cannot select the same action twice with different clock resets)
-		// (2) U is non-restricting: if there is an environment action at step i, then the controller
-		// must select a controller action at step j < i or it must select the environment action (3) U
-		// is non-blocking: if there is some successor, then U must not be empty. The environment then
-		// selects exactly one element of U.
-		if (first_good_controller_step < first_bad_environment_step) {
-			// The controller can just select the good controller action.
-			node->label_reason = LabelReason::GOOD_CONTROLLER_ACTION_FIRST;
+	}
+	return result;
+}
+
+/** Label the nodes of a strongly connected component, assuming that all nodes of the components
+ * that contain their children are already labeled.
+ *
+ * Within a component, the nodes are labeled with the greatest fixpoint: Every node is assumed to
+ * be labeled TOP, because staying in a loop forever is a monotonic domination. A node is labeled
+ * BOTTOM as soon as its children force it to be BOTTOM, which may in turn force its parents
+ * within the component to be BOTTOM.
+ * @param graph The components of the search graph
+ * @param component_index The index of the component to label
+ * @param controller_actions The set of actions that the controller can select.
+ * @param environment_actions The set of actions that the environment can select.
+ */
+template <typename Node, typename ActionType>
+void
+label_component(const SearchGraphComponents<Node> &graph,
+                std::size_t                        component_index,
+                const std::set<ActionType>        &controller_actions,
+                const std::set<ActionType>        &environment_actions)
+{
+	const auto &component = graph.components[component_index];
+	if (component.size() == 1 && is_labeled_by_state(*component.front())) {
+		Node *node = component.front();
+		if (node->state == NodeState::GOOD) {
+			node->label_reason = LabelReason::GOOD_NODE;
 			node->set_label(NodeLabel::TOP);
-		} else if (has_enviroment_step
-		           && first_bad_environment_step == std::numeric_limits<RegionIndex>::max()) {
-			// There is an environment action and no environment action is bad
-			// -> the controller can just select all environment actions
-			node->label_reason = LabelReason::NO_BAD_ENV_ACTION;
+		} else if (node->state == NodeState::DEAD) {
+			node->label_reason = LabelReason::DEAD_NODE;
 			node->set_label(NodeLabel::TOP);
-		} else if (!has_enviroment_step) {
-			// All controller actions must be bad (otherwise we would be in the first case)
-			// -> no controller strategy
-			assert(first_good_controller_step == std::numeric_limits<RegionIndex>::max());
-			node->label_reason = LabelReason::ALL_CONTROLLER_ACTIONS_BAD;
-			node->set_label(NodeLabel::BOTTOM);
 		} else {
-			// There must be an environment action (otherwise case 3) and one of them must be bad
-			// (otherwise case 2).
-			assert(first_bad_environment_step < std::numeric_limits<RegionIndex>::max());
-			node->label_reason = LabelReason::BAD_ENV_ACTION_FIRST;
+			node->label_reason = LabelReason::BAD_NODE;
 			node->set_label(NodeLabel::BOTTOM);
 		}
+		return;
+	}
+	const auto is_in_component = [&graph, component_index](const Node *node) {
+		const auto index = graph.component_indices.find(node);
+		return index != std::end(graph.component_indices) && index->second == component_index;
+	};
+	std::unordered_map<const Node *, std::pair<NodeLabel, LabelReason>> labels;
+	for (const auto *node : component) {
+		labels[node] = {NodeLabel::TOP, LabelReason::MONOTONIC_DOMINATION};
+	}
+	const auto get_label = [&labels, &is_in_component](const Node *child) -> NodeLabel {
+		if (is_in_component(child)) {
+			return labels.at(child).first;
+		}
+		return child->label;
+	};
+	std::vector<const Node *> worklist(std::begin(component), std::end(component));
+	while (!worklist.empty()) {
+		const Node *node = worklist.back();
+		worklist.pop_back();
+		auto &label = labels.at(node);
+		if (label.first == NodeLabel::BOTTOM) {
+			continue;
+		}
+		label = compute_label(*node, controller_actions, environment_actions, get_label);
+		if (label.first == NodeLabel::BOTTOM) {
+			for (const auto *parent : node->parents) {
+				if (is_in_component(parent)) {
+					worklist.push_back(parent);
+				}
+			}
+		}
+	}
+	for (auto *node : component) {
+		const auto &[label, reason] = labels.at(node);
+		node->label_reason          = reason;
+		node->set_label(label);
+	}
+}
+
+/** Label the components of a search graph concurrently. A component is labeled as soon as all
+ * components that contain one of its children are labeled.
+ * @param graph The components of the search graph
+ * @param controller_actions The set of actions that the controller can select.
+ * @param environment_actions The set of actions that the environment can select.
+ * @param num_threads The number of threads to use
+ */
+template <typename Node, typename ActionType>
+void
+label_components_concurrently(const SearchGraphComponents<Node> &graph,
+                              const std::set<ActionType>        &controller_actions,
+                              const std::set<ActionType>        &environment_actions,
+                              std::size_t                        num_threads)
+{
+	const std::size_t                     num_components = graph.components.size();
+	std::vector<std::vector<std::size_t>> dependent_components(num_components);
+	std::vector<std::atomic_size_t>       num_unlabeled_children(num_components);
+	for (std::size_t index = 0; index < num_components; ++index) {
+		for (const auto *node : graph.components[index]) {
+			if (is_labeled_by_state(*node)) {
+				// The node's label does not depend on its children.
+				continue;
+			}
+			for (const auto &[timed_action, child] : node->get_children()) {
+				const auto child_index = graph.component_indices.find(child);
+				if (child_index != std::end(graph.component_indices) && child_index->second != index) {
+					++num_unlabeled_children[index];
+					dependent_components[child_index->second].push_back(index);
+				}
+			}
+		}
+	}
+	std::mutex               mutex;
+	std::condition_variable  ready_cv;
+	std::vector<std::size_t> ready_components;
+	std::size_t              num_remaining_components = num_components;
+	for (std::size_t index = 0; index < num_components; ++index) {
+		if (num_unlabeled_children[index] == 0) {
+			ready_components.push_back(index);
+		}
+	}
+	const auto worker = [&]() {
+		std::unique_lock lock{mutex};
+		while (true) {
+			ready_cv.wait(lock, [&] {
+				return !ready_components.empty() || num_remaining_components == 0;
+			});
+			if (ready_components.empty()) {
+				return;
+			}
+			const std::size_t index = ready_components.back();
+			ready_components.pop_back();
+			lock.unlock();
+			label_component(graph, index, controller_actions, environment_actions);
+			std::vector<std::size_t> new_ready_components;
+			for (const auto dependent : dependent_components[index]) {
+				if (--num_unlabeled_children[dependent] == 0) {
+					new_ready_components.push_back(dependent);
+				}
+			}
+			lock.lock();
+			--num_remaining_components;
+			ready_components.insert(std::end(ready_components),
+			                        std::begin(new_ready_components),
+			                        std::end(new_ready_components));
+			ready_cv.notify_all();
+		}
+	};
+	std::vector<std::thread> threads;
+	for (std::size_t i = 0; i < num_threads; ++i) {
+		threads.emplace_back(worker);
+	}
+	for (auto &thread : threads) {
+		thread.join();
 	}
 }
+
+/** @brief A gate for jobs that run concurrently, unless an exclusive operation pauses them.
+ *
+ * Each job locks the gate while it runs. Any number of jobs may hold the gate at the same time.
+ * An exclusive operation closes the gate, waits until all running jobs have unlocked it, and
+ * reopens the gate when it is done. Jobs that try to lock a closed gate wait until it is reopened.
+ * In contrast to a std::shared_mutex, a waiting exclusive operation is never starved by jobs.
+ */
+class PauseGate
+{
+public:
+	/** Wait until the gate is open and enter it. */
+	void
+	lock()
+	{
+		std::unique_lock lock{mutex_};
+		open_cv_.wait(lock, [this] { return !is_paused_; });
+		++num_active_;
+	}
+
+	/** Leave the gate. */
+	void
+	unlock()
+	{
+		std::lock_guard lock{mutex_};
+		if (--num_active_ == 0) {
+			idle_cv_.notify_all();
+		}
+	}
+
+	/** Run a function while no job holds the gate.
+	 * The calling thread must not hold the gate itself. If another thread is already running an
+	 * exclusive operation, the function is not run.
+	 * @param function The function to run exclusively
+	 * @return true if the function was run
+	 */
+	template <typename Function>
+	bool
+	run_exclusively(Function &&function)
+	{
+		{
+			std::unique_lock lock{mutex_};
+			if (is_paused_) {
+				return false;
+			}
+			is_paused_ = true;
+			idle_cv_.wait(lock, [this] { return num_active_ == 0; });
+		}
+		function();
+		{
+			std::lock_guard lock{mutex_};
+			is_paused_ = false;
+		}
+		open_cv_.notify_all();
+		return true;
+	}
+
+private:
+	std::mutex              mutex_;
+	std::condition_variable open_cv_;
+	std::condition_variable idle_cv_;
+	bool                    is_paused_{false};
+	std::size_t             num_active_{0};
+};
+
 } // namespace details
 
 /** Label the search graph.
  *
- * Traverse the search graph and label it bottom-up.
+ * Label the search graph bottom-up, starting with the strongly connected components that do not
+ * have any unlabeled children. Nodes in loops are labeled with the greatest fixpoint, i.e., a loop
+ * is considered good for the controller unless the environment can force leaving it to a bad
+ * node. Nodes that are already labeled keep their label.
  * @param node The node to start the traversal from, usually the root of the search graph.
  * @param controller_actions The set of actions that the controller can select.
  * @param environment_actions The set of actions that the environment can select.
+ * @param num_threads The number of threads to use to label independent components concurrently.
+ * If 0, use as many threads as there are hardware threads.
  */
 template <typename Location, typename ActionType, typename ConstraintSymbolType>
 void
 label_graph(SearchTreeNode<Location, ActionType, ConstraintSymbolType> *node,
             const std::set<ActionType>                                 &controller_actions,
-            const std::set<ActionType>                                 &environment_actions)
+            const std::set<ActionType>                                 &environment_actions,
+            std::size_t                                                 num_threads = 1)
 {
-	std::set<SearchTreeNode<Location, ActionType, ConstraintSymbolType> *> visited;
-	return details::label_graph(node, controller_actions, environment_actions, visited);
+	if (node->label != NodeLabel::UNLABELED) {
+		return;
+	}
+	const auto graph = details::get_search_graph_components(node);
+	if (num_threads == 0) {
+		num_threads = std::max(1U, std::thread::hardware_concurrency());
+	}
+	if (num_threads == 1 || graph.components.size() == 1) {
+		for (std::size_t index = 0; index < graph.components.size(); ++index) {
+			details::label_component(graph, index, controller_actions, environment_actions);
+		}
+	} else {
+		details::label_components_concurrently(graph,
+		                                       controller_actions,
+		                                       environment_actions,
+		                                       num_threads);
+	}
 }
 
+/** Statistics about releasing the words of settled search nodes.
+ * @see TreeSearch::set_memory_budget
+ */
+struct MemoryStatistics
+{
+	/** The resident memory of the process when it was last checked, in bytes. */
+	std::size_t resident_memory{0};
+	/** The number of times that the words of settled nodes were released. */
+	std::size_t num_releases{0};
+	/** The number of nodes whose words have been released. */
+	std::size_t num_released_nodes{0};
+	/** The estimated memory in bytes that was reclaimed by releasing the words of the nodes and by
+	 * compacting the interned words. */
+	std::size_t released_memory{0};
+};
+
+/** The durations of a search, measured from the start of TreeSearch::build_tree. */
+struct SearchTimes
+{
+	/** The time until the root had a final label (TOP or BOTTOM), if it was labeled during the
+	 * search. This requires incremental labeling. */
+	std::optional<std::chrono::duration<double>> time_to_verdict;
+	/** The time until the search was complete, i.e., until all nodes were expanded or the search
+	 * was stopped. */
+	std::chrono::duration<double> time_to_exhaustion{0};
+	/** Whether the search was stopped as soon as the root was labeled. */
+	bool stopped_at_verdict{false};
+};
+
 /** @brief Search the configuration tree for a valid controller.
  *
  * This class implements the main algorithm to check the existence of a controller. It builds a
@@ -195,6 +546,12 @@ public:
 	    std::void_t<void>>::type;
 	/** The corresponding Node type of this search. */
 	using Node = SearchTreeNode<Location, ActionType, ConstraintSymbolType>;
+	/** The map of all search nodes, keyed by the interned word set of each node. */
+	using NodeMap = utilities::ShardedHashMap<WordSetKey, Node *, WordSetKeyHash>;
+	/** The type of a snapshot of this search. */
+	using Snapshot = SearchSnapshot<Location, ActionType, ConstraintSymbolType>;
+	/** The default number of node expansions between two checks of the resident memory. */
+	static constexpr std::size_t default_memory_check_interval = 1024;
 
 	/** Initialize the search.
 	 * @param ta The plant to be controlled
@@ -247,18 +604,32 @@ public:
 				  get_canonical_word(ta->get_initial_configuration(), ata_configuration, K));
 			}
 
-			tree_root_ = std::make_shared<Node>(initial_words);
+			tree_root_ = node_arena_.create(initial_words);
 		} else {
-			tree_root_ = std::make_shared<Node>(
+			tree_root_ = node_arena_.create(
 			  std::set<CanonicalABWord<typename Plant::Location, ConstraintSymbolType>>{
 			    get_canonical_word(ta->get_initial_configuration(),
 			                       ata->get_initial_configuration(),
 			                       K)});
 		}
-		nodes_                                  = {{{}, tree_root_}};
+		nodes_.get_or_insert(WordSetKey{}, [this] { return tree_root_; });
 		heuristic                               = std::move(search_heuristic);
 		tree_root_->min_total_region_increments = 0;
-		add_node_to_queue(tree_root_.get());
+		if (heuristic->has_dense_integer_costs()) {
+			pool_.set_queue_type(utilities::QueueType::BUCKET_QUEUE);
+		}
+		pool_.set_obsolete_job_check([this](const ExpansionJob &job) {
+			return is_stopped_at_verdict() || is_obsolete_queue_entry(job.node);
+		});
+		add_node_to_queue(tree_root_);
+	}
+
+	/** Wait until the last snapshot has been handled. */
+	~TreeSearch()
+	{
+		if (snapshot_writer_.joinable()) {
+			snapshot_writer_.join();
+		}
 	}
 
 	/** Get the root of the search tree.
@@ -268,7 +639,7 @@ public:
 	Node *
 	get_root() const
 	{
-		return tree_root_.get();
+		return tree_root_;
 	}
 
 	/** Check if a node is bad, i.e., if it violates the specification.
@@ -286,26 +657,48 @@ public:
 	}
 
 	/** Add a node the processing queue. This adds a new task to the thread pool that expands the
-	 * node asynchronously.
+	 * node asynchronously. If the node is already queued, it is not added a second time.
 	 * @param node The node to expand */
 	void
 	add_node_to_queue(Node *node)
 	{
-		pool_.add_job([this, node] { expand_node(node); }, -heuristic->compute_cost(node));
+		if (is_stopped_at_verdict() || node->is_queued.exchange(true)) {
+			return;
+		}
+		pool_.add_job(ExpansionJob{this, node}, -heuristic->compute_cost(node));
 	}
 
 	/** Build the complete search tree by expanding nodes recursively.
 	 * @param multi_threaded If set to true, run the thread pool. Otherwise, process the jobs
-	 * synchronously with a single thread. */
+	 * synchronously with a single thread.
+	 * @param num_threads The number of threads to use if multi_threaded is true. If 0, use as many
+	 * threads as there are hardware threads.
+	 * @param scheduling_mode The frontier policy, i.e., how the thread pool orders the node
+	 * expansions and distributes them to its workers */
 	void
-	build_tree(bool multi_threaded = true)
+	build_tree(bool                      multi_threaded  = true,
+	           std::size_t               num_threads     = 0,
+	           utilities::SchedulingMode scheduling_mode = utilities::SchedulingMode::GLOBAL_QUEUE)
 	{
+		build_start_        = std::chrono::steady_clock::now();
+		next_snapshot_time_ = build_start_ + snapshot_interval_;
+		// The root may already be labeled if the search has been restored from a snapshot.
+		check_verdict();
 		if (multi_threaded) {
-			pool_.start();
+			pool_.set_scheduling_mode(scheduling_mode);
+			if (num_threads == 0) {
+				pool_.start();
+			} else {
+				pool_.start(num_threads);
+			}
 			pool_.wait();
 		} else {
 			while (step()) {}
 		}
+		time_to_exhaustion_ = std::chrono::steady_clock::now() - build_start_;
+		if (snapshot_writer_.joinable()) {
+			snapshot_writer_.join();
+		}
 	}
 
 	/** Compute the next iteration by taking the first item of the queue and expanding it.
@@ -329,6 +722,21 @@ public:
 	void
 	expand_node(Node *node)
 	{
+		std::unique_lock<details::PauseGate> expansion_lock{expansion_gate_, std::defer_lock};
+		if (memory_budget_ > 0 || snapshot_handler_) {
+			// Release the words and take snapshots before entering the gate, as both wait for all
+			// running expansions.
+			if (memory_budget_ > 0) {
+				release_words_if_over_budget();
+			}
+			if (snapshot_handler_) {
+				take_snapshot_if_due();
+			}
+			expansion_lock.lock();
+		}
+		// Clear the flag before checking the label, so a concurrent reset_label() either sees the
+		// node as not queued and re-adds it, or we see the reset label.
+		node->is_queued = false;
 		if (node->label != NodeLabel::UNLABELED) {
 			// The node was already labeled, nothing to do.
 			return;
@@ -345,9 +753,10 @@ public:
 			node->state        = NodeState::BAD;
 			node->is_expanded  = true;
 			node->is_expanding = false;
+			add_to_antichain(node, NodeLabel::BOTTOM);
 			if (incremental_labeling_) {
 				node->set_label(NodeLabel::BOTTOM, terminate_early_);
-				node->label_propagate(controller_actions_, environment_actions_, terminate_early_);
+				propagate_label(node);
 			}
 			return;
 		}
@@ -356,20 +765,42 @@ public:
 			node->state        = NodeState::GOOD;
 			node->is_expanded  = true;
 			node->is_expanding = false;
+			add_to_antichain(node, NodeLabel::TOP);
 			if (incremental_labeling_) {
 				node->set_label(NodeLabel::TOP, terminate_early_);
-				node->label_propagate(controller_actions_, environment_actions_, terminate_early_);
+				propagate_label(node);
 			}
 			return;
 		}
-		if (dominates_ancestor(node)) {
-			node->label_reason = LabelReason::MONOTONIC_DOMINATION;
-			node->state        = NodeState::GOOD;
+		DominationStatistics domination_statistics;
+		const bool           dominates = dominates_ancestor(node, &domination_statistics);
+		num_domination_ancestors_ += domination_statistics.num_ancestors;
+		num_domination_signature_rejections_ += domination_statistics.num_signature_rejections;
+		num_domination_exact_checks_ += domination_statistics.num_exact_checks;
+		num_dominations_ += domination_statistics.num_dominations;
+		if (dominates) {
+			// The label only holds on the path through the dominated ancestor, so it is not stored in the
+			// antichain.
+			node->label_reason             = LabelReason::MONOTONIC_DOMINATION;
+			node->state                    = NodeState::GOOD;
+			node->has_path_dependent_label = true;
+			node->is_expanded              = true;
+			node->is_expanding             = false;
+			if (incremental_labeling_) {
+				node->set_label(NodeLabel::TOP, terminate_early_);
+				propagate_label(node);
+			}
+			return;
+		}
+		if (const NodeLabel label = find_antichain_label(*node); label != NodeLabel::UNLABELED) {
+			// The node is dominated by a TOP node or dominates a BOTTOM node somewhere else in the graph.
+			// Its state is still unknown, so it is labeled directly, even without incremental labeling.
+			node->label_reason = LabelReason::ANTICHAIN_DOMINATION;
 			node->is_expanded  = true;
 			node->is_expanding = false;
+			node->set_label(label, terminate_early_);
 			if (incremental_labeling_) {
-				node->set_label(NodeLabel::TOP, terminate_early_);
-				node->label_propagate(controller_actions_, environment_actions_, terminate_early_);
+				propagate_label(node);
 			}
 			return;
 		}
@@ -399,10 +830,12 @@ public:
 		if (incremental_labeling_ && !existing_children.empty()) {
 			// There is an existing child, directly check the labeling.
 			SPDLOG_TRACE("Node {} has existing child, updating labels", node_to_string(*node, false));
-			node->label_propagate(controller_actions_, environment_actions_, terminate_early_);
+			propagate_label(node);
 		}
 		for (const auto &child : new_children) {
-			add_node_to_queue(child);
+			if (!assign_node_ || assign_node_(child)) {
+				add_node_to_queue(child);
+			}
 		}
 		SPDLOG_TRACE("Node has {} children, {} of them new",
 		             node->get_children().size(),
@@ -410,23 +843,26 @@ public:
 		if (node->get_children().empty()) {
 			node->label_reason = LabelReason::DEAD_NODE;
 			node->state        = NodeState::DEAD;
+			add_to_antichain(node, NodeLabel::TOP);
 			if (incremental_labeling_) {
 				node->set_label(NodeLabel::TOP, terminate_early_);
-				node->label_propagate(controller_actions_, environment_actions_, terminate_early_);
+				propagate_label(node);
 			}
 		}
 	}
 
 	/** Compute the final tree labels.
 	 * @param node The node to start the labeling at (e.g., the root of the tree)
+	 * @param num_threads The number of threads to use. If 0, use as many threads as there are
+	 * hardware threads.
 	 */
 	void
-	label(Node *node = nullptr)
+	label(Node *node = nullptr, std::size_t num_threads = 1)
 	{
 		if (node == nullptr) {
 			node = get_root();
 		}
-		return label_graph(node, controller_actions_, environment_actions_);
+		return label_graph(node, controller_actions_, environment_actions_, num_threads);
 	}
 
 	/** Get the size of the search graph.
@@ -435,18 +871,682 @@ public:
 	size_t
 	get_size() const
 	{
-		std::lock_guard lock{nodes_mutex_};
 		return nodes_.size();
 	}
 
+	/** Set the data structure of the search frontier.
+	 * By default, a bucket queue is used if the heuristic has dense integer costs, and a binary heap
+	 * otherwise. This must be called before the tree is built.
+	 * @param type The type of the queue
+	 */
+	void
+	set_frontier_queue_type(utilities::QueueType type)
+	{
+		pool_.set_queue_type(type);
+	}
+
+	/** Enable or disable antichain pruning.
+	 * If enabled, all nodes with a known label are kept in an AntichainStore. A node that is
+	 * monotonically dominated by a TOP node or that monotonically dominates a BOTTOM node anywhere in
+	 * the search graph is then labeled without expanding it. This must be called before the tree is
+	 * built.
+	 * @param enable true to enable antichain pruning
+	 */
+	void
+	set_antichain_pruning(bool enable)
+	{
+		antichain_pruning_ = enable;
+	}
+
+	/** Limit the memory of the search by releasing the words of settled nodes.
+	 * If the resident memory of the process exceeds the budget, the words of all nodes with a final
+	 * label (TOP or BOTTOM) are released. Each released node only keeps pointers to the interned
+	 * copies of its words, which the search keeps anyway for deduplication, and those interned copies
+	 * are compacted into packed words. Domination checks compare the packed words directly, the full
+	 * words are only restored when they are needed, e.g., when the controller is created. Node
+	 * expansions are paused while the words are released. This must be called before the tree is
+	 * built.
+	 * @param budget The maximal resident memory of the process in bytes, 0 for no limit
+	 * @param check_interval The number of node expansions between two checks of the resident memory
+	 */
+	void
+	set_memory_budget(std::size_t budget,
+	                  std::size_t check_interval = default_memory_check_interval)
+	{
+		assert(check_interval > 0);
+		memory_budget_         = budget;
+		memory_check_interval_ = check_interval;
+	}
+
+	/** Get the statistics about releasing the words of settled nodes.
+	 * @see set_memory_budget
+	 */
+	MemoryStatistics
+	get_memory_statistics() const
+	{
+		MemoryStatistics statistics;
+		statistics.resident_memory    = resident_memory_;
+		statistics.num_releases       = num_word_releases_;
+		statistics.num_released_nodes = num_released_nodes_;
+		statistics.released_memory    = released_word_memory_;
+		return statistics;
+	}
+
+	/** Stop the search as soon as the root has a final label.
+	 * With incremental labeling, the root may be labeled TOP or BOTTOM long before all nodes have
+	 * been expanded. If enabled, all queued node expansions are dropped as soon as the root is
+	 * labeled, and no new nodes are queued. The remaining nodes stay unexpanded and unlabeled, which
+	 * does not affect the controller, as it only consists of nodes that are labeled TOP.
+	 * @param enable true to stop the search when the root is labeled
+	 */
+	void
+	set_stop_on_verdict(bool enable)
+	{
+		stop_on_verdict_ = enable;
+	}
+
+	/** Get the durations of the search, only valid after the tree has been built. */
+	SearchTimes
+	get_search_times() const
+	{
+		SearchTimes times;
+		times.time_to_verdict    = time_to_verdict_;
+		times.time_to_exhaustion = time_to_exhaustion_;
+		times.stopped_at_verdict = is_stopped_at_verdict();
+		return times;
+	}
+
+	/** Take snapshots of the search state periodically while the tree is built.
+	 * Each snapshot is passed to the handler on a separate thread, e.g., to write it to a file, so
+	 * handling the snapshot does not stall the node expansions. The expansions are only paused while
+	 * the search graph is captured, the words of the snapshot are copied afterwards by the separate
+	 * thread. If the previous snapshot is still being handled when the next one is due, the next one
+	 * is delayed. This must be called before the tree is built.
+	 * @param interval The minimal time between two snapshots
+	 * @param handler The function that is called with each snapshot
+	 */
+	void
+	set_snapshot_handler(std::chrono::duration<double>    interval,
+	                     std::function<void(Snapshot &&)> handler)
+	{
+		snapshot_interval_ = std::chrono::duration_cast<std::chrono::steady_clock::duration>(interval);
+		snapshot_handler_  = std::move(handler);
+	}
+
+	/** Capture the current state of the search.
+	 * This must not be called while the tree is being built, use set_snapshot_handler instead.
+	 * @return A snapshot from which the search can be resumed
+	 */
+	Snapshot
+	create_snapshot()
+	{
+		auto pending = capture_snapshot();
+		copy_snapshot_words(pending);
+		return std::move(pending.snapshot);
+	}
+
+	/** Restore the state of the search from a snapshot, e.g., to resume a search that has been
+	 * interrupted. The search must have been initialized with the same plant, specification, actions,
+	 * and maximal constant as the search that created the snapshot. Only the maximal constant and
+	 * the root are compared, a snapshot of a different problem with the same initial node is not
+	 * detected. The state of the heuristic is not part of the snapshot, the queued nodes keep the
+	 * priorities from the snapshot. This must be called before the tree is built.
+	 * @param snapshot The snapshot to restore
+	 * @throw std::invalid_argument if the snapshot does not belong to this search problem or is
+	 * malformed
+	 */
+	void
+	restore_snapshot(const Snapshot &snapshot)
+	{
+		if (get_size() != 1 || tree_root_->is_expanded) {
+			throw std::logic_error("Cannot restore a snapshot after the search has started");
+		}
+		if (snapshot.nodes.empty() || snapshot.K != K_) {
+			throw std::invalid_argument(
+			  fmt::format("Snapshot with K={} does not match the search with K={}", snapshot.K, K_));
+		}
+		for (const auto &node_snapshot : snapshot.nodes) {
+			for (const std::size_t word : node_snapshot.words) {
+				if (word >= snapshot.words.size()) {
+					throw std::invalid_argument(fmt::format("Invalid word {} in snapshot", word));
+				}
+			}
+			for (const auto &edge : node_snapshot.children) {
+				if (edge.child >= snapshot.nodes.size()) {
+					throw std::invalid_argument(fmt::format("Invalid child {} in snapshot", edge.child));
+				}
+			}
+		}
+		for (const auto &entry : snapshot.frontier) {
+			if (entry.node >= snapshot.nodes.size()) {
+				throw std::invalid_argument(
+				  fmt::format("Invalid frontier node {} in snapshot", entry.node));
+			}
+		}
+		const auto get_words = [&snapshot](const typename Snapshot::Node &node_snapshot) {
+			std::set<typename Node::Word> words;
+			for (const std::size_t word : node_snapshot.words) {
+				words.insert(snapshot.words[word]);
+			}
+			return words;
+		};
+		if (get_words(snapshot.nodes.front()) != tree_root_->words) {
+			throw std::invalid_argument("The root of the snapshot does not match the initial node");
+		}
+		// The frontier of the snapshot replaces the queued root.
+		for (utilities::QueueAccess queue_access{&pool_}; !queue_access.empty(); queue_access.pop()) {}
+		tree_root_->is_queued = false;
+
+		std::vector<Node *> nodes{tree_root_};
+		nodes.reserve(snapshot.nodes.size());
+		for (auto node_snapshot = std::next(std::begin(snapshot.nodes));
+		     node_snapshot != std::end(snapshot.nodes);
+		     ++node_snapshot) {
+			auto words                = get_words(*node_snapshot);
+			const auto [node, is_new] = nodes_.get_or_insert(words_.intern(words), [this, &words] {
+				return node_arena_.create(std::move(words));
+			});
+			if (!is_new) {
+				throw std::invalid_argument("The snapshot contains the same node twice");
+			}
+			nodes.push_back(node);
+		}
+		for (std::size_t index = 0; index < nodes.size(); ++index) {
+			for (const auto &edge : snapshot.nodes[index].children) {
+				nodes[index]->add_child({edge.increment, edge.action}, nodes[edge.child]);
+			}
+		}
+		// Assign the fields only after all edges have been added, as adding an edge updates the
+		// minimal total region increments of the child, which may differ from the stored value if the
+		// increments of the parent decreased after the child had been added.
+		for (std::size_t index = 0; index < nodes.size(); ++index) {
+			const auto &node_snapshot         = snapshot.nodes[index];
+			Node       *node                  = nodes[index];
+			node->state                       = node_snapshot.state;
+			node->label                       = node_snapshot.label;
+			node->label_reason                = node_snapshot.label_reason;
+			node->is_expanded                 = node_snapshot.is_expanded;
+			node->min_total_region_increments = node_snapshot.min_total_region_increments;
+			if (const NodeLabel label = node->label;
+			    label == NodeLabel::TOP || label == NodeLabel::BOTTOM) {
+				// The snapshot does not record whether a label depends on the path to the node, so only
+				// labels that follow from the node itself are reused for other nodes.
+				const LabelReason reason = node->label_reason;
+				node->has_path_dependent_label =
+				  reason != LabelReason::BAD_NODE && reason != LabelReason::DEAD_NODE
+				  && reason != LabelReason::NO_ATA_SUCCESSOR && reason != LabelReason::ANTICHAIN_DOMINATION;
+				add_to_antichain(node, label);
+			}
+		}
+		for (const auto &entry : snapshot.frontier) {
+			Node *node = nodes[entry.node];
+			if (node->label == NodeLabel::UNLABELED && !node->is_queued.exchange(true)) {
+				pool_.add_job(ExpansionJob{this, node}, entry.priority);
+			}
+		}
+	}
+
+	/** Check whether the search can be restricted to a partition with set_partition, i.e., whether
+	 * it uses incremental labeling without canceling children. */
+	bool
+	can_be_partitioned() const
+	{
+		return incremental_labeling_ && !terminate_early_;
+	}
+
+	/** @brief Restrict the search to a partition of the search graph, e.g., to distribute the
+	 * search over multiple processes.
+	 *
+	 * Each new node is assigned to a partition with the given function, starting with the root when
+	 * this is called. Only the nodes of this partition are expanded. The other nodes stay unexpanded
+	 * until their label is known from their own partition, which is then passed to
+	 * label_remote_node. Nodes that another partition found for this partition are added with
+	 * insert_node. As the nodes of other partitions are not expanded, the search must use
+	 * incremental labeling and must not cancel children. The search must be run with step(). This
+	 * must be called before the tree is built.
+	 * @param assign_node Called with each new node, returns true if the node belongs to this
+	 * partition
+	 * @param on_labeled Called with each node whose label is propagated to its parents
+	 * @throw std::logic_error if the search does not use incremental labeling or cancels children
+	 * @see can_be_partitioned
+	 */
+	void
+	set_partition(std::function<bool(Node *)> assign_node, std::function<void(Node *)> on_labeled)
+	{
+		if (!can_be_partitioned()) {
+			throw std::logic_error(
+			  "A partitioned search requires incremental labeling without canceling children");
+		}
+		assign_node_ = std::move(assign_node);
+		on_labeled_  = std::move(on_labeled);
+		if (!assign_node_(tree_root_)) {
+			for (utilities::QueueAccess queue_access{&pool_}; !queue_access.empty();
+			     queue_access.pop()) {}
+			tree_root_->is_queued = false;
+		}
+	}
+
+	/** Add a node that another partition has found and that belongs to this partition. If the node
+	 * is new, it is queued for expansion.
+	 * @param words The words of the node
+	 * @param min_total_region_increments The minimal total time to reach the node in the other
+	 * partition
+	 * @return The node with the given words
+	 * @see set_partition
+	 */
+	Node *
+	insert_node(std::set<typename Node::Word> words, RegionIndex min_total_region_increments)
+	{
+		const auto key            = words_.intern(words);
+		const auto [node, is_new] = nodes_.get_or_insert(key, [this, &words] {
+			return node_arena_.create(std::move(words));
+		});
+		node->min_total_region_increments =
+		  std::min(node->min_total_region_increments, min_total_region_increments);
+		if (is_new) {
+			add_node_to_queue(node);
+		}
+		return node;
+	}
+
+	/** Label a node of another partition and propagate the label to its parents.
+	 * @param node The node, which has not been expanded by this search
+	 * @param label The label of the node in its own partition
+	 * @param reason The reason for the label
+	 * @see set_partition
+	 */
+	void
+	label_remote_node(Node *node, NodeLabel label, LabelReason reason)
+	{
+		if (node->label != NodeLabel::UNLABELED) {
+			return;
+		}
+		// The label may depend on the path to the node in the other partition.
+		node->label_reason             = reason;
+		node->has_path_dependent_label = true;
+		node->is_expanded              = true;
+		node->set_label(label);
+		propagate_label(node);
+	}
+
+	/** Get the actions that the controller may decide to take. */
+	const std::set<ActionType> &
+	get_controller_actions() const
+	{
+		return controller_actions_;
+	}
+
+	/** Get the actions controlled by the environment. */
+	const std::set<ActionType> &
+	get_environment_actions() const
+	{
+		return environment_actions_;
+	}
+
+	/** Get the cache of time successor chains.
+	 * The cache can be passed to controller_synthesis::create_controller to reuse the chains that
+	 * were computed during the search.
+	 */
+	TimeSuccessorCache<Location, ConstraintSymbolType> &
+	get_time_successor_cache()
+	{
+		return time_successor_cache_;
+	}
+
+	/** Set the memory budget of the cache of symbol successors.
+	 * @param budget The maximal (estimated) memory of the cached successors in bytes
+	 */
+	void
+	set_successor_cache_budget(std::size_t budget)
+	{
+		successor_cache_.set_budget(budget);
+	}
+
+	/** Get the statistics of the cache of symbol successors. */
+	utilities::CacheStatistics
+	get_successor_cache_statistics() const
+	{
+		return successor_cache_.get_statistics();
+	}
+
+	/** Get the statistics of the antichain store. */
+	AntichainStatistics
+	get_antichain_statistics() const
+	{
+		return antichain_store_.get_statistics();
+	}
+
+	/** Get the rank error statistics of the search frontier.
+	 * The statistics are only available if the tree has been built with
+	 * utilities::SchedulingMode::MULTI_QUEUE.
+	 */
+	utilities::RankErrorStatistics
+	get_rank_error_statistics() const
+	{
+		return pool_.get_rank_error_statistics();
+	}
+
+	/** Get the statistics about queued node expansions that were dropped because the node had been
+	 * labeled or canceled in the meantime. */
+	utilities::ObsoleteJobStatistics
+	get_frontier_statistics() const
+	{
+		return pool_.get_obsolete_job_statistics();
+	}
+
+	/** Get the statistics about the ancestor domination checks so far. */
+	DominationStatistics
+	get_domination_statistics() const
+	{
+		DominationStatistics statistics;
+		statistics.num_ancestors            = num_domination_ancestors_;
+		statistics.num_signature_rejections = num_domination_signature_rejections_;
+		statistics.num_exact_checks         = num_domination_exact_checks_;
+		statistics.num_dominations          = num_dominations_;
+		return statistics;
+	}
+
 	/** Get the current search nodes. */
-	const std::map<std::set<CanonicalABWord<Location, ConstraintSymbolType>>, std::shared_ptr<Node>> &
+	const NodeMap &
 	get_nodes()
 	{
 		return nodes_;
 	}
 
 private:
+	/** A queued expansion of a single node. */
+	struct ExpansionJob
+	{
+		TreeSearch *search;
+		Node       *node;
+
+		void
+		operator()() const
+		{
+			search->expand_node(node);
+			search->check_verdict();
+		}
+	};
+
+	/** Propagate the label of a node to its parents and report the labeled nodes to the partition
+	 * of the search, if any. */
+	void
+	propagate_label(Node *node)
+	{
+		if (!on_labeled_ && !antichain_pruning_) {
+			node->label_propagate(controller_actions_, environment_actions_, terminate_early_);
+			return;
+		}
+		const bool          was_labeled = node->label != NodeLabel::UNLABELED;
+		std::vector<Node *> labeled_nodes;
+		node->label_propagate(controller_actions_,
+		                      environment_actions_,
+		                      terminate_early_,
+		                      &labeled_nodes);
+		for (Node *labeled_node : labeled_nodes) {
+			// A node that was labeled before the propagation has already been added by the caller.
+			if (labeled_node != node || !was_labeled) {
+				add_to_antichain(labeled_node, labeled_node->label);
+			}
+			if (on_labeled_) {
+				on_labeled_(labeled_node);
+			}
+		}
+	}
+
+	/** Check whether the search has been stopped because the root has been labeled. */
+	bool
+	is_stopped_at_verdict() const
+	{
+		return stop_on_verdict_ && has_verdict_;
+	}
+
+	/** Check whether the root has just been labeled. If so, record the time of the verdict and drop
+	 * all queued expansions if the search shall stop at the verdict. */
+	void
+	check_verdict()
+	{
+		if (has_verdict_) {
+			return;
+		}
+		const NodeLabel root_label = tree_root_->label;
+		if ((root_label != NodeLabel::TOP && root_label != NodeLabel::BOTTOM)
+		    || has_verdict_.exchange(true)) {
+			return;
+		}
+		time_to_verdict_ = std::chrono::steady_clock::now() - build_start_;
+		SPDLOG_DEBUG("Root labeled {} after {:.3f}s", root_label, time_to_verdict_->count());
+		if (stop_on_verdict_) {
+			pool_.compact_queue();
+		}
+	}
+
+	/** A captured snapshot whose words have not been copied yet. */
+	struct PendingSnapshot
+	{
+		/** The snapshot without words */
+		Snapshot snapshot;
+		/** The interned IDs of the words of the snapshot, in the order of the snapshot's words */
+		std::vector<WordId> word_ids;
+	};
+
+	/** Capture the search graph and the frontier. The words are only referenced by their interned
+	 * IDs, so capturing the snapshot does not copy any words. This must only be called while no node
+	 * is being expanded. */
+	PendingSnapshot
+	capture_snapshot()
+	{
+		PendingSnapshot pending;
+		Snapshot       &snapshot = pending.snapshot;
+		snapshot.K               = K_;
+		snapshot.nodes.reserve(nodes_.size());
+		std::vector<const Node *>                     nodes;
+		std::unordered_map<const Node *, std::size_t> node_indices;
+		std::unordered_map<WordId, std::size_t>       word_indices;
+		const auto add_node = [&](const Node *node, const WordSetKey &key) {
+			node_indices.emplace(node, nodes.size());
+			nodes.push_back(node);
+			auto &node_snapshot = snapshot.nodes.emplace_back();
+			for (const WordId id : key.get_ids()) {
+				const auto [word_index, is_new] = word_indices.try_emplace(id, pending.word_ids.size());
+				if (is_new) {
+					pending.word_ids.push_back(id);
+				}
+				node_snapshot.words.push_back(word_index->second);
+			}
+			node_snapshot.state                       = node->state;
+			node_snapshot.label                       = node->label;
+			node_snapshot.label_reason                = node->label_reason;
+			node_snapshot.is_expanded                 = node->is_expanded;
+			node_snapshot.min_total_region_increments = node->min_total_region_increments;
+		};
+		// The root is stored with an empty key, so we need to intern its words.
+		add_node(tree_root_, words_.intern(tree_root_->get_words()));
+		for (const auto &[key, node] : nodes_) {
+			if (node != tree_root_) {
+				add_node(node, key);
+			}
+		}
+		for (std::size_t index = 0; index < nodes.size(); ++index) {
+			for (const auto &[timed_action, child] : nodes[index]->get_children()) {
+				snapshot.nodes[index].children.push_back(
+				  {timed_action.first, timed_action.second, node_indices.at(child)});
+			}
+		}
+
+		std::unordered_map<const Node *, long> priorities;
+		pool_.visit_queued_jobs([&priorities](const std::pair<long, ExpansionJob> &job) {
+			const auto [priority, is_new] = priorities.try_emplace(job.second.node, job.first);
+			if (!is_new) {
+				priority->second = std::max(priority->second, job.first);
+			}
+		});
+		// A node that has already been taken from the queue is still marked as queued until its
+		// expansion starts. It would have been expanded next, so it gets the highest priority.
+		long max_priority = priorities.empty() ? 0 : std::numeric_limits<long>::min();
+		for (const auto &[node, priority] : priorities) {
+			max_priority = std::max(max_priority, priority);
+		}
+		for (std::size_t index = 0; index < nodes.size(); ++index) {
+			const Node *node = nodes[index];
+			if (!node->is_queued || node->label != NodeLabel::UNLABELED) {
+				continue;
+			}
+			const auto priority = priorities.find(node);
+			snapshot.frontier.push_back(
+			  {index, priority == std::end(priorities) ? max_priority : priority->second});
+		}
+		return pending;
+	}
+
+	/** Copy the words of a captured snapshot from the interning table. This may be called while
+	 * nodes are being expanded. */
+	void
+	copy_snapshot_words(PendingSnapshot &pending) const
+	{
+		pending.snapshot.words.reserve(pending.word_ids.size());
+		for (const WordId id : pending.word_ids) {
+			pending.snapshot.words.push_back(words_.get_word(id));
+		}
+	}
+
+	/** Take a snapshot if the snapshot interval has passed since the last snapshot. The snapshot is
+	 * completed and passed to the snapshot handler on a separate thread. */
+	void
+	take_snapshot_if_due()
+	{
+		if (std::chrono::steady_clock::now() < next_snapshot_time_.load()
+		    || is_handling_snapshot_.exchange(true)) {
+			return;
+		}
+		PendingSnapshot pending;
+		if (!expansion_gate_.run_exclusively([this, &pending] { pending = capture_snapshot(); })) {
+			// The words are being released concurrently, try again with the next expansion.
+			is_handling_snapshot_ = false;
+			return;
+		}
+		next_snapshot_time_ = std::chrono::steady_clock::now() + snapshot_interval_;
+		// Only one thread at a time gets here, and the previous writer has already handled its
+		// snapshot, so joining it does not block.
+		if (snapshot_writer_.joinable()) {
+			snapshot_writer_.join();
+		}
+		snapshot_writer_ = std::thread{[this, pending = std::move(pending)]() mutable {
+			try {
+				copy_snapshot_words(pending);
+				snapshot_handler_(std::move(pending.snapshot));
+			} catch (const std::exception &e) {
+				SPDLOG_ERROR("Failed to handle the search snapshot: {}", e.what());
+			}
+			is_handling_snapshot_ = false;
+		}};
+	}
+
+	/** Check whether a queued node no longer needs to be expanded because it has been labeled, e.g.,
+	 * because it was canceled. If so, the node is marked as not queued.
+	 * @param node The queued node
+	 * @return true if the queue entry of the node shall be dropped
+	 */
+	static bool
+	is_obsolete_queue_entry(Node *node)
+	{
+		if (node->label == NodeLabel::UNLABELED) {
+			return false;
+		}
+		node->is_queued = false;
+		// A canceled node may have been reset concurrently. Then, either the node was re-added in the
+		// meantime and this entry is a duplicate, or we keep this entry as the node's only entry.
+		return node->label != NodeLabel::UNLABELED || node->is_queued.exchange(true);
+	}
+
+	/** Check the resident memory of the process and release the words of all settled nodes if the
+	 * memory budget is exceeded. The resident memory is only checked every memory_check_interval_
+	 * expansions. To avoid visiting all nodes again and again if the memory is not returned to the
+	 * operating system, the words are only released again once the search graph has grown. */
+	void
+	release_words_if_over_budget()
+	{
+		if (num_expansions_.fetch_add(1, std::memory_order_relaxed) % memory_check_interval_ != 0) {
+			return;
+		}
+		const std::size_t resident_memory = utilities::get_resident_memory();
+		resident_memory_                  = resident_memory;
+		if (resident_memory <= memory_budget_ || nodes_.size() < next_word_release_size_) {
+			return;
+		}
+		expansion_gate_.run_exclusively([this] {
+			release_settled_words();
+			next_word_release_size_ = nodes_.size() + nodes_.size() / 8 + 1;
+		});
+	}
+
+	/** Release the words of all nodes with a final label.
+	 * This must only be called while no node is being expanded.
+	 * @see SearchTreeNode::release_words
+	 */
+	void
+	release_settled_words()
+	{
+		std::size_t num_released_nodes = 0;
+		std::size_t released_memory    = 0;
+		for (const auto &[key, node] : nodes_) {
+			if ((node->label != NodeLabel::TOP && node->label != NodeLabel::BOTTOM)
+			    || node->has_released_words() || node->words.empty()) {
+				continue;
+			}
+			// The node's own copies are freed and the interned copies are compacted. The interned words
+			// are still needed to recognize the words and to check domination, but only in packed form.
+			std::vector<const PackedCanonicalABWord *> packed_words;
+			packed_words.reserve(node->words.size());
+			std::size_t words_memory = 0;
+			for (const auto &word : node->words) {
+				const WordId id = words_.intern(word);
+				released_memory += words_.compact(id);
+				packed_words.push_back(&words_.get_packed_word(id));
+				words_memory += estimate_memory(word);
+			}
+			const std::size_t pointers_memory = packed_words.size() * sizeof(packed_words.front());
+			released_memory += words_memory - std::min(words_memory, pointers_memory);
+			node->release_words(std::move(packed_words), &words_.get_symbol_table());
+			++num_released_nodes;
+		}
+		++num_word_releases_;
+		num_released_nodes_ += num_released_nodes;
+		released_word_memory_ += released_memory;
+		SPDLOG_DEBUG("Released the words of {} nodes, about {} bytes",
+		             num_released_nodes,
+		             released_memory);
+	}
+
+	/** Get the key of the node in the antichain store, which is the interned reg_a of its words. */
+	WordId
+	get_antichain_key(const Node &node)
+	{
+		return words_.intern(reg_a(*std::begin(node.words)));
+	}
+
+	/** Add a node with a known label to the antichain store if antichain pruning is enabled. Labels
+	 * that depend on the path to the node, e.g., monotonic dominations of an ancestor, are only valid
+	 * for this node and therefore not added. */
+	void
+	add_to_antichain(Node *node, NodeLabel label)
+	{
+		if (antichain_pruning_ && !node->words.empty() && !node->has_path_dependent_label
+		    && (label == NodeLabel::TOP || label == NodeLabel::BOTTOM)) {
+			antichain_store_.insert(get_antichain_key(*node), node, label);
+		}
+	}
+
+	/** Get the label of a node from the antichain store if antichain pruning is enabled. */
+	NodeLabel
+	find_antichain_label(const Node &node)
+	{
+		if (!antichain_pruning_ || node.words.empty()) {
+			return NodeLabel::UNLABELED;
+		}
+		return antichain_store_.find_label(get_antichain_key(node), node);
+	}
+
 	std::pair<std::set<Node *>, std::set<Node *>>
 	compute_children(Node *node)
 	{
@@ -458,17 +1558,33 @@ private:
 		         std::set<CanonicalABWord<Location, ConstraintSymbolType>>>
 		  child_classes;
 
-		const auto time_successors = get_time_successors(node->words, K_);
+		const auto time_successors = get_time_successors(node->words, time_successor_cache_);
 		for (std::size_t increment = 0; increment < time_successors.size(); ++increment) {
 			for (const auto &time_successor : time_successors[increment]) {
-				auto successors =
-				  get_next_canonical_words<Plant,
-				                           ActionType,
-				                           ConstraintSymbolType,
-				                           use_location_constraints,
-				                           use_set_semantics>(controller_actions_, environment_actions_)(
-				    *ta_, *ata_, get_candidate(time_successor), increment, K_);
-				for (const auto &[symbol, successor] : successors) {
+				// The adapters only depend on the time successor and not on the increment, so the
+				// successors can be shared between all nodes with the same time successor.
+				const auto successors = successor_cache_.get_successors(time_successor, [&] {
+					using Adapter = get_next_canonical_words<Plant,
+					                                         ActionType,
+					                                         ConstraintSymbolType,
+					                                         use_location_constraints,
+					                                         use_set_semantics>;
+					Adapter adapter{controller_actions_, environment_actions_};
+					// Prefer adapters that compute the successors directly on the word, which avoids
+					// computing a candidate and regionalizing its successors.
+					using Word = CanonicalABWord<Location, ConstraintSymbolType>;
+					if constexpr (std::is_invocable_v<Adapter,
+					                                  decltype(*ta_),
+					                                  decltype(*ata_),
+					                                  const Word &,
+					                                  RegionIndex,
+					                                  RegionIndex>) {
+						return adapter(*ta_, *ata_, time_successor, increment, K_);
+					} else {
+						return adapter(*ta_, *ata_, get_candidate(time_successor), increment, K_);
+					}
+				});
+				for (const auto &[symbol, successor] : *successors) {
 					assert(
 					  std::find(std::begin(controller_actions_), std::end(controller_actions_), symbol)
 					    != std::end(controller_actions_)
@@ -479,25 +1595,39 @@ private:
 			}
 		}
 
+		// Intern the word sets first so the node map's shards are only locked for the (cheap) hash
+		// lookups.
+		std::vector<WordSetKey> keys;
+		keys.reserve(child_classes.size());
+		for (const auto &[timed_action, words] : child_classes) {
+			keys.push_back(words_.intern(words));
+		}
+
 		std::set<Node *> new_children;
 		std::set<Node *> existing_children;
 		// Create child nodes, where each child contains all successors words of
 		// the same reg_a class.
-		{
-			std::lock_guard lock{nodes_mutex_};
-			for (const auto &[timed_action, words] : child_classes) {
-				auto [child_it, is_new] = nodes_.insert({words, std::make_shared<Node>(words)});
-				const std::shared_ptr<Node> &child_ptr = child_it->second;
-				node->add_child(timed_action, child_ptr);
-				SPDLOG_TRACE("Action ({}, {}): Adding child {}",
-				             timed_action.first,
-				             timed_action.second,
-				             words);
-				if (is_new) {
-					new_children.insert(child_ptr.get());
-				} else {
-					existing_children.insert(child_ptr.get());
-				}
+		auto key = std::begin(keys);
+		for (const auto &child_class : child_classes) {
+			const auto &timed_action = child_class.first;
+			Node       *child        = nullptr;
+			const bool  is_new       = nodes_.get_or_insert(
+			  std::move(*key++),
+			  [this, &child_class] { return node_arena_.create(child_class.second); },
+			  [&node, &timed_action, &child](Node *child_ptr) {
+				  // The child may also be added to other nodes that are expanded concurrently, so add it
+				  // while the child's shard is locked.
+				  node->add_child(timed_action, child_ptr);
+				  child = child_ptr;
+			  });
+			SPDLOG_TRACE("Action ({}, {}): Adding child {}",
+			             timed_action.first,
+			             timed_action.second,
+			             child_class.second);
+			if (is_new) {
+				new_children.insert(child);
+			} else {
+				existing_children.insert(child);
 			}
 		}
 		return {new_children, existing_children};
@@ -513,13 +1643,50 @@ private:
 	RegionIndex                K_;
 	const bool                 incremental_labeling_;
 	const bool                 terminate_early_{false};
+	bool                       antichain_pruning_{false};
+	bool                       stop_on_verdict_{false};
+	std::size_t                memory_budget_{0};
+	std::size_t                memory_check_interval_{default_memory_check_interval};
 
-	mutable std::mutex    nodes_mutex_;
-	std::shared_ptr<Node> tree_root_;
-	std::map<std::set<CanonicalABWord<Location, ConstraintSymbolType>>, std::shared_ptr<Node>> nodes_;
-	utilities::ThreadPool<long> pool_{utilities::ThreadPool<long>::StartOnInit::NO};
+	// The arena owns all nodes, so it must be destroyed after every other member that refers to them.
+	utilities::ObjectArena<Node>                               node_arena_;
+	Node                                                      *tree_root_;
+	WordInterningTable<Location, ConstraintSymbolType>         words_;
+	NodeMap                                                    nodes_;
+	AntichainStore<Node>                                       antichain_store_;
+	TimeSuccessorCache<Location, ConstraintSymbolType>         time_successor_cache_{K_};
+	SuccessorCache<Location, ActionType, ConstraintSymbolType> successor_cache_;
+	utilities::ThreadPool<long, ExpansionJob> pool_{
+	  utilities::ThreadPool<long, ExpansionJob>::StartOnInit::NO};
 	std::unique_ptr<Heuristic<long, SearchTreeNode<Location, ActionType, ConstraintSymbolType>>>
 	  heuristic;
+
+	std::atomic_size_t num_domination_ancestors_{0};
+	std::atomic_size_t num_domination_signature_rejections_{0};
+	std::atomic_size_t num_domination_exact_checks_{0};
+	std::atomic_size_t num_dominations_{0};
+
+	details::PauseGate expansion_gate_;
+	std::atomic_size_t num_expansions_{0};
+	std::atomic_size_t next_word_release_size_{0};
+	std::atomic_size_t resident_memory_{0};
+	std::atomic_size_t num_word_releases_{0};
+	std::atomic_size_t num_released_nodes_{0};
+	std::atomic_size_t released_word_memory_{0};
+
+	std::chrono::steady_clock::duration                snapshot_interval_{0};
+	std::function<void(Snapshot &&)>                   snapshot_handler_;
+	std::atomic<std::chrono::steady_clock::time_point> next_snapshot_time_{};
+	std::atomic_bool                                   is_handling_snapshot_{false};
+	std::thread                                        snapshot_writer_;
+
+	std::function<bool(Node *)> assign_node_;
+	std::function<void(Node *)> on_labeled_;
+
+	std::atomic_bool                             has_verdict_{false};
+	std::chrono::steady_clock::time_point        build_start_{std::chrono::steady_clock::now()};
+	std::optional<std::chrono::duration<double>> time_to_verdict_;
+	std::chrono::duration<double>                time_to_exhaustion_{0};
 };
 
 } // namespace tacos::search
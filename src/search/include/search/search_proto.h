@@ -0,0 +1,58 @@
+/***************************************************************************
+ *  search_proto.h - Protobuf import/export for search snapshots
+ *
+ *  Created:   Sat 17 Oct 23:20:18 CEST 2026
+ *  Copyright  2026  Till Hofmann <hofmann@kbsg.rwth-aachen.de>
+ *  SPDX-License-Identifier: LGPL-3.0-or-later
+ ****************************************************************************/
+
+
+#pragma once
+
+#include "automata/ta.h"
+#include "search/search.pb.h"
+#include "search/search_snapshot.h"
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace tacos::search {
+
+/** A snapshot of a search over a product of timed automata with string actions. */
+using ProductSearchSnapshot =
+  SearchSnapshot<automata::ta::Location<std::vector<std::string>>, std::string>;
+
+/** Convert a search snapshot to a proto.
+ * @param snapshot The snapshot to convert
+ * @return The proto representation of the snapshot
+ */
+proto::SearchSnapshot snapshot_to_proto(const ProductSearchSnapshot &snapshot);
+
+/** Parse a search snapshot from a proto.
+ * @param snapshot_proto The proto representation of the snapshot
+ * @return The parsed snapshot
+ * @throw std::invalid_argument if the proto refers to an entry that does not exist
+ */
+ProductSearchSnapshot parse_proto(const proto::SearchSnapshot &snapshot_proto);
+
+/** @brief Write a search snapshot to a binary file.
+ *
+ * The snapshot is first written to a temporary file next to the given path, which then replaces
+ * the file at the given path. Thus, the file always contains a complete snapshot, even if the
+ * process is killed while writing.
+ * @param snapshot The snapshot to write
+ * @param path The path of the file
+ * @throw std::runtime_error if the file cannot be written
+ */
+void write_snapshot_to_file(const ProductSearchSnapshot &snapshot,
+                            const std::filesystem::path &path);
+
+/** Read a search snapshot from a binary file written by write_snapshot_to_file.
+ * @param path The path of the file
+ * @return The snapshot read from the file
+ * @throw std::runtime_error if the file cannot be read
+ */
+ProductSearchSnapshot read_snapshot_from_file(const std::filesystem::path &path);
+
+} // namespace tacos::search
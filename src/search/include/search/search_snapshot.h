@@ -0,0 +1,82 @@
+/***************************************************************************
+ *  search_snapshot.h - A snapshot of the state of a search
+ *
+ *  Created:   Sat 17 Oct 21:05:36 CEST 2026
+ *  Copyright  2026  Till Hofmann <hofmann@kbsg.rwth-aachen.de>
+ *  SPDX-License-Identifier: LGPL-3.0-or-later
+ ****************************************************************************/
+
+#pragma once
+
+#include "canonical_word.h"
+#include "search_tree.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace tacos::search {
+
+/** @brief A snapshot of the state of a TreeSearch.
+ *
+ * The snapshot contains the search graph with the state and label of each node as well as the
+ * search frontier, so the search can be resumed from it, e.g., after a crash. Nodes refer to their
+ * words and to their children by index, and the root is always the first node.
+ * @see TreeSearch::set_snapshot_handler
+ * @see TreeSearch::restore_snapshot
+ */
+template <typename Location, typename ActionType, typename ConstraintSymbolType = ActionType>
+struct SearchSnapshot
+{
+	/** The type of the words in the snapshot. */
+	using Word = CanonicalABWord<Location, ConstraintSymbolType>;
+
+	/** An edge from a node to one of its children. */
+	struct Edge
+	{
+		/** The region increment of the time step that leads to the child */
+		RegionIndex increment;
+		/** The action that leads to the child */
+		ActionType action;
+		/** The index of the child in the list of nodes */
+		std::size_t child;
+	};
+
+	/** A single node of the search graph. */
+	struct Node
+	{
+		/** The indices of the words of the node in the list of words */
+		std::vector<std::size_t> words;
+		/** The state of the node */
+		NodeState state{NodeState::UNKNOWN};
+		/** The label of the node */
+		NodeLabel label{NodeLabel::UNLABELED};
+		/** The reason for the label of the node */
+		LabelReason label_reason{LabelReason::UNKNOWN};
+		/** Whether the node has been expanded */
+		bool is_expanded{false};
+		/** The regionalized minimal total time to reach the node */
+		RegionIndex min_total_region_increments{0};
+		/** The edges to the children of the node */
+		std::vector<Edge> children;
+	};
+
+	/** A node in the search frontier, i.e., a node that is queued for expansion. */
+	struct FrontierEntry
+	{
+		/** The index of the node in the list of nodes */
+		std::size_t node;
+		/** The priority of the node's expansion */
+		long priority;
+	};
+
+	/** The maximal constant of the search */
+	RegionIndex K{0};
+	/** All distinct words of the nodes */
+	std::vector<Word> words;
+	/** All nodes of the search graph, starting with the root */
+	std::vector<Node> nodes;
+	/** The search frontier */
+	std::vector<FrontierEntry> frontier;
+};
+
+} // namespace tacos::search
@@ -10,17 +10,29 @@
 
 #include "automata/ta_regions.h"
 #include "canonical_word.h"
+#include "domination_signature.h"
+#include "packed_canonical_word.h"
 #include "reg_a.h"
+#include "utilities/append_only_list.h"
+#include "utilities/flat_map.h"
 
 #include <fmt/ostream.h>
 #include <spdlog/spdlog.h>
 
 #include <algorithm>
+#include <array>
 #include <atomic>
+#include <cstddef>
 #include <iostream>
 #include <limits>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <set>
 #include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace tacos::search {
 
@@ -48,6 +60,7 @@ enum class LabelReason {
 	DEAD_NODE,
 	NO_ATA_SUCCESSOR,
 	MONOTONIC_DOMINATION,
+	ANTICHAIN_DOMINATION,
 	NO_BAD_ENV_ACTION,
 	GOOD_CONTROLLER_ACTION_FIRST,
 	BAD_ENV_ACTION_FIRST,
@@ -60,11 +73,19 @@ template <typename Location, typename ActionType, typename ConstraintSymbolType
 class SearchTreeNode
 {
 public:
+	/** The children of a node, keyed by the time step and action that lead to the child. The
+	 * children are owned by the search graph, e.g., by the arena of the TreeSearch. */
+	using Children = utilities::FlatMap<std::pair<RegionIndex, ActionType>, SearchTreeNode *>;
+	/** The type of the words of a node. */
+	using Word = CanonicalABWord<Location, ConstraintSymbolType>;
+	/** The table that the words of a node are packed with when they are released. */
+	using SymbolTable = PackedSymbolTable<Location, ConstraintSymbolType>;
+
 	/** Construct a node.
 	 * @param words The CanonicalABWords of the node (being of the same reg_a class)
 	 */
 	SearchTreeNode(const std::set<CanonicalABWord<Location, ConstraintSymbolType>> &words)
-	: words(words)
+	: words(words), domination_signature(get_domination_signature(words))
 	{
 		// The constraints must be either over locations or over actions.
 		static_assert(std::is_same_v<Location, ConstraintSymbolType>
@@ -97,12 +118,11 @@ public:
 			  "Labeling {} {} with {}, reason: {}", fmt::ptr(this), *this, new_label, label_reason);
 			label = new_label;
 			if (cancel_children) {
-				for (const auto &action_child : children) {
-					auto child = std::get<1>(action_child);
+				for (const auto &[timed_action, child] : children) {
 					if (std::all_of(std::begin(child->parents),
 					                std::end(child->parents),
-					                [&child](const auto &parent) {
-						                return parent == child.get() || parent->label != NodeLabel::UNLABELED;
+					                [child = child](const auto &parent) {
+						                return parent == child || parent->label != NodeLabel::UNLABELED;
 					                })) {
 						child->set_label(NodeLabel::CANCELED, true);
 					}
@@ -119,7 +139,11 @@ public:
 	reset_label()
 	{
 		NodeLabel expected_label = NodeLabel::CANCELED;
-		label.compare_exchange_strong(expected_label, NodeLabel::UNLABELED);
+		if (label.compare_exchange_strong(expected_label, NodeLabel::UNLABELED)) {
+			// The children may have been labeled without propagating to this node, so count them again.
+			std::lock_guard lock{child_counters_mutex};
+			child_counter_state.reset();
+		}
 	}
 
 	/**
@@ -133,44 +157,278 @@ public:
 	 * and came from a control-action and there is no non-"GOOD" environmental-action happening
 	 * before -> the node can be labelled "GOOD". The call should be propagated to the parent node
 	 * in case the labelling has been determined.
+	 *
+	 * The propagation uses a worklist of parents whose label may have changed, together with the
+	 * child that caused the change. Each node counts its children by time step, action type, and
+	 * label, so re-evaluating a parent only needs to update the counters of the changed child
+	 * rather than checking all children again.
 	 * @param controller_actions The set of controller actions
 	 * @param environment_actions The set of environment actions
 	 * @param cancel_children If true, cancel children if a node is labeled
+	 * @param labeled_nodes If not nullptr, all nodes whose label is propagated to their parents,
+	 * i.e., this node if it is labeled and every node that is labeled by the propagation, are added
+	 * to this vector
 	 */
 	void
-	label_propagate(const std::set<ActionType> &controller_actions,
-	                const std::set<ActionType> &environment_actions,
-	                bool                        cancel_children = false)
+	label_propagate(const std::set<ActionType>    &controller_actions,
+	                const std::set<ActionType>    &environment_actions,
+	                bool                           cancel_children = false,
+	                std::vector<SearchTreeNode *> *labeled_nodes   = nullptr)
 	{
 		// SPDLOG_TRACE("Call propagate on node {}", *this);
-		if (is_expanding) {
-			SPDLOG_DEBUG("Cancelling node propagation on {}, currently expanding", *this);
-			return;
-		}
-		if (!is_expanded) {
-			SPDLOG_DEBUG("Cancelling node propagation on {}, node is not expanded yet", *this);
+		if (!is_ready_for_labeling()) {
 			return;
 		}
 		// leaf-nodes should always be labelled directly
 		assert(!children.empty() || label != NodeLabel::UNLABELED);
-		// if not already happened: call recursively on parent node
-		if (children.empty()) {
-			assert(label != NodeLabel::UNLABELED);
+		if (!children.empty()) {
+			// do nothing if the node is already labelled
+			if (label != NodeLabel::UNLABELED) {
+				SPDLOG_TRACE("Node is already labelled, abort.");
+				return;
+			}
+			if (!update_label(controller_actions, environment_actions, nullptr, cancel_children)) {
+				return;
+			}
+		} else {
 			SPDLOG_TRACE("Node is a leaf, propagate labels.", *this);
-			for (const auto &parent : parents) {
-				if (parent != this) {
-					parent->label_propagate(controller_actions, environment_actions, cancel_children);
+		}
+		// Pairs of a parent and its child that was labeled.
+		std::vector<std::pair<SearchTreeNode *, const SearchTreeNode *>> worklist;
+		const auto add_parents = [&worklist, labeled_nodes](SearchTreeNode *node) {
+			if (labeled_nodes != nullptr) {
+				labeled_nodes->push_back(node);
+			}
+			for (const auto &parent : node->parents) {
+				if (parent != node && parent->label == NodeLabel::UNLABELED) {
+					worklist.emplace_back(parent, node);
 				}
 			}
-			return;
+		};
+		add_parents(this);
+		while (!worklist.empty()) {
+			const auto [node, labeled_child] = worklist.back();
+			worklist.pop_back();
+			if (node->label == NodeLabel::UNLABELED && node->is_ready_for_labeling()
+			    && node->update_label(
+			      controller_actions, environment_actions, labeled_child, cancel_children)) {
+				add_parents(node);
+			}
 		}
-		// do nothing if the node is already labelled
-		if (label != NodeLabel::UNLABELED) {
-			SPDLOG_TRACE("Node is already labelled, abort.");
-			return;
+	}
+
+	/**
+	 * @brief Compares two nodes for equality.
+	 * @param other The other node
+	 * @return true If both nodes are the same (without considering subtrees)
+	 * @return false Otherwise
+	 */
+	bool
+	operator==(const SearchTreeNode<Location, ActionType, ConstraintSymbolType> &other) const
+	{
+		return this->get_words() == other.get_words() && this->state == other.state
+		       && this->label == other.label
+		  //&& this->parent == other.parent && this->children == other.children
+		  ;
+	}
+
+	/** Get a reference to the map of children.
+	 * @return The children
+	 */
+	const auto &
+	get_children() const
+	{
+		return children;
+	}
+
+	/** Add a child to the node.
+	 * @param action Taking this action in the current node leads to the new child node
+	 * @param node The new child, must outlive this node
+	 */
+	void
+	add_child(const std::pair<RegionIndex, ActionType> &action, SearchTreeNode *node)
+	{
+		// Only add this node once as parent, even if it reaches the child with multiple actions. Only
+		// the children of this node are searched, so this does not depend on the number of parents.
+		const bool is_new_parent =
+		  std::none_of(std::begin(children), std::end(children), [node](const auto &child) {
+			  return child.second == node;
+		  });
+		if (!children.insert(std::make_pair(action, node)).second) {
+			throw std::invalid_argument(fmt::format("\n{}\nCannot add child node \n{}\n, node already "
+			                                        "has child \n{}\n with the same action ({}, {})",
+			                                        *this,
+			                                        *node,
+			                                        *children.at(action),
+			                                        action.first,
+			                                        action.second));
 		}
-		assert(!children.empty());
+		node->min_total_region_increments =
+		  std::min(node->min_total_region_increments, min_total_region_increments + action.first);
+		if (is_new_parent) {
+			// Other nodes may add the same child concurrently, while the parents are read without a lock.
+			std::lock_guard lock{node->child_counters_mutex};
+			node->parents.push_back(this);
+		}
+	}
+
+	/** Release the words of the node and only keep pointers to packed copies of the words that are
+	 * stored elsewhere, e.g., in a WordInterningTable.
+	 * This must not be called concurrently with any function that accesses the words of the node.
+	 * @param packed_words Pointers to packed copies of all words of the node, which must outlive the
+	 * node
+	 * @param symbol_table The table that the words have been packed with, which must outlive the node
+	 */
+	void
+	release_words(std::vector<const PackedCanonicalABWord *> packed_words, SymbolTable *symbol_table)
+	{
+		assert(packed_words.size() == words.size());
+		assert(std::all_of(std::begin(packed_words),
+		                   std::end(packed_words),
+		                   [this, symbol_table](const PackedCanonicalABWord *word) {
+			                   return words.count(symbol_table->unpack(*word)) == 1;
+		                   }));
+		released_words = std::move(packed_words);
+		packed_symbols = symbol_table;
+		words.clear();
+	}
+
+	/** Check whether the words of the node have been released.
+	 * @see release_words
+	 */
+	bool
+	has_released_words() const
+	{
+		return !released_words.empty();
+	}
+
+	/** Get the packed words of the node, which is empty if the words have not been released.
+	 * @see release_words
+	 */
+	const std::vector<const PackedCanonicalABWord *> &
+	get_packed_words() const
+	{
+		return released_words;
+	}
+
+	/** Get the table that the released words have been packed with.
+	 * This must only be called if the words have been released.
+	 */
+	SymbolTable &
+	get_symbol_table() const
+	{
+		assert(packed_symbols != nullptr);
+		return *packed_symbols;
+	}
 
+	/** Get a copy of the words of the node, unpacked from the packed words if they have been
+	 * released. */
+	std::set<Word>
+	get_words() const
+	{
+		if (!has_released_words()) {
+			return words;
+		}
+		std::set<Word> restored_words;
+		for (const PackedCanonicalABWord *word : released_words) {
+			restored_words.insert(packed_symbols->unpack(*word));
+		}
+		return restored_words;
+	}
+
+	/** The words of the node, empty if they have been released
+	 * @see get_words
+	 */
+	std::set<Word> words;
+	/** The signature of the node's words, used to quickly rule out monotonic domination */
+	const DominationSignature domination_signature;
+	/** The state of the node */
+	std::atomic<NodeState> state = NodeState::UNKNOWN;
+	/** Whether we have a successful strategy in the node */
+	std::atomic<NodeLabel> label = NodeLabel::UNLABELED;
+	/** The parents of the node, this node was directly reached from each parent. The parents may be
+	 * read while other parents are added concurrently. */
+	utilities::AppendOnlyList<SearchTreeNode *> parents;
+	/** Whether the node has been expanded. This is used for multithreading, in particular to check
+	 * whether we can access the children already. */
+	std::atomic_bool is_expanded{false};
+	/** Whether the node is currently being expanded. */
+	std::atomic_bool is_expanding{false};
+	/** Whether the node is in the search frontier, i.e., whether it is queued for expansion. */
+	std::atomic_bool is_queued{false};
+	/** Whether the label of the node depends on the path to the node, e.g., because the node
+	 * monotonically dominates one of its ancestors or because the label is derived from such a
+	 * child. Such a label must not be reused for other nodes. This is always set before the label. */
+	std::atomic_bool has_path_dependent_label{false};
+	/** A more detailed description for the node that explains the current label. */
+	LabelReason label_reason = LabelReason::UNKNOWN;
+	/** The current regionalized minimal total time to reach this node */
+	RegionIndex min_total_region_increments = std::numeric_limits<RegionIndex>::max();
+
+private:
+	/** The number of children reachable with a single time step, by action type and label. */
+	struct ChildCounters
+	{
+		/** Get the number of children with the given action type and label. */
+		std::size_t &
+		count(bool is_controller_action, NodeLabel child_label)
+		{
+			return counts[is_controller_action][static_cast<std::size_t>(child_label)];
+		}
+
+		/** The counts, indexed by whether the action is a controller action and by the label. */
+		std::array<std::array<std::size_t, 4>, 2> counts{};
+	};
+
+	/** A child as it is currently counted in the child counters. */
+	struct CountedChild
+	{
+		/** The label of the child when it was last counted. */
+		NodeLabel label;
+		/** The time step and whether the action is a controller action for each edge to the child. */
+		std::vector<std::pair<RegionIndex, bool>> edges;
+	};
+
+	/** The counters of all children of a node. */
+	struct ChildCounterState
+	{
+		/** Whether the node has a child that is reachable with an environment action. */
+		bool has_environment_child{false};
+		/** The counters of the children for each time step. */
+		std::map<RegionIndex, ChildCounters> step_counters;
+		/** The counted children with their edges. */
+		std::unordered_map<const SearchTreeNode *, CountedChild> counted_children;
+	};
+
+	/** Check whether the node is expanded, i.e., whether all its children are known. */
+	bool
+	is_ready_for_labeling() const
+	{
+		if (is_expanding) {
+			SPDLOG_DEBUG("Cancelling node propagation on {}, currently expanding", *this);
+			return false;
+		}
+		if (!is_expanded) {
+			SPDLOG_DEBUG("Cancelling node propagation on {}, node is not expanded yet", *this);
+			return false;
+		}
+		return true;
+	}
+
+	/** Update the child counters and label the node if the label is determined by its children.
+	 * @param controller_actions The set of controller actions
+	 * @param environment_actions The set of environment actions
+	 * @param labeled_child The child whose label has changed, or nullptr to count all children again
+	 * @param cancel_children If true, cancel children if the node is labeled
+	 * @return true if the node is labeled with TOP or BOTTOM
+	 */
+	bool
+	update_label(const std::set<ActionType> &controller_actions,
+	             const std::set<ActionType> &environment_actions,
+	             const SearchTreeNode       *labeled_child,
+	             bool                        cancel_children)
+	{
+		assert(!children.empty());
 		// Find good and bad child nodes which are already labelled and determine their order (with
 		// respect to time). Also keep track of yet unlabelled nodes (both cases, environmental and
 		// controller action).
@@ -180,22 +438,33 @@ public:
 		RegionIndex    first_non_good_environment_step{max};
 		RegionIndex    first_bad_environment_step{max};
 		bool           has_enviroment_step{false};
-		for (const auto &[timed_action, child] : children) {
-			// Copy label to avoid races while checking the conditions below.
-			const NodeLabel child_label = child->label;
-			const auto &[step, action]  = timed_action;
-			if (controller_actions.find(action) != std::end(controller_actions)) {
-				if (child_label == NodeLabel::TOP || child.get() == this) {
-					first_good_controller_step = std::min(first_good_controller_step, step);
-				} else if (child_label == NodeLabel::UNLABELED) {
-					first_non_bad_controller_step = std::min(first_non_bad_controller_step, step);
+		{
+			std::lock_guard lock{child_counters_mutex};
+			if (label != NodeLabel::UNLABELED) {
+				// The node has been labeled concurrently.
+				return false;
+			}
+			if (child_counter_state == nullptr || labeled_child == nullptr) {
+				count_children(controller_actions, environment_actions);
+			} else {
+				update_child_counters(labeled_child);
+			}
+			has_enviroment_step = child_counter_state->has_environment_child;
+			// The counters are ordered by time step, so the first matching step is the minimum.
+			for (auto &[step, counters] : child_counter_state->step_counters) {
+				if (first_good_controller_step == max && counters.count(true, NodeLabel::TOP) > 0) {
+					first_good_controller_step = step;
 				}
-			} else if (environment_actions.find(action) != std::end(environment_actions)) {
-				has_enviroment_step = true;
-				if (child_label == NodeLabel::BOTTOM) {
-					first_bad_environment_step = std::min(first_bad_environment_step, step);
-				} else if (child.get() != this && child_label == NodeLabel::UNLABELED) {
-					first_non_good_environment_step = std::min(first_non_good_environment_step, step);
+				if (first_non_bad_controller_step == max
+				    && counters.count(true, NodeLabel::UNLABELED) > 0) {
+					first_non_bad_controller_step = step;
+				}
+				if (first_bad_environment_step == max && counters.count(false, NodeLabel::BOTTOM) > 0) {
+					first_bad_environment_step = step;
+				}
+				if (first_non_good_environment_step == max
+				    && counters.count(false, NodeLabel::UNLABELED) > 0) {
+					first_non_good_environment_step = step;
 				}
 			}
 		}
@@ -211,20 +480,23 @@ public:
 		if (first_good_controller_step
 		    < std::min(first_bad_environment_step, first_non_good_environment_step)) {
 			// The controller can just select the good controller action.
-			label_reason = LabelReason::GOOD_CONTROLLER_ACTION_FIRST;
+			label_reason             = LabelReason::GOOD_CONTROLLER_ACTION_FIRST;
+			has_path_dependent_label = has_child_with_path_dependent_label();
 			set_label(NodeLabel::TOP, cancel_children);
 		} else if (has_enviroment_step
 		           && std::min(first_bad_environment_step, first_non_good_environment_step)
 		                == std::numeric_limits<RegionIndex>::max()) {
 			// There is an environment action and no environment action is bad
 			// -> the controller can just select all environment actions
-			label_reason = LabelReason::NO_BAD_ENV_ACTION;
+			label_reason             = LabelReason::NO_BAD_ENV_ACTION;
+			has_path_dependent_label = has_child_with_path_dependent_label();
 			set_label(NodeLabel::TOP, cancel_children);
 		} else if (!has_enviroment_step && first_good_controller_step == max
 		           && first_non_bad_controller_step == max) {
 			// All controller actions must be bad (otherwise we would be in the first case)
 			// -> no controller strategy
-			label_reason = LabelReason::ALL_CONTROLLER_ACTIONS_BAD;
+			label_reason             = LabelReason::ALL_CONTROLLER_ACTIONS_BAD;
+			has_path_dependent_label = has_child_with_path_dependent_label();
 			set_label(NodeLabel::BOTTOM, cancel_children);
 		} else if (has_enviroment_step && first_bad_environment_step < max
 		           && first_bad_environment_step
@@ -232,85 +504,111 @@ public:
 			// There must be an environment action (otherwise case 3) and one of them must be bad
 			// (otherwise case 2).
 			assert(first_bad_environment_step < std::numeric_limits<RegionIndex>::max());
-			label_reason = LabelReason::BAD_ENV_ACTION_FIRST;
+			label_reason             = LabelReason::BAD_ENV_ACTION_FIRST;
+			has_path_dependent_label = has_child_with_path_dependent_label();
 			set_label(NodeLabel::BOTTOM, cancel_children);
 		}
-		if (label != NodeLabel::UNLABELED) {
-			for (const auto &parent : parents) {
-				if (parent != this) {
-					parent->label_propagate(controller_actions, environment_actions, cancel_children);
-				}
-			}
+		if (const NodeLabel new_label = label;
+		    new_label == NodeLabel::TOP || new_label == NodeLabel::BOTTOM) {
+			// The label is final, the counters are no longer needed.
+			std::lock_guard lock{child_counters_mutex};
+			child_counter_state.reset();
+			return true;
 		}
+		return false;
 	}
 
-	/**
-	 * @brief Compares two nodes for equality.
-	 * @param other The other node
-	 * @return true If both nodes are the same (without considering subtrees)
-	 * @return false Otherwise
-	 */
+	/** Check whether any labeled child has a label that depends on the path to the child. As the
+	 * flag of a node is always set before its label, a labeled child has its final flag. */
 	bool
-	operator==(const SearchTreeNode<Location, ActionType, ConstraintSymbolType> &other) const
+	has_child_with_path_dependent_label() const
 	{
-		return this->words == other.words && this->state == other.state && this->label == other.label
-		  //&& this->parent == other.parent && this->children == other.children
-		  ;
+		return std::any_of(std::begin(children), std::end(children), [](const auto &child) {
+			const NodeLabel child_label = child.second->label;
+			return (child_label == NodeLabel::TOP || child_label == NodeLabel::BOTTOM)
+			       && child.second->has_path_dependent_label;
+		});
 	}
 
-	/** Get a reference to the map of children.
-	 * @return The children
-	 */
-	const auto &
-	get_children() const
+	/** Count all children of the node. Expects the child counters mutex to be locked. */
+	void
+	count_children(const std::set<ActionType> &controller_actions,
+	               const std::set<ActionType> &environment_actions)
 	{
-		return children;
+		child_counter_state = std::make_unique<ChildCounterState>();
+		auto &state         = *child_counter_state;
+		for (const auto &[timed_action, child] : children) {
+			const auto &[step, action] = timed_action;
+			const bool is_controller_action =
+			  controller_actions.find(action) != std::end(controller_actions);
+			if (!is_controller_action) {
+				if (environment_actions.find(action) == std::end(environment_actions)) {
+					continue;
+				}
+				state.has_environment_child = true;
+			}
+			if (child == this) {
+				// A self loop is always good for the controller and never bad for the environment.
+				if (is_controller_action) {
+					++state.step_counters[step].count(true, NodeLabel::TOP);
+				}
+				continue;
+			}
+			state.counted_children[child].edges.emplace_back(step, is_controller_action);
+		}
+		for (auto &[child, counted_child] : state.counted_children) {
+			counted_child.label = child->label;
+			count_child(counted_child, true);
+		}
 	}
 
-	/** Add a child to the node.
-	 * @param action Taking this action in the current node leads to the new child node
-	 * @param node The new child
-	 */
+	/** Update the counters for a child whose label may have changed. Expects the child counters
+	 * mutex to be locked. */
 	void
-	add_child(const std::pair<RegionIndex, ActionType> &action, std::shared_ptr<SearchTreeNode> node)
+	update_child_counters(const SearchTreeNode *child)
 	{
-		if (!children.insert(std::make_pair(action, node)).second) {
-			throw std::invalid_argument(fmt::format("\n{}\nCannot add child node \n{}\n, node already "
-			                                        "has child \n{}\n with the same action ({}, {})",
-			                                        *this,
-			                                        *node,
-			                                        *children.at(action),
-			                                        action.first,
-			                                        action.second));
+		auto      &counted_children = child_counter_state->counted_children;
+		const auto counted_child    = counted_children.find(child);
+		if (counted_child == std::end(counted_children)) {
+			// The child is only reachable with actions that are neither controller nor environment
+			// actions.
+			return;
 		}
-		node->min_total_region_increments =
-		  std::min(node->min_total_region_increments, min_total_region_increments + action.first);
-		node->parents.insert(this);
+		const NodeLabel child_label = child->label;
+		if (child_label == counted_child->second.label) {
+			return;
+		}
+		count_child(counted_child->second, false);
+		counted_child->second.label = child_label;
+		count_child(counted_child->second, true);
 	}
 
-	/** The words of the node */
-	std::set<CanonicalABWord<Location, ConstraintSymbolType>> words;
-	/** The state of the node */
-	std::atomic<NodeState> state = NodeState::UNKNOWN;
-	/** Whether we have a successful strategy in the node */
-	std::atomic<NodeLabel> label = NodeLabel::UNLABELED;
-	/** The parent of the node, this node was directly reached from the parent */
-	std::set<SearchTreeNode *> parents = {};
-	/** Whether the node has been expanded. This is used for multithreading, in particular to check
-	 * whether we can access the children already. */
-	std::atomic_bool is_expanded{false};
-	/** Whether the node is currently being expanded. */
-	std::atomic_bool is_expanding{false};
-	/** A more detailed description for the node that explains the current label. */
-	LabelReason label_reason = LabelReason::UNKNOWN;
-	/** The current regionalized minimal total time to reach this node */
-	RegionIndex min_total_region_increments = std::numeric_limits<RegionIndex>::max();
+	/** Add or remove all edges of a counted child to or from the counters. */
+	void
+	count_child(const CountedChild &counted_child, bool add)
+	{
+		for (const auto &[step, is_controller_action] : counted_child.edges) {
+			auto &count =
+			  child_counter_state->step_counters[step].count(is_controller_action, counted_child.label);
+			if (add) {
+				++count;
+			} else {
+				--count;
+			}
+		}
+	}
 
-private:
-	/** A list of the children of the node, which are reachable by a single transition */
-	// TODO change container with custom comparator to set to avoid duplicates (also better
-	// performance)
-	std::map<std::pair<RegionIndex, ActionType>, std::shared_ptr<SearchTreeNode>> children = {};
+	/** The children of the node, which are reachable by a single transition, sorted by action. */
+	Children children;
+	/** Protects the child counters, which may be updated by multiple children concurrently. Also
+	 * serializes adding parents to the node. */
+	std::mutex child_counters_mutex;
+	/** The child counters, only allocated while the node is evaluated incrementally. */
+	std::unique_ptr<ChildCounterState> child_counter_state;
+	/** Pointers to the packed words of the node if the words have been released. */
+	std::vector<const PackedCanonicalABWord *> released_words;
+	/** The table that the released words have been packed with. */
+	SymbolTable *packed_symbols = nullptr;
 };
 
 /** Print a node state. */
@@ -335,7 +633,7 @@ print_to_ostream(std::ostream
                  __attribute__((unused)) bool         print_children = false,
                  __attribute__((unused)) unsigned int indent         = 0)
 {
-	os << node.words << ": " << node.state << " " << node.label;
+	os << node.get_words() << ": " << node.state << " " << node.label;
 }
 
 /** Print a node
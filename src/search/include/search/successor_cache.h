@@ -0,0 +1,111 @@
+/***************************************************************************
+ *  successor_cache.h - A bounded cache of the symbol successors of canonical words
+ *
+ *  Created:   Sat 17 Oct 20:48:05 CEST 2026
+ *  Copyright  2026  Till Hofmann <hofmann@kbsg.rwth-aachen.de>
+ *  SPDX-License-Identifier: LGPL-3.0-or-later
+ ****************************************************************************/
+
+#pragma once
+
+#include "canonical_word.h"
+#include "utilities/clock_cache.h"
+#include "word_interning.h"
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <utility>
+
+namespace tacos::search {
+
+/** @brief A bounded, thread-safe cache of the symbol successors of time successor words.
+ *
+ * The successors of a word are computed by the plant adapter (get_next_canonical_words) from a
+ * candidate of the word. As the candidate only depends on the word, the successors can be shared
+ * between all nodes that contain the same time successor. The cache is keyed by the hash of each
+ * word and owns a copy of the word, which is evicted together with its successors. Words with the
+ * same hash are cached side by side and told apart by their copies. The memory of
+ * the cached words and successors is bounded by a budget in bytes; if the budget is exceeded,
+ * entries are evicted with the clock algorithm.
+ * @see utilities::ClockCache
+ */
+template <typename Location, typename ActionType, typename ConstraintSymbolType>
+class SuccessorCache
+{
+public:
+	/** The type of the cached words. */
+	using Word = CanonicalABWord<Location, ConstraintSymbolType>;
+	/** The successors of a word, grouped by the symbol that leads to the successor. */
+	using Successors = std::multimap<ActionType, Word>;
+	/** The default memory budget in bytes. */
+	static constexpr std::size_t default_budget = std::size_t{64} << 20;
+
+	/** Construct the cache.
+	 * @param budget The maximal (estimated) memory of all cached words and successors in bytes
+	 */
+	explicit SuccessorCache(std::size_t budget = default_budget)
+	: entries_(budget, &estimate_entry_memory)
+	{
+	}
+
+	/** Get the successors of a word, compute them if they are not cached.
+	 * @param word The time successor word to get the successors of
+	 * @param compute A Callable that computes the successors of the word
+	 * @return A pointer to the successors of the word
+	 */
+	template <typename Compute>
+	std::shared_ptr<const Successors>
+	get_successors(const Word &word, Compute &&compute)
+	{
+		const auto entry =
+		  entries_.get_or_compute(hash_word(word),
+		                          [&word](const Entry &cached) { return cached.word == word; },
+		                          [&word, &compute] { return Entry{word, compute()}; });
+		// Share the ownership of the entry, so the successors stay valid if the entry is evicted.
+		return std::shared_ptr<const Successors>(entry, &entry->successors);
+	}
+
+	/** Set the maximal (estimated) memory of all cached words and successors.
+	 * @param budget The budget in bytes
+	 */
+	void
+	set_budget(std::size_t budget)
+	{
+		entries_.set_budget(budget);
+	}
+
+	/** Get the statistics of the cache, the cost is the estimated memory in bytes. */
+	utilities::CacheStatistics
+	get_statistics() const
+	{
+		return entries_.get_statistics();
+	}
+
+private:
+	/** A cached word together with its successors. */
+	struct Entry
+	{
+		/** The word, which tells the entry apart from entries of other words with the same hash. */
+		Word word;
+		/** The successors of the word. */
+		Successors successors;
+	};
+
+	/** Estimate the memory that is used by a word and its successors. */
+	static std::size_t
+	estimate_entry_memory(const Entry &entry)
+	{
+		// The overhead of a node in a red-black tree: color, parent, left and right.
+		constexpr std::size_t tree_node_overhead = 4 * sizeof(void *);
+		std::size_t           size               = sizeof(entry) + estimate_memory(entry.word);
+		for (const auto &[_, word] : entry.successors) {
+			size += tree_node_overhead + sizeof(ActionType) + estimate_memory(word);
+		}
+		return size;
+	}
+
+	utilities::ClockCache<std::size_t, Entry> entries_;
+};
+
+} // namespace tacos::search
@@ -14,6 +14,7 @@
 #include "automata/ta_regions.h"
 #include "canonical_word.h"
 #include "mtl/MTLFormula.h"
+#include "reg_a.h"
 #include "utilities/numbers.h"
 #include "utilities/types.h"
 
@@ -23,8 +24,10 @@
 #include <algorithm>
 #include <iterator>
 #include <stdexcept>
+#include <string_view>
 #include <type_traits>
 #include <variant>
+#include <vector>
 
 namespace tacos::search {
 
@@ -177,6 +180,19 @@ get_candidate(const CanonicalABWord<Location, ConstraintSymbolType> &word)
 	PlantConfiguration<Location>           plant_configuration{};
 	ATAConfiguration<ConstraintSymbolType> ata_configuration{};
 	const Time                             time_delta = Time(1) / Time(word.size() + 1);
+	// Collect all clocks first so the valuation does not switch its registry for each clock.
+	std::vector<std::string_view> clocks;
+	for (const auto &abs_i : word) {
+		for (const auto &symbol : abs_i) {
+			if (std::holds_alternative<PlantRegionState<Location>>(symbol)) {
+				clocks.push_back(std::get<PlantRegionState<Location>>(symbol).clock);
+			}
+		}
+	}
+	std::sort(std::begin(clocks), std::end(clocks));
+	clocks.erase(std::unique(std::begin(clocks), std::end(clocks)), std::end(clocks));
+	plant_configuration.clock_valuations =
+	  ClockSetValuation{ClockRegistry::get(std::begin(clocks), std::end(clocks))};
 	for (std::size_t i = 0; i < word.size(); i++) {
 		const auto &abs_i = word[i];
 		for (const ABRegionSymbol<Location, ConstraintSymbolType> &symbol : abs_i) {
@@ -190,7 +206,7 @@ get_candidate(const CanonicalABWord<Location, ConstraintSymbolType> &word)
 				const auto &clock_name    = ta_region_state.clock;
 				// update ta_configuration
 				plant_configuration.location                     = ta_region_state.location;
-				plant_configuration.clock_valuations[clock_name] = integral_part + fractional_part;
+				plant_configuration.clock_valuations.at(clock_name) = integral_part + fractional_part;
 			} else { // ATARegionState<ConstraintSymbolType>
 				const auto       &ata_region_state = std::get<ATARegionState<ConstraintSymbolType>>(symbol);
 				const RegionIndex region_index     = ata_region_state.region_index;
@@ -245,16 +261,19 @@ get_time_successors(const CanonicalABWord<Location, ConstraintSymbolType> &canon
 	}
 	return time_successors;
 }
-/** Compute the direct time successors which introduce an increment in the ATA configuration for each of the passed words.
+namespace details {
+
+/** Compute the direct time successors which introduce an increment in the ATA configuration for
+ * each of the passed words.
  * @param canonical_words The set of canonical words to compute time successors of
- * @param K The maximal constant
+ * @param get_successor A Callable that returns the time successor of a single word
  * @return All direct time successors of the passed words
  */
-template <typename Location, typename ConstraintSymbolType>
+template <typename Location, typename ConstraintSymbolType, typename TimeSuccessorFunction>
 std::set<CanonicalABWord<Location, ConstraintSymbolType>>
 get_next_time_successors(
   const std::set<CanonicalABWord<Location, ConstraintSymbolType>> &canonical_words,
-  RegionIndex                                                      K)
+  TimeSuccessorFunction                                          &&get_successor)
 {
 	assert(!canonical_words.empty());
 	assert(std::all_of(std::begin(canonical_words), std::end(canonical_words), [&](const auto &word) {
@@ -265,7 +284,7 @@ get_next_time_successors(
 	         CanonicalABWord<Location, ConstraintSymbolType>>
 	  successors_map;
 	for (const auto &word : canonical_words) {
-		successors_map[word] = get_time_successor(word, K);
+		successors_map[word] = get_successor(word);
 	}
 	if (std::any_of(std::begin(successors_map), std::end(successors_map), [](const auto &map_entry) {
 		    return reg_a(map_entry.first) == reg_a(map_entry.second);
@@ -288,22 +307,22 @@ get_next_time_successors(
 	return successors;
 }
 
-/** Compute all time successors of a set of canonical words (i.e., of a node in the search tree).
+/** Compute all time successors of a set of canonical words.
  * @param canonical_words A set of canonical words to compute the time successors of
- * @param K The maximal constant
- * @return A map of time successors of each word along with the region increment to reach the
- * successor
+ * @param get_successor A Callable that returns the time successor of a single word
+ * @return The time successors of the set, the nth entry is reached with region increment n
  */
-template <typename Location, typename ConstraintSymbolType>
+template <typename Location, typename ConstraintSymbolType, typename TimeSuccessorFunction>
 std::vector<std::set<CanonicalABWord<Location, ConstraintSymbolType>>>
 get_time_successors(
   const std::set<CanonicalABWord<Location, ConstraintSymbolType>> &canonical_words,
-  RegionIndex                                                      K)
+  TimeSuccessorFunction                                          &&get_successor)
 {
 	std::vector<std::set<CanonicalABWord<Location, ConstraintSymbolType>>> successors;
 	successors.push_back(canonical_words);
 	while (true) {
-		const auto next = get_next_time_successors(successors.back(), K);
+		const auto next =
+		  get_next_time_successors<Location, ConstraintSymbolType>(successors.back(), get_successor);
 		if (next != successors.back()) {
 			successors.push_back(next);
 		} else {
@@ -313,4 +332,37 @@ get_time_successors(
 	return successors;
 }
 
+} // namespace details
+
+/** Compute the direct time successors which introduce an increment in the ATA configuration for each of the passed words.
+ * @param canonical_words The set of canonical words to compute time successors of
+ * @param K The maximal constant
+ * @return All direct time successors of the passed words
+ */
+template <typename Location, typename ConstraintSymbolType>
+std::set<CanonicalABWord<Location, ConstraintSymbolType>>
+get_next_time_successors(
+  const std::set<CanonicalABWord<Location, ConstraintSymbolType>> &canonical_words,
+  RegionIndex                                                      K)
+{
+	return details::get_next_time_successors<Location, ConstraintSymbolType>(
+	  canonical_words, [K](const auto &word) { return get_time_successor(word, K); });
+}
+
+/** Compute all time successors of a set of canonical words (i.e., of a node in the search tree).
+ * @param canonical_words A set of canonical words to compute the time successors of
+ * @param K The maximal constant
+ * @return A map of time successors of each word along with the region increment to reach the
+ * successor
+ */
+template <typename Location, typename ConstraintSymbolType>
+std::vector<std::set<CanonicalABWord<Location, ConstraintSymbolType>>>
+get_time_successors(
+  const std::set<CanonicalABWord<Location, ConstraintSymbolType>> &canonical_words,
+  RegionIndex                                                      K)
+{
+	return details::get_time_successors<Location, ConstraintSymbolType>(
+	  canonical_words, [K](const auto &word) { return get_time_successor(word, K); });
+}
+
 } // namespace tacos::search
@@ -14,6 +14,16 @@
 
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <map>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <variant>
 #include <vector>
 
 namespace tacos::search {
@@ -75,10 +85,9 @@ public:
 		  CanonicalABWord<typename automata::ta::TimedAutomaton<LocationT, ActionType>::Location,
 		                  ConstraintSymbolType>>
 		  successors;
-		for (const auto &symbol : ta.get_alphabet()) {
+		// Only symbols with at least one TA successor may lead to a successor word.
+		for (const auto &[symbol, ta_successors] : ta.make_symbol_steps(ab_configuration.first)) {
 			SPDLOG_TRACE("({}, {}): Symbol {}", ab_configuration.first, ab_configuration.second, symbol);
-			const std::set<typename automata::ta::TimedAutomaton<LocationT, ActionType>::Configuration>
-			  ta_successors = ta.make_symbol_step(ab_configuration.first, symbol);
 			std::set<ATAConfiguration<ConstraintSymbolType>> ata_successors;
 			if constexpr (!use_location_constraints) {
 				ata_successors = ata.make_symbol_step(ab_configuration.second, symbol);
@@ -114,6 +123,138 @@ public:
 		}
 		return successors;
 	}
+
+	/** Get the next canonical words directly from a canonical word.
+	 * This computes the same successors as the overload that expects a candidate of the word, but it
+	 * evaluates all clock constraints on the region indexes of the word and builds the successor
+	 * words from the regions. A symbol of the word keeps its region index and its position among the
+	 * fractional parts, unless its clock is reset.
+	 */
+	std::multimap<
+	  ActionType,
+	  CanonicalABWord<typename automata::ta::TimedAutomaton<LocationT, ActionType>::Location,
+	                  ConstraintSymbolType>>
+	operator()(
+	  const automata::ta::TimedAutomaton<LocationT, ActionType> &ta,
+	  const automata::ata::AlternatingTimedAutomaton<logic::MTLFormula<ConstraintSymbolType>,
+	                                                 logic::AtomicProposition<ConstraintSymbolType>>
+	    &ata,
+	  const CanonicalABWord<typename automata::ta::TimedAutomaton<LocationT, ActionType>::Location,
+	                        ConstraintSymbolType> &word,
+	  const RegionIndex,
+	  [[maybe_unused]] const RegionIndex K)
+	{
+		const Location        *location = nullptr;
+		ClockStates            clocks;
+		ATARegionConfiguration ata_configuration;
+		for (std::size_t partition = 0; partition < word.size(); ++partition) {
+			for (const auto &symbol : word[partition]) {
+				// The rank of a fractional part is the index of its partition, shifted by one such that 0
+				// is reserved for the fractional part 0.
+				const std::size_t fractional_rank =
+				  get_region_index(symbol) % 2 == 0 ? 0 : partition + 1;
+				if (std::holds_alternative<PlantRegionState<Location>>(symbol)) {
+					const auto &state = std::get<PlantRegionState<Location>>(symbol);
+					location          = &state.location;
+					clocks.emplace_back(&state, fractional_rank);
+				} else {
+					const auto &state = std::get<ATARegionState<ConstraintSymbolType>>(symbol);
+					ata_configuration.insert({state.formula, state.region_index, fractional_rank});
+				}
+			}
+		}
+		if (location == nullptr) {
+			throw std::invalid_argument("TA without clocks are not supported");
+		}
+		const auto get_clock_region_index = [&clocks](const std::string &clock) {
+			const auto state = std::find_if(std::begin(clocks),
+			                                std::end(clocks),
+			                                [&clock](const auto &c) { return c.first->clock == clock; });
+			assert(state != std::end(clocks));
+			return state->first->region_index;
+		};
+		const auto transitions =
+		  ta.get_enabled_transitions_in_region(*location, get_clock_region_index);
+		std::multimap<ActionType, Word>  successors;
+		std::set<ATARegionConfiguration> ata_successors;
+		// The successors for the current symbol, the transitions are ordered by symbol.
+		std::set<Word> symbol_successors;
+		for (auto transition = std::begin(transitions); transition != std::end(transitions);
+		     ++transition) {
+			const auto &symbol = (*transition)->get_label();
+			if (transition == std::begin(transitions)
+			    || (*std::prev(transition))->get_label() != symbol) {
+				symbol_successors.clear();
+				if constexpr (!use_location_constraints) {
+					ata_successors = ata.make_region_symbol_step(ata_configuration, symbol);
+				}
+			}
+			if constexpr (use_location_constraints) {
+				ata_successors =
+				  ata.make_region_symbol_step(ata_configuration,
+				                              logic::AtomicProposition{(*transition)->get_target()});
+			}
+			for (const auto &ata_successor : ata_successors) {
+				symbol_successors.insert(get_successor_word((*transition)->get_target(),
+				                                            clocks,
+				                                            (*transition)->get_reset(),
+				                                            ata_successor,
+				                                            word.size()));
+			}
+			if (std::next(transition) == std::end(transitions)
+			    || (*std::next(transition))->get_label() != symbol) {
+				for (const auto &successor : symbol_successors) {
+					SPDLOG_TRACE("{}: Getting {} with symbol {}", word, successor, symbol);
+					successors.emplace_hint(std::end(successors), symbol, successor);
+				}
+			}
+		}
+		return successors;
+	}
+
+private:
+	using Location = typename automata::ta::TimedAutomaton<LocationT, ActionType>::Location;
+	using Word     = CanonicalABWord<Location, ConstraintSymbolType>;
+	/** The plant region states of a word, each with the rank of its fractional part. */
+	using ClockStates = std::vector<std::pair<const PlantRegionState<Location> *, std::size_t>>;
+	using ATARegionConfiguration =
+	  automata::ata::RegionConfiguration<logic::MTLFormula<ConstraintSymbolType>>;
+
+	/** Build the canonical word that is reached from a word by taking a transition.
+	 * @param location The target location of the transition
+	 * @param clocks The plant region states of the word and their fractional ranks
+	 * @param resets The clocks that are reset by the transition
+	 * @param ata_configuration The ATA region configuration after the symbol step
+	 * @param num_partitions The number of partitions of the word
+	 * @return The successor word
+	 */
+	static Word
+	get_successor_word(const Location               &location,
+	                   const ClockStates            &clocks,
+	                   const std::set<std::string>  &resets,
+	                   const ATARegionConfiguration &ata_configuration,
+	                   std::size_t                   num_partitions)
+	{
+		// Partition the symbols by their fractional rank, a reset moves a clock to rank 0.
+		Word partitions(num_partitions + 1);
+		for (const auto &[state, fractional_rank] : clocks) {
+			if (resets.count(state->clock) > 0) {
+				partitions[0].insert(PlantRegionState<Location>{location, state->clock, 0});
+			} else {
+				partitions[fractional_rank].insert(
+				  PlantRegionState<Location>{location, state->clock, state->region_index});
+			}
+		}
+		for (const auto &state : ata_configuration) {
+			partitions[state.fractional_rank].insert(
+			  ATARegionState<ConstraintSymbolType>{state.location, state.region_index});
+		}
+		partitions.erase(std::remove_if(std::begin(partitions),
+		                                std::end(partitions),
+		                                [](const auto &partition) { return partition.empty(); }),
+		                 std::end(partitions));
+		return partitions;
+	}
 };
 
 } // namespace tacos::search
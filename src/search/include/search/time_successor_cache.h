@@ -0,0 +1,130 @@
+/***************************************************************************
+ *  time_successor_cache.h - A bounded cache of time successor chains
+ *
+ *  Created:   Sat 17 Oct 18:20:31 CEST 2026
+ *  Copyright  2026  Till Hofmann <hofmann@kbsg.rwth-aachen.de>
+ *  SPDX-License-Identifier: LGPL-3.0-or-later
+ ****************************************************************************/
+
+#pragma once
+
+#include "canonical_word.h"
+#include "synchronous_product.h"
+#include "utilities/clock_cache.h"
+#include "word_interning.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <set>
+#include <vector>
+
+namespace tacos::search {
+
+/** @brief A bounded, thread-safe cache of time successor chains.
+ *
+ * For each word, the cache stores the full chain of time successors, starting with the word itself
+ * and ending with the first word that is its own time successor. The chain has at most 2K+2
+ * entries. The cache is keyed by the hash of each word. As the chain starts with the word itself,
+ * chains of different words with the same hash are cached side by side and told apart by their
+ * first word. If the cache is full, chains are evicted with the clock algorithm, together with
+ * their words.
+ * @see utilities::ClockCache
+ */
+template <typename Location, typename ConstraintSymbolType>
+class TimeSuccessorCache
+{
+public:
+	/** The type of the cached words. */
+	using Word = CanonicalABWord<Location, ConstraintSymbolType>;
+	/** A chain of time successors, the nth entry is the nth time successor. */
+	using Chain = std::vector<Word>;
+
+	/** Construct the cache.
+	 * @param K The maximal constant
+	 * @param capacity The maximal number of cached chains
+	 */
+	explicit TimeSuccessorCache(RegionIndex K, std::size_t capacity = 4096)
+	: K_(K), chains_(capacity)
+	{
+	}
+
+	/** Get the chain of time successors of a word.
+	 * @param word The word to get the time successors of
+	 * @return The chain of time successors, starting with the word itself
+	 */
+	std::shared_ptr<const Chain>
+	get_time_successors(const Word &word)
+	{
+		return chains_.get_or_compute(hash_word(word),
+		                              [&word](const Chain &chain) { return chain.front() == word; },
+		                              [this, &word] { return compute_chain(word); });
+	}
+
+	/** Get the direct time successor of a word.
+	 * @param word The word to get the time successor of
+	 * @return The time successor, which is the word itself if time cannot change the word
+	 */
+	Word
+	get_time_successor(const Word &word)
+	{
+		const auto chain = get_time_successors(word);
+		return (*chain)[std::min<std::size_t>(1, chain->size() - 1)];
+	}
+
+	/** Get the nth time successor of a word.
+	 * @param word The word to get the time successor of
+	 * @param n The number of time steps
+	 * @return The nth time successor of the word
+	 */
+	Word
+	get_nth_time_successor(const Word &word, RegionIndex n)
+	{
+		const auto chain = get_time_successors(word);
+		return (*chain)[std::min<std::size_t>(n, chain->size() - 1)];
+	}
+
+	/** Get the statistics of the cache. */
+	utilities::CacheStatistics
+	get_statistics() const
+	{
+		return chains_.get_statistics();
+	}
+
+private:
+	/** Compute the chain of time successors of a word. */
+	Chain
+	compute_chain(const Word &word) const
+	{
+		// The member functions hide the free functions, so we need to qualify the call.
+		Chain chain{word};
+		auto  next = tacos::search::get_time_successor(word, K_);
+		while (next != chain.back()) {
+			chain.push_back(next);
+			next = tacos::search::get_time_successor(chain.back(), K_);
+		}
+		return chain;
+	}
+
+	const RegionIndex                         K_;
+	utilities::ClockCache<std::size_t, Chain> chains_;
+};
+
+/** Compute all time successors of a set of canonical words using a TimeSuccessorCache.
+ * This is the same as get_time_successors with a maximal constant, but looks up the time successor
+ * of each word in the cache.
+ * @param canonical_words A set of canonical words to compute the time successors of
+ * @param cache The cache to look up the time successors of each word
+ * @return The time successors of the set, the nth entry is reached with region increment n
+ */
+template <typename Location, typename ConstraintSymbolType>
+std::vector<std::set<CanonicalABWord<Location, ConstraintSymbolType>>>
+get_time_successors(
+  const std::set<CanonicalABWord<Location, ConstraintSymbolType>> &canonical_words,
+  TimeSuccessorCache<Location, ConstraintSymbolType>              &cache)
+{
+	return details::get_time_successors<Location, ConstraintSymbolType>(
+	  canonical_words, [&cache](const auto &word) { return cache.get_time_successor(word); });
+}
+
+} // namespace tacos::search
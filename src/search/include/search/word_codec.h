@@ -0,0 +1,312 @@
+/***************************************************************************
+ *  word_codec.h - Encode canonical words into a portable binary format
+ *
+ *  Created:   Sun 18 Oct 10:41:12 CEST 2026
+ *  Copyright  2026  Till Hofmann <hofmann@kbsg.rwth-aachen.de>
+ *  SPDX-License-Identifier: LGPL-3.0-or-later
+ ****************************************************************************/
+
+#pragma once
+
+#include "canonical_word.h"
+#include "mtl/MTLFormula.h"
+#include "utilities/Interval.h"
+#include "utilities/type_traits.h"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace tacos::search {
+
+/** @brief Encode canonical words and their components into a compact binary format.
+ *
+ * The encoding only depends on the encoded values and not on the state of the process, e.g., the
+ * IDs of hash-consed formulas. Thus, the encoding can be decoded by another process with a
+ * WordDecoder, and equal values always have the same encoding, so the encoding can be hashed to
+ * assign values to processes consistently. Integers are encoded as variable-length integers,
+ * containers with their size followed by their elements. The elements of sets are ordered by their
+ * encodings rather than by the order of the set.
+ */
+class WordEncoder
+{
+public:
+	/** Append the encoding of a value.
+	 * @param value The value to encode, e.g., a set of canonical words
+	 */
+	template <typename T>
+	void
+	write(const T &value)
+	{
+		if constexpr (std::is_enum_v<T>) {
+			write_integer(static_cast<std::uint64_t>(value));
+		} else if constexpr (std::is_integral_v<T>) {
+			static_assert(std::is_unsigned_v<T>, "Only unsigned integers are supported");
+			write_integer(value);
+		} else if constexpr (std::is_same_v<T, std::string>) {
+			write_integer(value.size());
+			buffer_.append(value);
+		} else if constexpr (utilities::is_specialization<T, std::vector>::value) {
+			write_integer(value.size());
+			for (const auto &element : value) {
+				write(element);
+			}
+		} else if constexpr (utilities::is_specialization<T, std::set>::value) {
+			// The order of a set may depend on the process, e.g., on the creation order of formulas.
+			// Sort the encodings of the elements, so equal sets have the same encoding.
+			std::vector<std::string> elements;
+			elements.reserve(value.size());
+			for (const auto &element : value) {
+				WordEncoder encoder;
+				encoder.write(element);
+				elements.push_back(encoder.take_buffer());
+			}
+			std::sort(std::begin(elements), std::end(elements));
+			write_integer(value.size());
+			for (const auto &element : elements) {
+				buffer_.append(element);
+			}
+		} else if constexpr (utilities::is_specialization<T, std::variant>::value) {
+			write_integer(value.index());
+			std::visit([this](const auto &alternative) { write(alternative); }, value);
+		} else if constexpr (utilities::is_specialization<T, PlantRegionState>::value) {
+			write(value.location);
+			write(value.clock);
+			write(value.region_index);
+		} else if constexpr (utilities::is_specialization<T, ATARegionState>::value) {
+			write(value.formula);
+			write(value.region_index);
+		} else if constexpr (utilities::is_specialization<T, logic::MTLFormula>::value) {
+			write_formula(value);
+		} else if constexpr (utilities::is_specialization<T, logic::AtomicProposition>::value) {
+			write(value.ap_);
+		} else if constexpr (utilities::is_named_type<T>::value) {
+			write(value.get());
+		} else {
+			static_assert(!sizeof(T), "Cannot encode values of this type");
+		}
+	}
+
+	/** Append an unsigned integer with a variable-length encoding. */
+	void
+	write_integer(std::uint64_t value)
+	{
+		while (value >= 0x80) {
+			buffer_.push_back(static_cast<char>((value & 0x7f) | 0x80));
+			value >>= 7;
+		}
+		buffer_.push_back(static_cast<char>(value));
+	}
+
+	/** Get the encoding of all values that have been written so far. */
+	const std::string &
+	get_buffer() const
+	{
+		return buffer_;
+	}
+
+	/** Get the encoding of all values that have been written so far and reset the encoder. */
+	std::string
+	take_buffer()
+	{
+		return std::move(buffer_);
+	}
+
+private:
+	template <typename APType>
+	void
+	write_formula(const logic::MTLFormula<APType> &formula)
+	{
+		const logic::LOP op = formula.get_operator();
+		write(op);
+		if (op == logic::LOP::AP) {
+			write(formula.get_atomicProposition());
+		} else if (op == logic::LOP::LUNTIL || op == logic::LOP::LDUNTIL) {
+			const auto interval = formula.get_interval();
+			write(interval.lowerBoundType());
+			write(interval.lower());
+			write(interval.upperBoundType());
+			write(interval.upper());
+		}
+		write(formula.get_operands());
+	}
+
+	std::string buffer_;
+};
+
+/** @brief Decode values that have been encoded with a WordEncoder.
+ *
+ * The values must be read with the same types and in the same order as they were written.
+ * Formulas are constructed again, so they refer to the same hash-consed formulas as all other
+ * equal formulas of the process.
+ */
+class WordDecoder
+{
+public:
+	/** Initialize the decoder.
+	 * @param data The encoded values, must outlive the decoder
+	 */
+	explicit WordDecoder(std::string_view data) : data_(data)
+	{
+	}
+
+	/** Read the next value.
+	 * @return The decoded value
+	 * @throw std::invalid_argument if the data is not a valid encoding of a value of type T
+	 */
+	template <typename T>
+	T
+	read()
+	{
+		if constexpr (std::is_enum_v<T>) {
+			return static_cast<T>(read_integer());
+		} else if constexpr (std::is_integral_v<T>) {
+			return static_cast<T>(read_integer());
+		} else if constexpr (std::is_same_v<T, std::string>) {
+			const auto size = read_integer();
+			if (size > data_.size() - position_) {
+				throw std::invalid_argument("Unexpected end of encoded string");
+			}
+			std::string value{data_.substr(position_, size)};
+			position_ += size;
+			return value;
+		} else if constexpr (utilities::is_specialization<T, std::vector>::value) {
+			T          value;
+			const auto size = read_integer();
+			for (std::uint64_t i = 0; i < size; ++i) {
+				value.push_back(read<typename T::value_type>());
+			}
+			return value;
+		} else if constexpr (utilities::is_specialization<T, std::set>::value) {
+			T          value;
+			const auto size = read_integer();
+			for (std::uint64_t i = 0; i < size; ++i) {
+				value.insert(std::end(value), read<typename T::value_type>());
+			}
+			return value;
+		} else if constexpr (utilities::is_specialization<T, std::variant>::value) {
+			return read_variant<T>(read_integer(), std::make_index_sequence<std::variant_size_v<T>>{});
+		} else if constexpr (utilities::is_specialization<T, PlantRegionState>::value) {
+			auto location     = read<decltype(T::location)>();
+			auto clock        = read<std::string>();
+			auto region_index = read<RegionIndex>();
+			return T{std::move(location), std::move(clock), region_index};
+		} else if constexpr (utilities::is_specialization<T, ATARegionState>::value) {
+			auto formula      = read<decltype(T::formula)>();
+			auto region_index = read<RegionIndex>();
+			return T{std::move(formula), region_index};
+		} else if constexpr (utilities::is_specialization<T, logic::MTLFormula>::value) {
+			return read_formula<T>();
+		} else if constexpr (utilities::is_specialization<T, logic::AtomicProposition>::value) {
+			return T{read<decltype(std::declval<T>().ap_)>()};
+		} else if constexpr (utilities::is_named_type<T>::value) {
+			return T{read<typename T::UnderlyingType>()};
+		} else {
+			static_assert(!sizeof(T), "Cannot decode values of this type");
+		}
+	}
+
+	/** Read the next variable-length unsigned integer. */
+	std::uint64_t
+	read_integer()
+	{
+		std::uint64_t value = 0;
+		for (unsigned int shift = 0; shift < 64; shift += 7) {
+			if (position_ >= data_.size()) {
+				throw std::invalid_argument("Unexpected end of encoded integer");
+			}
+			const auto byte = static_cast<unsigned char>(data_[position_++]);
+			value |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+			if ((byte & 0x80) == 0) {
+				return value;
+			}
+		}
+		throw std::invalid_argument("Encoded integer is too long");
+	}
+
+	/** Check whether all data has been read. */
+	bool
+	at_end() const
+	{
+		return position_ == data_.size();
+	}
+
+private:
+	template <typename Variant, std::size_t... Indices>
+	Variant
+	read_variant(std::uint64_t index, std::index_sequence<Indices...>)
+	{
+		if (index >= sizeof...(Indices)) {
+			throw std::invalid_argument(fmt::format("Invalid encoded variant index {}", index));
+		}
+		using Reader = Variant (WordDecoder::*)();
+		static constexpr Reader readers[] = {&WordDecoder::read_alternative<Variant, Indices>...};
+		return (this->*readers[index])();
+	}
+
+	template <typename Variant, std::size_t Index>
+	Variant
+	read_alternative()
+	{
+		return Variant{std::in_place_index<Index>, read<std::variant_alternative_t<Index, Variant>>()};
+	}
+
+	template <typename Formula>
+	Formula
+	read_formula()
+	{
+		using logic::LOP;
+		using utilities::arithmetic::BoundType;
+		using APType  = typename utilities::first_template_argument<Formula>::type;
+		using AP      = logic::AtomicProposition<APType>;
+		const auto op = read<LOP>();
+		std::optional<AP>                  ap;
+		std::optional<logic::TimeInterval> interval;
+		if (op == LOP::AP) {
+			ap = read<AP>();
+		} else if (op == LOP::LUNTIL || op == LOP::LDUNTIL) {
+			const auto lower_bound_type = read<BoundType>();
+			const auto lower            = read<Endpoint>();
+			const auto upper_bound_type = read<BoundType>();
+			const auto upper            = read<Endpoint>();
+
+			interval = logic::TimeInterval{lower, lower_bound_type, upper, upper_bound_type};
+		}
+		const auto operands           = read<std::vector<Formula>>();
+		const auto check_num_operands = [&operands, op](std::size_t expected) {
+			if (operands.size() != expected) {
+				throw std::invalid_argument(fmt::format("Invalid number of operands {} for operator {}",
+				                                        operands.size(),
+				                                        static_cast<int>(op)));
+			}
+		};
+		switch (op) {
+		case LOP::TRUE: check_num_operands(0); return Formula::TRUE();
+		case LOP::FALSE: check_num_operands(0); return Formula::FALSE();
+		case LOP::AP: check_num_operands(0); return Formula{*ap};
+		case LOP::LAND: return Formula::create_conjunction(operands);
+		case LOP::LOR: return Formula::create_disjunction(operands);
+		case LOP::LNEG: check_num_operands(1); return !operands.front();
+		case LOP::LUNTIL: check_num_operands(2); return operands[0].until(operands[1], *interval);
+		case LOP::LDUNTIL:
+			check_num_operands(2);
+			return operands[0].dual_until(operands[1], *interval);
+		}
+		throw std::invalid_argument(fmt::format("Invalid formula operator {}", static_cast<int>(op)));
+	}
+
+	std::string_view data_;
+	std::size_t      position_{0};
+};
+
+} // namespace tacos::search
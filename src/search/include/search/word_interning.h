@@ -0,0 +1,375 @@
+/***************************************************************************
+ *  word_interning.h - Intern canonical words and sets of canonical words
+ *
+ *  Created:   Fri 16 Oct 09:12:40 CEST 2026
+ *  Copyright  2026  Till Hofmann <hofmann@kbsg.rwth-aachen.de>
+ *  SPDX-License-Identifier: LGPL-3.0-or-later
+ ****************************************************************************/
+
+#pragma once
+
+#include "canonical_word.h"
+#include "packed_canonical_word.h"
+#include "utilities/type_traits.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace tacos::search {
+
+/** The ID of an interned canonical word. */
+using WordId = std::uint32_t;
+
+/** @brief A key that identifies a set of canonical words.
+ *
+ * The key consists of the sorted IDs of the interned words in the set and a hash over those IDs,
+ * which is computed once on construction. Comparing two keys is therefore cheap compared to
+ * comparing the word sets themselves, and the key can directly be used in hash tables.
+ */
+class WordSetKey
+{
+public:
+	/** Construct a key from a list of word IDs.
+	 * @param ids The IDs of the words in the set, in any order
+	 */
+	explicit WordSetKey(std::vector<WordId> ids = {}) : ids_(std::move(ids))
+	{
+		std::sort(std::begin(ids_), std::end(ids_));
+		ids_.erase(std::unique(std::begin(ids_), std::end(ids_)), std::end(ids_));
+		// FNV-1a over the sorted IDs.
+		std::uint64_t hash = 14695981039346656037ULL;
+		for (const auto id : ids_) {
+			hash ^= id;
+			hash *= 1099511628211ULL;
+		}
+		hash_ = static_cast<std::size_t>(hash);
+	}
+
+	/** Get the sorted IDs of the words in the set. */
+	const std::vector<WordId> &
+	get_ids() const
+	{
+		return ids_;
+	}
+
+	/** Get the precomputed hash of the key. */
+	std::size_t
+	get_hash() const
+	{
+		return hash_;
+	}
+
+	/** Compare two keys for equality. */
+	friend bool
+	operator==(const WordSetKey &first, const WordSetKey &second)
+	{
+		return first.hash_ == second.hash_ && first.ids_ == second.ids_;
+	}
+
+	/** Compare two keys for inequality. */
+	friend bool
+	operator!=(const WordSetKey &first, const WordSetKey &second)
+	{
+		return !(first == second);
+	}
+
+private:
+	std::vector<WordId> ids_;
+	std::size_t         hash_;
+};
+
+/** Hash function for WordSetKey, which just returns the precomputed hash. */
+struct WordSetKeyHash
+{
+	/** Get the hash of the key. */
+	std::size_t
+	operator()(const WordSetKey &key) const
+	{
+		return key.get_hash();
+	}
+};
+
+namespace details {
+
+/** Combine a hash value with the hash of another value. */
+inline std::size_t
+combine_hash(std::size_t seed, std::size_t hash)
+{
+	return seed ^ (hash + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2));
+}
+
+/** Hash a plant location. Strong types and containers are hashed by their elements, all other
+ * locations must specialize std::hash. */
+template <typename LocationT>
+std::size_t
+hash_location(const LocationT &location)
+{
+	// Strong types are unwrapped first, as their hash may only be declared but not defined for the
+	// wrapped type.
+	if constexpr (utilities::is_named_type<LocationT>::value) {
+		return hash_location(location.get());
+	} else if constexpr (utilities::is_hashable<LocationT>::value) {
+		return std::hash<LocationT>{}(location);
+	} else if constexpr (utilities::is_specialization<LocationT, std::vector>::value
+	                     || utilities::is_specialization<LocationT, std::set>::value) {
+		std::size_t hash = location.size();
+		for (const auto &element : location) {
+			hash = combine_hash(hash, hash_location(element));
+		}
+		return hash;
+	} else {
+		static_assert(!sizeof(LocationT), "Plant locations must be hashable");
+	}
+}
+
+} // namespace details
+
+/** @brief Compute the hash of a canonical word.
+ *
+ * Formulas are hashed by their hash-consed ID, so the hash is only consistent within a single
+ * process.
+ * @param word The word to hash
+ * @return The hash of the word
+ */
+template <typename LocationT, typename ConstraintSymbolT>
+std::size_t
+hash_word(const CanonicalABWord<LocationT, ConstraintSymbolT> &word)
+{
+	std::size_t hash = word.size();
+	for (const auto &partition : word) {
+		hash = details::combine_hash(hash, partition.size());
+		for (const auto &symbol : partition) {
+			if (const auto *plant_state = std::get_if<PlantRegionState<LocationT>>(&symbol)) {
+				hash = details::combine_hash(hash, details::hash_location(plant_state->location));
+				hash = details::combine_hash(hash, std::hash<std::string>{}(plant_state->clock));
+				hash = details::combine_hash(hash, plant_state->region_index);
+			} else {
+				const auto &ata_state = std::get<ATARegionState<ConstraintSymbolT>>(symbol);
+				const auto  formula_hash =
+				  std::hash<logic::MTLFormula<ConstraintSymbolT>>{}(ata_state.formula);
+				hash = details::combine_hash(hash, formula_hash);
+				hash = details::combine_hash(hash, ata_state.region_index);
+			}
+		}
+	}
+	return hash;
+}
+
+/** Estimate the memory that is used by a canonical word.
+ * The estimate includes the partitions and the region symbols, but not the memory that is
+ * allocated by the locations or the formulas themselves.
+ * @param word The word to estimate the memory of
+ * @return The estimated size in bytes
+ */
+template <typename Location, typename ConstraintSymbolType>
+std::size_t
+estimate_memory(const CanonicalABWord<Location, ConstraintSymbolType> &word)
+{
+	using Partition = typename CanonicalABWord<Location, ConstraintSymbolType>::value_type;
+	using Symbol    = typename Partition::value_type;
+	// The overhead of a node in a red-black tree: color, parent, left and right.
+	constexpr std::size_t tree_node_overhead = 4 * sizeof(void *);
+	std::size_t           size               = sizeof(word) + word.capacity() * sizeof(Partition);
+	for (const auto &partition : word) {
+		size += partition.size() * (tree_node_overhead + sizeof(Symbol));
+	}
+	return size;
+}
+
+/** @brief A table of interned canonical words.
+ *
+ * Each distinct canonical word is stored exactly once and gets a stable ID, which is never
+ * reused. The words are kept in hash tables keyed by the hash of each word, which is computed
+ * once when the word is interned. Thus, interning a word only compares it against the words with
+ * the same hash, rather than against O(log n) other words. The table is split into shards by the
+ * word hash, each with its own lock, so threads that intern different words rarely block each
+ * other. The table is thread-safe.
+ *
+ * Words that are no longer needed in their full form, e.g., the words of settled search nodes, can
+ * be compacted. A compacted word is only kept as a PackedCanonicalABWord next to its hash, which is
+ * enough to recognize the word when it is interned again and to check domination.
+ * @tparam NumShards The number of independently locked shards
+ */
+template <typename Location, typename ConstraintSymbolType, std::size_t NumShards = 64>
+class WordInterningTable
+{
+public:
+	/** The type of the interned words. */
+	using Word = CanonicalABWord<Location, ConstraintSymbolType>;
+	/** The table that is used to pack compacted words. */
+	using SymbolTable = PackedSymbolTable<Location, ConstraintSymbolType>;
+
+	/** Intern a word.
+	 * @param word The word to intern
+	 * @return The ID of the word, which is the same for all equal words
+	 */
+	WordId
+	intern(const Word &word)
+	{
+		return intern(word, hash_word(word));
+	}
+
+	/** Intern a set of words. Each word only locks its own shard.
+	 * @param words The words to intern
+	 * @return The key of the word set, which is the same for all equal sets
+	 */
+	WordSetKey
+	intern(const std::set<Word> &words)
+	{
+		std::vector<WordId> ids;
+		ids.reserve(words.size());
+		for (const auto &word : words) {
+			ids.push_back(intern(word));
+		}
+		return WordSetKey{std::move(ids)};
+	}
+
+	/** Get the word with the given ID.
+	 * @param id The ID of the word, must have been returned by intern
+	 * @return A copy of the interned word, which is unpacked if the word has been compacted
+	 */
+	Word
+	get_word(WordId id) const
+	{
+		const Shard    &shard = shards_[id % NumShards];
+		std::lock_guard lock{shard.mutex};
+		assert(id / NumShards < shard.words.size());
+		const StoredWord &stored = shard.words[id / NumShards];
+		return stored.word ? *stored.word : symbols_.unpack(stored.packed);
+	}
+
+	/** Compact the word with the given ID, i.e., only keep the packed word and drop the full word.
+	 * @param id The ID of the word, must have been returned by intern
+	 * @return The estimated memory in bytes that is reclaimed, 0 if the word was already compacted
+	 */
+	std::size_t
+	compact(WordId id)
+	{
+		Shard          &shard = shards_[id % NumShards];
+		std::lock_guard lock{shard.mutex};
+		assert(id / NumShards < shard.words.size());
+		StoredWord &stored = shard.words[id / NumShards];
+		if (!stored.word) {
+			return 0;
+		}
+		stored.packed = symbols_.pack(*stored.word);
+		stored.packed.shrink_to_fit();
+		const std::size_t word_memory   = estimate_memory(*stored.word);
+		const std::size_t packed_memory = stored.packed.estimate_memory();
+		stored.word.reset();
+		return word_memory - std::min(word_memory, packed_memory);
+	}
+
+	/** Get the packed word with the given ID.
+	 * @param id The ID of the word, which must have been compacted
+	 * @return A reference to the packed word, valid as long as the table exists
+	 */
+	const PackedCanonicalABWord &
+	get_packed_word(WordId id) const
+	{
+		const Shard    &shard = shards_[id % NumShards];
+		std::lock_guard lock{shard.mutex};
+		assert(id / NumShards < shard.words.size());
+		assert(!shard.words[id / NumShards].word);
+		return shard.words[id / NumShards].packed;
+	}
+
+	/** Get the table that is used to pack compacted words. */
+	SymbolTable &
+	get_symbol_table()
+	{
+		return symbols_;
+	}
+
+	/** Get the number of distinct words in the table. */
+	std::size_t
+	size() const
+	{
+		std::size_t size = 0;
+		for (const auto &shard : shards_) {
+			std::lock_guard lock{shard.mutex};
+			size += shard.words.size();
+		}
+		return size;
+	}
+
+private:
+	/** Hash function for the precomputed word hashes. */
+	struct IdentityHash
+	{
+		std::size_t
+		operator()(std::size_t hash) const
+		{
+			return hash;
+		}
+	};
+
+	/** An interned word, either in its full form or compacted. */
+	struct StoredWord
+	{
+		/** The full word, empty if the word has been compacted. */
+		std::optional<Word> word;
+		/** The packed word, only set if the word has been compacted. */
+		PackedCanonicalABWord packed;
+	};
+
+	/** A part of the table with its own lock. */
+	struct Shard
+	{
+		mutable std::mutex                                         mutex;
+		std::unordered_multimap<std::size_t, WordId, IdentityHash> ids;
+		std::deque<StoredWord>                                     words;
+	};
+
+	WordId
+	intern(const Word &word, std::size_t hash)
+	{
+		// Use the upper bits to select the shard, the lower bits select the bucket within the shard.
+		const std::size_t shard_index = (hash >> (4 * sizeof(std::size_t))) % NumShards;
+		Shard            &shard       = shards_[shard_index];
+		std::lock_guard   lock{shard.mutex};
+		const auto [begin, end] = shard.ids.equal_range(hash);
+		// Compacted candidates are compared in their packed form, the word is only packed once.
+		std::optional<PackedCanonicalABWord> packed_word;
+		for (auto candidate = begin; candidate != end; ++candidate) {
+			const StoredWord &stored = shard.words[candidate->second / NumShards];
+			if (stored.word) {
+				if (*stored.word == word) {
+					return candidate->second;
+				}
+				continue;
+			}
+			if (!packed_word) {
+				packed_word = symbols_.pack(word);
+			}
+			if (stored.packed == *packed_word) {
+				return candidate->second;
+			}
+		}
+		// The ID encodes the shard and the index of the word within the shard.
+		assert(shard.words.size() < (std::numeric_limits<WordId>::max() - shard_index) / NumShards);
+		const auto id = static_cast<WordId>(shard.words.size() * NumShards + shard_index);
+		// Elements of a deque are stable, so references to the packed words stay valid.
+		shard.words.push_back(StoredWord{word, {}});
+		shard.ids.emplace(hash, id);
+		return id;
+	}
+
+	std::array<Shard, NumShards> shards_;
+	SymbolTable                  symbols_;
+};
+
+} // namespace tacos::search
@@ -0,0 +1,255 @@
+/***************************************************************************
+ *  search_proto.cpp - Protobuf import/export for search snapshots
+ *
+ *  Created:   Sat 17 Oct 23:31:02 CEST 2026
+ *  Copyright  2026  Till Hofmann <hofmann@kbsg.rwth-aachen.de>
+ *  SPDX-License-Identifier: LGPL-3.0-or-later
+ ****************************************************************************/
+
+
+#include "search/search_proto.h"
+
+#include "mtl/MTLFormula.h"
+#include "mtl/mtl_proto.h"
+#include "search/canonical_word.h"
+#include "search/search.pb.h"
+#include "search/search_tree.h"
+
+#include <fmt/format.h>
+
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <stdexcept>
+#include <string_view>
+
+namespace tacos::search {
+
+namespace {
+
+using Location   = automata::ta::Location<std::vector<std::string>>;
+using MTLFormula = logic::MTLFormula<std::string>;
+
+// The proto enums list their values in the same order as the enums of the search.
+static_assert(static_cast<int>(NodeState::DEAD) == proto::SearchSnapshot::STATE_DEAD);
+static_assert(static_cast<int>(NodeLabel::CANCELED) == proto::SearchSnapshot::LABEL_CANCELED);
+static_assert(static_cast<int>(LabelReason::ALL_CONTROLLER_ACTIONS_BAD)
+              == proto::SearchSnapshot::REASON_ALL_CONTROLLER_ACTIONS_BAD);
+
+/** A table of distinct values that are referred to by their index. */
+template <typename T>
+class IndexTable
+{
+public:
+	/** Get the index of a value, add the value to the table if it is not in the table yet. */
+	std::uint32_t
+	get_index(const T &value)
+	{
+		const auto [it, inserted] = indices_.try_emplace(value, values_.size());
+		if (inserted) {
+			values_.push_back(value);
+		}
+		return it->second;
+	}
+
+	/** Get all values of the table, ordered by their index. */
+	const std::vector<T> &
+	get_values() const
+	{
+		return values_;
+	}
+
+private:
+	std::map<T, std::uint32_t> indices_;
+	std::vector<T>             values_;
+};
+
+/** Check that an index refers to an entry of a table with the given size. */
+std::size_t
+check_index(std::uint64_t index, std::size_t size, std::string_view table_name)
+{
+	if (index >= size) {
+		throw std::invalid_argument(
+		  fmt::format("Invalid index {} into the {} of the snapshot", index, table_name));
+	}
+	return index;
+}
+
+/** Get the entry with the given index from a table of the snapshot. */
+template <typename Table>
+const auto &
+get_entry(const Table &table, std::uint64_t index, std::string_view table_name)
+{
+	return table[static_cast<int>(check_index(index, table.size(), table_name))];
+}
+
+} // namespace
+
+proto::SearchSnapshot
+snapshot_to_proto(const ProductSearchSnapshot &snapshot)
+{
+	proto::SearchSnapshot   snapshot_proto;
+	IndexTable<Location>    locations;
+	IndexTable<std::string> clocks;
+	IndexTable<MTLFormula>  formulas;
+	IndexTable<std::string> actions;
+	snapshot_proto.set_k(snapshot.K);
+	for (const auto &word : snapshot.words) {
+		auto &word_proto = *snapshot_proto.add_words();
+		for (const auto &partition : word) {
+			auto &partition_proto = *word_proto.add_partitions();
+			for (const auto &symbol : partition) {
+				auto &symbol_proto = *partition_proto.add_symbols();
+				if (std::holds_alternative<PlantRegionState<Location>>(symbol)) {
+					const auto &state       = std::get<PlantRegionState<Location>>(symbol);
+					auto       &state_proto = *symbol_proto.mutable_plant_state();
+					state_proto.set_location(locations.get_index(state.location));
+					state_proto.set_clock(clocks.get_index(state.clock));
+					state_proto.set_region_index(state.region_index);
+				} else {
+					const auto &state       = std::get<ATARegionState<std::string>>(symbol);
+					auto       &state_proto = *symbol_proto.mutable_ata_state();
+					state_proto.set_formula(formulas.get_index(state.formula));
+					state_proto.set_region_index(state.region_index);
+				}
+			}
+		}
+	}
+	for (const auto &node : snapshot.nodes) {
+		auto &node_proto = *snapshot_proto.add_nodes();
+		for (const auto word : node.words) {
+			node_proto.add_words(word);
+		}
+		node_proto.set_state(static_cast<proto::SearchSnapshot::NodeState>(node.state));
+		node_proto.set_label(static_cast<proto::SearchSnapshot::NodeLabel>(node.label));
+		node_proto.set_label_reason(
+		  static_cast<proto::SearchSnapshot::LabelReason>(node.label_reason));
+		node_proto.set_is_expanded(node.is_expanded);
+		node_proto.set_min_total_region_increments(node.min_total_region_increments);
+		for (const auto &edge : node.children) {
+			auto &edge_proto = *node_proto.add_children();
+			edge_proto.set_increment(edge.increment);
+			edge_proto.set_action(actions.get_index(edge.action));
+			edge_proto.set_child(edge.child);
+		}
+	}
+	for (const auto &entry : snapshot.frontier) {
+		auto &entry_proto = *snapshot_proto.add_frontier();
+		entry_proto.set_node(entry.node);
+		entry_proto.set_priority(entry.priority);
+	}
+	for (const auto &location : locations.get_values()) {
+		auto &location_proto = *snapshot_proto.add_locations();
+		for (const auto &component : location.get()) {
+			location_proto.add_components(component);
+		}
+	}
+	for (const auto &clock : clocks.get_values()) {
+		snapshot_proto.add_clocks(clock);
+	}
+	for (const auto &formula : formulas.get_values()) {
+		*snapshot_proto.add_formulas() = logic::to_proto(formula);
+	}
+	for (const auto &action : actions.get_values()) {
+		snapshot_proto.add_actions(action);
+	}
+	return snapshot_proto;
+}
+
+ProductSearchSnapshot
+parse_proto(const proto::SearchSnapshot &snapshot_proto)
+{
+	ProductSearchSnapshot snapshot;
+	snapshot.K = snapshot_proto.k();
+	std::vector<Location> locations;
+	for (const auto &location : snapshot_proto.locations()) {
+		locations.emplace_back(
+		  std::vector<std::string>{std::begin(location.components()), std::end(location.components())});
+	}
+	std::vector<MTLFormula> formulas;
+	for (const auto &formula : snapshot_proto.formulas()) {
+		formulas.push_back(logic::parse_proto(formula));
+	}
+	for (const auto &word_proto : snapshot_proto.words()) {
+		auto &word = snapshot.words.emplace_back();
+		for (const auto &partition_proto : word_proto.partitions()) {
+			auto &partition = word.emplace_back();
+			for (const auto &symbol : partition_proto.symbols()) {
+				if (symbol.has_plant_state()) {
+					const auto &state = symbol.plant_state();
+					partition.insert(PlantRegionState<Location>{
+					  get_entry(locations, state.location(), "locations"),
+					  get_entry(snapshot_proto.clocks(), state.clock(), "clocks"),
+					  state.region_index()});
+				} else if (symbol.has_ata_state()) {
+					const auto &state = symbol.ata_state();
+					partition.insert(ATARegionState<std::string>{
+					  get_entry(formulas, state.formula(), "formulas"),
+					  state.region_index()});
+				} else {
+					throw std::invalid_argument("Unknown symbol type in snapshot: "
+					                            + symbol.ShortDebugString());
+				}
+			}
+		}
+	}
+	for (const auto &node_proto : snapshot_proto.nodes()) {
+		if (!proto::SearchSnapshot::NodeState_IsValid(node_proto.state())
+		    || !proto::SearchSnapshot::NodeLabel_IsValid(node_proto.label())
+		    || !proto::SearchSnapshot::LabelReason_IsValid(node_proto.label_reason())) {
+			throw std::invalid_argument("Invalid node in snapshot: " + node_proto.ShortDebugString());
+		}
+		auto &node = snapshot.nodes.emplace_back();
+		for (const auto word : node_proto.words()) {
+			node.words.push_back(check_index(word, snapshot.words.size(), "words"));
+		}
+		node.state                       = static_cast<NodeState>(node_proto.state());
+		node.label                       = static_cast<NodeLabel>(node_proto.label());
+		node.label_reason                = static_cast<LabelReason>(node_proto.label_reason());
+		node.is_expanded                 = node_proto.is_expanded();
+		node.min_total_region_increments = node_proto.min_total_region_increments();
+		for (const auto &edge : node_proto.children()) {
+			node.children.push_back({edge.increment(),
+			                         get_entry(snapshot_proto.actions(), edge.action(), "actions"),
+			                         check_index(edge.child(), snapshot_proto.nodes().size(), "nodes")});
+		}
+	}
+	for (const auto &entry : snapshot_proto.frontier()) {
+		snapshot.frontier.push_back(
+		  {check_index(entry.node(), snapshot.nodes.size(), "nodes"), entry.priority()});
+	}
+	return snapshot;
+}
+
+void
+write_snapshot_to_file(const ProductSearchSnapshot &snapshot, const std::filesystem::path &path)
+{
+	auto temporary_path = path;
+	temporary_path += ".tmp";
+	std::ofstream stream(temporary_path, std::ios::binary | std::ios::trunc);
+	if (stream) {
+		snapshot_to_proto(snapshot).SerializeToOstream(&stream);
+		stream.close();
+	}
+	if (!stream) {
+		throw std::runtime_error(
+		  fmt::format("Failed to write snapshot to '{}'", temporary_path.c_str()));
+	}
+	std::filesystem::rename(temporary_path, path);
+}
+
+ProductSearchSnapshot
+read_snapshot_from_file(const std::filesystem::path &path)
+{
+	std::ifstream stream(path, std::ios::binary);
+	if (!stream) {
+		throw std::runtime_error(fmt::format("Could not open snapshot file '{}'", path.c_str()));
+	}
+	proto::SearchSnapshot snapshot_proto;
+	if (!snapshot_proto.ParseFromIstream(&stream)) {
+		throw std::runtime_error(fmt::format("Failed to read snapshot from '{}'", path.c_str()));
+	}
+	return parse_proto(snapshot_proto);
+}
+
+} // namespace tacos::search
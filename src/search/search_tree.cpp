@@ -49,6 +49,7 @@ operator<<(std::ostream &os, const search::LabelReason &reason)
 	case LabelReason::DEAD_NODE: label_reason = "dead node"; break;
 	case LabelReason::NO_ATA_SUCCESSOR: label_reason = "no ATA successor"; break;
 	case LabelReason::MONOTONIC_DOMINATION: label_reason = "monotonic domination"; break;
+	case LabelReason::ANTICHAIN_DOMINATION: label_reason = "antichain domination"; break;
 	case LabelReason::NO_BAD_ENV_ACTION: label_reason = "no bad env action"; break;
 	case LabelReason::GOOD_CONTROLLER_ACTION_FIRST:
 		label_reason = "good controller action first";
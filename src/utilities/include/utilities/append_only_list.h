@@ -0,0 +1,177 @@
+/***************************************************************************
+ *  append_only_list.h - A list that can be read while it is appended to
+ *
+ *  Created:   Sat 17 Oct 22:14:03 CEST 2026
+ *  Copyright  2026  Till Hofmann <hofmann@kbsg.rwth-aachen.de>
+ *  SPDX-License-Identifier: LGPL-3.0-or-later
+ ****************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+namespace tacos::utilities {
+
+/** @brief A list that only grows and that can be iterated while elements are appended.
+ *
+ * The elements are stored in a chain of chunks, where each chunk is twice as large as the previous
+ * one. Chunks are never reallocated, so appending never moves an element. The number of elements
+ * is published with an atomic counter after the element has been written. Therefore, readers do
+ * not need a lock: an iterator sees all elements that were appended before begin() was called.
+ * Appending must be serialized, e.g., with a lock.
+ * @tparam T The type of the elements, which must be default-constructible
+ */
+template <typename T>
+class AppendOnlyList
+{
+	/** A block of elements, which is linked to the next block once it is full. */
+	struct Chunk
+	{
+		explicit Chunk(std::size_t capacity) : elements(capacity)
+		{
+		}
+
+		std::vector<T>         elements;
+		std::unique_ptr<Chunk> next;
+	};
+
+public:
+	/** An iterator over the elements that existed when the iteration started. */
+	class const_iterator
+	{
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type        = T;
+		using difference_type   = std::ptrdiff_t;
+		using pointer           = const T *;
+		using reference         = const T &;
+
+		/** Construct the end iterator. */
+		const_iterator() = default;
+
+		/** Construct an iterator to the first element of a chunk.
+		 * @param chunk The first chunk
+		 * @param remaining The number of elements to iterate over, starting from the chunk
+		 */
+		const_iterator(const Chunk *chunk, std::size_t remaining) : chunk_(chunk), remaining_(remaining)
+		{
+		}
+
+		reference
+		operator*() const
+		{
+			return chunk_->elements[index_];
+		}
+
+		pointer
+		operator->() const
+		{
+			return &chunk_->elements[index_];
+		}
+
+		const_iterator &
+		operator++()
+		{
+			// Only follow the link to the next chunk if there are more elements, as the link may be
+			// written concurrently otherwise.
+			if (--remaining_ > 0 && ++index_ == chunk_->elements.size()) {
+				chunk_ = chunk_->next.get();
+				index_ = 0;
+			}
+			return *this;
+		}
+
+		const_iterator
+		operator++(int)
+		{
+			auto res = *this;
+			++*this;
+			return res;
+		}
+
+		/** Compare two iterators by the number of remaining elements. */
+		friend bool
+		operator==(const const_iterator &first, const const_iterator &second)
+		{
+			return first.remaining_ == second.remaining_;
+		}
+
+		friend bool
+		operator!=(const const_iterator &first, const const_iterator &second)
+		{
+			return !(first == second);
+		}
+
+	private:
+		const Chunk *chunk_{nullptr};
+		std::size_t  index_{0};
+		std::size_t  remaining_{0};
+	};
+
+	AppendOnlyList() = default;
+
+	AppendOnlyList(const AppendOnlyList &)            = delete;
+	AppendOnlyList &operator=(const AppendOnlyList &) = delete;
+
+	/** Append an element. This must not be called concurrently with another push_back.
+	 * @param value The element to append
+	 */
+	void
+	push_back(const T &value)
+	{
+		const std::uint32_t size = size_.load(std::memory_order_relaxed);
+		if (tail_ == nullptr) {
+			head_ = std::make_unique<Chunk>(1);
+			tail_ = head_.get();
+		} else if (size - tail_begin_ == tail_->elements.size()) {
+			tail_->next = std::make_unique<Chunk>(2 * tail_->elements.size());
+			tail_       = tail_->next.get();
+			tail_begin_ = size;
+		}
+		tail_->elements[size - tail_begin_] = value;
+		size_.store(size + 1, std::memory_order_release);
+	}
+
+	/** Get the number of elements. */
+	std::size_t
+	size() const
+	{
+		return size_.load(std::memory_order_acquire);
+	}
+
+	/** Check whether the list is empty. */
+	bool
+	empty() const
+	{
+		return size() == 0;
+	}
+
+	/** Get an iterator to the first element. */
+	const_iterator
+	begin() const
+	{
+		const std::size_t size = this->size();
+		return size == 0 ? const_iterator{} : const_iterator{head_.get(), size};
+	}
+
+	/** Get the end iterator. */
+	const_iterator
+	end() const
+	{
+		return {};
+	}
+
+private:
+	std::unique_ptr<Chunk>     head_;
+	Chunk                     *tail_{nullptr};
+	std::atomic<std::uint32_t> size_{0};
+	/** The index of the first element in the tail chunk. */
+	std::uint32_t tail_begin_{0};
+};
+
+} // namespace tacos::utilities
@@ -0,0 +1,121 @@
+/***************************************************************************
+ *  arena.h - Allocate objects in large chunks that live as long as the arena
+ *
+ *  Created:   Sat 17 Oct 09:41:17 CEST 2026
+ *  Copyright  2026  Till Hofmann <hofmann@kbsg.rwth-aachen.de>
+ *  SPDX-License-Identifier: LGPL-3.0-or-later
+ ****************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace tacos::utilities {
+
+/** @brief A thread-safe arena that allocates objects of a single type in chunks.
+ *
+ * Objects are never freed individually, they are destroyed together with the arena. This avoids
+ * the per-object overhead of separate heap allocations and reference counting. Pointers to the
+ * created objects stay valid for the lifetime of the arena.
+ *
+ * To reduce contention, the arena is split into shards that each allocate from their own chunk.
+ * Each thread uses the shard determined by its thread ID, so threads usually do not block each
+ * other.
+ *
+ * @tparam T The type of the allocated objects
+ * @tparam NumShards The number of shards
+ */
+template <typename T, std::size_t NumShards = 64>
+class ObjectArena
+{
+	static_assert(NumShards > 0, "The arena needs at least one shard");
+
+public:
+	/** The default number of objects per chunk. */
+	static constexpr std::size_t default_chunk_size = 1024;
+
+	/** Construct an empty arena.
+	 * @param chunk_size The number of objects that are allocated at once
+	 */
+	explicit ObjectArena(std::size_t chunk_size = default_chunk_size) : chunk_size_(chunk_size)
+	{
+	}
+
+	ObjectArena(const ObjectArena &)            = delete;
+	ObjectArena &operator=(const ObjectArena &) = delete;
+
+	/** Destroy all objects in the arena. */
+	~ObjectArena()
+	{
+		for (auto &shard : shards_) {
+			for (auto &chunk : shard.chunks) {
+				for (std::size_t i = 0; i < chunk.size; ++i) {
+					std::launder(reinterpret_cast<T *>(&chunk.storage[i]))->~T();
+				}
+			}
+		}
+	}
+
+	/** Create a new object in the arena.
+	 * @param args The arguments to pass to the constructor of the object
+	 * @return A pointer to the new object, valid as long as the arena exists
+	 */
+	template <typename... Args>
+	T *
+	create(Args &&...args)
+	{
+		const std::size_t shard_index =
+		  std::hash<std::thread::id>{}(std::this_thread::get_id()) % NumShards;
+		auto           &shard = shards_[shard_index];
+		std::lock_guard lock{shard.mutex};
+		if (shard.chunks.empty() || shard.chunks.back().size == chunk_size_) {
+			shard.chunks.push_back(Chunk{std::make_unique<Storage[]>(chunk_size_), 0});
+		}
+		auto &chunk  = shard.chunks.back();
+		T    *object = new (&chunk.storage[chunk.size]) T(std::forward<Args>(args)...);
+		// Only count the object after its constructor succeeded, so it is destroyed exactly once.
+		++chunk.size;
+		size_.fetch_add(1, std::memory_order_relaxed);
+		return object;
+	}
+
+	/** Get the number of objects in the arena. */
+	std::size_t
+	size() const
+	{
+		return size_.load(std::memory_order_relaxed);
+	}
+
+private:
+	using Storage = std::aligned_storage_t<sizeof(T), alignof(T)>;
+
+	/** A contiguous block of storage for chunk_size_ objects, of which the first size are used. */
+	struct Chunk
+	{
+		std::unique_ptr<Storage[]> storage;
+		std::size_t                size;
+	};
+
+	/** A single shard, aligned to avoid false sharing between neighboring shards. */
+	struct alignas(64) Shard
+	{
+		std::mutex         mutex;
+		std::vector<Chunk> chunks;
+	};
+
+	const std::size_t            chunk_size_;
+	std::array<Shard, NumShards> shards_;
+	std::atomic_size_t           size_{0};
+};
+
+} // namespace tacos::utilities
@@ -0,0 +1,159 @@
+/***************************************************************************
+ *  bucket_queue.h - A priority queue for dense integer priorities
+ *
+ *  Created:   Sat 17 Oct 11:20:36 CEST 2026
+ *  Copyright  2026  Till Hofmann <hofmann@kbsg.rwth-aachen.de>
+ *  SPDX-License-Identifier: LGPL-3.0-or-later
+ ****************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <deque>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace tacos::utilities {
+
+/** @brief A priority queue for integer priorities that uses one bucket per priority.
+ *
+ * The queue keeps a contiguous range of buckets, one for each priority between the lowest and the
+ * highest priority in the queue. Pushing an element and accessing the top element take constant
+ * time. Popping an element takes time linear in the gap to the next lower non-empty bucket, which
+ * is constant if the priorities are dense. Thus, the queue should only be used if the priorities of
+ * the elements that are in the queue at the same time span a small range, e.g., if the priorities
+ * are counters. Elements with the same priority are popped in LIFO order.
+ *
+ * The interface is the same as the one of std::priority_queue, i.e., the element with the highest
+ * priority is at the top.
+ * @tparam Priority The priority type, must be an integer type
+ * @tparam T The element type
+ */
+template <typename Priority, typename T>
+class BucketQueue
+{
+public:
+	/** The type of the queued elements. */
+	using value_type = std::pair<Priority, T>;
+
+	/** Add an element to the queue.
+	 * @param element A pair (priority, element)
+	 */
+	void
+	push(value_type element)
+	{
+		const Priority priority = element.first;
+		if (size_ == 0) {
+			buckets_.resize(1);
+			lowest_ = priority;
+			top_    = 0;
+		} else if (priority < lowest_) {
+			buckets_.insert(std::begin(buckets_), static_cast<std::size_t>(lowest_ - priority), {});
+			top_ += static_cast<std::size_t>(lowest_ - priority);
+			lowest_ = priority;
+		} else if (static_cast<std::size_t>(priority - lowest_) >= buckets_.size()) {
+			buckets_.resize(static_cast<std::size_t>(priority - lowest_) + 1);
+		}
+		const auto index = static_cast<std::size_t>(priority - lowest_);
+		buckets_[index].push_back(std::move(element));
+		if (index > top_) {
+			top_ = index;
+		}
+		++size_;
+	}
+
+	/** Get the element with the highest priority. The queue must not be empty. */
+	const value_type &
+	top() const
+	{
+		assert(size_ > 0);
+		return buckets_[top_].back();
+	}
+
+	/** Remove the element with the highest priority. The queue must not be empty. */
+	void
+	pop()
+	{
+		assert(size_ > 0);
+		buckets_[top_].pop_back();
+		--size_;
+		if (size_ == 0) {
+			buckets_.clear();
+			top_ = 0;
+			return;
+		}
+		// All buckets above the top are empty, drop them so the range stays small.
+		while (buckets_[top_].empty()) {
+			buckets_.pop_back();
+			--top_;
+		}
+	}
+
+	/** Remove all elements that satisfy the given predicate.
+	 * @param predicate A predicate on (priority, element) pairs
+	 * @return The number of removed elements
+	 */
+	template <typename Predicate>
+	std::size_t
+	remove_if(Predicate predicate)
+	{
+		std::size_t num_removed = 0;
+		for (auto &bucket : buckets_) {
+			const auto new_end = std::remove_if(std::begin(bucket), std::end(bucket), predicate);
+			num_removed += static_cast<std::size_t>(std::distance(new_end, std::end(bucket)));
+			bucket.erase(new_end, std::end(bucket));
+		}
+		size_ -= num_removed;
+		if (size_ == 0) {
+			buckets_.clear();
+			top_ = 0;
+			return num_removed;
+		}
+		while (buckets_[top_].empty()) {
+			buckets_.pop_back();
+			--top_;
+		}
+		return num_removed;
+	}
+
+	/** Call a function for each element in the queue, in no particular order.
+	 * @param visit A Callable that is called with each pair (priority, element)
+	 */
+	template <typename Visitor>
+	void
+	for_each(Visitor &&visit) const
+	{
+		for (const auto &bucket : buckets_) {
+			for (const auto &element : bucket) {
+				visit(element);
+			}
+		}
+	}
+
+	/** Check whether the queue is empty. */
+	bool
+	empty() const
+	{
+		return size_ == 0;
+	}
+
+	/** Get the number of elements in the queue. */
+	std::size_t
+	size() const
+	{
+		return size_;
+	}
+
+private:
+	std::deque<std::vector<value_type>> buckets_;
+	/** The priority of the first bucket. */
+	Priority lowest_{};
+	/** The index of the highest non-empty bucket. */
+	std::size_t top_{0};
+	std::size_t size_{0};
+};
+
+} // namespace tacos::utilities
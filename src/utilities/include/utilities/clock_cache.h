@@ -0,0 +1,255 @@
+/***************************************************************************
+ *  clock_cache.h - A bounded concurrent cache with clock eviction
+ *
+ *  Created:   Sat 17 Oct 20:11:46 CEST 2026
+ *  Copyright  2026  Till Hofmann <hofmann@kbsg.rwth-aachen.de>
+ *  SPDX-License-Identifier: LGPL-3.0-or-later
+ ****************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace tacos::utilities {
+
+/** Statistics about the lookups in a cache. */
+struct CacheStatistics
+{
+	/** The number of lookups that found a cached value. */
+	std::size_t num_hits{0};
+	/** The number of lookups that had to compute the value. */
+	std::size_t num_misses{0};
+	/** The number of values that were evicted from the cache. */
+	std::size_t num_evictions{0};
+	/** The number of values that are currently cached. */
+	std::size_t size{0};
+	/** The total cost of the values that are currently cached. */
+	std::size_t cost{0};
+
+	/** Get the ratio of lookups that found a cached value, or 0 if there was no lookup. */
+	double
+	get_hit_rate() const
+	{
+		const std::size_t num_lookups = num_hits + num_misses;
+		return num_lookups == 0 ? 0. : static_cast<double>(num_hits) / num_lookups;
+	}
+};
+
+/** @brief A bounded, thread-safe cache that evicts values with the clock algorithm.
+ *
+ * Each value has a cost, e.g., its (estimated) size in bytes, and the total cost of all cached
+ * values is bounded by a budget. The cache is split into shards, each with its own lock and an
+ * equal share of the budget. If inserting a value exceeds the budget of its shard, values are
+ * evicted with the clock (second chance) algorithm: each lookup marks a value as referenced and
+ * the clock hand skips (and unmarks) referenced values once before evicting them. A value that is
+ * more expensive than the budget of a shard is never cached.
+ *
+ * Values are stored as shared pointers, so a value that is returned by the cache stays valid even
+ * if it is evicted in the meantime. A key may identify multiple values, e.g., if it is only the
+ * hash of the actual identity of a value. Such values are told apart with a predicate.
+ *
+ * @tparam Key The key type
+ * @tparam Value The value type
+ * @tparam Hash The hash function for the keys
+ * @tparam NumShards The number of shards
+ */
+template <typename Key, typename Value, typename Hash = std::hash<Key>, std::size_t NumShards = 16>
+class ClockCache
+{
+	static_assert(NumShards > 0, "The cache needs at least one shard");
+
+public:
+	/** The function that computes the cost of a value. */
+	using CostFunction = std::function<std::size_t(const Value &)>;
+
+	/** Construct the cache.
+	 * @param budget The maximal total cost of all cached values
+	 * @param get_cost The function that computes the cost of a value, by default each value costs 1
+	 */
+	explicit ClockCache(
+	  std::size_t  budget,
+	  CostFunction get_cost = [](const Value &) -> std::size_t { return 1; })
+	: shard_budget_(budget / NumShards), get_cost_(std::move(get_cost))
+	{
+	}
+
+	/** Get the value for the given key, compute it if it is not cached.
+	 * The value is computed without holding any lock. If two threads compute the value for the same
+	 * key at the same time, the value of the first thread is cached and returned to both.
+	 * @param key The key to look up
+	 * @param compute A Callable that computes the value if it is not cached
+	 * @return A pointer to the value
+	 */
+	template <typename Compute>
+	std::shared_ptr<const Value>
+	get_or_compute(const Key &key, Compute &&compute)
+	{
+		return get_or_compute(key, [](const Value &) { return true; }, std::forward<Compute>(compute));
+	}
+
+	/** Get the value for the given key that satisfies a predicate, compute it if there is none.
+	 * Other values with the same key stay cached, so keys may collide.
+	 * @param key The key to look up
+	 * @param matches A predicate that selects the value among all values with the same key
+	 * @param compute A Callable that computes the value if it is not cached, the computed value
+	 * must satisfy the predicate
+	 * @return A pointer to the value
+	 */
+	template <typename Matches, typename Compute>
+	std::shared_ptr<const Value>
+	get_or_compute(const Key &key, Matches &&matches, Compute &&compute)
+	{
+		auto &shard = get_shard(key);
+		{
+			std::lock_guard lock{shard.mutex};
+			if (auto *entry = find(shard, key, matches)) {
+				entry->referenced = true;
+				++num_hits_;
+				return entry->value;
+			}
+		}
+		++num_misses_;
+		auto              value = std::make_shared<const Value>(compute());
+		const std::size_t cost  = get_cost_(*value);
+		std::lock_guard   lock{shard.mutex};
+		if (const auto *entry = find(shard, key, matches)) {
+			return entry->value;
+		}
+		if (cost <= shard_budget_) {
+			insert(shard, key, value, cost);
+		}
+		return value;
+	}
+
+	/** Set the maximal total cost of all cached values.
+	 * If the budget is reduced, values are evicted lazily when the next value is inserted.
+	 * @param budget The new budget
+	 */
+	void
+	set_budget(std::size_t budget)
+	{
+		shard_budget_ = budget / NumShards;
+	}
+
+	/** Get the statistics of the cache. */
+	CacheStatistics
+	get_statistics() const
+	{
+		CacheStatistics statistics;
+		statistics.num_hits      = num_hits_;
+		statistics.num_misses    = num_misses_;
+		statistics.num_evictions = num_evictions_;
+		for (const auto &shard : shards_) {
+			std::lock_guard lock{shard.mutex};
+			statistics.size += shard.entries.size();
+			statistics.cost += shard.cost;
+		}
+		return statistics;
+	}
+
+private:
+	struct Entry
+	{
+		Key                          key;
+		std::shared_ptr<const Value> value;
+		std::size_t                  cost;
+		bool                         referenced;
+	};
+
+	/** A single shard, aligned to avoid false sharing between neighboring shards. */
+	struct alignas(64) Shard
+	{
+		mutable std::mutex                              mutex;
+		std::unordered_multimap<Key, std::size_t, Hash> slots;
+		std::vector<Entry>                              entries;
+		std::size_t                                     hand{0};
+		std::size_t                                     cost{0};
+	};
+
+	Shard &
+	get_shard(const Key &key)
+	{
+		return shards_[Hash{}(key) % NumShards];
+	}
+
+	/** Find the entry with the given key whose value satisfies the predicate.
+	 * The shard must be locked.
+	 */
+	template <typename Matches>
+	Entry *
+	find(Shard &shard, const Key &key, Matches &matches)
+	{
+		const auto [first, last] = shard.slots.equal_range(key);
+		for (auto it = first; it != last; ++it) {
+			if (matches(*shard.entries[it->second].value)) {
+				return &shard.entries[it->second];
+			}
+		}
+		return nullptr;
+	}
+
+	/** Find the slot of the entry at the given index. The shard must be locked. */
+	typename std::unordered_multimap<Key, std::size_t, Hash>::iterator
+	find_slot(Shard &shard, const Key &key, std::size_t index)
+	{
+		auto [it, last] = shard.slots.equal_range(key);
+		while (it != last && it->second != index) {
+			++it;
+		}
+		assert(it != last);
+		return it;
+	}
+
+	/** Insert a value into a shard and evict values until the shard is within its budget.
+	 * The shard must be locked.
+	 */
+	void
+	insert(Shard &shard, const Key &key, std::shared_ptr<const Value> value, std::size_t cost)
+	{
+		const std::size_t budget = shard_budget_;
+		while (shard.cost + cost > budget && !shard.entries.empty()) {
+			if (shard.hand >= shard.entries.size()) {
+				shard.hand = 0;
+			}
+			auto &entry = shard.entries[shard.hand];
+			if (entry.referenced) {
+				// Give the entry a second chance.
+				entry.referenced = false;
+				++shard.hand;
+				continue;
+			}
+			// Evict the entry by moving the last entry into its slot.
+			shard.cost -= entry.cost;
+			shard.slots.erase(find_slot(shard, entry.key, shard.hand));
+			const std::size_t last = shard.entries.size() - 1;
+			if (shard.hand != last) {
+				entry                                     = std::move(shard.entries.back());
+				find_slot(shard, entry.key, last)->second = shard.hand;
+			}
+			shard.entries.pop_back();
+			++num_evictions_;
+		}
+		shard.slots.emplace(key, shard.entries.size());
+		shard.entries.push_back(Entry{key, std::move(value), cost, false});
+		shard.cost += cost;
+	}
+
+	std::atomic_size_t           shard_budget_;
+	const CostFunction           get_cost_;
+	std::array<Shard, NumShards> shards_;
+	std::atomic_size_t           num_hits_{0};
+	std::atomic_size_t           num_misses_{0};
+	std::atomic_size_t           num_evictions_{0};
+};
+
+} // namespace tacos::utilities
@@ -0,0 +1,158 @@
+/***************************************************************************
+ *  flat_map.h - A sorted map that stores its elements in a single array
+ *
+ *  Created:   Sat 17 Oct 09:58:02 CEST 2026
+ *  Copyright  2026  Till Hofmann <hofmann@kbsg.rwth-aachen.de>
+ *  SPDX-License-Identifier: LGPL-3.0-or-later
+ ****************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace tacos::utilities {
+
+/** @brief A map that keeps its elements sorted by key in a contiguous array.
+ *
+ * Compared to a std::map, this avoids a separate allocation and the tree pointers for every
+ * element. Lookups are binary searches. Insertion is linear in the number of elements that are
+ * greater than the new key, so it is cheap if the elements are inserted in order.
+ * Elements cannot be modified or removed after insertion.
+ *
+ * @tparam Key The key type
+ * @tparam Value The mapped type
+ */
+template <typename Key, typename Value>
+class FlatMap
+{
+public:
+	/** The type of the stored elements. */
+	using value_type = std::pair<Key, Value>;
+	/** The iterator type, the elements cannot be modified. */
+	using const_iterator = typename std::vector<value_type>::const_iterator;
+	/** The iterator type, the elements cannot be modified. */
+	using iterator = const_iterator;
+
+	/** Insert an element if there is no element with the same key.
+	 * @param value The element to insert
+	 * @return A pair of an iterator to the element with the key and a flag that is true if the
+	 * element was inserted
+	 */
+	std::pair<const_iterator, bool>
+	insert(value_type value)
+	{
+		// Elements are usually inserted in order, so check the back first.
+		if (elements_.empty() || elements_.back().first < value.first) {
+			elements_.push_back(std::move(value));
+			return {std::prev(std::end(elements_)), true};
+		}
+		auto it = lower_bound(value.first);
+		if (it != std::end(elements_) && !(value.first < it->first)) {
+			return {it, false};
+		}
+		return {elements_.insert(it, std::move(value)), true};
+	}
+
+	/** Find the element with the given key.
+	 * @return An iterator to the element or end() if there is no such element
+	 */
+	const_iterator
+	find(const Key &key) const
+	{
+		const auto it = lower_bound(key);
+		if (it == std::end(elements_) || key < it->first) {
+			return std::end(elements_);
+		}
+		return it;
+	}
+
+	/** Get the value for the given key.
+	 * @throws std::out_of_range if there is no element with the key
+	 */
+	const Value &
+	at(const Key &key) const
+	{
+		const auto it = find(key);
+		if (it == std::end(elements_)) {
+			throw std::out_of_range("Key not found in map");
+		}
+		return it->second;
+	}
+
+	/** Count the elements with the given key, which is either 0 or 1. */
+	std::size_t
+	count(const Key &key) const
+	{
+		return find(key) == std::end(elements_) ? 0 : 1;
+	}
+
+	/** Get the number of elements. */
+	std::size_t
+	size() const
+	{
+		return elements_.size();
+	}
+
+	/** Check whether the map is empty. */
+	bool
+	empty() const
+	{
+		return elements_.empty();
+	}
+
+	/** Get an iterator to the first element. */
+	const_iterator
+	begin() const
+	{
+		return std::begin(elements_);
+	}
+
+	/** Get the past-the-end iterator. */
+	const_iterator
+	end() const
+	{
+		return std::end(elements_);
+	}
+
+	/** Compare two maps for equality. */
+	friend bool
+	operator==(const FlatMap &first, const FlatMap &second)
+	{
+		return first.elements_ == second.elements_;
+	}
+
+	/** Compare two maps for inequality. */
+	friend bool
+	operator!=(const FlatMap &first, const FlatMap &second)
+	{
+		return !(first == second);
+	}
+
+private:
+	static bool
+	compare_key(const value_type &element, const Key &key)
+	{
+		return element.first < key;
+	}
+
+	typename std::vector<value_type>::iterator
+	lower_bound(const Key &key)
+	{
+		return std::lower_bound(std::begin(elements_), std::end(elements_), key, compare_key);
+	}
+
+	const_iterator
+	lower_bound(const Key &key) const
+	{
+		return std::lower_bound(std::begin(elements_), std::end(elements_), key, compare_key);
+	}
+
+	std::vector<value_type> elements_;
+};
+
+} // namespace tacos::utilities
@@ -0,0 +1,281 @@
+/***************************************************************************
+ *  local_transport.h - Exchange messages between processes on the same host
+ *
+ *  Created:   Sun 18 Oct 10:04:31 CEST 2026
+ *  Copyright  2026  Till Hofmann <hofmann@kbsg.rwth-aachen.de>
+ *  SPDX-License-Identifier: LGPL-3.0-or-later
+ ****************************************************************************/
+
+#pragma once
+
+#include <fmt/format.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <array>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace tacos::utilities {
+
+/** @brief A message-based connection to another process on the same host.
+ *
+ * The connection wraps one end of a Unix domain stream socket. Each message is framed with its
+ * length, so the receiver gets the same messages that were sent. The socket is non-blocking:
+ * Sent messages are buffered and written with flush() as far as the socket accepts them, and
+ * receive() only reads the data that is available. This allows two processes to send to each
+ * other at the same time without blocking each other, as long as both keep receiving.
+ */
+class LocalConnection
+{
+public:
+	/** Create a connection from a connected stream socket.
+	 * @param fd The file descriptor of the socket, the connection takes ownership of it
+	 */
+	explicit LocalConnection(int fd = -1) : fd_(fd)
+	{
+		if (fd_ >= 0 && fcntl(fd_, F_SETFL, fcntl(fd_, F_GETFL) | O_NONBLOCK) < 0) {
+			throw std::runtime_error(
+			  fmt::format("Failed to make socket non-blocking: {}", std::strerror(errno)));
+		}
+	}
+
+	/** Close the connection. */
+	~LocalConnection()
+	{
+		close();
+	}
+
+	LocalConnection(const LocalConnection &)            = delete;
+	LocalConnection &operator=(const LocalConnection &) = delete;
+
+	/** Move constructor. */
+	LocalConnection(LocalConnection &&other) noexcept
+	: fd_(std::exchange(other.fd_, -1)),
+	  input_(std::move(other.input_)),
+	  input_offset_(std::exchange(other.input_offset_, 0)),
+	  output_(std::move(other.output_)),
+	  is_closed_by_peer_(other.is_closed_by_peer_)
+	{
+	}
+
+	/** Move assignment. */
+	LocalConnection &
+	operator=(LocalConnection &&other) noexcept
+	{
+		if (this != &other) {
+			close();
+			fd_                = std::exchange(other.fd_, -1);
+			input_             = std::move(other.input_);
+			input_offset_      = std::exchange(other.input_offset_, 0);
+			output_            = std::move(other.output_);
+			is_closed_by_peer_ = other.is_closed_by_peer_;
+		}
+		return *this;
+	}
+
+	/** Create a pair of connections that are connected to each other, e.g., to share them with a
+	 * child process.
+	 * @return Both ends of the connection
+	 * @throw std::runtime_error if the socket pair cannot be created
+	 */
+	static std::pair<LocalConnection, LocalConnection>
+	create_pair()
+	{
+		std::array<int, 2> fds{};
+		if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds.data()) < 0) {
+			throw std::runtime_error(
+			  fmt::format("Failed to create socket pair: {}", std::strerror(errno)));
+		}
+		return {LocalConnection{fds[0]}, LocalConnection{fds[1]}};
+	}
+
+	/** Get the file descriptor of the socket, e.g., to wait for it. */
+	int
+	get_fd() const
+	{
+		return fd_;
+	}
+
+	/** Check whether the connection is open, i.e., whether it has a socket that has not been closed
+	 * by either side. */
+	bool
+	is_open() const
+	{
+		return fd_ >= 0 && !is_closed_by_peer_;
+	}
+
+	/** Close the socket. Buffered messages that have not been written yet are dropped. */
+	void
+	close()
+	{
+		if (fd_ >= 0) {
+			::close(fd_);
+			fd_ = -1;
+		}
+		output_.clear();
+	}
+
+	/** Add a message to the send buffer. The message is written with the next call of flush().
+	 * Messages to a connection that has been closed are dropped.
+	 * @param message The message to send
+	 */
+	void
+	send(std::string_view message)
+	{
+		if (!is_open()) {
+			return;
+		}
+		const auto size = static_cast<std::uint32_t>(message.size());
+		for (std::size_t byte = 0; byte < sizeof(size); ++byte) {
+			output_.push_back(static_cast<char>((size >> (8 * byte)) & 0xff));
+		}
+		output_.append(message);
+	}
+
+	/** Write as much of the send buffer as the socket accepts without blocking.
+	 * If the peer has closed the connection, the buffer is dropped.
+	 * @return true if the send buffer is empty
+	 * @throw std::runtime_error if writing to the socket fails
+	 */
+	bool
+	flush()
+	{
+		std::size_t written = 0;
+		while (written < output_.size() && is_open()) {
+			const ssize_t result =
+			  ::send(fd_, output_.data() + written, output_.size() - written, MSG_NOSIGNAL);
+			if (result >= 0) {
+				written += static_cast<std::size_t>(result);
+			} else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+				break;
+			} else if (errno == EPIPE || errno == ECONNRESET) {
+				is_closed_by_peer_ = true;
+			} else if (errno != EINTR) {
+				throw std::runtime_error(
+				  fmt::format("Failed to write to socket: {}", std::strerror(errno)));
+			}
+		}
+		if (!is_open()) {
+			output_.clear();
+		} else {
+			output_.erase(0, written);
+		}
+		return output_.empty();
+	}
+
+	/** Write the whole send buffer, wait for the socket if necessary. */
+	void
+	flush_blocking()
+	{
+		while (!flush()) {
+			pollfd poll_fd{fd_, POLLOUT, 0};
+			poll(&poll_fd, 1, -1);
+		}
+	}
+
+	/** Check whether there are buffered messages that have not been written yet. */
+	bool
+	has_pending_output() const
+	{
+		return !output_.empty();
+	}
+
+	/** Read all data that is available on the socket without blocking.
+	 * @return false if the peer has closed the connection
+	 * @throw std::runtime_error if reading from the socket fails
+	 */
+	bool
+	receive()
+	{
+		std::array<char, 1 << 16> buffer;
+		while (is_open()) {
+			const ssize_t result = recv(fd_, buffer.data(), buffer.size(), 0);
+			if (result > 0) {
+				input_.append(buffer.data(), static_cast<std::size_t>(result));
+			} else if (result == 0 || errno == ECONNRESET) {
+				is_closed_by_peer_ = true;
+			} else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+				break;
+			} else if (errno != EINTR) {
+				throw std::runtime_error(
+				  fmt::format("Failed to read from socket: {}", std::strerror(errno)));
+			}
+		}
+		return is_open();
+	}
+
+	/** Get the next complete message that has been received.
+	 * @return The message, or nothing if no complete message has been received yet
+	 */
+	std::optional<std::string>
+	pop_message()
+	{
+		std::uint32_t size = 0;
+		if (input_.size() - input_offset_ < sizeof(size)) {
+			return std::nullopt;
+		}
+		for (std::size_t byte = 0; byte < sizeof(size); ++byte) {
+			size |= static_cast<std::uint32_t>(static_cast<unsigned char>(input_[input_offset_ + byte]))
+			        << (8 * byte);
+		}
+		if (input_.size() - input_offset_ < sizeof(size) + size) {
+			return std::nullopt;
+		}
+		std::string message = input_.substr(input_offset_ + sizeof(size), size);
+		input_offset_ += sizeof(size) + size;
+		if (input_offset_ > input_.size() / 2) {
+			// Drop the consumed messages, but only once they make up most of the buffer.
+			input_.erase(0, input_offset_);
+			input_offset_ = 0;
+		}
+		return message;
+	}
+
+private:
+	int         fd_;
+	std::string input_;
+	std::size_t input_offset_{0};
+	std::string output_;
+	bool        is_closed_by_peer_{false};
+};
+
+/** Wait until one of the connections can be read or, if it has pending output, written.
+ * Connections that are not open are ignored, if no connection is open, this returns
+ * immediately.
+ * @param connections The connections to wait for
+ * @param timeout The maximal time to wait in milliseconds, -1 to wait without a time limit
+ * @throw std::runtime_error if waiting fails
+ */
+inline void
+wait_for_connections(const std::vector<LocalConnection *> &connections, int timeout)
+{
+	std::vector<pollfd> poll_fds;
+	poll_fds.reserve(connections.size());
+	for (const auto *connection : connections) {
+		if (connection->is_open()) {
+			poll_fds.push_back(
+			  {connection->get_fd(),
+			   static_cast<short>(POLLIN | (connection->has_pending_output() ? POLLOUT : 0)),
+			   0});
+		}
+	}
+	if (poll_fds.empty()) {
+		return;
+	}
+	if (poll(poll_fds.data(), poll_fds.size(), timeout) < 0 && errno != EINTR) {
+		throw std::runtime_error(
+		  fmt::format("Failed to wait for connections: {}", std::strerror(errno)));
+	}
+}
+
+} // namespace tacos::utilities
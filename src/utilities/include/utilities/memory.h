@@ -0,0 +1,40 @@
+/***************************************************************************
+ *  memory.h - Query the memory usage of the process
+ *
+ *  Created:   Sat 17 Oct 14:22:05 CEST 2026
+ *  Copyright  2026  Till Hofmann <hofmann@kbsg.rwth-aachen.de>
+ *  SPDX-License-Identifier: LGPL-3.0-or-later
+ ****************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <fstream>
+
+#ifdef __linux__
+#	include <unistd.h>
+#endif
+
+namespace tacos::utilities {
+
+/** Get the resident set size (RSS) of the current process.
+ * This is only supported on Linux, where it is read from /proc/self/statm.
+ * @return The resident memory in bytes, or 0 if it cannot be determined
+ */
+inline std::size_t
+get_resident_memory()
+{
+#ifdef __linux__
+	std::ifstream statm{"/proc/self/statm"};
+	std::size_t   total_pages    = 0;
+	std::size_t   resident_pages = 0;
+	if (!(statm >> total_pages >> resident_pages)) {
+		return 0;
+	}
+	return resident_pages * static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+#else
+	return 0;
+#endif
+}
+
+} // namespace tacos::utilities
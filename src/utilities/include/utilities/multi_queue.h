@@ -0,0 +1,257 @@
+/***************************************************************************
+ *  multi_queue.h - A relaxed concurrent priority queue
+ *
+ *  Created:   Sat 17 Oct 09:12:54 CEST 2026
+ *  Copyright  2026  Till Hofmann <hofmann@kbsg.rwth-aachen.de>
+ *  SPDX-License-Identifier: LGPL-3.0-or-later
+ ****************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace tacos::utilities {
+
+/** @brief Statistics about the rank error of a relaxed priority queue.
+ *
+ * The rank error of a pop is the number of elements in the queue that have a strictly higher
+ * priority than the popped element. A strict priority queue always has a rank error of 0.
+ */
+struct RankErrorStatistics
+{
+	/** The total number of pops. */
+	std::size_t num_pops{0};
+	/** The number of pops for which the rank error was measured. */
+	std::size_t num_samples{0};
+	/** The sum of all measured rank errors. */
+	std::size_t total_rank_error{0};
+	/** The maximal measured rank error. */
+	std::size_t max_rank_error{0};
+
+	/** Get the mean rank error over all measured pops. */
+	double
+	get_mean_rank_error() const
+	{
+		return num_samples == 0 ? 0 : static_cast<double>(total_rank_error) / num_samples;
+	}
+};
+
+/** @brief A relaxed concurrent priority queue.
+ *
+ * The MultiQueue consists of multiple internal heaps, each protected by its own lock. A push
+ * inserts into a random heap. A pop looks at two random heaps and removes the top element of the
+ * one with the higher priority. This results in an approximate best-first order with very little
+ * contention if the number of heaps is a small multiple of the number of threads.
+ *
+ * @tparam Priority The priority type, the element with the highest priority is popped first
+ * @tparam T The element type
+ */
+template <typename Priority, typename T>
+class MultiQueue
+{
+	static_assert(std::is_arithmetic_v<Priority>, "The priority must be an arithmetic type");
+
+	/** A single heap. */
+	struct alignas(64) Heap
+	{
+		std::mutex                          mutex;
+		std::vector<std::pair<Priority, T>> elements;
+		// The following can be read without locking the heap.
+		std::atomic_bool      is_empty{true};
+		std::atomic<Priority> top_priority{std::numeric_limits<Priority>::lowest()};
+	};
+
+public:
+	/** Construct a MultiQueue.
+	 * @param num_heaps The number of internal heaps
+	 * @param rank_error_sampling_interval Measure the rank error of every n-th pop. Measuring the
+	 * rank error is expensive, as all heaps need to be scanned. If 0, do not measure the rank error.
+	 */
+	explicit MultiQueue(std::size_t num_heaps, std::size_t rank_error_sampling_interval = 0)
+	: rank_error_sampling_interval_(rank_error_sampling_interval)
+	{
+		assert(num_heaps > 0);
+		heaps_.reserve(num_heaps);
+		for (std::size_t i = 0; i < num_heaps; ++i) {
+			heaps_.push_back(std::make_unique<Heap>());
+		}
+	}
+
+	/** Add an element to the queue.
+	 * @param element A pair (priority, element)
+	 */
+	void
+	push(std::pair<Priority, T> &&element)
+	{
+		auto &rng = get_rng();
+		while (true) {
+			auto            &heap = *heaps_[rng() % heaps_.size()];
+			std::unique_lock lock{heap.mutex, std::try_to_lock};
+			if (!lock.owns_lock()) {
+				// Another thread is using the heap, try a different one.
+				continue;
+			}
+			heap.elements.push_back(std::move(element));
+			std::push_heap(std::begin(heap.elements), std::end(heap.elements), compare);
+			heap.top_priority = heap.elements.front().first;
+			heap.is_empty     = false;
+			++size_;
+			return;
+		}
+	}
+
+	/** Remove an element with a high priority.
+	 * @return The removed pair (priority, element) or nothing if the queue is empty
+	 */
+	std::optional<std::pair<Priority, T>>
+	pop()
+	{
+		auto &rng = get_rng();
+		while (size_ > 0) {
+			// Select the better one of two random heaps.
+			Heap *heap       = heaps_[rng() % heaps_.size()].get();
+			Heap *other_heap = heaps_[rng() % heaps_.size()].get();
+			if (!other_heap->is_empty
+			    && (heap->is_empty || other_heap->top_priority > heap->top_priority)) {
+				heap = other_heap;
+			}
+			if (heap->is_empty) {
+				heap = find_non_empty_heap();
+				if (heap == nullptr) {
+					continue;
+				}
+			}
+			std::unique_lock lock{heap->mutex, std::try_to_lock};
+			if (!lock.owns_lock() || heap->elements.empty()) {
+				continue;
+			}
+			std::pop_heap(std::begin(heap->elements), std::end(heap->elements), compare);
+			auto element = std::move(heap->elements.back());
+			heap->elements.pop_back();
+			if (heap->elements.empty()) {
+				heap->is_empty = true;
+			} else {
+				heap->top_priority = heap->elements.front().first;
+			}
+			--size_;
+			lock.unlock();
+			const auto num_pops = ++num_pops_;
+			if (rank_error_sampling_interval_ > 0 && num_pops % rank_error_sampling_interval_ == 0) {
+				record_rank_error(element.first);
+			}
+			return element;
+		}
+		return std::nullopt;
+	}
+
+	/** Get the number of elements in the queue. */
+	std::size_t
+	size() const
+	{
+		return size_;
+	}
+
+	/** Check whether the queue is empty. */
+	bool
+	empty() const
+	{
+		return size_ == 0;
+	}
+
+	/** Call a function for each element in the queue, in no particular order.
+	 * This locks one heap at a time, so elements that are pushed or popped concurrently may or may not
+	 * be visited.
+	 * @param visit A Callable that is called with each pair (priority, element)
+	 */
+	template <typename Visitor>
+	void
+	for_each(Visitor &&visit) const
+	{
+		for (const auto &heap : heaps_) {
+			std::lock_guard lock{heap->mutex};
+			for (const auto &element : heap->elements) {
+				visit(element);
+			}
+		}
+	}
+
+	/** Get the rank error statistics of all pops so far. */
+	RankErrorStatistics
+	get_rank_error_statistics() const
+	{
+		RankErrorStatistics statistics;
+		statistics.num_pops         = num_pops_;
+		statistics.num_samples      = num_samples_;
+		statistics.total_rank_error = total_rank_error_;
+		statistics.max_rank_error   = max_rank_error_;
+		return statistics;
+	}
+
+private:
+	static bool
+	compare(const std::pair<Priority, T> &first, const std::pair<Priority, T> &second)
+	{
+		return first.first < second.first;
+	}
+
+	static std::minstd_rand &
+	get_rng()
+	{
+		static thread_local std::minstd_rand rng{std::random_device{}()};
+		return rng;
+	}
+
+	/** Find any heap that is not empty, used if both randomly selected heaps are empty. */
+	Heap *
+	find_non_empty_heap() const
+	{
+		for (const auto &heap : heaps_) {
+			if (!heap->is_empty) {
+				return heap.get();
+			}
+		}
+		return nullptr;
+	}
+
+	/** Count the elements with a higher priority than the popped element. This locks one heap at a
+	 * time, so the result is only approximate if the queue is modified concurrently. */
+	void
+	record_rank_error(const Priority &popped_priority)
+	{
+		std::size_t rank_error = 0;
+		for (const auto &heap : heaps_) {
+			std::lock_guard lock{heap->mutex};
+			rank_error += static_cast<std::size_t>(
+			  std::count_if(std::begin(heap->elements),
+			                std::end(heap->elements),
+			                [&popped_priority](const auto &element) {
+				                return element.first > popped_priority;
+			                }));
+		}
+		++num_samples_;
+		total_rank_error_ += rank_error;
+		auto max = max_rank_error_.load();
+		while (rank_error > max && !max_rank_error_.compare_exchange_weak(max, rank_error)) {}
+	}
+
+	std::vector<std::unique_ptr<Heap>> heaps_;
+	std::atomic<std::size_t>           size_{0};
+	const std::size_t                  rank_error_sampling_interval_;
+	std::atomic<std::size_t>           num_pops_{0};
+	std::atomic<std::size_t>           num_samples_{0};
+	std::atomic<std::size_t>           total_rank_error_{0};
+	std::atomic<std::size_t>           max_rank_error_{0};
+};
+
+} // namespace tacos::utilities
@@ -9,13 +9,24 @@
 #ifndef SRC_UTILITIES_INCLUDE_UTILITIES_PRIORITY_THREAD_POOL_H
 #define SRC_UTILITIES_INCLUDE_UTILITIES_PRIORITY_THREAD_POOL_H
 
+#include "bucket_queue.h"
+#include "multi_queue.h"
+
+#include <algorithm>
 #include <atomic>
 #include <condition_variable>
+#include <deque>
 #include <functional>
+#include <iterator>
+#include <memory>
 #include <mutex>
-#include <queue>
+#include <optional>
+#include <random>
+#include <stdexcept>
 #include <thread>
+#include <type_traits>
 #include <utility>
+#include <vector>
 
 namespace tacos::utilities {
 
@@ -45,7 +56,52 @@ struct CompareFirstOfPair
 template <class Priority, class T>
 class QueueAccess;
 
+/** The strategy that a ThreadPool uses to distribute jobs to its workers. */
+enum class SchedulingMode {
+	/** All workers share a single priority queue. Jobs are strictly processed in priority order. */
+	GLOBAL_QUEUE,
+	/** Each worker has its own deque. A worker processes its own jobs in LIFO order and steals the
+	 * oldest job of a random other worker if it runs out of jobs. Priorities are ignored. */
+	WORK_STEALING,
+	/** Each worker has its own priority queue and steals the best job of a random other worker if it
+	 * runs out of jobs. Additionally, after a bounded number of local jobs, a worker compares its
+	 * best job with the best job of a random other worker and takes the better one. This keeps the
+	 * priority order approximately intact. */
+	RELAXED_PRIORITY,
+	/** All workers share a MultiQueue, i.e., a relaxed priority queue that consists of multiple
+	 * heaps, where each pop takes the better top element of two random heaps. */
+	MULTI_QUEUE,
+};
+
+/** The data structure of the pool's global queue. */
+enum class QueueType {
+	/** A binary heap, which works with any priorities. */
+	BINARY_HEAP,
+	/** A BucketQueue, which requires integer priorities. It is only efficient if the priorities of the
+	 * queued jobs span a small range. */
+	BUCKET_QUEUE,
+};
+
+/** Statistics about queued jobs that became obsolete before they were run.
+ * @see ThreadPool::set_obsolete_job_check
+ */
+struct ObsoleteJobStatistics
+{
+	/** The number of obsolete jobs that were dropped when they were taken from the queue. */
+	std::size_t num_discarded_jobs{0};
+	/** The number of obsolete jobs that were removed by compacting the queue. */
+	std::size_t num_compacted_jobs{0};
+	/** The number of times the queue was compacted. */
+	std::size_t num_compactions{0};
+	/** The maximal number of jobs that were queued at the same time. */
+	std::size_t max_queued_jobs{0};
+};
+
 /** @brief A multi-threaded priority queue with a fixed number of workers.
+ *
+ * By default, all workers share a single priority queue. Alternatively, each worker may have its
+ * own queue, see SchedulingMode. In any case, jobs that are added before the pool is started are
+ * kept in a single priority queue, which can be processed directly with a QueueAccess.
  *
  * @tparam Priority The priority type
  * @tparam T The job type, must be a Callable
@@ -78,8 +134,46 @@ public:
 	 * @param priority The priority of the job, the job with the highest priority is run first
 	 */
 	void add_job(T &&job, const Priority &priority = Priority{});
+	/** Set the scheduling mode, must be called before the pool is started.
+	 * @param mode The scheduling mode to use
+	 * @param relaxation With SchedulingMode::RELAXED_PRIORITY, the number of local jobs after which a
+	 * worker compares its best job with the best job of another worker
+	 * @param heaps_per_worker With SchedulingMode::MULTI_QUEUE, the number of heaps per worker
+	 */
+	void set_scheduling_mode(SchedulingMode mode,
+	                         std::size_t    relaxation       = 8,
+	                         std::size_t    heaps_per_worker = 2);
+	/** Set the data structure of the global queue. Jobs that are already queued are moved to the
+	 * new queue. This must be called before the pool is started.
+	 * @param type The type of the queue
+	 */
+	void set_queue_type(QueueType type);
+	/** Set a check that tells whether a queued job has become obsolete, e.g., because its result is
+	 * no longer needed. Obsolete jobs are dropped instead of being run when they are taken from the
+	 * queue. Additionally, the global queue is compacted once the number of dropped jobs is large
+	 * compared to the queue size. The check may be called while the queue is locked, so it must not
+	 * add jobs to the pool. It is called at most once for each job for which it returns true. This
+	 * must be called before the pool is started.
+	 * @param is_obsolete The check, returns true if the given job is obsolete
+	 */
+	void set_obsolete_job_check(std::function<bool(const T &)> is_obsolete);
+	/** Remove all obsolete jobs from the queue. Jobs in a MultiQueue are only dropped lazily. */
+	void compact_queue();
+	/** Call a function for each queued job, in no particular order.
+	 * Jobs that a worker has already taken from the queue are not visited, even if they have not
+	 * been run yet. The queues are locked while they are visited, so the function must not add jobs
+	 * to the pool.
+	 * @param visit A Callable that is called with each pair (priority, job)
+	 */
+	template <typename Visitor>
+	void visit_queued_jobs(Visitor &&visit);
 	/** Start the workers in the pool. */
 	void start();
+	/** Start the workers in the pool with a different number of workers than configured on
+	 * construction.
+	 * @param num_threads The number of workers to start
+	 */
+	void start(std::size_t num_threads);
 	/** Stop the workers. They will finish their current job, but not necessarily process all jobs in
 	 * the queue. */
 	void cancel();
@@ -89,15 +183,147 @@ public:
 	void wait();
 	/** Close the queue and let the workers finish all jobs. */
 	void finish();
+	/** Get the rank error statistics of the pool's queue.
+	 * The rank error is only measured with SchedulingMode::MULTI_QUEUE, where every n-th pop is
+	 * sampled. In all other modes, the statistics are empty.
+	 */
+	RankErrorStatistics get_rank_error_statistics() const;
+	/** Get the statistics about obsolete jobs. */
+	ObsoleteJobStatistics get_obsolete_job_statistics() const;
+
+	/** Measure the rank error of every n-th job with SchedulingMode::MULTI_QUEUE. */
+	static constexpr std::size_t rank_error_sampling_interval = 256;
 
 private:
+	/** The global job queue, which is either a binary heap or a bucket queue. */
+	class GlobalQueue
+	{
+	public:
+		void
+		set_type(QueueType type)
+		{
+			if (type == QueueType::BUCKET_QUEUE && !std::is_integral_v<Priority>) {
+				throw std::invalid_argument("A bucket queue requires integer priorities");
+			}
+			if ((type == QueueType::BUCKET_QUEUE) == buckets.has_value()) {
+				return;
+			}
+			GlobalQueue new_queue;
+			if (type == QueueType::BUCKET_QUEUE) {
+				new_queue.buckets.emplace();
+			}
+			for (; !empty(); pop()) {
+				new_queue.push(top());
+			}
+			*this = std::move(new_queue);
+		}
+
+		void
+		push(std::pair<Priority, T> job)
+		{
+			if (buckets) {
+				buckets->push(std::move(job));
+			} else {
+				heap.push_back(std::move(job));
+				std::push_heap(std::begin(heap), std::end(heap), CompareFirstOfPair<Priority, T>{});
+			}
+		}
+
+		const std::pair<Priority, T> &
+		top() const
+		{
+			return buckets ? buckets->top() : heap.front();
+		}
+
+		void
+		pop()
+		{
+			if (buckets) {
+				buckets->pop();
+			} else {
+				std::pop_heap(std::begin(heap), std::end(heap), CompareFirstOfPair<Priority, T>{});
+				heap.pop_back();
+			}
+		}
+
+		template <typename Predicate>
+		std::size_t
+		remove_if(Predicate predicate)
+		{
+			if (buckets) {
+				return buckets->remove_if(predicate);
+			}
+			const auto new_end     = std::remove_if(std::begin(heap), std::end(heap), predicate);
+			const auto num_removed = static_cast<std::size_t>(std::distance(new_end, std::end(heap)));
+			heap.erase(new_end, std::end(heap));
+			std::make_heap(std::begin(heap), std::end(heap), CompareFirstOfPair<Priority, T>{});
+			return num_removed;
+		}
+
+		template <typename Visitor>
+		void
+		for_each(Visitor &&visit) const
+		{
+			if (buckets) {
+				buckets->for_each(visit);
+				return;
+			}
+			for (const auto &job : heap) {
+				visit(job);
+			}
+		}
+
+		bool
+		empty() const
+		{
+			return buckets ? buckets->empty() : heap.empty();
+		}
+
+		std::size_t
+		size() const
+		{
+			return buckets ? buckets->size() : heap.size();
+		}
+
+	private:
+		/** A binary heap, maintained with std::push_heap and std::pop_heap. */
+		std::vector<std::pair<Priority, T>>     heap;
+		std::optional<BucketQueue<Priority, T>> buckets;
+	};
+
+	/** The job queue of a single worker, only used if the pool is not using a global queue. */
+	struct alignas(64) WorkerQueue
+	{
+		std::mutex                         mutex;
+		std::deque<std::pair<Priority, T>> jobs;
+		std::size_t                        num_local_jobs{0};
+	};
+
+	bool             uses_global_queue() const;
+	void             run_global_queue_worker(std::size_t worker);
+	void             run_work_stealing_worker(std::size_t worker);
+	void             push_job(std::pair<Priority, T> &&job);
+	std::optional<T> take_job(std::size_t worker, std::minstd_rand &rng);
+	std::optional<T> take_better_job(std::size_t worker, std::size_t victim);
+	std::optional<T> pop_job(WorkerQueue &worker_queue, bool steal);
+	/** Check whether the job is obsolete and count it as discarded if so. */
+	bool discard_if_obsolete(const T &job);
+	/** Drop obsolete jobs from the top of the global queue and compact the queue if many jobs have
+	 * been dropped. The queue must be locked. */
+	void discard_obsolete_jobs();
+	/** Remove all obsolete jobs from the global queue. The queue must be locked. */
+	void compact_global_queue();
+	void update_max_queued_jobs(std::size_t num_jobs);
+	/** Get the pool and the index of the worker that runs on the current thread. */
+	static std::pair<ThreadPool *, std::size_t> &current_worker();
+
 	std::size_t              size;
+	SchedulingMode           scheduling_mode{SchedulingMode::GLOBAL_QUEUE};
+	std::size_t              relaxation{8};
+	std::size_t              heaps_per_worker{2};
 	bool                     started{false};
 	std::vector<std::thread> workers;
-	std::priority_queue<std::pair<Priority, T>,
-	                    std::vector<std::pair<Priority, T>>,
-	                    CompareFirstOfPair<Priority, T>>
-	                        queue;
+	GlobalQueue              queue;
 	std::atomic_bool        stopping{false};
 	std::atomic_bool        queue_open{true};
 	std::mutex              queue_mutex;
@@ -105,6 +331,19 @@ private:
 	std::vector<bool>       worker_idle;
 	std::condition_variable worker_idle_cond;
 	std::mutex              worker_idle_mutex;
+	// Only used if the pool is not using a global queue.
+	std::vector<std::unique_ptr<WorkerQueue>> worker_queues;
+	std::unique_ptr<MultiQueue<Priority, T>>  multi_queue;
+	std::atomic<std::size_t>                  num_queued_jobs{0};
+	std::atomic<std::size_t>                  num_pending_jobs{0};
+	std::atomic<std::size_t>                  num_sleeping_workers{0};
+	std::atomic<std::size_t>                  next_worker_queue{0};
+	std::function<bool(const T &)>            is_obsolete;
+	std::size_t                               num_discarded_since_compaction{0};
+	std::atomic<std::size_t>                  num_discarded_jobs{0};
+	std::atomic<std::size_t>                  num_compacted_jobs{0};
+	std::atomic<std::size_t>                  num_compactions{0};
+	std::atomic<std::size_t>                  max_queued_jobs{0};
 };
 
 /** @brief Get direct access to the job of a thread pool.
@@ -124,16 +363,16 @@ public:
 	 * @param pool The pool to access
 	 */
 	QueueAccess(ThreadPool<Priority, T> *pool);
-	/** Get the first element of the pool.
+	/** Get the first element of the pool. Obsolete jobs at the top of the queue are dropped first.
 	 * @return The first element of the pool's queue.
 	 */
 	const std::pair<Priority, T> &top() const;
 	/** Remove the first element of the pool's queue. */
 	void pop();
-	/** Check if the pool's queue is empty. */
+	/** Check if the pool's queue is empty, ignoring obsolete jobs at the top of the queue. */
 	bool empty() const;
 
-	/** Get the size of the queue. */
+	/** Get the size of the queue, including obsolete jobs that have not been dropped yet. */
 	std::size_t get_size() const;
 
 private:
@@ -11,6 +11,7 @@
 #include "priority_thread_pool.h"
 
 #include <algorithm>
+#include <iterator>
 #include <mutex>
 #include <stdexcept>
 
@@ -38,6 +39,147 @@ ThreadPool<Priority, T>::ThreadPool(StartOnInit start_on_init, std::size_t size)
 	}
 }
 
+template <class Priority, class T>
+void
+ThreadPool<Priority, T>::set_scheduling_mode(SchedulingMode mode,
+                                             std::size_t    relaxation,
+                                             std::size_t    heaps_per_worker)
+{
+	if (started) {
+		throw QueueStartedException("Pool already started");
+	}
+	scheduling_mode        = mode;
+	this->relaxation       = relaxation;
+	this->heaps_per_worker = heaps_per_worker;
+}
+
+template <class Priority, class T>
+void
+ThreadPool<Priority, T>::set_queue_type(QueueType type)
+{
+	if (started) {
+		throw QueueStartedException("Pool already started");
+	}
+	std::lock_guard guard{queue_mutex};
+	queue.set_type(type);
+}
+
+template <class Priority, class T>
+void
+ThreadPool<Priority, T>::set_obsolete_job_check(std::function<bool(const T &)> is_obsolete)
+{
+	if (started) {
+		throw QueueStartedException("Pool already started");
+	}
+	this->is_obsolete = std::move(is_obsolete);
+}
+
+template <class Priority, class T>
+void
+ThreadPool<Priority, T>::compact_queue()
+{
+	if (!is_obsolete) {
+		return;
+	}
+	{
+		std::lock_guard guard{queue_mutex};
+		compact_global_queue();
+	}
+	std::size_t num_removed = 0;
+	for (auto &worker_queue : worker_queues) {
+		std::lock_guard guard{worker_queue->mutex};
+		auto           &jobs = worker_queue->jobs;
+		const auto      new_end =
+		  std::remove_if(std::begin(jobs), std::end(jobs), [this](const std::pair<Priority, T> &job) {
+			  return is_obsolete(job.second);
+		  });
+		num_removed += static_cast<std::size_t>(std::distance(new_end, std::end(jobs)));
+		jobs.erase(new_end, std::end(jobs));
+		if (scheduling_mode == SchedulingMode::RELAXED_PRIORITY) {
+			std::make_heap(std::begin(jobs), std::end(jobs), CompareFirstOfPair<Priority, T>{});
+		}
+	}
+	if (num_removed == 0) {
+		return;
+	}
+	num_compacted_jobs += num_removed;
+	num_queued_jobs -= num_removed;
+	if ((num_pending_jobs -= num_removed) == 0) {
+		std::lock_guard done_guard{worker_idle_mutex};
+		worker_idle_cond.notify_all();
+	}
+}
+
+template <class Priority, class T>
+template <typename Visitor>
+void
+ThreadPool<Priority, T>::visit_queued_jobs(Visitor &&visit)
+{
+	{
+		std::lock_guard guard{queue_mutex};
+		queue.for_each(visit);
+	}
+	for (auto &worker_queue : worker_queues) {
+		std::lock_guard guard{worker_queue->mutex};
+		for (const auto &job : worker_queue->jobs) {
+			visit(job);
+		}
+	}
+	if (multi_queue) {
+		multi_queue->for_each(visit);
+	}
+}
+
+template <class Priority, class T>
+bool
+ThreadPool<Priority, T>::discard_if_obsolete(const T &job)
+{
+	if (!is_obsolete || !is_obsolete(job)) {
+		return false;
+	}
+	++num_discarded_jobs;
+	return true;
+}
+
+template <class Priority, class T>
+void
+ThreadPool<Priority, T>::discard_obsolete_jobs()
+{
+	if (!is_obsolete) {
+		return;
+	}
+	while (!queue.empty() && discard_if_obsolete(queue.top().second)) {
+		queue.pop();
+		++num_discarded_since_compaction;
+	}
+	// Obsolete jobs at the top indicate that there are more obsolete jobs further down. Compacting
+	// only after many dropped jobs keeps the amortized cost per dropped job constant.
+	if (2 * num_discarded_since_compaction > queue.size()) {
+		compact_global_queue();
+	}
+}
+
+template <class Priority, class T>
+void
+ThreadPool<Priority, T>::compact_global_queue()
+{
+	num_discarded_since_compaction = 0;
+	if (queue.empty()) {
+		return;
+	}
+	++num_compactions;
+	num_compacted_jobs +=
+	  queue.remove_if([this](const std::pair<Priority, T> &job) { return is_obsolete(job.second); });
+}
+
+template <class Priority, class T>
+void
+ThreadPool<Priority, T>::update_max_queued_jobs(std::size_t num_jobs)
+{
+	std::size_t max_jobs = max_queued_jobs;
+	while (max_jobs < num_jobs && !max_queued_jobs.compare_exchange_weak(max_jobs, num_jobs)) {}
+}
+
 template <class Priority, class T>
 void
 ThreadPool<Priority, T>::start()
@@ -46,38 +188,245 @@ ThreadPool<Priority, T>::start()
 		throw QueueStartedException("Pool already started");
 	}
 	worker_idle = std::vector(size, false);
-	for (std::size_t i = 0; i < size; ++i) {
-		workers.push_back(std::thread{[this, i]() {
-			while (!stopping) {
-				{
-					std::lock_guard idle_guard{worker_idle_mutex};
-					worker_idle[i] = false;
-				}
-				std::unique_lock lock{queue_mutex};
-				while (!queue.empty()) {
-					auto job = std::get<1>(queue.top());
-					queue.pop();
-					lock.unlock();
-					job();
-					lock.lock();
-					if (stopping) {
-						return;
-					}
-				}
-				{
-					std::lock_guard done_guard{worker_idle_mutex};
-					worker_idle[i] = true;
-					worker_idle_cond.notify_all();
-				}
-				if (!queue_open) {
-					return;
-				}
-				// Wait for the stop signal or a new job.
-				queue_cond.wait(lock, [this] { return stopping || !queue.empty() || !queue_open; });
+	if (scheduling_mode == SchedulingMode::MULTI_QUEUE && size > 0) {
+		multi_queue = std::make_unique<MultiQueue<Priority, T>>(
+		  std::max<std::size_t>(heaps_per_worker, 1) * size, rank_error_sampling_interval);
+		for (; !queue.empty(); queue.pop()) {
+			auto job = queue.top();
+			multi_queue->push(std::move(job));
+			++num_queued_jobs;
+			++num_pending_jobs;
+		}
+	} else if (scheduling_mode != SchedulingMode::GLOBAL_QUEUE && size > 0) {
+		// Distribute all jobs that have been added before the pool was started.
+		for (std::size_t i = 0; i < size; ++i) {
+			worker_queues.push_back(std::make_unique<WorkerQueue>());
+		}
+		for (std::size_t i = 0; !queue.empty(); ++i, queue.pop()) {
+			auto &jobs = worker_queues[i % size]->jobs;
+			jobs.push_back(queue.top());
+			if (scheduling_mode == SchedulingMode::RELAXED_PRIORITY) {
+				std::push_heap(std::begin(jobs), std::end(jobs), CompareFirstOfPair<Priority, T>{});
 			}
-		}});
+			++num_queued_jobs;
+			++num_pending_jobs;
+		}
 	}
+	// Set this before starting the workers, as add_job depends on it.
 	started = true;
+	const bool use_global_queue = uses_global_queue();
+	for (std::size_t i = 0; i < size; ++i) {
+		if (use_global_queue) {
+			workers.push_back(std::thread{[this, i]() { run_global_queue_worker(i); }});
+		} else {
+			workers.push_back(std::thread{[this, i]() { run_work_stealing_worker(i); }});
+		}
+	}
+}
+
+template <class Priority, class T>
+bool
+ThreadPool<Priority, T>::uses_global_queue() const
+{
+	return !started || scheduling_mode == SchedulingMode::GLOBAL_QUEUE || size == 0;
+}
+
+template <class Priority, class T>
+void
+ThreadPool<Priority, T>::run_global_queue_worker(std::size_t worker)
+{
+	while (!stopping) {
+		{
+			std::lock_guard idle_guard{worker_idle_mutex};
+			worker_idle[worker] = false;
+		}
+		std::unique_lock lock{queue_mutex};
+		for (discard_obsolete_jobs(); !queue.empty(); discard_obsolete_jobs()) {
+			auto job = std::get<1>(queue.top());
+			queue.pop();
+			lock.unlock();
+			job();
+			lock.lock();
+			if (stopping) {
+				return;
+			}
+		}
+		{
+			std::lock_guard done_guard{worker_idle_mutex};
+			worker_idle[worker] = true;
+			worker_idle_cond.notify_all();
+		}
+		if (!queue_open) {
+			return;
+		}
+		// Wait for the stop signal or a new job.
+		queue_cond.wait(lock, [this] { return stopping || !queue.empty() || !queue_open; });
+	}
+}
+
+template <class Priority, class T>
+void
+ThreadPool<Priority, T>::run_work_stealing_worker(std::size_t worker)
+{
+	current_worker() = {this, worker};
+	std::minstd_rand rng{static_cast<std::minstd_rand::result_type>(worker + 1)};
+	while (!stopping) {
+		if (auto job = take_job(worker, rng)) {
+			if (!discard_if_obsolete(*job)) {
+				(*job)();
+			}
+			if (--num_pending_jobs == 0) {
+				std::lock_guard done_guard{worker_idle_mutex};
+				worker_idle_cond.notify_all();
+			}
+			continue;
+		}
+		std::unique_lock lock{queue_mutex};
+		if (!queue_open && num_queued_jobs == 0) {
+			return;
+		}
+		// Wait for the stop signal or a new job. The counter tells add_job that it needs to notify us.
+		++num_sleeping_workers;
+		queue_cond.wait(lock, [this] { return stopping || num_queued_jobs > 0 || !queue_open; });
+		--num_sleeping_workers;
+	}
+}
+
+template <class Priority, class T>
+void
+ThreadPool<Priority, T>::push_job(std::pair<Priority, T> &&job)
+{
+	// Count the job as pending before it becomes visible to other workers, otherwise wait() may
+	// return early.
+	++num_pending_jobs;
+	if (multi_queue) {
+		update_max_queued_jobs(++num_queued_jobs);
+		multi_queue->push(std::move(job));
+	} else {
+		auto [pool, worker] = current_worker();
+		if (pool != this) {
+			// The job is added from outside of the pool, distribute it evenly.
+			worker = next_worker_queue++ % size;
+		}
+		auto           &worker_queue = *worker_queues[worker];
+		std::lock_guard guard{worker_queue.mutex};
+		worker_queue.jobs.push_back(std::move(job));
+		if (scheduling_mode == SchedulingMode::RELAXED_PRIORITY) {
+			std::push_heap(std::begin(worker_queue.jobs),
+			               std::end(worker_queue.jobs),
+			               CompareFirstOfPair<Priority, T>{});
+		}
+		update_max_queued_jobs(++num_queued_jobs);
+	}
+	if (num_sleeping_workers > 0) {
+		std::lock_guard guard{queue_mutex};
+		queue_cond.notify_one();
+	}
+}
+
+template <class Priority, class T>
+std::optional<T>
+ThreadPool<Priority, T>::take_job(std::size_t worker, std::minstd_rand &rng)
+{
+	if (multi_queue) {
+		if (auto job = multi_queue->pop()) {
+			--num_queued_jobs;
+			return std::move(job->second);
+		}
+		return std::nullopt;
+	}
+	auto &own_queue = *worker_queues[worker];
+	if (scheduling_mode == SchedulingMode::RELAXED_PRIORITY && size > 1 && relaxation > 0
+	    && ++own_queue.num_local_jobs % relaxation == 0) {
+		const std::size_t victim = (worker + 1 + rng() % (size - 1)) % size;
+		if (auto job = take_better_job(worker, victim)) {
+			return job;
+		}
+	}
+	if (auto job = pop_job(own_queue, false)) {
+		return job;
+	}
+	// Our own queue is empty, try to steal a job from the other workers, starting at a random one.
+	const std::size_t first_victim = rng() % size;
+	for (std::size_t i = 0; i < size; ++i) {
+		const std::size_t victim = (first_victim + i) % size;
+		if (victim == worker) {
+			continue;
+		}
+		if (auto job = pop_job(*worker_queues[victim], true)) {
+			return job;
+		}
+	}
+	return std::nullopt;
+}
+
+template <class Priority, class T>
+std::optional<T>
+ThreadPool<Priority, T>::take_better_job(std::size_t worker, std::size_t victim)
+{
+	std::optional<Priority> own_best;
+	{
+		auto           &own_queue = *worker_queues[worker];
+		std::lock_guard guard{own_queue.mutex};
+		if (!own_queue.jobs.empty()) {
+			own_best = own_queue.jobs.front().first;
+		}
+	}
+	auto           &victim_queue = *worker_queues[victim];
+	std::lock_guard guard{victim_queue.mutex};
+	auto           &jobs = victim_queue.jobs;
+	if (jobs.empty() || (own_best && !(*own_best < jobs.front().first))) {
+		return std::nullopt;
+	}
+	std::pop_heap(std::begin(jobs), std::end(jobs), CompareFirstOfPair<Priority, T>{});
+	auto job = std::move(jobs.back().second);
+	jobs.pop_back();
+	--num_queued_jobs;
+	return job;
+}
+
+template <class Priority, class T>
+std::optional<T>
+ThreadPool<Priority, T>::pop_job(WorkerQueue &worker_queue, bool steal)
+{
+	std::lock_guard guard{worker_queue.mutex};
+	auto           &jobs = worker_queue.jobs;
+	if (jobs.empty()) {
+		return std::nullopt;
+	}
+	std::optional<T> job;
+	if (scheduling_mode == SchedulingMode::RELAXED_PRIORITY) {
+		std::pop_heap(std::begin(jobs), std::end(jobs), CompareFirstOfPair<Priority, T>{});
+		job = std::move(jobs.back().second);
+		jobs.pop_back();
+	} else if (steal) {
+		job = std::move(jobs.front().second);
+		jobs.pop_front();
+	} else {
+		job = std::move(jobs.back().second);
+		jobs.pop_back();
+	}
+	--num_queued_jobs;
+	return job;
+}
+
+template <class Priority, class T>
+std::pair<ThreadPool<Priority, T> *, std::size_t> &
+ThreadPool<Priority, T>::current_worker()
+{
+	static thread_local std::pair<ThreadPool *, std::size_t> worker{nullptr, 0};
+	return worker;
+}
+
+template <class Priority, class T>
+void
+ThreadPool<Priority, T>::start(std::size_t num_threads)
+{
+	if (started) {
+		throw QueueStartedException("Pool already started");
+	}
+	size = num_threads;
+	start();
 }
 
 template <class Priority, class T>
@@ -93,8 +442,13 @@ ThreadPool<Priority, T>::add_job(std::pair<Priority, T> &&job)
 	if (!queue_open) {
 		throw QueueClosedException("Queue is closed!");
 	}
+	if (!uses_global_queue()) {
+		push_job(std::move(job));
+		return;
+	}
 	std::lock_guard guard{queue_mutex};
 	queue.push(job);
+	update_max_queued_jobs(queue.size());
 	queue_cond.notify_one();
 }
 
@@ -117,6 +471,10 @@ void
 ThreadPool<Priority, T>::wait()
 {
 	std::unique_lock lock{worker_idle_mutex};
+	if (!uses_global_queue()) {
+		worker_idle_cond.wait(lock, [this] { return stopping || num_pending_jobs == 0; });
+		return;
+	}
 	while (true) {
 		if (std::all_of(begin(worker_idle), end(worker_idle), [](const auto &worker_idle) {
 			    return worker_idle;
@@ -148,9 +506,35 @@ void
 ThreadPool<Priority, T>::cancel()
 {
 	stopping = true;
+	{
+		std::lock_guard guard{worker_idle_mutex};
+		worker_idle_cond.notify_all();
+	}
 	finish();
 }
 
+template <class Priority, class T>
+RankErrorStatistics
+ThreadPool<Priority, T>::get_rank_error_statistics() const
+{
+	if (multi_queue) {
+		return multi_queue->get_rank_error_statistics();
+	}
+	return {};
+}
+
+template <class Priority, class T>
+ObsoleteJobStatistics
+ThreadPool<Priority, T>::get_obsolete_job_statistics() const
+{
+	ObsoleteJobStatistics statistics;
+	statistics.num_discarded_jobs = num_discarded_jobs;
+	statistics.num_compacted_jobs = num_compacted_jobs;
+	statistics.num_compactions    = num_compactions;
+	statistics.max_queued_jobs    = max_queued_jobs;
+	return statistics;
+}
+
 template <class Priority, class T>
 QueueAccess<Priority, T>::QueueAccess(ThreadPool<Priority, T> *pool) : pool(pool)
 {
@@ -163,6 +547,7 @@ QueueAccess<Priority, T>::top() const
 	if (pool->started) {
 		throw QueueStartedException("Pool already started");
 	}
+	pool->discard_obsolete_jobs();
 	return pool->queue.top();
 }
 
@@ -183,6 +568,7 @@ QueueAccess<Priority, T>::empty() const
 	if (pool->started) {
 		throw QueueStartedException("Pool already started");
 	}
+	pool->discard_obsolete_jobs();
 	return pool->queue.empty();
 }
 
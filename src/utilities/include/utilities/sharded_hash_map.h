@@ -0,0 +1,261 @@
+/***************************************************************************
+ *  sharded_hash_map.h - A hash map that is split into independently locked shards
+ *
+ *  Created:   Fri 16 Oct 14:05:31 CEST 2026
+ *  Copyright  2026  Till Hofmann <hofmann@kbsg.rwth-aachen.de>
+ *  SPDX-License-Identifier: LGPL-3.0-or-later
+ ****************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+namespace tacos::utilities {
+
+/** @brief A thread-safe hash map that is split into shards.
+ *
+ * Each key is assigned to exactly one shard based on its hash and each shard is protected by its
+ * own mutex. Concurrent accesses to keys in different shards therefore do not block each other.
+ * The map only supports insertion, elements are never removed. Thus, references to stored values
+ * stay valid for the lifetime of the map.
+ *
+ * Iterating over the map is not thread-safe, i.e., the map must not be modified while iterating.
+ *
+ * @tparam Key The key type
+ * @tparam Value The value type
+ * @tparam Hash The hash function for the keys
+ * @tparam NumShards The number of shards
+ */
+template <typename Key, typename Value, typename Hash = std::hash<Key>, std::size_t NumShards = 64>
+class ShardedHashMap
+{
+	static_assert(NumShards > 0, "The map needs at least one shard");
+
+	/** A single shard, aligned to avoid false sharing between neighboring shards. */
+	struct alignas(64) Shard
+	{
+		std::mutex                           mutex;
+		std::unordered_map<Key, Value, Hash> map;
+	};
+
+public:
+	/** The type of the stored elements. */
+	using value_type = std::pair<const Key, Value>;
+
+	/** @brief Iterator over all elements in all shards. */
+	class const_iterator
+	{
+	public:
+		/** The iterator category. */
+		using iterator_category = std::forward_iterator_tag;
+		/** The element type. */
+		using value_type = ShardedHashMap::value_type;
+		/** The difference type. */
+		using difference_type = std::ptrdiff_t;
+		/** The pointer type. */
+		using pointer = const value_type *;
+		/** The reference type. */
+		using reference = const value_type &;
+
+		/** Dereference the iterator. */
+		reference
+		operator*() const
+		{
+			return *it_;
+		}
+
+		/** Access the element the iterator points to. */
+		pointer
+		operator->() const
+		{
+			return &*it_;
+		}
+
+		/** Advance the iterator. */
+		const_iterator &
+		operator++()
+		{
+			++it_;
+			skip_empty_shards();
+			return *this;
+		}
+
+		/** Advance the iterator. */
+		const_iterator
+		operator++(int)
+		{
+			auto tmp = *this;
+			++*this;
+			return tmp;
+		}
+
+		/** Compare two iterators for equality. */
+		friend bool
+		operator==(const const_iterator &first, const const_iterator &second)
+		{
+			return first.shard_ == second.shard_
+			       && (first.shard_ == NumShards || first.it_ == second.it_);
+		}
+
+		/** Compare two iterators for inequality. */
+		friend bool
+		operator!=(const const_iterator &first, const const_iterator &second)
+		{
+			return !(first == second);
+		}
+
+	private:
+		friend class ShardedHashMap;
+
+		const_iterator(const std::array<Shard, NumShards> *shards, std::size_t shard)
+		: shards_(shards), shard_(shard)
+		{
+			if (shard_ < NumShards) {
+				it_ = std::begin((*shards_)[shard_].map);
+				skip_empty_shards();
+			}
+		}
+
+		void
+		skip_empty_shards()
+		{
+			while (it_ == std::end((*shards_)[shard_].map)) {
+				if (++shard_ == NumShards) {
+					return;
+				}
+				it_ = std::begin((*shards_)[shard_].map);
+			}
+		}
+
+		const std::array<Shard, NumShards>                            *shards_;
+		std::size_t                                                    shard_;
+		typename std::unordered_map<Key, Value, Hash>::const_iterator it_{};
+	};
+
+	/** Get the value for the given key or insert a new one.
+	 * If the key does not exist yet, insert the value created by make_value. In both cases, call
+	 * visit on the stored value while holding the lock of the key's shard. This allows to
+	 * update the stored value atomically with respect to all other accesses to the same key.
+	 * @param key The key to look up
+	 * @param make_value A Callable without arguments that creates the value if the key is new
+	 * @param visit A Callable that is called with a reference to the stored value
+	 * @return true if the value was newly inserted
+	 */
+	template <typename Factory, typename Visitor>
+	bool
+	get_or_insert(Key key, Factory &&make_value, Visitor &&visit)
+	{
+		auto           &shard = get_shard(key);
+		std::lock_guard lock{shard.mutex};
+		auto            it     = shard.map.find(key);
+		const bool      is_new = it == std::end(shard.map);
+		if (is_new) {
+			it = shard.map.emplace(std::move(key), make_value()).first;
+			size_.fetch_add(1, std::memory_order_relaxed);
+		}
+		visit(it->second);
+		return is_new;
+	}
+
+	/** Get the value for the given key or insert a new one.
+	 * @param key The key to look up
+	 * @param make_value A Callable without arguments that creates the value if the key is new
+	 * @return A pair of a reference to the stored value and a flag that is true if the value was
+	 * newly inserted
+	 */
+	template <typename Factory>
+	std::pair<const Value &, bool>
+	get_or_insert(Key key, Factory &&make_value)
+	{
+		const Value *value  = nullptr;
+		const bool   is_new = get_or_insert(std::move(key),
+		                                    std::forward<Factory>(make_value),
+		                                    [&value](const Value &v) { value = &v; });
+		return {*value, is_new};
+	}
+
+	/** Call visit on the value for the given key while holding the lock of the key's shard.
+	 * @param key The key to look up
+	 * @param visit A Callable that is called with a const reference to the stored value
+	 * @return true if the key exists, false if it does not exist and visit has not been called
+	 */
+	template <typename Visitor>
+	bool
+	visit(const Key &key, Visitor &&visit) const
+	{
+		auto           &shard = get_shard(key);
+		std::lock_guard lock{shard.mutex};
+		const auto      it = shard.map.find(key);
+		if (it == std::end(shard.map)) {
+			return false;
+		}
+		visit(std::as_const(it->second));
+		return true;
+	}
+
+	/** Check whether the map contains the given key. */
+	bool
+	contains(const Key &key) const
+	{
+		auto           &shard = get_shard(key);
+		std::lock_guard lock{shard.mutex};
+		return shard.map.find(key) != std::end(shard.map);
+	}
+
+	/** Get the number of elements in the map.
+	 * This does not lock any shard and may therefore be called concurrently to insertions.
+	 */
+	std::size_t
+	size() const
+	{
+		return size_.load(std::memory_order_relaxed);
+	}
+
+	/** Check whether the map is empty. */
+	bool
+	empty() const
+	{
+		return size() == 0;
+	}
+
+	/** Get an iterator to the first element. Not thread-safe. */
+	const_iterator
+	begin() const
+	{
+		return const_iterator{&shards_, 0};
+	}
+
+	/** Get an iterator past the last element. Not thread-safe. */
+	const_iterator
+	end() const
+	{
+		return const_iterator{&shards_, NumShards};
+	}
+
+private:
+	std::size_t
+	get_shard_index(const Key &key) const
+	{
+		const std::size_t hash = Hash{}(key);
+		// Mix in the upper bits, as the lower bits are also used for the bucket inside the shard.
+		return (hash ^ (hash >> (4 * sizeof(std::size_t)))) % NumShards;
+	}
+
+	Shard &
+	get_shard(const Key &key) const
+	{
+		return shards_[get_shard_index(key)];
+	}
+
+	mutable std::array<Shard, NumShards> shards_;
+	std::atomic<std::size_t>             size_{0};
+};
+
+} // namespace tacos::utilities
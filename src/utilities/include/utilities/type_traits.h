@@ -8,6 +8,11 @@
 
 #pragma once
 
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
 namespace tacos::utilities {
 
 /** @brief Check if two types are the same.
@@ -22,4 +27,53 @@ struct values_equal : std::bool_constant<V1 == V2>
 	using type = T;
 };
 
+/** Check whether a type is a specialization of the given class template. */
+template <typename T, template <typename...> class Template>
+struct is_specialization : std::false_type
+{
+};
+
+/** Check whether a type is a specialization of the given class template. */
+template <template <typename...> class Template, typename... Args>
+struct is_specialization<Template<Args...>, Template> : std::true_type
+{
+};
+
+/** Get the first template argument of a class template specialization. */
+template <typename T>
+struct first_template_argument;
+
+/** Get the first template argument of a class template specialization. */
+template <template <typename...> class Template, typename First, typename... Args>
+struct first_template_argument<Template<First, Args...>>
+{
+	/** The first template argument. */
+	using type = First;
+};
+
+/** Check whether a type is a strong type that wraps another type, e.g., a plant location. */
+template <typename T, typename = void>
+struct is_named_type : std::false_type
+{
+};
+
+/** Check whether a type is a strong type that wraps another type, e.g., a plant location. */
+template <typename T>
+struct is_named_type<T, std::void_t<typename T::UnderlyingType>> : std::true_type
+{
+};
+
+/** Check whether a type can be hashed with std::hash. */
+template <typename T, typename = void>
+struct is_hashable : std::false_type
+{
+};
+
+/** Check whether a type can be hashed with std::hash. */
+template <typename T>
+struct is_hashable<T, std::void_t<decltype(std::hash<T>{}(std::declval<const T &>()))>>
+: std::true_type
+{
+};
+
 } // namespace tacos::utilities
@@ -10,9 +10,22 @@
 
 #include <fmt/ostream.h>
 
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
 #include <iostream>
+#include <iterator>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <stdexcept>
 #include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace tacos {
 
@@ -67,7 +80,422 @@ private:
 	Time valuation_;
 };
 
-using ClockSetValuation = std::map<std::string, Clock>;
+/** @brief An immutable registry of clock names.
+ *
+ * The registry assigns the dense IDs 0, ..., n-1 to a set of n clocks, ordered by their names.
+ * Registries are interned: there is exactly one registry for each set of clocks, so two registries
+ * with the same clocks are the same object.
+ */
+class ClockRegistry
+{
+public:
+	/** The ID of a clock in a registry. */
+	using ClockId = std::size_t;
+
+	/** Get the registry for a set of clocks.
+	 * @param first The beginning of a sorted range of unique clock names
+	 * @param last The end of the range of clock names
+	 * @return The registry for the given clocks
+	 */
+	template <typename InputIt>
+	static std::shared_ptr<const ClockRegistry>
+	get(InputIt first, InputIt last)
+	{
+		// Most lookups ask for the same clocks as the previous lookup, e.g., the clocks of the plant.
+		thread_local std::shared_ptr<const ClockRegistry> last_registry;
+		if (last_registry
+		    && std::equal(std::begin(last_registry->clocks_),
+		                  std::end(last_registry->clocks_),
+		                  first,
+		                  last)) {
+			return last_registry;
+		}
+		last_registry = intern(std::vector<std::string>(first, last));
+		return last_registry;
+	}
+
+	/** Get the registry for a set of clocks.
+	 * @param clocks The clock names
+	 * @return The registry for the given clocks
+	 */
+	static std::shared_ptr<const ClockRegistry>
+	get(const std::set<std::string> &clocks)
+	{
+		return get(std::begin(clocks), std::end(clocks));
+	}
+
+	/** Get the number of clocks in the registry. */
+	[[nodiscard]] std::size_t
+	size() const noexcept
+	{
+		return clocks_.size();
+	}
+
+	/** Get the names of all clocks, the name of the clock with ID i is at position i. */
+	[[nodiscard]] const std::vector<std::string> &
+	get_clocks() const noexcept
+	{
+		return clocks_;
+	}
+
+	/** Get the ID of a clock.
+	 * @param clock The name of the clock
+	 * @return The ID of the clock, or nothing if the clock is not in the registry
+	 */
+	[[nodiscard]] std::optional<ClockId>
+	find(const std::string &clock) const
+	{
+		const auto it = std::lower_bound(std::begin(clocks_), std::end(clocks_), clock);
+		if (it == std::end(clocks_) || *it != clock) {
+			return std::nullopt;
+		}
+		return static_cast<ClockId>(std::distance(std::begin(clocks_), it));
+	}
+
+private:
+	explicit ClockRegistry(std::vector<std::string> clocks) : clocks_(std::move(clocks))
+	{
+	}
+
+	/** Get the unique registry for the given sorted clocks. */
+	static std::shared_ptr<const ClockRegistry>
+	intern(std::vector<std::string> clocks)
+	{
+		static std::mutex mutex;
+		// The registries are never removed, there are only few distinct sets of clocks.
+		static std::map<std::vector<std::string>, std::shared_ptr<const ClockRegistry>> registries;
+		std::lock_guard lock{mutex};
+		auto           &registry = registries[clocks];
+		if (!registry) {
+			registry = std::shared_ptr<const ClockRegistry>(new ClockRegistry(std::move(clocks)));
+		}
+		return registry;
+	}
+
+	const std::vector<std::string> clocks_;
+};
+
+/** @brief The valuations of a set of clocks.
+ *
+ * The valuations are stored in a vector that is indexed by the clock IDs of a ClockRegistry. The
+ * interface resembles a map from clock names to clocks, which iterates over the clocks ordered by
+ * their names. Copying and comparing valuations with the same registry does not touch any clock
+ * names. Adding or removing a clock switches to the registry of the new set of clocks, which
+ * reallocates the clocks. Unlike with a std::map, this invalidates all references and iterators
+ * into the valuation as well as all clock IDs of the previous registry.
+ */
+class ClockSetValuation
+{
+	template <bool Const>
+	class Iterator
+	{
+	public:
+		using valuation_type    = std::conditional_t<Const, const ClockSetValuation, ClockSetValuation>;
+		using clock_reference   = std::conditional_t<Const, const Clock &, Clock &>;
+		using iterator_category = std::forward_iterator_tag;
+		using value_type        = std::pair<std::string, Clock>;
+		using difference_type   = std::ptrdiff_t;
+		using pointer           = void;
+		using reference         = std::pair<const std::string &, clock_reference>;
+
+		Iterator(valuation_type *valuation, ClockRegistry::ClockId id) : valuation_(valuation), id_(id)
+		{
+		}
+
+		reference
+		operator*() const
+		{
+			return {valuation_->registry_->get_clocks()[id_], valuation_->clocks_[id_]};
+		}
+
+		Iterator &
+		operator++()
+		{
+			++id_;
+			return *this;
+		}
+
+		Iterator
+		operator++(int)
+		{
+			auto res = *this;
+			++id_;
+			return res;
+		}
+
+		friend bool
+		operator==(const Iterator &first, const Iterator &second)
+		{
+			return first.valuation_ == second.valuation_ && first.id_ == second.id_;
+		}
+
+		friend bool
+		operator!=(const Iterator &first, const Iterator &second)
+		{
+			return !(first == second);
+		}
+
+	private:
+		valuation_type        *valuation_;
+		ClockRegistry::ClockId id_;
+	};
+
+public:
+	/** An iterator over pairs of clock names and clocks. */
+	using iterator = Iterator<false>;
+	/** A constant iterator over pairs of clock names and clocks. */
+	using const_iterator = Iterator<true>;
+
+	/** Construct a valuation without any clocks. */
+	ClockSetValuation() = default;
+
+	/** Construct a valuation of all clocks of a registry.
+	 * @param registry The registry of the clocks
+	 * @param valuation The initial valuation of each clock
+	 */
+	explicit ClockSetValuation(std::shared_ptr<const ClockRegistry> registry, Time valuation = 0)
+	: clocks_(registry->size(), Clock{valuation})
+	{
+		set_registry(std::move(registry));
+	}
+
+	/** Construct a valuation from pairs of clock names and clocks.
+	 * @param valuations The valuation of each clock
+	 */
+	ClockSetValuation(std::initializer_list<std::pair<const std::string, Clock>> valuations)
+	{
+		const std::map<std::string, Clock> sorted_valuations{valuations};
+		std::vector<std::string>           clocks;
+		for (const auto &[clock, valuation] : sorted_valuations) {
+			clocks.push_back(clock);
+			clocks_.push_back(valuation);
+		}
+		set_registry(ClockRegistry::get(std::begin(clocks), std::end(clocks)));
+	}
+
+	/** Get the registry of the clocks, which is nullptr if there are no clocks. */
+	[[nodiscard]] const std::shared_ptr<const ClockRegistry> &
+	get_registry() const noexcept
+	{
+		return registry_;
+	}
+
+	/** Get the number of clocks. */
+	[[nodiscard]] std::size_t
+	size() const noexcept
+	{
+		return clocks_.size();
+	}
+
+	/** Check if there are no clocks. */
+	[[nodiscard]] bool
+	empty() const noexcept
+	{
+		return clocks_.empty();
+	}
+
+	/** Check whether the valuation contains the given clock. */
+	[[nodiscard]] std::size_t
+	count(const std::string &clock) const
+	{
+		return find_id(clock).has_value() ? 1 : 0;
+	}
+
+	/** Find the clock with the given name.
+	 * @return An iterator to the clock, or end() if there is no such clock
+	 */
+	iterator
+	find(const std::string &clock)
+	{
+		const auto id = find_id(clock);
+		return {this, id ? *id : clocks_.size()};
+	}
+
+	/** Find the clock with the given name.
+	 * @return An iterator to the clock, or end() if there is no such clock
+	 */
+	[[nodiscard]] const_iterator
+	find(const std::string &clock) const
+	{
+		const auto id = find_id(clock);
+		return {this, id ? *id : clocks_.size()};
+	}
+
+	/** Get the clock with the given ID in the registry. */
+	[[nodiscard]] const Clock &
+	at(ClockRegistry::ClockId id) const
+	{
+		return clocks_.at(id);
+	}
+
+	/** Get the clock with the given ID in the registry. */
+	Clock &
+	at(ClockRegistry::ClockId id)
+	{
+		return clocks_.at(id);
+	}
+
+	/** Get the clock with the given name.
+	 * @throw std::out_of_range if there is no such clock
+	 */
+	[[nodiscard]] const Clock &
+	at(const std::string &clock) const
+	{
+		return clocks_[get_id(clock)];
+	}
+
+	/** Get the clock with the given name.
+	 * @throw std::out_of_range if there is no such clock
+	 */
+	Clock &
+	at(const std::string &clock)
+	{
+		return clocks_[get_id(clock)];
+	}
+
+	/** Get the clock with the given name, add the clock with valuation 0 if it does not exist.
+	 * Adding a clock switches the registry and invalidates all references, iterators, and clock IDs.
+	 */
+	Clock &
+	operator[](const std::string &clock)
+	{
+		if (const auto id = find_id(clock); id) {
+			return clocks_[*id];
+		}
+		auto clocks = registry_ ? registry_->get_clocks() : std::vector<std::string>{};
+		clocks.insert(std::upper_bound(std::begin(clocks), std::end(clocks), clock), clock);
+		switch_registry(ClockRegistry::get(std::begin(clocks), std::end(clocks)));
+		return clocks_[get_id(clock)];
+	}
+
+	/** Remove the clock with the given name.
+	 * Removing a clock switches the registry and invalidates all references, iterators, and clock
+	 * IDs.
+	 * @return The number of removed clocks
+	 */
+	std::size_t
+	erase(const std::string &clock)
+	{
+		if (!find_id(clock)) {
+			return 0;
+		}
+		auto clocks = registry_->get_clocks();
+		clocks.erase(std::lower_bound(std::begin(clocks), std::end(clocks), clock));
+		switch_registry(ClockRegistry::get(std::begin(clocks), std::end(clocks)));
+		return 1;
+	}
+
+	/** Let all clocks tick for the given amount of time. */
+	void
+	tick(const Time &diff) noexcept
+	{
+		for (auto &clock : clocks_) {
+			clock.tick(diff);
+		}
+	}
+
+	/** Get an iterator to the first clock. */
+	iterator
+	begin() noexcept
+	{
+		return {this, 0};
+	}
+
+	/** Get an iterator past the last clock. */
+	iterator
+	end() noexcept
+	{
+		return {this, clocks_.size()};
+	}
+
+	/** Get an iterator to the first clock. */
+	const_iterator
+	begin() const noexcept
+	{
+		return {this, 0};
+	}
+
+	/** Get an iterator past the last clock. */
+	const_iterator
+	end() const noexcept
+	{
+		return {this, clocks_.size()};
+	}
+
+	/** Compare two valuations lexicographically by their clock names and valuations. */
+	friend bool
+	operator<(const ClockSetValuation &first, const ClockSetValuation &second)
+	{
+		if (first.registry_ == second.registry_) {
+			return first.clocks_ < second.clocks_;
+		}
+		return std::lexicographical_compare(std::begin(first),
+		                                    std::end(first),
+		                                    std::begin(second),
+		                                    std::end(second),
+		                                    [](const auto &a, const auto &b) {
+			                                    if (a.first != b.first) {
+				                                    return a.first < b.first;
+			                                    }
+			                                    return a.second.get_valuation()
+			                                           < b.second.get_valuation();
+		                                    });
+	}
+
+	/** Check if two valuations have the same clocks with the same valuations. */
+	friend bool
+	operator==(const ClockSetValuation &first, const ClockSetValuation &second)
+	{
+		return first.registry_ == second.registry_ && first.clocks_ == second.clocks_;
+	}
+
+	/** Check if two valuations differ. */
+	friend bool
+	operator!=(const ClockSetValuation &first, const ClockSetValuation &second)
+	{
+		return !(first == second);
+	}
+
+private:
+	std::optional<ClockRegistry::ClockId>
+	find_id(const std::string &clock) const
+	{
+		return registry_ ? registry_->find(clock) : std::nullopt;
+	}
+
+	ClockRegistry::ClockId
+	get_id(const std::string &clock) const
+	{
+		if (const auto id = find_id(clock); id) {
+			return *id;
+		}
+		throw std::out_of_range("Unknown clock '" + clock + "'");
+	}
+
+	/** Switch to another registry, keep the valuations of all clocks that are in both registries. */
+	void
+	switch_registry(std::shared_ptr<const ClockRegistry> registry)
+	{
+		std::vector<Clock> clocks(registry->size());
+		for (ClockRegistry::ClockId id = 0; id < clocks_.size(); ++id) {
+			if (const auto new_id = registry->find(registry_->get_clocks()[id]); new_id) {
+				clocks[*new_id] = clocks_[id];
+			}
+		}
+		clocks_ = std::move(clocks);
+		set_registry(std::move(registry));
+	}
+
+	/** Set the registry, a valuation without clocks never has a registry. */
+	void
+	set_registry(std::shared_ptr<const ClockRegistry> registry)
+	{
+		registry_ = registry && registry->size() > 0 ? std::move(registry) : nullptr;
+	}
+
+	std::shared_ptr<const ClockRegistry> registry_;
+	std::vector<Clock>                   clocks_;
+};
 
 /** @brief A configuration of a plant, e.g., a TA.
  *
@@ -33,9 +33,8 @@ std::ostream &operator<<(std::ostream &os, const Mode &mode);
 namespace details {
 template <typename ActionT, typename NodeT>
 std::map<int, const NodeT *>
-create_selector_map(
-  const std::map<std::pair<RegionIndex, ActionT>, std::shared_ptr<NodeT>> &children,
-  const std::set<NodeT *>                                                 &parents = {})
+create_selector_map(const typename NodeT::Children &children,
+                    const std::vector<NodeT *>     &parents = {})
 {
 	std::map<int, const NodeT *> selector_map;
 	int                          node_index = 0;
@@ -45,7 +44,7 @@ create_selector_map(
 		node_index += 1;
 	}
 	for (const auto &[action, node] : children) {
-		selector_map[node_index] = node.get();
+		selector_map[node_index] = node;
 		fmt::print("{}: \033[34m({}, {})\033[0m -> \033[37m{}\033[0m\n",
 		           node_index,
 		           action.first,
@@ -92,8 +91,9 @@ search_tree_to_graphviz_interactive(
 
 		std::map<int, const Node *> selector_map;
 		if (mode == Mode::NAVIGATE) {
-			selector_map =
-			  details::create_selector_map<ActionT, Node>(last_node->get_children(), last_node->parents);
+			selector_map = details::create_selector_map<ActionT, Node>(
+			  last_node->get_children(),
+			  {std::begin(last_node->parents), std::end(last_node->parents)});
 		} else {
 			selector_map = details::create_selector_map<ActionT, Node>(last_node->get_children());
 		}
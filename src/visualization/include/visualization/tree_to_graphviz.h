@@ -43,7 +43,7 @@ add_search_node_to_graph(
 	}
 	std::vector<std::string> words_labels;
 	std::string              program_label;
-	for (const auto &word : search_node->words) {
+	for (const auto &word : search_node->get_words()) {
 		std::vector<std::string> word_labels;
 		for (const auto &word_partition : word) {
 			std::vector<std::string> partition_labels;
@@ -78,6 +78,7 @@ add_search_node_to_graph(
 	case LabelReason::DEAD_NODE: label_reason = "dead node"; break;
 	case LabelReason::NO_ATA_SUCCESSOR: label_reason = "no ATA successor"; break;
 	case LabelReason::MONOTONIC_DOMINATION: label_reason = "monotonic domination"; break;
+	case LabelReason::ANTICHAIN_DOMINATION: label_reason = "antichain domination"; break;
 	case LabelReason::NO_BAD_ENV_ACTION: label_reason = "no bad env action"; break;
 	case LabelReason::GOOD_CONTROLLER_ACTION_FIRST:
 		label_reason = "good controller action first";
@@ -98,7 +99,7 @@ add_search_node_to_graph(
 	}
 	if (new_node) {
 		for (const auto &[action, child] : search_node->get_children()) {
-			auto graphviz_child = add_search_node_to_graph(child.get(), graph, node_selector);
+			auto graphviz_child = add_search_node_to_graph(child, graph, node_selector);
 			if (graphviz_child) {
 				graph->add_edge(node,
 				                *graphviz_child,
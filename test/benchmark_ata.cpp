@@ -0,0 +1,93 @@
+/***************************************************************************
+ *  benchmark_ata.cpp - Benchmarking symbol steps of translated ATAs
+ *
+ *  Created:   Sun 18 Oct 10:12:36 CEST 2026
+ *  Copyright  2026  Till Hofmann <hofmann@kbsg.rwth-aachen.de>
+ *  SPDX-License-Identifier: LGPL-3.0-or-later
+ ****************************************************************************/
+
+#include "automata/ata.h"
+#include "automata/ata_compiled_formula.h"
+#include "automata/ata_formula.h"
+#include "mtl/MTLFormula.h"
+#include "mtl_ata_translation/translator.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <memory>
+#include <set>
+#include <string>
+
+using namespace tacos;
+
+using AP = logic::AtomicProposition<std::string>;
+using F  = logic::MTLFormula<std::string>;
+
+static void
+BM_SymbolStep(benchmark::State &state)
+{
+	const auto   num_requests = state.range(0);
+	std::set<AP> requests;
+	std::set<AP> alphabet;
+	F            spec = F::TRUE();
+	for (long i = 0; i < num_requests; ++i) {
+		const AP request{"request" + std::to_string(i)};
+		const AP grant{"grant" + std::to_string(i)};
+		requests.insert(request);
+		alphabet.insert({request, grant});
+		// Each request must be granted within i + 1 time units.
+		spec = spec && globally(!F{request} || finally(F{grant}, logic::TimeInterval(0, i + 1)));
+	}
+	const auto ata = mtl_ata_translation::translate(spec, alphabet);
+	// Read all requests to obtain a configuration that contains a state for each subformula.
+	auto configuration = ata.get_initial_configuration();
+	for (const auto &request : requests) {
+		const auto successors = ata.make_symbol_step(configuration, request);
+		configuration =
+		  ata.make_time_step(*std::max_element(std::begin(successors),
+		                                       std::end(successors),
+		                                       [](const auto &first, const auto &second) {
+			                                       return first.size() < second.size();
+		                                       }),
+		                     0.5);
+	}
+	for (auto _ : state) {
+		for (const auto &symbol : alphabet) {
+			benchmark::DoNotOptimize(ata.make_symbol_step(configuration, symbol));
+		}
+	}
+	state.counters["states"] = configuration.size();
+}
+
+BENCHMARK(BM_SymbolStep)->RangeMultiplier(2)->Range(1, 16);
+
+static void
+BM_MinimalModels(benchmark::State &state, bool compiled)
+{
+	using namespace automata;
+	using namespace automata::ata;
+	// A conjunction of disjunctions (s_i ∧ x < i) ∨ x.t_i, similar to the translation of an until.
+	std::vector<std::unique_ptr<Formula<std::string>>> conjuncts;
+	for (long i = 0; i < state.range(0); ++i) {
+		conjuncts.push_back(create_disjunction<std::string>(
+		  create_conjunction<std::string>(
+		    std::make_unique<LocationFormula<std::string>>("s" + std::to_string(i)),
+		    std::make_unique<ClockConstraintFormula<std::string>>(
+		      AtomicClockConstraintT<std::less<Time>>(i))),
+		  std::make_unique<ResetClockFormula<std::string>>(
+		    std::make_unique<LocationFormula<std::string>>("t" + std::to_string(i)))));
+	}
+	const auto                         formula = create_conjunction(std::move(conjuncts));
+	const CompiledFormula<std::string> compiled_formula{*formula};
+	for (auto _ : state) {
+		if (compiled) {
+			benchmark::DoNotOptimize(compiled_formula.get_minimal_models(0.5));
+		} else {
+			benchmark::DoNotOptimize(formula->get_minimal_models(0.5));
+		}
+	}
+}
+
+BENCHMARK_CAPTURE(BM_MinimalModels, tree, false)->RangeMultiplier(2)->Range(1, 8);
+BENCHMARK_CAPTURE(BM_MinimalModels, compiled, true)->RangeMultiplier(2)->Range(1, 8);
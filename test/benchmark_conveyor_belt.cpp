@@ -34,7 +34,10 @@ using AP         = logic::AtomicProposition<std::string>;
 using TreeSearch = search::TreeSearch<automata::ta::Location<std::string>, std::string>;
 
 static void
-BM_ConveyorBelt(benchmark::State &state, bool weighted = true, bool multi_threaded = true)
+BM_ConveyorBelt(benchmark::State &state,
+                bool              weighted          = true,
+                bool              multi_threaded    = true,
+                bool              force_binary_heap = false)
 {
 	Location l_no{"NO"};
 	Location l_st{"ST"};
@@ -71,7 +74,6 @@ BM_ConveyorBelt(benchmark::State &state, bool weighted = true, bool multi_thread
 	const auto release_f = F{AP{"release"}};
 	const auto stuck_f   = F{AP{"stuck"}};
 	const auto stop_f    = F{AP{"stop"}};
-	const auto resume_f  = F{AP{"resume"}};
 	const auto spec      = finally(release_f && finally(move_f, logic::TimeInterval(0, 2)))
 	                  || finally(stop_f && (!stuck_f).until(stop_f)) || (!stuck_f).until(stop_f);
 	// || finally(globally(!move_f)); // cannot be satisfied as we cannot enforce 'release'
@@ -118,7 +120,10 @@ BM_ConveyorBelt(benchmark::State &state, bool weighted = true, bool multi_thread
 		                  K,
 		                  true,
 		                  true,
-		                  generate_heuristic<TreeSearch::Node>()};
+		                  std::move(heuristic)};
+		if (force_binary_heap) {
+			search.set_frontier_queue_type(utilities::QueueType::BINARY_HEAP);
+		}
 		search.build_tree(multi_threaded);
 		search.label();
 		auto controller = controller_synthesis::create_controller(search.get_root(),
@@ -158,6 +163,12 @@ BENCHMARK_CAPTURE(BM_ConveyorBelt, single_heuristic_single_thread, false, false)
   ->MeasureProcessCPUTime()
   ->Unit(benchmark::kSecond)
   ->UseRealTime();
+// Single-threaded with a binary heap, even if the heuristic allows a bucket queue.
+BENCHMARK_CAPTURE(BM_ConveyorBelt, single_heuristic_single_thread_binary_heap, false, false, true)
+  ->DenseRange(0, 4, 1)
+  ->MeasureProcessCPUTime()
+  ->Unit(benchmark::kSecond)
+  ->UseRealTime();
 // Single-threaded with weighted heuristics.
 BENCHMARK_CAPTURE(BM_ConveyorBelt, weighted_single_thread, true, false)
   ->Args({16, 4, 1})
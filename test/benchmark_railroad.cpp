@@ -34,6 +34,7 @@ enum class Mode {
 	SIMPLE,
 	WEIGHTED,
 	SCALED,
+	THREADS,
 };
 
 using namespace tacos;
@@ -47,14 +48,18 @@ using TreeSearch =
   search::TreeSearch<automata::ta::Location<std::vector<std::string>>, std::string>;
 
 static void
-BM_Railroad(benchmark::State &state, Mode mode, bool multi_threaded = true)
+BM_Railroad(benchmark::State &state,
+            Mode              mode,
+            bool              multi_threaded    = true,
+            bool              force_binary_heap = false)
 {
 	spdlog::set_level(spdlog::level::err);
 	spdlog::set_pattern("%t %v");
 	std::vector<Endpoint> distances;
 	switch (mode) {
 	case Mode::SIMPLE:
-	case Mode::WEIGHTED: distances = {2, 2}; break;
+	case Mode::WEIGHTED:
+	case Mode::THREADS: distances = {2, 2}; break;
 	case Mode::SCALED:
 		for (std::size_t i = 0; i < 3; ++i) {
 			if (state.range(i) > 0) {
@@ -77,16 +82,23 @@ BM_Railroad(benchmark::State &state, Mode mode, bool multi_threaded = true)
 	auto               ata = mtl_ata_translation::translate(spec, actions);
 	const unsigned int K   = std::max(plant.get_largest_constant(), spec.get_largest_constant());
 
-	std::size_t tree_size        = 0;
-	std::size_t pruned_tree_size = 0;
-	std::size_t controller_size  = 0;
-	std::size_t plant_size       = 0;
+	std::size_t tree_size          = 0;
+	std::size_t pruned_tree_size   = 0;
+	std::size_t controller_size    = 0;
+	std::size_t plant_size         = 0;
+	std::size_t rank_error_samples = 0;
+	std::size_t total_rank_error   = 0;
+	std::size_t obsolete_jobs      = 0;
+	std::size_t max_frontier_size  = 0;
+
+	search::DominationStatistics domination_statistics;
 
 	std::unique_ptr<search::Heuristic<long, TreeSearch::Node>> heuristic;
 
 	for (auto _ : state) {
 		switch (mode) {
 		case Mode::SCALED:
+		case Mode::THREADS:
 			heuristic = generate_heuristic<TreeSearch::Node>(16, 4, environment_actions, 1);
 			break;
 		case Mode::WEIGHTED:
@@ -117,9 +129,26 @@ BM_Railroad(benchmark::State &state, Mode mode, bool multi_threaded = true)
 		}
 		TreeSearch search{
 		  &plant, &ata, controller_actions, environment_actions, K, true, true, std::move(heuristic)};
+		if (force_binary_heap) {
+			search.set_frontier_queue_type(utilities::QueueType::BINARY_HEAP);
+		}
 
-		search.build_tree(multi_threaded);
+		if (mode == Mode::THREADS) {
+			search.build_tree(multi_threaded,
+			                  static_cast<std::size_t>(state.range(0)),
+			                  static_cast<utilities::SchedulingMode>(state.range(1)));
+		} else {
+			search.build_tree(multi_threaded);
+		}
 		search.label();
+		const auto rank_errors = search.get_rank_error_statistics();
+		rank_error_samples += rank_errors.num_samples;
+		total_rank_error += rank_errors.total_rank_error;
+		const auto frontier_statistics = search.get_frontier_statistics();
+		obsolete_jobs +=
+		  frontier_statistics.num_discarded_jobs + frontier_statistics.num_compacted_jobs;
+		max_frontier_size += frontier_statistics.max_queued_jobs;
+		domination_statistics += search.get_domination_statistics();
 		plant_size += plant.get_locations().size();
 		tree_size += search.get_size();
 		std::for_each(std::begin(search.get_nodes()),
@@ -142,6 +171,26 @@ BM_Railroad(benchmark::State &state, Mode mode, bool multi_threaded = true)
 	  benchmark::Counter(static_cast<double>(controller_size), benchmark::Counter::kAvgIterations);
 	state.counters["plant_size"] =
 	  benchmark::Counter(static_cast<double>(plant_size), benchmark::Counter::kAvgIterations);
+	state.counters["obsolete_jobs"] =
+	  benchmark::Counter(static_cast<double>(obsolete_jobs), benchmark::Counter::kAvgIterations);
+	state.counters["max_frontier_size"] =
+	  benchmark::Counter(static_cast<double>(max_frontier_size), benchmark::Counter::kAvgIterations);
+	state.counters["domination_ancestors"] =
+	  benchmark::Counter(static_cast<double>(domination_statistics.num_ancestors),
+	                     benchmark::Counter::kAvgIterations);
+	state.counters["domination_signature_rejections"] =
+	  benchmark::Counter(static_cast<double>(domination_statistics.num_signature_rejections),
+	                     benchmark::Counter::kAvgIterations);
+	state.counters["domination_exact_checks"] =
+	  benchmark::Counter(static_cast<double>(domination_statistics.num_exact_checks),
+	                     benchmark::Counter::kAvgIterations);
+	state.counters["dominations"] =
+	  benchmark::Counter(static_cast<double>(domination_statistics.num_dominations),
+	                     benchmark::Counter::kAvgIterations);
+	if (rank_error_samples > 0) {
+		state.counters["mean_rank_error"] =
+		  static_cast<double>(total_rank_error) / static_cast<double>(rank_error_samples);
+	}
 }
 
 // Range all over all heuristics individually.
@@ -156,6 +205,13 @@ BENCHMARK_CAPTURE(BM_Railroad, single_heuristic_single_thread, Mode::SIMPLE, fal
   ->MeasureProcessCPUTime()
   ->Unit(benchmark::kSecond)
   ->UseRealTime();
+// Single-threaded with a binary heap, even if the heuristic allows a bucket queue.
+BENCHMARK_CAPTURE(
+  BM_Railroad, single_heuristic_single_thread_binary_heap, Mode::SIMPLE, false, true)
+  ->DenseRange(0, 4, 1)
+  ->MeasureProcessCPUTime()
+  ->Unit(benchmark::kSecond)
+  ->UseRealTime();
 // Single-threaded with weighted heuristics.
 BENCHMARK_CAPTURE(BM_Railroad, weighted_single_thread, Mode::WEIGHTED, false)
   ->Args({16, 4, 1})
@@ -170,6 +226,12 @@ BENCHMARK_CAPTURE(BM_Railroad, weighted, Mode::WEIGHTED)
   ->MeasureProcessCPUTime()
   ->Unit(benchmark::kSecond)
   ->UseRealTime();
+// Scale the number of worker threads with each scheduling mode of the thread pool.
+BENCHMARK_CAPTURE(BM_Railroad, threads, Mode::THREADS)
+  ->ArgsProduct({benchmark::CreateRange(1, 64, 2), benchmark::CreateDenseRange(0, 3, 1)})
+  ->MeasureProcessCPUTime()
+  ->Unit(benchmark::kSecond)
+  ->UseRealTime();
 // Different distances
 BENCHMARK_CAPTURE(BM_Railroad, scaled, Mode::SCALED)
   ->ArgsProduct({benchmark::CreateRange(1, 8, 2), benchmark::CreateRange(1, 8, 2), {0}})
@@ -0,0 +1,80 @@
+/***************************************************************************
+ *  test_antichain_store.cpp - Test the antichain store of labeled nodes
+ *
+ *  Created:   Sat 17 Oct 16:48:03 CEST 2026
+ *  Copyright  2026  Till Hofmann <hofmann@kbsg.rwth-aachen.de>
+ *  SPDX-License-Identifier: LGPL-3.0-or-later
+ ****************************************************************************/
+
+#include "automata/ta.h"
+#include "mtl/MTLFormula.h"
+#include "search/antichain_store.h"
+#include "search/canonical_word.h"
+#include "search/search_tree.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <memory>
+#include <set>
+#include <string>
+
+namespace {
+
+using namespace tacos;
+
+using ATARegionState  = search::ATARegionState<std::string>;
+using CanonicalABWord = search::CanonicalABWord<automata::ta::Location<std::string>, std::string>;
+using Location        = automata::ta::Location<std::string>;
+using TARegionState   = search::PlantRegionState<Location>;
+using Node            = search::SearchTreeNode<Location, std::string, std::string>;
+using search::NodeLabel;
+
+TEST_CASE("Label nodes with an antichain store", "[search][antichain]")
+{
+	const logic::MTLFormula a{logic::AtomicProposition<std::string>{"a"}};
+	const logic::MTLFormula b{logic::AtomicProposition<std::string>{"b"}};
+	// n_small is dominated by n_medium, which is dominated by n_large.
+	Node n_small{std::set{CanonicalABWord{{TARegionState{Location{"l0"}, "x", 0}}}}};
+	Node n_medium{
+	  std::set{CanonicalABWord{{TARegionState{Location{"l0"}, "x", 0}, ATARegionState{a, 0}}}}};
+	Node n_large{std::set{CanonicalABWord{
+	  {TARegionState{Location{"l0"}, "x", 0}, ATARegionState{a, 0}, ATARegionState{b, 0}}}}};
+	Node n_other{
+	  std::set{CanonicalABWord{{TARegionState{Location{"l0"}, "x", 0}}, {ATARegionState{b, 1}}}}};
+
+	search::AntichainStore<Node> store;
+	// All nodes share the same reg_a, so they use the same key.
+	const search::WordId key = 0;
+	CHECK(store.find_label(key, n_medium) == NodeLabel::UNLABELED);
+
+	SECTION("A node dominated by a TOP node is TOP")
+	{
+		store.insert(key, &n_medium, NodeLabel::TOP);
+		CHECK(store.find_label(key, n_small) == NodeLabel::TOP);
+		CHECK(store.find_label(key, n_medium) == NodeLabel::TOP);
+		CHECK(store.find_label(key, n_large) == NodeLabel::UNLABELED);
+		CHECK(store.find_label(key, n_other) == NodeLabel::UNLABELED);
+		// Other keys are not affected.
+		CHECK(store.find_label(key + 1, n_small) == NodeLabel::UNLABELED);
+		// Only the maximal TOP nodes are kept.
+		store.insert(key, &n_small, NodeLabel::TOP);
+		CHECK(store.get_statistics().num_stored_nodes == 1);
+		store.insert(key, &n_large, NodeLabel::TOP);
+		CHECK(store.get_statistics().num_stored_nodes == 1);
+		CHECK(store.get_statistics().num_top_prunings == 2);
+	}
+	SECTION("A node dominating a BOTTOM node is BOTTOM")
+	{
+		store.insert(key, &n_medium, NodeLabel::BOTTOM);
+		CHECK(store.find_label(key, n_large) == NodeLabel::BOTTOM);
+		CHECK(store.find_label(key, n_small) == NodeLabel::UNLABELED);
+		// Only the minimal BOTTOM nodes are kept.
+		store.insert(key, &n_large, NodeLabel::BOTTOM);
+		CHECK(store.get_statistics().num_stored_nodes == 1);
+		store.insert(key, &n_small, NodeLabel::BOTTOM);
+		CHECK(store.get_statistics().num_stored_nodes == 1);
+		CHECK(store.find_label(key, n_other) == NodeLabel::BOTTOM);
+		CHECK(store.get_statistics().num_bottom_prunings == 2);
+	}
+}
+
+} // namespace
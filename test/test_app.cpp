@@ -52,6 +52,21 @@ TEST_CASE("Launch the main application", "[app]")
 		tacos::app::Launcher launcher{argv.size(), argv.data()};
 		CHECK_NOTHROW(launcher.run());
 	}
+	SECTION("Antichain pruning")
+	{
+		const std::array argv{
+		  "app",
+		  "--antichain-pruning",
+		  "--plant",
+		  plant_path.c_str(),
+		  "--spec",
+		  spec_path.c_str(),
+		  "-c",
+		  "c",
+		};
+		tacos::app::Launcher launcher{argv.size(), argv.data()};
+		CHECK_NOTHROW(launcher.run());
+	}
 	SECTION("Select heuristics")
 	{
 		for (const auto &heuristic : {"bfs", "dfs", "composite", "random", "time"}) {
@@ -0,0 +1,81 @@
+/***************************************************************************
+ *  test_append_only_list.cpp - Test the append-only list
+ *
+ *  Created:   Sat 17 Oct 22:31:52 CEST 2026
+ *  Copyright  2026  Till Hofmann <hofmann@kbsg.rwth-aachen.de>
+ *  SPDX-License-Identifier: LGPL-3.0-or-later
+ ****************************************************************************/
+
+#include "utilities/append_only_list.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using namespace tacos;
+
+using utilities::AppendOnlyList;
+
+TEST_CASE("Append to a list", "[append_only_list]")
+{
+	AppendOnlyList<int> list;
+	CHECK(list.empty());
+	CHECK(list.begin() == list.end());
+	std::vector<const int *> addresses;
+	for (int i = 0; i < 100; ++i) {
+		list.push_back(i);
+		addresses.push_back(&*std::next(std::begin(list), i));
+	}
+	CHECK(list.size() == 100);
+	CHECK(std::distance(std::begin(list), std::end(list)) == 100);
+	std::vector<int> expected(100);
+	std::iota(std::begin(expected), std::end(expected), 0);
+	CHECK(std::vector<int>(std::begin(list), std::end(list)) == expected);
+	// Appending never moves an element.
+	for (int i = 0; i < 100; ++i) {
+		CHECK(addresses[i] == &*std::next(std::begin(list), i));
+	}
+}
+
+TEST_CASE("An iterator only sees the elements that existed when it was created",
+          "[append_only_list]")
+{
+	AppendOnlyList<int> list;
+	list.push_back(0);
+	list.push_back(1);
+	const auto begin = std::begin(list);
+	list.push_back(2);
+	CHECK(std::vector<int>(begin, std::end(list)) == std::vector<int>{0, 1});
+	CHECK(std::vector<int>(std::begin(list), std::end(list)) == std::vector<int>{0, 1, 2});
+}
+
+TEST_CASE("Read a list while it is appended to", "[append_only_list]")
+{
+	constexpr int       num_elements = 100000;
+	AppendOnlyList<int> list;
+	std::atomic_bool    done{false};
+	std::thread         writer([&list, &done] {
+		for (int i = 0; i < num_elements; ++i) {
+			list.push_back(i);
+		}
+		done = true;
+	});
+	bool is_consistent = true;
+	while (!done) {
+		int expected = 0;
+		for (const int element : list) {
+			is_consistent = is_consistent && element == expected++;
+		}
+	}
+	writer.join();
+	CHECK(is_consistent);
+	CHECK(list.size() == num_elements);
+}
+
+} // namespace
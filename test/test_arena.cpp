@@ -0,0 +1,87 @@
+/***************************************************************************
+ *  test_arena.cpp - Test the object arena
+ *
+ *  Created:   Sat 17 Oct 10:21:45 CEST 2026
+ *  Copyright  2026  Till Hofmann <hofmann@kbsg.rwth-aachen.de>
+ *  SPDX-License-Identifier: LGPL-3.0-or-later
+ ****************************************************************************/
+
+#include "utilities/arena.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using namespace tacos;
+
+using utilities::ObjectArena;
+
+/** Count the number of live objects. */
+struct Counted
+{
+	explicit Counted(std::size_t *num_objects, std::string name)
+	: num_objects(num_objects), name(std::move(name))
+	{
+		++*num_objects;
+	}
+	~Counted()
+	{
+		--*num_objects;
+	}
+	std::size_t *num_objects;
+	std::string  name;
+};
+
+TEST_CASE("Create objects in an arena", "[arena]")
+{
+	std::size_t num_objects = 0;
+	{
+		ObjectArena<Counted, 2> arena{3};
+		CHECK(arena.size() == 0);
+		std::vector<Counted *> objects;
+		for (std::size_t i = 0; i < 10; ++i) {
+			objects.push_back(arena.create(&num_objects, std::to_string(i)));
+		}
+		CHECK(arena.size() == 10);
+		CHECK(num_objects == 10);
+		// Allocating new chunks does not move existing objects.
+		for (std::size_t i = 0; i < 10; ++i) {
+			CHECK(objects[i]->name == std::to_string(i));
+		}
+	}
+	// All objects are destroyed with the arena.
+	CHECK(num_objects == 0);
+}
+
+TEST_CASE("Create objects in an arena concurrently", "[threading][arena]")
+{
+	ObjectArena<std::size_t, 4> arena{16};
+	std::vector<std::vector<std::size_t *>> objects(8);
+	std::vector<std::thread>                threads;
+	for (std::size_t t = 0; t < objects.size(); ++t) {
+		threads.emplace_back([&arena, &objects, t] {
+			for (std::size_t i = 0; i < 1000; ++i) {
+				objects[t].push_back(arena.create(t * 1000 + i));
+			}
+		});
+	}
+	for (auto &thread : threads) {
+		thread.join();
+	}
+	CHECK(arena.size() == 8000);
+	std::set<std::size_t *> addresses;
+	for (std::size_t t = 0; t < objects.size(); ++t) {
+		for (std::size_t i = 0; i < 1000; ++i) {
+			CHECK(*objects[t][i] == t * 1000 + i);
+			addresses.insert(objects[t][i]);
+		}
+	}
+	CHECK(addresses.size() == 8000);
+}
+
+} // namespace
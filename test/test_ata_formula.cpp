@@ -8,7 +8,9 @@
 
 
 
+#include "automata/ata_compiled_formula.h"
 #include "automata/ata_formula.h"
+#include "automata/ata_model_cache.h"
 #include "automata/automata.h"
 
 #include <catch2/catch_test_macros.hpp>
@@ -276,4 +278,96 @@ TEST_CASE("Create simplified formulas", "[ta]")
 	CHECK(*create_disjunction<std::string>(std::make_unique<L>("l"), std::make_unique<F>()) == l);
 }
 
+TEST_CASE("Cache minimal models of ATA formulas", "[ta]")
+{
+	using L = LocationFormula<std::string>;
+	// (s0 ∧ x < 2) ∨ x.s1
+	const auto formula = create_disjunction<std::string>(
+	  create_conjunction<std::string>(std::make_unique<L>("s0"),
+	                                  std::make_unique<ClockConstraintFormula<std::string>>(
+	                                    AtomicClockConstraintT<std::less<Time>>(2))),
+	  std::make_unique<ResetClockFormula<std::string>>(std::make_unique<L>("s1")));
+	MinimalModelCache<std::string> cache;
+	cache.add_formula(formula.get());
+	for (const ClockValuation v : {0.0, 0.5, 0.7, 1.0, 1.0, 1.5, 2.0, 2.5, 3.5}) {
+		CHECK(*cache.get_minimal_models(formula.get(), v) == formula->get_minimal_models(v));
+	}
+	CHECK(*cache.get_minimal_models(formula.get(), 0.5)
+	      == std::set<std::set<State>>{{State{"s0", 0.5}}, {State{"s1", 0}}});
+	CHECK(*cache.get_minimal_models(formula.get(), 2.5) == std::set<std::set<State>>{{{"s1", 0}}});
+	const auto statistics = cache.get_statistics();
+	// The regions are {0}, (0, 1), {1}, (1, 2), {2}, and (2, ∞).
+	CHECK(statistics.num_misses == 6);
+	CHECK(statistics.num_hits == 5);
+	// A cached result that was computed for the same clock valuation is not copied.
+	CHECK(cache.get_minimal_models(formula.get(), 0.5)
+	      == cache.get_minimal_models(formula.get(), 0.5));
+
+	// Formulas that have not been added are evaluated directly.
+	L l{"s0"};
+	CHECK(*cache.get_minimal_models(&l, 1) == std::set<std::set<State>>{{{"s0", 1}}});
+	CHECK(cache.get_statistics().num_misses == 6);
+}
+
+TEST_CASE("Compiled ATA formulas", "[ta]")
+{
+	using T      = TrueFormula<std::string>;
+	using F      = FalseFormula<std::string>;
+	using L      = LocationFormula<std::string>;
+	using ClockC = ClockConstraintFormula<std::string>;
+	using R      = ResetClockFormula<std::string>;
+	const auto conjunction = [](std::unique_ptr<Formula<std::string>> conjunct1,
+	                            std::unique_ptr<Formula<std::string>> conjunct2) {
+		return std::make_unique<ConjunctionFormula<std::string>>(std::move(conjunct1),
+		                                                         std::move(conjunct2));
+	};
+	const auto disjunction = [](std::unique_ptr<Formula<std::string>> disjunct1,
+	                            std::unique_ptr<Formula<std::string>> disjunct2) {
+		return std::make_unique<DisjunctionFormula<std::string>>(std::move(disjunct1),
+		                                                         std::move(disjunct2));
+	};
+	std::vector<std::unique_ptr<Formula<std::string>>> formulas;
+	formulas.push_back(std::make_unique<T>());
+	formulas.push_back(std::make_unique<F>());
+	formulas.push_back(std::make_unique<L>("s0"));
+	// (s0 ∧ x < 2) ∨ x.s1
+	formulas.push_back(disjunction(
+	  conjunction(std::make_unique<L>("s0"),
+	              std::make_unique<ClockC>(AtomicClockConstraintT<std::less<Time>>(2))),
+	  std::make_unique<R>(std::make_unique<L>("s1"))));
+	// s0 ∧ x.s0, which only has a single state if the clock is 0
+	formulas.push_back(
+	  conjunction(std::make_unique<L>("s0"), std::make_unique<R>(std::make_unique<L>("s0"))));
+	// ((s0 ∨ s1) ∧ (s0 ∨ s2)) ∨ (s1 ∧ s2), the conjunction has models that are not minimal
+	formulas.push_back(
+	  disjunction(conjunction(disjunction(std::make_unique<L>("s0"), std::make_unique<L>("s1")),
+	                          disjunction(std::make_unique<L>("s0"), std::make_unique<L>("s2"))),
+	              conjunction(std::make_unique<L>("s2"), std::make_unique<L>("s1"))));
+	// x.(s1 ∧ x > 0) ∨ (s2 ∧ x ≥ 1)
+	formulas.push_back(disjunction(
+	  std::make_unique<R>(
+	    conjunction(std::make_unique<L>("s1"),
+	                std::make_unique<ClockC>(AtomicClockConstraintT<std::greater<Time>>(0)))),
+	  conjunction(std::make_unique<L>("s2"),
+	              std::make_unique<ClockC>(AtomicClockConstraintT<std::greater_equal<Time>>(1)))));
+
+	const std::vector<std::set<State>> configurations{
+	  {}, {{"s0", 0}}, {{"s0", 1}}, {{"s1", 0}, {"s2", 1}}, {{"s0", 0}, {"s0", 1.5}, {"s2", 1.5}}};
+	EvaluationBuffer buffer;
+	for (const auto &formula : formulas) {
+		const CompiledFormula<std::string> compiled{*formula};
+		CHECK(compiled.get_largest_clock_constant() == formula->get_largest_clock_constant());
+		for (const ClockValuation v : {0.0, 0.5, 1.0, 1.5, 2.0, 3.0}) {
+			INFO("Formula: " << *formula << ", v = " << v);
+			CHECK(compiled.get_minimal_models(v) == formula->get_minimal_models(v));
+			CHECK(compiled.get_minimal_models(v, buffer) == formula->get_minimal_models(v));
+			for (const auto &configuration : configurations) {
+				CHECK(compiled.is_satisfied(configuration, v) == formula->is_satisfied(configuration, v));
+			}
+		}
+	}
+	// The reset is folded into the location instruction.
+	CHECK(CompiledFormula<std::string>{*formulas[3]}.size() == 5);
+}
+
 } // namespace
@@ -0,0 +1,97 @@
+/***************************************************************************
+ *  test_bucket_queue.cpp - Test the bucket queue for integer priorities
+ *
+ *  Created:   Sat 17 Oct 11:58:40 CEST 2026
+ *  Copyright  2026  Till Hofmann <hofmann@kbsg.rwth-aachen.de>
+ *  SPDX-License-Identifier: LGPL-3.0-or-later
+ ****************************************************************************/
+
+#include "utilities/bucket_queue.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <queue>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+using namespace tacos;
+
+using utilities::BucketQueue;
+
+TEST_CASE("Push and pop from a bucket queue", "[bucket_queue]")
+{
+	BucketQueue<long, std::string> queue;
+	CHECK(queue.empty());
+	queue.push({3, "c"});
+	queue.push({-2, "minus b"});
+	queue.push({5, "e"});
+	queue.push({3, "c2"});
+	queue.push({0, "zero"});
+	CHECK(queue.size() == 5);
+	std::vector<std::string> elements;
+	for (; !queue.empty(); queue.pop()) {
+		elements.push_back(queue.top().second);
+	}
+	// Elements with the same priority are popped in LIFO order.
+	CHECK(elements == std::vector<std::string>{"e", "c2", "c", "zero", "minus b"});
+
+	SECTION("The queue can be reused after it was empty")
+	{
+		queue.push({100, "x"});
+		queue.push({99, "y"});
+		CHECK(queue.top().second == "x");
+		queue.pop();
+		CHECK(queue.top().second == "y");
+		queue.push({101, "z"});
+		CHECK(queue.top().second == "z");
+	}
+}
+
+TEST_CASE("A bucket queue pops priorities in the same order as a heap", "[bucket_queue]")
+{
+	BucketQueue<int, int>                   buckets;
+	std::priority_queue<std::pair<int, int>> heap;
+	std::mt19937                             rng{42};
+	std::uniform_int_distribution<int>       priority{-50, 50};
+	for (int i = 0; i < 1000; ++i) {
+		// Interleave pushes and pops.
+		if (i % 3 == 2) {
+			REQUIRE(buckets.top().first == heap.top().first);
+			buckets.pop();
+			heap.pop();
+		} else {
+			const int p = priority(rng);
+			buckets.push({p, i});
+			heap.push({p, i});
+		}
+		CHECK(buckets.size() == heap.size());
+	}
+	while (!heap.empty()) {
+		REQUIRE(buckets.top().first == heap.top().first);
+		buckets.pop();
+		heap.pop();
+	}
+	CHECK(buckets.empty());
+}
+
+TEST_CASE("Remove elements from a bucket queue", "[bucket_queue]")
+{
+	BucketQueue<int, int> queue;
+	for (int i = 0; i < 10; ++i) {
+		queue.push({i, i});
+	}
+	CHECK(queue.remove_if([](const auto &element) { return element.second % 2 == 0; }) == 5);
+	CHECK(queue.size() == 5);
+	std::vector<int> elements;
+	for (; !queue.empty(); queue.pop()) {
+		elements.push_back(queue.top().second);
+	}
+	CHECK(elements == std::vector{9, 7, 5, 3, 1});
+	queue.push({3, 3});
+	CHECK(queue.remove_if([](const auto &) { return true; }) == 1);
+	CHECK(queue.empty());
+}
+
+} // namespace
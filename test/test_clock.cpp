@@ -10,6 +10,10 @@
 #include "automata/automata.h"
 
 #include <catch2/catch_test_macros.hpp>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
 
 namespace {
 
@@ -37,4 +41,49 @@ TEST_CASE("Clock implicit conversion to time", "[automata]")
 	CHECK(Clock{0.1} == Time{0.1});
 }
 
+TEST_CASE("Clock registries", "[automata]")
+{
+	const auto registry = ClockRegistry::get(std::set<std::string>{"y", "x"});
+	CHECK(registry->get_clocks() == std::vector<std::string>{"x", "y"});
+	CHECK(registry->find("x") == 0);
+	CHECK(registry->find("y") == 1);
+	CHECK(!registry->find("z"));
+	// Registries are interned.
+	const std::vector<std::string> clocks{"x", "y"};
+	CHECK(ClockRegistry::get(std::begin(clocks), std::end(clocks)) == registry);
+	CHECK(ClockRegistry::get(std::set<std::string>{"x"}) != registry);
+}
+
+TEST_CASE("Clock set valuations", "[automata]")
+{
+	ClockSetValuation v{ClockRegistry::get(std::set<std::string>{"x", "y"})};
+	CHECK(v.size() == 2);
+	CHECK(v.at("x") == 0);
+	CHECK_THROWS_AS(v.at("z"), std::out_of_range);
+	v.tick(1.5);
+	v.at("y").reset();
+	CHECK(v == ClockSetValuation{{"x", 1.5}, {"y", 0}});
+	CHECK(ClockSetValuation{{"x", 1}, {"y", 0}} < v);
+	// Adding and removing clocks switches the registry and keeps the other valuations.
+	v["a"] = 2;
+	CHECK(v.get_registry()->get_clocks() == std::vector<std::string>{"a", "x", "y"});
+	CHECK(v.at(0) == 2);
+	CHECK(v.at("x") == 1.5);
+	CHECK(v.erase("a") == 1);
+	CHECK(v.erase("a") == 0);
+	CHECK(v == ClockSetValuation{{"x", 1.5}, {"y", 0}});
+	// Valuations with different clocks are compared by their clock names.
+	CHECK(ClockSetValuation{{"a", 5}} < v);
+	CHECK(!(v < ClockSetValuation{{"a", 5}}));
+	std::vector<std::string> names;
+	for (const auto &[name, clock] : v) {
+		names.push_back(name);
+	}
+	CHECK(names == std::vector<std::string>{"x", "y"});
+	CHECK(v.erase("x") == 1);
+	CHECK(v.erase("y") == 1);
+	CHECK(v.empty());
+	CHECK(v == ClockSetValuation{});
+}
+
 } // namespace
@@ -0,0 +1,122 @@
+/***************************************************************************
+ *  test_clock_cache.cpp - Test the bounded cache with clock eviction
+ *
+ *  Created:   Sat 17 Oct 21:24:37 CEST 2026
+ *  Copyright  2026  Till Hofmann <hofmann@kbsg.rwth-aachen.de>
+ *  SPDX-License-Identifier: LGPL-3.0-or-later
+ ****************************************************************************/
+
+#include "utilities/clock_cache.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using namespace tacos;
+
+using utilities::ClockCache;
+
+TEST_CASE("Look up values in a clock cache", "[threading][cache]")
+{
+	ClockCache<int, std::string, std::hash<int>, 1> cache{2};
+	int                                             num_computations = 0;
+	const auto compute = [&num_computations](const std::string &value) {
+		return [&num_computations, value] {
+			++num_computations;
+			return value;
+		};
+	};
+	CHECK(*cache.get_or_compute(1, compute("one")) == "one");
+	CHECK(*cache.get_or_compute(1, compute("uno")) == "one");
+	CHECK(num_computations == 1);
+	CHECK(*cache.get_or_compute(2, compute("two")) == "two");
+	CHECK(cache.get_statistics().size == 2);
+	// The cache is full. 1 has been referenced since it was inserted, so it gets a second chance and
+	// 2 is evicted instead.
+	CHECK(*cache.get_or_compute(3, compute("three")) == "three");
+	CHECK(num_computations == 3);
+	CHECK(*cache.get_or_compute(1, compute("uno")) == "one");
+	CHECK(*cache.get_or_compute(3, compute("drei")) == "three");
+	CHECK(num_computations == 3);
+	const auto statistics = cache.get_statistics();
+	CHECK(statistics.num_hits == 3);
+	CHECK(statistics.num_misses == 3);
+	CHECK(statistics.num_evictions == 1);
+	CHECK(statistics.size == 2);
+	CHECK(statistics.cost == 2);
+	CHECK(statistics.get_hit_rate() == 0.5);
+}
+
+TEST_CASE("Bound the cost of a clock cache", "[threading][cache]")
+{
+	ClockCache<int, std::string, std::hash<int>, 1> cache{
+	  10, [](const std::string &value) { return value.size(); }};
+	cache.get_or_compute(1, [] { return std::string{"abcd"}; });
+	cache.get_or_compute(2, [] { return std::string{"efgh"}; });
+	CHECK(cache.get_statistics().cost == 8);
+	// Too expensive to be cached at all.
+	CHECK(*cache.get_or_compute(3, [] { return std::string(11, 'x'); }) == std::string(11, 'x'));
+	CHECK(cache.get_statistics().size == 2);
+	// Needs to evict one of the other values.
+	cache.get_or_compute(4, [] { return std::string{"ijk"}; });
+	CHECK(cache.get_statistics().size == 2);
+	CHECK(cache.get_statistics().cost == 7);
+	// Reducing the budget evicts values on the next insertion.
+	cache.set_budget(4);
+	cache.get_or_compute(5, [] { return std::string{"l"}; });
+	CHECK(cache.get_statistics().cost <= 4);
+}
+
+TEST_CASE("Cache multiple values with the same key", "[threading][cache]")
+{
+	// The key is only the length of the value, so values of the same length collide.
+	ClockCache<std::size_t, std::string, std::hash<std::size_t>, 1> cache{3};
+	const auto get = [&cache](const std::string &value) {
+		return *cache.get_or_compute(value.size(),
+		                             [&value](const std::string &cached) { return cached == value; },
+		                             [&value] { return value; });
+	};
+	CHECK(get("ab") == "ab");
+	CHECK(get("cd") == "cd");
+	CHECK(get("efg") == "efg");
+	CHECK(cache.get_statistics().size == 3);
+	CHECK(get("ab") == "ab");
+	CHECK(get("cd") == "cd");
+	CHECK(cache.get_statistics().num_hits == 2);
+	// Evicting one of the colliding values keeps the other one.
+	CHECK(get("hi") == "hi");
+	CHECK(cache.get_statistics().num_evictions == 1);
+	CHECK(get("hi") == "hi");
+	CHECK(cache.get_statistics().num_hits == 3);
+	CHECK(cache.get_statistics().size == 3);
+}
+
+TEST_CASE("Access a clock cache concurrently", "[threading][cache]")
+{
+	constexpr int            num_threads = 4;
+	ClockCache<int, int>     cache{64};
+	std::vector<std::thread> threads;
+	std::vector<int>         num_wrong_values(num_threads, 0);
+	for (int t = 0; t < num_threads; ++t) {
+		threads.emplace_back([&cache, &num_wrong_values, t] {
+			for (int i = 0; i < 1000; ++i) {
+				const int key = i % 128;
+				if (*cache.get_or_compute(key, [key] { return 2 * key; }) != 2 * key) {
+					++num_wrong_values[t];
+				}
+			}
+		});
+	}
+	for (auto &thread : threads) {
+		thread.join();
+	}
+	CHECK(num_wrong_values == std::vector<int>(num_threads, 0));
+	const auto statistics = cache.get_statistics();
+	CHECK(statistics.num_hits + statistics.num_misses == 4000);
+	CHECK(statistics.size <= 64);
+}
+
+} // namespace
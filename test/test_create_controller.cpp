@@ -106,7 +106,6 @@ TEST_CASE("Controller time bounds", "[.railroad][controller]")
                     {{"c", automata::AtomicClockConstraintT<std::equal_to<Time>>{4}}},
                     {"c"}}}};
 	const auto finish_close = F{AP{"finish_close"}};
-	const auto start_open   = F{AP{"start_open"}};
 	const auto enter        = F{AP{"enter"}};
 
 	auto ata = mtl_ata_translation::translate(
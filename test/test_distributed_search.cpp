@@ -0,0 +1,163 @@
+/***************************************************************************
+ *  test_distributed_search.cpp - Tests for the multi-process search
+ *
+ *  Created:   Sun 18 Oct 13:12:08 CEST 2026
+ *  Copyright  2026  Till Hofmann <hofmann@kbsg.rwth-aachen.de>
+ *  SPDX-License-Identifier: LGPL-3.0-or-later
+ ****************************************************************************/
+
+
+#include "automata/ta.h"
+#include "mtl/MTLFormula.h"
+#include "mtl_ata_translation/translator.h"
+#include "railroad.h"
+#include "search/distributed_search.h"
+#include "search/search.h"
+#include "search/search_tree.h"
+#include "search/ta_adapter.h"
+#include "search/word_codec.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <set>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+using namespace tacos;
+
+using AP                = logic::AtomicProposition<std::string>;
+using F                 = logic::MTLFormula<std::string>;
+using Location          = automata::ta::Location<std::vector<std::string>>;
+using TreeSearch        = search::TreeSearch<Location, std::string>;
+using DistributedSearch = search::DistributedSearch<Location, std::string>;
+using Words             = std::set<TreeSearch::Node::Word>;
+using search::NodeLabel;
+
+TEST_CASE("Encode and decode words", "[search][distributed]")
+{
+	const auto &[plant, spec, controller_actions, environment_actions] = create_crossing_problem({2});
+	std::set<AP> actions;
+	std::set_union(begin(controller_actions),
+	               end(controller_actions),
+	               begin(environment_actions),
+	               end(environment_actions),
+	               inserter(actions, end(actions)));
+	auto               ata = mtl_ata_translation::translate(spec, actions);
+	const unsigned int K   = std::max(plant.get_largest_constant(), spec.get_largest_constant());
+	TreeSearch         search{&plant, &ata, controller_actions, environment_actions, K, true};
+	for (int i = 0; i < 20 && search.step(); ++i) {}
+	REQUIRE(search.get_size() > 1);
+	for (const auto &[key, node] : search.get_nodes()) {
+		const Words         words = node->get_words();
+		search::WordEncoder encoder;
+		encoder.write(words);
+		search::WordDecoder decoder{encoder.get_buffer()};
+		CHECK(decoder.read<Words>() == words);
+		CHECK(decoder.at_end());
+		search::WordEncoder other_encoder;
+		other_encoder.write(Words{words});
+		CHECK(other_encoder.get_buffer() == encoder.get_buffer());
+	}
+
+	SECTION("Formulas are constructed again")
+	{
+		const F formula = (F{AP{"a"}}.until(!F{AP{"b"}}, logic::TimeInterval{1, 3}) || F::TRUE())
+		                  && F{AP{"c"}}.dual_until(F::FALSE());
+		search::WordEncoder encoder;
+		encoder.write(formula);
+		search::WordDecoder decoder{encoder.get_buffer()};
+		CHECK(decoder.read<F>() == formula);
+	}
+
+	SECTION("Sets are encoded independently of their order")
+	{
+		const std::set<F>                   formulas{F{AP{"a"}}, F::TRUE(), F{AP{"a"}} && F{AP{"b"}}};
+		const std::set<F, F::CreationOrder> formulas_by_creation{begin(formulas), end(formulas)};
+		search::WordEncoder                 encoder;
+		encoder.write(formulas);
+		search::WordEncoder other_encoder;
+		other_encoder.write(formulas_by_creation);
+		CHECK(other_encoder.get_buffer() == encoder.get_buffer());
+		search::WordDecoder decoder{other_encoder.get_buffer()};
+		CHECK(decoder.read<std::set<F>>() == formulas);
+	}
+
+	SECTION("Invalid encodings are rejected")
+	{
+		search::WordEncoder encoder;
+		encoder.write(search.get_root()->get_words());
+		std::string encoding = encoder.take_buffer();
+		encoding.pop_back();
+		search::WordDecoder decoder{encoding};
+		CHECK_THROWS_AS(decoder.read<Words>(), std::invalid_argument);
+	}
+}
+
+TEST_CASE("Distributed railroad search", "[search][distributed][railroad]")
+{
+	const auto &[plant, spec, controller_actions, environment_actions] = create_crossing_problem({2});
+	std::set<AP> actions;
+	std::set_union(begin(controller_actions),
+	               end(controller_actions),
+	               begin(environment_actions),
+	               end(environment_actions),
+	               inserter(actions, end(actions)));
+	auto               ata = mtl_ata_translation::translate(spec, actions);
+	const unsigned int K   = std::max(plant.get_largest_constant(), spec.get_largest_constant());
+	const std::size_t  num_workers = GENERATE(1, 2, 4);
+	CAPTURE(num_workers);
+
+	SECTION("The controller has a strategy")
+	{
+		TreeSearch search{&plant, &ata, controller_actions, environment_actions, K, true};
+		search.build_tree(false);
+		search.label();
+		REQUIRE(search.get_root()->label == NodeLabel::TOP);
+
+		TreeSearch distributed_search{&plant, &ata, controller_actions, environment_actions, K, true};
+		const auto result = DistributedSearch{&distributed_search, num_workers}.run();
+		CHECK(result.root_label == NodeLabel::TOP);
+		REQUIRE(result.workers.size() == num_workers);
+		std::size_t num_nodes = 0;
+		for (const auto &statistics : result.workers) {
+			num_nodes += statistics.num_nodes;
+			CHECK(statistics.num_nodes > 0);
+			if (num_workers > 1) {
+				CHECK(statistics.num_forwarded_nodes > 0);
+				CHECK(statistics.num_sent_messages > 0);
+			}
+		}
+		CHECK(num_nodes > 1);
+		// The search of this process is not modified.
+		CHECK(distributed_search.get_size() == 1);
+	}
+
+	SECTION("The controller has no strategy")
+	{
+		// Without any controller actions, the environment can violate the specification.
+		std::set<std::string> all_actions = environment_actions;
+		all_actions.insert(std::begin(controller_actions), std::end(controller_actions));
+		TreeSearch search{&plant, &ata, {}, all_actions, K, true};
+		search.build_tree(false);
+		search.label();
+		REQUIRE(search.get_root()->label == NodeLabel::BOTTOM);
+
+		TreeSearch distributed_search{&plant, &ata, {}, all_actions, K, true};
+		const auto result = DistributedSearch{&distributed_search, num_workers}.run();
+		CHECK(result.root_label == NodeLabel::BOTTOM);
+	}
+
+	SECTION("The search must use incremental labeling without canceling children")
+	{
+		TreeSearch canceling_search{
+		  &plant, &ata, controller_actions, environment_actions, K, true, true};
+		CHECK_THROWS_AS(DistributedSearch(&canceling_search, num_workers), std::invalid_argument);
+		TreeSearch non_incremental_search{
+		  &plant, &ata, controller_actions, environment_actions, K, false};
+		CHECK_THROWS_AS(DistributedSearch(&non_incremental_search, num_workers), std::invalid_argument);
+	}
+}
+
+} // namespace
@@ -0,0 +1,54 @@
+/***************************************************************************
+ *  test_flat_map.cpp - Test the sorted flat map
+ *
+ *  Created:   Sat 17 Oct 10:34:12 CEST 2026
+ *  Copyright  2026  Till Hofmann <hofmann@kbsg.rwth-aachen.de>
+ *  SPDX-License-Identifier: LGPL-3.0-or-later
+ ****************************************************************************/
+
+#include "utilities/flat_map.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using namespace tacos;
+
+using utilities::FlatMap;
+
+TEST_CASE("Insert into a flat map", "[flat_map]")
+{
+	FlatMap<int, std::string> map;
+	CHECK(map.empty());
+	CHECK(map.begin() == map.end());
+	CHECK(map.insert({3, "three"}).second);
+	CHECK(map.insert({5, "five"}).second);
+	CHECK(map.insert({1, "one"}).second);
+	CHECK(map.insert({4, "four"}).second);
+	{
+		const auto [it, is_new] = map.insert({3, "drei"});
+		CHECK(!is_new);
+		CHECK(it->second == "three");
+	}
+	CHECK(map.size() == 4);
+	// The elements are sorted by key.
+	CHECK(std::vector<std::pair<int, std::string>>(std::begin(map), std::end(map))
+	      == std::vector<std::pair<int, std::string>>{{1, "one"},
+	                                                  {3, "three"},
+	                                                  {4, "four"},
+	                                                  {5, "five"}});
+	CHECK(map.at(4) == "four");
+	CHECK_THROWS_AS(map.at(2), std::out_of_range);
+	CHECK(map.count(1) == 1);
+	CHECK(map.count(6) == 0);
+	CHECK(map.find(5)->second == "five");
+	CHECK(map.find(0) == map.end());
+	CHECK(map.find(2) == map.end());
+}
+
+} // namespace
@@ -114,6 +114,10 @@ TEST_CASE("Compare GologLocations", "[golog]")
 	CHECK(l1 < i2);
 	CHECK(l2 < i1);
 	CHECK(l2 < i2);
+	// Equal locations have the same hash.
+	CHECK(std::hash<GologLocation>{}(l1) == std::hash<GologLocation>{}(l2));
+	CHECK(std::hash<GologLocation>{}(i1) == std::hash<GologLocation>{}(i2));
+	CHECK(std::hash<GologLocation>{}(l1) != std::hash<GologLocation>{}(i1));
 }
 
 TEST_CASE("Check Golog final locations", "[golog]")
@@ -34,6 +34,8 @@ TEST_CASE("Test BFS heuristic", "[search][heuristics]")
 	long h3 = bfs.compute_cost(nullptr);
 	CHECK(h1 < h2);
 	CHECK(h2 < h3);
+	// The counter grows with every node, so the costs of the frontier are not dense.
+	CHECK(!bfs.has_dense_integer_costs());
 }
 TEST_CASE("Test DFS heuristic", "[search][heuristics]")
 {
@@ -44,6 +46,8 @@ TEST_CASE("Test DFS heuristic", "[search][heuristics]")
 	long h3 = dfs.compute_cost(nullptr);
 	CHECK(h1 > h2);
 	CHECK(h2 > h3);
+	// The counter grows with every node, so the costs of the frontier are not dense.
+	CHECK(!dfs.has_dense_integer_costs());
 }
 
 TEST_CASE("Test time heuristic", "[search][heuristics]")
@@ -57,19 +61,19 @@ TEST_CASE("Test time heuristic", "[search][heuristics]")
 	root->min_total_region_increments = 0;
 	CHECK(h.compute_cost(root.get()) == 0);
 	auto c1 = std::make_shared<Node>(dummy_words);
-	root->add_child({1, "a1"}, c1);
+	root->add_child({1, "a1"}, c1.get());
 	CHECK(h.compute_cost(c1.get()) == 1);
 	auto c2 = std::make_shared<Node>(dummy_words);
-	root->add_child({3, "a1"}, c2);
-	root->add_child({4, "b"}, c2);
+	root->add_child({3, "a1"}, c2.get());
+	root->add_child({4, "b"}, c2.get());
 	CHECK(h.compute_cost(c2.get()) == 3);
 	auto cc1 = std::make_shared<Node>(dummy_words);
-	c1->add_child({2, "a"}, cc1);
-	c1->add_child({4, "a"}, cc1);
+	c1->add_child({2, "a"}, cc1.get());
+	c1->add_child({4, "a"}, cc1.get());
 	CHECK(h.compute_cost(cc1.get()) == 3);
 	auto cc2 = std::make_shared<Node>(dummy_words);
-	c2->add_child({2, "a"}, cc2);
-	c2->add_child({4, "a"}, cc2);
+	c2->add_child({2, "a"}, cc2.get());
+	c2->add_child({4, "a"}, cc2.get());
 	CHECK(h.compute_cost(cc2.get()) == 5);
 }
 
@@ -83,14 +87,14 @@ TEST_CASE("Test PreferEnvironmentActionHeuristic", "[search][heuristics]")
 	  std::set<CanonicalABWord>{CanonicalABWord({{TARegionState{Location{"l0"}, "x", 0}}})};
 	auto root = std::make_shared<Node>(std::set<CanonicalABWord>{});
 	auto n1   = std::make_shared<Node>(dummy_words);
-	root->add_child({0, "e1"}, n1);
+	root->add_child({0, "e1"}, n1.get());
 	CHECK(h.compute_cost(n1.get()) == 0);
 	auto n2 = std::make_shared<Node>(dummy_words);
-	root->add_child({0, "c1"}, n2);
+	root->add_child({0, "c1"}, n2.get());
 	CHECK(h.compute_cost(n2.get()) == 1);
 	auto n3 = std::make_shared<Node>(dummy_words);
-	root->add_child({0, "e2"}, n3);
-	root->add_child({0, "c2"}, n3);
+	root->add_child({0, "e2"}, n3.get());
+	root->add_child({0, "c2"}, n3.get());
 	CHECK(h.compute_cost(n3.get()) == 0);
 }
 
@@ -104,18 +108,18 @@ TEST_CASE("Test NumCanonicalWordsHeuristic", "[search][heuristics]")
 	auto root = std::make_shared<Node>(std::set<CanonicalABWord>{});
 	auto n1 =
 	  std::make_shared<Node>(std::set<CanonicalABWord>{{{TARegionState{Location{"l"}, "c", 0}}}});
-	root->add_child({1, "a"}, n1);
+	root->add_child({1, "a"}, n1.get());
 	CHECK(h.compute_cost(n1.get()) == 1);
 	auto n2 = std::make_shared<Node>(
 	  std::set<CanonicalABWord>{{{CanonicalABWord{{TARegionState{Location{"l"}, "c1", 0}},
 	                                              {TARegionState{Location{"l"}, "c2", 1}}}}}});
-	root->add_child({1, "b"}, n2);
+	root->add_child({1, "b"}, n2.get());
 	CHECK(h.compute_cost(n2.get()) == 1);
 	const logic::MTLFormula f{logic::AtomicProposition<std::string>{"a"}};
 	auto                    n3 = std::make_shared<Node>(
     std::set{CanonicalABWord{{TARegionState{Location{"l1"}, "c", 0}}},
              CanonicalABWord{{ATARegionState{f, 0}, TARegionState{Location{"l1"}, "c", 0}}}});
-	root->add_child({1, "c"}, n3);
+	root->add_child({1, "c"}, n3.get());
 	CHECK(h.compute_cost(n3.get()) == 2);
 }
 
@@ -126,12 +130,12 @@ TEST_CASE("Test CompositeHeuristic", "[search][heuristics]")
 	const auto dummy_words =
 	  std::set<CanonicalABWord>{CanonicalABWord({{TARegionState{Location{"l0"}, "x", 0}}})};
 	auto n1 = std::make_shared<Node>(dummy_words);
-	root->add_child({0, "environment_action"}, n1);
+	root->add_child({0, "environment_action"}, n1.get());
 	auto n2 = std::make_shared<Node>(dummy_words);
-	root->add_child({1, "controller_action"}, n2);
+	root->add_child({1, "controller_action"}, n2.get());
 	auto n3 = std::make_shared<Node>(dummy_words);
-	root->add_child({2, "environment_action"}, n3);
-	root->add_child({3, "controller_action"}, n3);
+	root->add_child({2, "environment_action"}, n3.get());
+	root->add_child({3, "controller_action"}, n3.get());
 	long w_time = GENERATE(0, 1, 10);
 	long w_env  = GENERATE(0, 1, 10);
 	SECTION(fmt::format("w_time={}, w_env={}", w_time, w_env))
@@ -154,6 +158,35 @@ TEST_CASE("Test CompositeHeuristic", "[search][heuristics]")
 		CHECK(h.compute_cost(n1.get()) == 0);
 		CHECK(h.compute_cost(n2.get()) == w_time * 1 + w_env * 1);
 		CHECK(h.compute_cost(n3.get()) == w_time * 2);
+		CHECK(h.has_dense_integer_costs());
+	}
+	SECTION("A composite heuristic is not dense if its weights are large")
+	{
+		using H = search::Heuristic<long, search::SearchTreeNode<std::string, std::string>>;
+		std::vector<std::pair<long, std::unique_ptr<H>>> heuristics;
+		heuristics.emplace_back(
+		  1000,
+		  std::make_unique<
+		    search::TimeHeuristic<long, search::SearchTreeNode<std::string, std::string>>>());
+		search::CompositeHeuristic<long, search::SearchTreeNode<std::string, std::string>> h{
+		  std::move(heuristics)};
+		CHECK(!h.has_dense_integer_costs());
+	}
+	SECTION("A composite heuristic is not dense if one of its heuristics is not dense")
+	{
+		using H = search::Heuristic<long, search::SearchTreeNode<std::string, std::string>>;
+		std::vector<std::pair<long, std::unique_ptr<H>>> heuristics;
+		heuristics.emplace_back(
+		  1,
+		  std::make_unique<
+		    search::TimeHeuristic<long, search::SearchTreeNode<std::string, std::string>>>());
+		heuristics.emplace_back(
+		  1,
+		  std::make_unique<
+		    search::RandomHeuristic<long, search::SearchTreeNode<std::string, std::string>>>());
+		search::CompositeHeuristic<long, search::SearchTreeNode<std::string, std::string>> h{
+		  std::move(heuristics)};
+		CHECK(!h.has_dense_integer_costs());
 	}
 }
 
@@ -167,6 +200,7 @@ TEST_CASE("Random heuristic", "[search][heuristics]")
 	// Two nodes are not assigned the same cost.
 	H h;
 	CHECK(h.compute_cost(nullptr) != h.compute_cost(nullptr));
+	CHECK(!h.has_dense_integer_costs());
 }
 
 } // namespace
@@ -0,0 +1,80 @@
+/***************************************************************************
+ *  test_local_transport.cpp - Test message exchange over local sockets
+ *
+ *  Created:   Sun 18 Oct 14:02:37 CEST 2026
+ *  Copyright  2026  Till Hofmann <hofmann@kbsg.rwth-aachen.de>
+ *  SPDX-License-Identifier: LGPL-3.0-or-later
+ ****************************************************************************/
+
+#include "utilities/local_transport.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <string>
+#include <vector>
+
+namespace {
+
+using namespace tacos;
+
+using utilities::LocalConnection;
+
+TEST_CASE("Exchange messages over a local connection", "[utilities][transport]")
+{
+	auto [first, second] = LocalConnection::create_pair();
+	CHECK(first.is_open());
+	CHECK(second.is_open());
+	CHECK(!second.pop_message());
+
+	first.send("hello");
+	first.send("");
+	first.send("world");
+	CHECK(first.has_pending_output());
+	CHECK(first.flush());
+	CHECK(!first.has_pending_output());
+	CHECK(second.receive());
+	CHECK(second.pop_message() == "hello");
+	CHECK(second.pop_message() == "");
+	CHECK(second.pop_message() == "world");
+	CHECK(!second.pop_message());
+
+	second.send("reply");
+	second.flush_blocking();
+	CHECK(first.receive());
+	CHECK(first.pop_message() == "reply");
+
+	SECTION("Large messages are split and reassembled")
+	{
+		std::vector<std::string> messages;
+		for (std::size_t i = 0; i < 16; ++i) {
+			messages.push_back(std::string(100000 + i, static_cast<char>('a' + i)));
+			first.send(messages.back());
+		}
+		std::vector<std::string> received;
+		while (received.size() < messages.size()) {
+			first.flush();
+			utilities::wait_for_connections({&first, &second}, 1000);
+			REQUIRE(second.receive());
+			while (auto message = second.pop_message()) {
+				received.push_back(std::move(*message));
+			}
+		}
+		CHECK(!first.has_pending_output());
+		CHECK(received == messages);
+	}
+
+	SECTION("Closing one end is detected by the other end")
+	{
+		first.send("last");
+		first.flush_blocking();
+		first.close();
+		CHECK(!first.is_open());
+		CHECK(!second.receive());
+		CHECK(!second.is_open());
+		// Messages that have been received before the connection was closed are still available.
+		CHECK(second.pop_message() == "last");
+		second.send("dropped");
+		CHECK(second.flush());
+	}
+}
+
+} // namespace
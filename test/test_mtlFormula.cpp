@@ -332,4 +332,33 @@ TEST_CASE("Compare MTL formulas", "[libmtl]")
 	CHECK(MTLFormula::create_conjunction({a, b}) != MTLFormula::create_conjunction({a, b, c}));
 }
 
+TEST_CASE("MTL formulas are hash-consed", "[libmtl]")
+{
+	using MTLFormula = logic::MTLFormula<std::string>;
+	using AP         = logic::AtomicProposition<std::string>;
+	using logic::TimeInterval;
+	const auto a   = MTLFormula{AP{"a"}};
+	const auto b   = MTLFormula{AP{"b"}};
+	const auto phi = (a && b).until(!a, TimeInterval{1, 2});
+	const auto psi = (MTLFormula{AP{"a"}} && MTLFormula{AP{"b"}}).until(!a, TimeInterval{1, 2});
+	CHECK(phi == psi);
+	CHECK(phi.get_id() == psi.get_id());
+	CHECK(std::hash<MTLFormula>{}(phi) == std::hash<MTLFormula>{}(psi));
+	CHECK(phi.get_id() != (a && b).get_id());
+	CHECK(!(phi < psi));
+	CHECK(!(psi < phi));
+	// Creating an existing formula does not create a new node.
+	const auto num_formulas = MTLFormula::get_num_formulas();
+	CHECK(MTLFormula{AP{"b"}}.until(a) == b.until(a));
+	CHECK(MTLFormula::get_num_formulas() == num_formulas + 1);
+	// The positive normal form is computed once and then shared.
+	CHECK((!phi).to_positive_normal_form() == (!psi).to_positive_normal_form());
+	CHECK((!phi).to_positive_normal_form()
+	      == (!a || !b).dual_until(a, TimeInterval{1, 2}).to_positive_normal_form());
+	// Shared sub-formulas are only reported once.
+	const auto shared = phi && phi.until(phi);
+	CHECK(shared.get_subformulas_of_type(logic::LOP::LUNTIL) == std::set{phi, phi.until(phi)});
+	CHECK(shared.get_subformulas_of_type(logic::LOP::AP) == std::set{a, b});
+}
+
 } // namespace
@@ -24,6 +24,7 @@ using google::protobuf::TextFormat;
 using AtomicProposition = logic::AtomicProposition<std::string>;
 using MTLFormula        = logic::MTLFormula<std::string>;
 using logic::parse_proto;
+using logic::to_proto;
 using logic::TimeInterval;
 using utilities::arithmetic::BoundType;
 
@@ -210,6 +211,40 @@ TEST_CASE("Import MTL formulas from a proto", "[libmtl][proto]")
 	}
 }
 
+TEST_CASE("Export MTL formulas to a proto", "[libmtl][proto]")
+{
+	MTLFormula a{AtomicProposition{"a"}};
+	MTLFormula b{AtomicProposition{"b"}};
+	MTLFormula c{AtomicProposition{"c"}};
+
+	SECTION("Constants and atomic formulas")
+	{
+		CHECK(parse_proto(to_proto(MTLFormula::TRUE())) == MTLFormula::TRUE());
+		CHECK(parse_proto(to_proto(MTLFormula::FALSE())) == MTLFormula::FALSE());
+		CHECK(parse_proto(to_proto(a)) == a);
+		logic::proto::MTLFormula expected;
+		REQUIRE(TextFormat::ParseFromString(R"pb(atomic { symbol: "a" })pb", &expected));
+		CHECK(to_proto(a).SerializeAsString() == expected.SerializeAsString());
+	}
+
+	SECTION("Boolean combinations")
+	{
+		const auto formula = MTLFormula::create_conjunction({a, b || !c, !(a && c)});
+		CHECK(parse_proto(to_proto(formula)) == formula);
+	}
+
+	SECTION("Until and dual until")
+	{
+		CHECK(parse_proto(to_proto(a.until(b))) == a.until(b));
+		const auto until =
+		  a.until(b, TimeInterval{1, BoundType::STRICT, 2, BoundType::WEAK}).dual_until(c);
+		CHECK(parse_proto(to_proto(until)) == until);
+		const auto dual_until =
+		  a.dual_until(b, TimeInterval{0, BoundType::WEAK, 3, BoundType::STRICT}) && finally(c);
+		CHECK(parse_proto(to_proto(dual_until)) == dual_until);
+	}
+}
+
 TEST_CASE("Exceptions when importing invalid MTL protos", "[libmtl][proto]")
 {
 	logic::proto::MTLFormula proto_formula;
@@ -0,0 +1,99 @@
+/***************************************************************************
+ *  test_multi_queue.cpp - Test the relaxed concurrent priority queue
+ *
+ *  Created:   Sat 17 Oct 10:02:17 CEST 2026
+ *  Copyright  2026  Till Hofmann <hofmann@kbsg.rwth-aachen.de>
+ *  SPDX-License-Identifier: LGPL-3.0-or-later
+ ****************************************************************************/
+
+#include "utilities/multi_queue.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using namespace tacos;
+
+using utilities::MultiQueue;
+
+TEST_CASE("A MultiQueue with a single heap is a priority queue", "[threading][multi_queue]")
+{
+	MultiQueue<int, int> queue{1, 1};
+	CHECK(queue.empty());
+	CHECK(!queue.pop());
+	for (int i : {3, 1, 4, 5, 9, 2, 6}) {
+		queue.push({i, 10 * i});
+	}
+	CHECK(queue.size() == 7);
+	std::vector<int> priorities;
+	while (auto element = queue.pop()) {
+		CHECK(element->second == 10 * element->first);
+		priorities.push_back(element->first);
+	}
+	CHECK(priorities == std::vector{9, 6, 5, 4, 3, 2, 1});
+	CHECK(queue.empty());
+	const auto statistics = queue.get_rank_error_statistics();
+	CHECK(statistics.num_pops == 7);
+	CHECK(statistics.num_samples == 7);
+	CHECK(statistics.max_rank_error == 0);
+	CHECK(statistics.get_mean_rank_error() == 0);
+}
+
+TEST_CASE("Measure the rank error of a MultiQueue", "[threading][multi_queue]")
+{
+	MultiQueue<int, int> queue{8, 1};
+	constexpr int        num_elements = 1000;
+	for (int i = 0; i < num_elements; ++i) {
+		queue.push({i, i});
+	}
+	std::set<int> popped;
+	while (auto element = queue.pop()) {
+		popped.insert(element->second);
+	}
+	CHECK(popped.size() == num_elements);
+	const auto statistics = queue.get_rank_error_statistics();
+	CHECK(statistics.num_pops == num_elements);
+	CHECK(statistics.num_samples == num_elements);
+	// The MultiQueue is relaxed, but it is still far from random order.
+	CHECK(statistics.get_mean_rank_error() < num_elements / 10);
+	CHECK(statistics.max_rank_error < num_elements);
+}
+
+TEST_CASE("Concurrently use a MultiQueue", "[threading][multi_queue]")
+{
+	MultiQueue<int, int>     queue{16, 64};
+	constexpr int            num_threads  = 4;
+	constexpr int            num_elements = 10000;
+	std::mutex               popped_mutex;
+	std::multiset<int>       popped;
+	std::vector<std::thread> threads;
+	for (int t = 0; t < num_threads; ++t) {
+		threads.emplace_back([&, t] {
+			for (int i = t; i < num_elements; i += num_threads) {
+				queue.push({i % 100, i});
+			}
+			std::vector<int> local;
+			while (auto element = queue.pop()) {
+				local.push_back(element->second);
+			}
+			std::lock_guard lock{popped_mutex};
+			popped.insert(std::begin(local), std::end(local));
+		});
+	}
+	for (auto &thread : threads) {
+		thread.join();
+	}
+	// Threads may finish while others are still pushing, so pop the remaining elements.
+	while (auto element = queue.pop()) {
+		popped.insert(element->second);
+	}
+	CHECK(popped.size() == num_elements);
+	CHECK(std::set<int>(std::begin(popped), std::end(popped)).size() == num_elements);
+	CHECK(queue.get_rank_error_statistics().num_pops == num_elements);
+}
+
+} // namespace
@@ -0,0 +1,124 @@
+/***************************************************************************
+ *  test_packed_canonical_word.cpp - Test the packed canonical word layout
+ *
+ *  Created:   Fri 16 Oct 11:48:03 CEST 2026
+ *  Copyright  2026  Till Hofmann <hofmann@kbsg.rwth-aachen.de>
+ *  SPDX-License-Identifier: LGPL-3.0-or-later
+ ****************************************************************************/
+
+#include "automata/ta.h"
+#include "mtl/MTLFormula.h"
+#include "search/canonical_word.h"
+#include "search/operators.h"
+#include "search/packed_canonical_word.h"
+#include "search/reg_a.h"
+#include "search/synchronous_product.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+using namespace tacos;
+
+using ATARegionState  = search::ATARegionState<std::string>;
+using CanonicalABWord = search::CanonicalABWord<automata::ta::Location<std::string>, std::string>;
+using Location        = automata::ta::Location<std::string>;
+using TARegionState   = search::PlantRegionState<Location>;
+using search::PackedCanonicalABWord;
+
+TEST_CASE("Pack and unpack canonical words", "[search][packed_word]")
+{
+	const logic::MTLFormula a{logic::AtomicProposition<std::string>{"a"}};
+	const logic::MTLFormula b{logic::AtomicProposition<std::string>{"b"}};
+	search::PackedSymbolTable<Location, std::string> table;
+
+	const CanonicalABWord w1{{TARegionState{Location{"l0"}, "x", 0}, ATARegionState{a, 0}},
+	                         {TARegionState{Location{"l0"}, "y", 1}, ATARegionState{b, 3}}};
+	const CanonicalABWord w2{{TARegionState{Location{"l1"}, "x", 2}}, {ATARegionState{a, 1}}};
+	const auto            p1 = table.pack(w1);
+	const auto            p2 = table.pack(w2);
+	CHECK(p1.size() == 2);
+	CHECK(p1.get_symbols().size() == 4);
+	CHECK(table.unpack(p1) == w1);
+	CHECK(table.unpack(p2) == w2);
+	CHECK(p1 == table.pack(w1));
+	CHECK(p1 != p2);
+	CHECK(table.get_location(p1.partition_begin(0)->id) == Location{"l0"});
+	CHECK(table.get_clock(p1.partition_begin(0)->clock) == "x");
+	CHECK(table.get_formula(std::prev(p1.partition_end(0))->id) == a);
+	std::stringstream str;
+	str << p2;
+	CHECK(str.str() == "[ { (l1, c0, 2) }, { (f0, 1) } ]");
+}
+
+TEST_CASE("Operations on packed canonical words", "[search][packed_word]")
+{
+	const logic::MTLFormula a{logic::AtomicProposition<std::string>{"a"}};
+	const logic::MTLFormula b{logic::AtomicProposition<std::string>{"b"}};
+	const logic::MTLFormula c{logic::AtomicProposition<std::string>{"c"}};
+	search::PackedSymbolTable<Location, std::string> table;
+
+	const std::vector<CanonicalABWord> words{
+	  {{TARegionState{Location{"l0"}, "x", 0}, ATARegionState{a, 0}}},
+	  {{TARegionState{Location{"l0"}, "x", 0}, ATARegionState{a, 2}},
+	   {TARegionState{Location{"l0"}, "y", 1}, ATARegionState{b, 3}}},
+	  {{TARegionState{Location{"l0"}, "x", 1}},
+	   {ATARegionState{a, 1}, ATARegionState{c, 3}},
+	   {TARegionState{Location{"l0"}, "y", 5}, ATARegionState{b, 5}}},
+	  {{TARegionState{Location{"l1"}, "x", 4}, ATARegionState{b, 2}},
+	   {TARegionState{Location{"l1"}, "y", 5}}},
+	  {{ATARegionState{a, 3}, ATARegionState{c, 1}}, {TARegionState{Location{"l1"}, "x", 5}}},
+	};
+	const RegionIndex K = 2;
+
+	SECTION("Time successors")
+	{
+		for (const auto &word : words) {
+			INFO("Word: " << word);
+			auto packed = table.pack(word);
+			auto cur    = word;
+			// Follow the whole chain of time successors.
+			for (int i = 0; i < 10; ++i) {
+				cur    = search::get_time_successor(cur, K);
+				packed = search::get_time_successor(packed, K);
+				CHECK(table.unpack(packed) == cur);
+			}
+		}
+	}
+
+	SECTION("reg_a")
+	{
+		for (const auto &word : words) {
+			INFO("Word: " << word);
+			CHECK(table.unpack(search::reg_a(table.pack(word))) == search::reg_a(word));
+		}
+	}
+
+	SECTION("Candidates")
+	{
+		for (const auto &word : words) {
+			INFO("Word: " << word);
+			CHECK(search::get_candidate(table.pack(word), table) == search::get_candidate(word));
+		}
+	}
+
+	SECTION("Monotonic domination")
+	{
+		std::vector<CanonicalABWord> all_words = words;
+		all_words.push_back({{TARegionState{Location{"l0"}, "x", 0}}});
+		all_words.push_back({{TARegionState{Location{"l0"}, "y", 1}, ATARegionState{b, 3}}});
+		all_words.push_back({{ATARegionState{a, 1}}, {TARegionState{Location{"l0"}, "y", 5}}});
+		for (const auto &w1 : all_words) {
+			for (const auto &w2 : all_words) {
+				INFO("w1: " << w1 << ", w2: " << w2);
+				CHECK(search::is_monotonically_dominated(table.pack(w1), table.pack(w2))
+				      == search::is_monotonically_dominated(w1, w2));
+			}
+		}
+	}
+}
+
+} // namespace
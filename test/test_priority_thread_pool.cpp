@@ -10,12 +10,16 @@
 #include "utilities/priority_thread_pool.h"
 #include "utilities/priority_thread_pool.hpp"
 
+#include <atomic>
 #include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
 #include <chrono>
 #include <condition_variable>
+#include <functional>
 #include <mutex>
 #include <set>
 #include <thread>
+#include <vector>
 
 using namespace tacos;
 
@@ -148,3 +152,250 @@ TEST_CASE("Direct access to a thread pool", "[threading]")
 		CHECK_THROWS_AS(queue_access.pop(), utilities::QueueStartedException);
 	}
 }
+
+TEST_CASE("Thread pools with per-worker queues", "[threading]")
+{
+	const auto mode = GENERATE(utilities::SchedulingMode::WORK_STEALING,
+	                           utilities::SchedulingMode::RELAXED_PRIORITY,
+	                           utilities::SchedulingMode::MULTI_QUEUE);
+	ThreadPool<int> pool{ThreadPool<int>::StartOnInit::NO, 4};
+	pool.set_scheduling_mode(mode, 2);
+	std::atomic<int> num_done{0};
+	SECTION("Jobs may spawn new jobs")
+	{
+		// Each job spawns two more jobs until the depth is reached, i.e., we get a full binary tree.
+		constexpr int             depth = 10;
+		std::function<void(int)> spawn  = [&](int level) {
+			++num_done;
+			if (level < depth) {
+				for (int i = 0; i < 2; ++i) {
+					pool.add_job([&spawn, level] { spawn(level + 1); }, level);
+				}
+			}
+		};
+		pool.add_job([&spawn] { spawn(0); });
+		pool.start();
+		pool.wait();
+		CHECK(num_done == (1 << (depth + 1)) - 1);
+		pool.finish();
+	}
+	SECTION("Jobs added before the pool is started are processed")
+	{
+		for (int i = 0; i < 100; ++i) {
+			pool.add_job([&num_done] { ++num_done; }, i);
+		}
+		pool.start();
+		for (int i = 0; i < 100; ++i) {
+			pool.add_job([&num_done] { ++num_done; }, i);
+		}
+		pool.finish();
+		CHECK(num_done == 200);
+	}
+	SECTION("Jobs are canceled after stopping the queue")
+	{
+		constexpr int num_jobs = 100;
+		pool.start();
+		for (int i = 0; i < num_jobs; ++i) {
+			pool.add_job(
+			  [&num_done] {
+				  std::this_thread::sleep_for(std::chrono::milliseconds{100});
+				  ++num_done;
+			  },
+			  i);
+		}
+		pool.cancel();
+		CHECK(num_done < num_jobs);
+	}
+	SECTION("Cannot change the scheduling mode of a running pool")
+	{
+		pool.start();
+		CHECK_THROWS_AS(pool.set_scheduling_mode(utilities::SchedulingMode::GLOBAL_QUEUE),
+		                utilities::QueueStartedException);
+	}
+}
+
+TEST_CASE("Relaxed priority scheduling with a single worker keeps the order", "[threading]")
+{
+	ThreadPool<int> pool{ThreadPool<int>::StartOnInit::NO, 1};
+	pool.set_scheduling_mode(utilities::SchedulingMode::RELAXED_PRIORITY);
+	std::vector<int> order;
+	for (int i = 0; i < 10; ++i) {
+		pool.add_job([&order, i] { order.push_back(i); }, i);
+	}
+	pool.start();
+	pool.finish();
+	CHECK(order == std::vector{9, 8, 7, 6, 5, 4, 3, 2, 1, 0});
+}
+
+TEST_CASE("A thread pool with a bucket queue", "[threading]")
+{
+	ThreadPool<int> pool{ThreadPool<int>::StartOnInit::NO, 2};
+	std::mutex      res_mutex;
+	std::set<int>   res;
+	for (int i = 0; i < 5; ++i) {
+		pool.add_job(
+		  [&res_mutex, &res, i] {
+			  std::lock_guard guard{res_mutex};
+			  res.insert(i);
+		  },
+		  i);
+	}
+	// The queued jobs are moved to the new queue.
+	pool.set_queue_type(utilities::QueueType::BUCKET_QUEUE);
+	QueueAccess queue_access{&pool};
+	CHECK(queue_access.get_size() == 5);
+	CHECK(queue_access.top().first == 4);
+	SECTION("Process the queue synchronously")
+	{
+		for (int i = 4; i >= 0; --i) {
+			REQUIRE(!queue_access.empty());
+			CHECK(queue_access.top().first == i);
+			queue_access.top().second();
+			queue_access.pop();
+		}
+		CHECK(res == std::set{0, 1, 2, 3, 4});
+	}
+	SECTION("Process the queue with the workers")
+	{
+		pool.start();
+		CHECK_THROWS_AS(pool.set_queue_type(utilities::QueueType::BINARY_HEAP),
+		                utilities::QueueStartedException);
+		for (int i = 5; i < 10; ++i) {
+			pool.add_job(
+			  [&res_mutex, &res, i] {
+				  std::lock_guard guard{res_mutex};
+				  res.insert(i);
+			  },
+			  i);
+		}
+		pool.finish();
+		CHECK(res == std::set{0, 1, 2, 3, 4, 5, 6, 7, 8, 9});
+	}
+}
+
+namespace {
+
+/** A job that records its ID when it is run. */
+struct IdJob
+{
+	int               id;
+	std::mutex       *res_mutex;
+	std::vector<int> *res;
+
+	void
+	operator()() const
+	{
+		std::lock_guard guard{*res_mutex};
+		res->push_back(id);
+	}
+};
+
+} // namespace
+
+TEST_CASE("Obsolete jobs are dropped from the queue", "[threading]")
+{
+	ThreadPool<int, IdJob> pool{ThreadPool<int, IdJob>::StartOnInit::NO, 2};
+	std::mutex             res_mutex;
+	std::vector<int>       res;
+	// Jobs with an odd ID are obsolete.
+	pool.set_obsolete_job_check([](const IdJob &job) { return job.id % 2 == 1; });
+	for (int i = 0; i < 10; ++i) {
+		pool.add_job(IdJob{i, &res_mutex, &res}, i);
+	}
+	CHECK(pool.get_obsolete_job_statistics().max_queued_jobs == 10);
+	SECTION("Process the queue synchronously")
+	{
+		QueueAccess queue_access{&pool};
+		while (!queue_access.empty()) {
+			queue_access.top().second();
+			queue_access.pop();
+		}
+		CHECK(res == std::vector{8, 6, 4, 2, 0});
+		const auto statistics = pool.get_obsolete_job_statistics();
+		CHECK(statistics.num_discarded_jobs + statistics.num_compacted_jobs == 5);
+	}
+	SECTION("Compact the queue")
+	{
+		pool.compact_queue();
+		CHECK(QueueAccess{&pool}.get_size() == 5);
+		const auto statistics = pool.get_obsolete_job_statistics();
+		CHECK(statistics.num_compacted_jobs == 5);
+		CHECK(statistics.num_compactions == 1);
+		CHECK(statistics.num_discarded_jobs == 0);
+	}
+	SECTION("Process the queue with the workers")
+	{
+		const auto mode = GENERATE(utilities::SchedulingMode::GLOBAL_QUEUE,
+		                           utilities::SchedulingMode::WORK_STEALING,
+		                           utilities::SchedulingMode::RELAXED_PRIORITY,
+		                           utilities::SchedulingMode::MULTI_QUEUE);
+		pool.set_scheduling_mode(mode);
+		pool.start();
+		CHECK_THROWS_AS(pool.set_obsolete_job_check(nullptr), utilities::QueueStartedException);
+		for (int i = 10; i < 20; ++i) {
+			pool.add_job(IdJob{i, &res_mutex, &res}, i);
+		}
+		pool.compact_queue();
+		pool.finish();
+		CHECK(std::set(std::begin(res), std::end(res)) == std::set{0, 2, 4, 6, 8, 10, 12, 14, 16, 18});
+		const auto statistics = pool.get_obsolete_job_statistics();
+		CHECK(statistics.num_discarded_jobs + statistics.num_compacted_jobs == 10);
+	}
+}
+
+TEST_CASE("Visit the queued jobs of a thread pool", "[threading]")
+{
+	ThreadPool<int> pool{ThreadPool<int>::StartOnInit::NO, 1};
+
+	const auto get_queued_priorities = [&pool] {
+		std::multiset<int> priorities;
+		pool.visit_queued_jobs([&priorities](const auto &job) { priorities.insert(job.first); });
+		return priorities;
+	};
+	SECTION("Visit the jobs before the pool is started")
+	{
+		for (int i = 0; i < 3; ++i) {
+			pool.add_job([] {}, i);
+		}
+		CHECK(get_queued_priorities() == std::multiset{0, 1, 2});
+		pool.set_queue_type(utilities::QueueType::BUCKET_QUEUE);
+		CHECK(get_queued_priorities() == std::multiset{0, 1, 2});
+	}
+	SECTION("Visit the jobs while the worker is busy")
+	{
+		const auto mode = GENERATE(utilities::SchedulingMode::GLOBAL_QUEUE,
+		                           utilities::SchedulingMode::WORK_STEALING,
+		                           utilities::SchedulingMode::RELAXED_PRIORITY,
+		                           utilities::SchedulingMode::MULTI_QUEUE);
+		pool.set_scheduling_mode(mode);
+		std::mutex              mutex;
+		std::condition_variable cond;
+		bool                    is_running{false};
+		bool                    is_released{false};
+		pool.add_job(
+		  [&] {
+			  std::unique_lock lock{mutex};
+			  is_running = true;
+			  cond.notify_all();
+			  cond.wait(lock, [&is_released] { return is_released; });
+		  },
+		  10);
+		pool.start();
+		{
+			std::unique_lock lock{mutex};
+			cond.wait(lock, [&is_running] { return is_running; });
+		}
+		// The only worker is blocked, so all other jobs stay in the queue.
+		for (int i = 0; i < 3; ++i) {
+			pool.add_job([] {}, i);
+		}
+		CHECK(get_queued_priorities() == std::multiset{0, 1, 2});
+		{
+			std::lock_guard lock{mutex};
+			is_released = true;
+		}
+		cond.notify_all();
+		pool.finish();
+		CHECK(get_queued_priorities().empty());
+	}
+}
@@ -36,6 +36,11 @@
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/generators/catch_generators.hpp>
 #include <iterator>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <tuple>
 
 #undef TRUE
 
@@ -52,6 +57,57 @@ using search::NodeLabel;
 using TreeSearch =
   search::TreeSearch<automata::ta::Location<std::vector<std::string>>, std::string>;
 
+/** Get the nodes of a snapshot indexed by their words, independent of the order of the nodes. */
+auto
+get_canonical_graph(const TreeSearch::Snapshot &snapshot)
+{
+	using Words = std::set<TreeSearch::Snapshot::Word>;
+	const auto get_words = [&snapshot](std::size_t node) {
+		Words words;
+		for (const auto word : snapshot.nodes[node].words) {
+			words.insert(snapshot.words[word]);
+		}
+		return words;
+	};
+	std::map<Words,
+	         std::tuple<search::NodeState,
+	                    NodeLabel,
+	                    search::LabelReason,
+	                    bool,
+	                    RegionIndex,
+	                    std::set<std::tuple<RegionIndex, std::string, Words>>>>
+	  graph;
+	for (std::size_t i = 0; i < snapshot.nodes.size(); ++i) {
+		const auto &node = snapshot.nodes[i];
+		std::set<std::tuple<RegionIndex, std::string, Words>> children;
+		for (const auto &edge : node.children) {
+			children.emplace(edge.increment, edge.action, get_words(edge.child));
+		}
+		graph[get_words(i)] = std::make_tuple(node.state,
+		                                      node.label,
+		                                      node.label_reason,
+		                                      node.is_expanded,
+		                                      node.min_total_region_increments,
+		                                      children);
+	}
+	return graph;
+}
+
+/** Get the priorities of the frontier of a snapshot indexed by the words of the nodes. */
+std::map<std::set<TreeSearch::Snapshot::Word>, long>
+get_canonical_frontier(const TreeSearch::Snapshot &snapshot)
+{
+	std::map<std::set<TreeSearch::Snapshot::Word>, long> frontier;
+	for (const auto &entry : snapshot.frontier) {
+		std::set<TreeSearch::Snapshot::Word> words;
+		for (const auto word : snapshot.nodes[entry.node].words) {
+			words.insert(snapshot.words[word]);
+		}
+		frontier[words] = entry.priority;
+	}
+	return frontier;
+}
+
 TEST_CASE("Railroad", "[railroad]")
 {
 	const auto &[plant, spec, controller_actions, environment_actions] = create_crossing_problem({2});
@@ -75,7 +131,11 @@ TEST_CASE("Railroad", "[railroad]")
                     true,
                     true,
                     generate_heuristic<TreeSearch::Node>()};
-	search.build_tree(true);
+	const auto scheduling_mode = GENERATE(utilities::SchedulingMode::GLOBAL_QUEUE,
+	                                      utilities::SchedulingMode::WORK_STEALING,
+	                                      utilities::SchedulingMode::RELAXED_PRIORITY,
+	                                      utilities::SchedulingMode::MULTI_QUEUE);
+	search.build_tree(true, 0, scheduling_mode);
 	CHECK(search.get_root()->label == NodeLabel::TOP);
 #ifdef HAVE_VISUALIZATION
 	visualization::search_tree_to_graphviz(*search.get_root(), true)
@@ -87,6 +147,173 @@ TEST_CASE("Railroad", "[railroad]")
 #endif
 }
 
+TEST_CASE("Railroad with a memory budget", "[railroad]")
+{
+	const auto &[plant, spec, controller_actions, environment_actions] = create_crossing_problem({2});
+	std::set<AP> actions;
+	std::set_union(begin(controller_actions),
+	               end(controller_actions),
+	               begin(environment_actions),
+	               end(environment_actions),
+	               inserter(actions, end(actions)));
+	auto               ata = mtl_ata_translation::translate(spec, actions);
+	const unsigned int K   = std::max(plant.get_largest_constant(), spec.get_largest_constant());
+	const bool         antichain_pruning = GENERATE(false, true);
+	CAPTURE(antichain_pruning);
+	TreeSearch search{&plant, &ata, controller_actions, environment_actions, K, true, true};
+	TreeSearch bounded_search{&plant, &ata, controller_actions, environment_actions, K, true, true};
+	search.set_antichain_pruning(antichain_pruning);
+	bounded_search.set_antichain_pruning(antichain_pruning);
+	// Every process exceeds a budget of a single byte, so release the words whenever possible.
+	bounded_search.set_memory_budget(1, 1);
+	search.build_tree(false);
+	bounded_search.build_tree(false);
+	REQUIRE(search.get_root()->label == NodeLabel::TOP);
+	CHECK(bounded_search.get_root()->label == NodeLabel::TOP);
+	CHECK(bounded_search.get_size() == search.get_size());
+	const auto statistics = bounded_search.get_memory_statistics();
+	CHECK(statistics.num_releases > 0);
+	CHECK(statistics.num_released_nodes > 0);
+	CHECK(statistics.released_memory > 0);
+	CHECK(search.get_memory_statistics().num_released_nodes == 0);
+
+	// The released words are restored for the controller.
+	const auto controller = controller_synthesis::create_controller(
+	  search.get_root(), controller_actions, environment_actions, K);
+	const auto bounded_controller = controller_synthesis::create_controller(
+	  bounded_search.get_root(), controller_actions, environment_actions, K);
+	CHECK(bounded_controller.get_locations() == controller.get_locations());
+	CHECK(bounded_controller.get_transitions() == controller.get_transitions());
+
+	SECTION("Multi-threaded search")
+	{
+		TreeSearch concurrent_search{
+		  &plant, &ata, controller_actions, environment_actions, K, true, true};
+		concurrent_search.set_antichain_pruning(antichain_pruning);
+		concurrent_search.set_memory_budget(1, 1);
+		concurrent_search.build_tree(true, 4);
+		CHECK(concurrent_search.get_root()->label == NodeLabel::TOP);
+		CHECK(concurrent_search.get_memory_statistics().num_released_nodes > 0);
+	}
+}
+
+TEST_CASE("Railroad search stops at the verdict", "[railroad]")
+{
+	const auto &[plant, spec, controller_actions, environment_actions] = create_crossing_problem({2});
+	std::set<AP> actions;
+	std::set_union(begin(controller_actions),
+	               end(controller_actions),
+	               begin(environment_actions),
+	               end(environment_actions),
+	               inserter(actions, end(actions)));
+	auto               ata = mtl_ata_translation::translate(spec, actions);
+	const unsigned int K   = std::max(plant.get_largest_constant(), spec.get_largest_constant());
+	// Do not terminate early, otherwise the labeled root already cancels all remaining nodes.
+	TreeSearch search{&plant, &ata, controller_actions, environment_actions, K, true, false};
+	search.build_tree(false);
+	REQUIRE(search.get_root()->label == NodeLabel::TOP);
+	const auto times = search.get_search_times();
+	REQUIRE(times.time_to_verdict);
+	CHECK(!times.stopped_at_verdict);
+	CHECK(*times.time_to_verdict <= times.time_to_exhaustion);
+
+	const bool multi_threaded = GENERATE(false, true);
+	CAPTURE(multi_threaded);
+	TreeSearch stopped_search{&plant, &ata, controller_actions, environment_actions, K, true, false};
+	stopped_search.set_stop_on_verdict(true);
+	stopped_search.build_tree(multi_threaded);
+	CHECK(stopped_search.get_root()->label == NodeLabel::TOP);
+	const auto stopped_times = stopped_search.get_search_times();
+	CHECK(stopped_times.stopped_at_verdict);
+	REQUIRE(stopped_times.time_to_verdict);
+	CHECK(*stopped_times.time_to_verdict <= stopped_times.time_to_exhaustion);
+	if (!multi_threaded) {
+		// The single-threaded search expands the nodes in the same order until the verdict.
+		CHECK(stopped_search.get_size() < search.get_size());
+	}
+	const auto controller = controller_synthesis::create_controller(
+	  stopped_search.get_root(), controller_actions, environment_actions, K);
+	CHECK(!controller.get_transitions().empty());
+}
+
+TEST_CASE("Resume a railroad search from a snapshot", "[railroad]")
+{
+	const auto &[plant, spec, controller_actions, environment_actions] = create_crossing_problem({2});
+	std::set<AP> actions;
+	std::set_union(begin(controller_actions),
+	               end(controller_actions),
+	               begin(environment_actions),
+	               end(environment_actions),
+	               inserter(actions, end(actions)));
+	auto               ata = mtl_ata_translation::translate(spec, actions);
+	const unsigned int K   = std::max(plant.get_largest_constant(), spec.get_largest_constant());
+	// Do not terminate early, so the resumed search explores the same graph.
+	TreeSearch search{&plant, &ata, controller_actions, environment_actions, K, true, false};
+	search.build_tree(false);
+	REQUIRE(search.get_root()->label == NodeLabel::TOP);
+
+	const bool multi_threaded = GENERATE(false, true);
+	CAPTURE(multi_threaded);
+	TreeSearch interrupted_search{
+	  &plant, &ata, controller_actions, environment_actions, K, true, false};
+	std::mutex                          snapshot_mutex;
+	std::size_t                         num_snapshots = 0;
+	std::optional<TreeSearch::Snapshot> snapshot;
+	const auto keep_snapshot = [&](TreeSearch::Snapshot &&new_snapshot) {
+		std::lock_guard lock{snapshot_mutex};
+		++num_snapshots;
+		// Keep a snapshot from the middle of the search.
+		if (!snapshot && 2 * new_snapshot.nodes.size() >= search.get_size()) {
+			snapshot = std::move(new_snapshot);
+		}
+	};
+	interrupted_search.set_snapshot_handler(std::chrono::seconds{0}, keep_snapshot);
+	interrupted_search.build_tree(multi_threaded, 4);
+	CHECK(interrupted_search.get_size() == search.get_size());
+	REQUIRE(num_snapshots > 0);
+	REQUIRE(snapshot);
+	CHECK(snapshot->nodes.size() < search.get_size());
+	CHECK(!snapshot->frontier.empty());
+
+	TreeSearch resumed_search{&plant, &ata, controller_actions, environment_actions, K, true, false};
+	resumed_search.restore_snapshot(*snapshot);
+	CHECK(resumed_search.get_size() == snapshot->nodes.size());
+	const auto restored_snapshot = resumed_search.create_snapshot();
+	CHECK(get_canonical_graph(restored_snapshot) == get_canonical_graph(*snapshot));
+	CHECK(get_canonical_frontier(restored_snapshot) == get_canonical_frontier(*snapshot));
+	resumed_search.build_tree(multi_threaded, 4);
+	CHECK(resumed_search.get_root()->label == NodeLabel::TOP);
+	CHECK(resumed_search.get_size() == search.get_size());
+	// The resumed search may expand the remaining nodes in a different order, so only check that the
+	// labels of both searches are consistent.
+	const auto nodes_by_words = [](TreeSearch &tree_search) {
+		std::map<std::set<TreeSearch::Node::Word>, const TreeSearch::Node *> nodes;
+		for (const auto &[key, node] : tree_search.get_nodes()) {
+			nodes[node->get_words()] = node;
+		}
+		return nodes;
+	};
+	const auto resumed_nodes = nodes_by_words(resumed_search);
+	for (const auto &[words, node] : nodes_by_words(search)) {
+		const auto resumed_node = resumed_nodes.find(words);
+		REQUIRE(resumed_node != std::end(resumed_nodes));
+		const NodeLabel resumed_label = resumed_node->second->label;
+		if (node->label != NodeLabel::UNLABELED && resumed_label != NodeLabel::UNLABELED) {
+			CHECK(resumed_label == node->label);
+		}
+	}
+	const auto resumed_controller = controller_synthesis::create_controller(
+	  resumed_search.get_root(), controller_actions, environment_actions, K);
+	CHECK(!resumed_controller.get_transitions().empty());
+
+	SECTION("A snapshot of a different problem is rejected")
+	{
+		TreeSearch other_search{&plant, &ata, controller_actions, environment_actions, K + 1};
+		CHECK_THROWS_AS(other_search.restore_snapshot(*snapshot), std::invalid_argument);
+		CHECK_THROWS_AS(search.restore_snapshot(*snapshot), std::logic_error);
+	}
+}
+
 TEST_CASE("Railroad crossing benchmark", "[.benchmark][railroad]")
 {
 	spdlog::set_level(spdlog::level::debug);
@@ -20,11 +20,16 @@
 
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
 #include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators_range.hpp>
+#include <cstddef>
 #include <memory>
 #include <ostream>
+#include <random>
 #include <string>
 #include <utility>
+#include <vector>
 
 using tacos::RegionIndex;
 
@@ -74,11 +79,11 @@ using ::utilities::arithmetic::BoundType;
 using Location = automata::ta::Location<std::string>;
 using Node     = search::SearchTreeNode<automata::ta::Location<std::string>, std::string>;
 
-template <typename Key, typename Val>
-std::set<Key>
-get_map_keys(const std::map<Key, Val> &map)
+template <typename Map>
+auto
+get_map_keys(const Map &map)
 {
-	std::set<Key> keys;
+	std::set<typename Map::value_type::first_type> keys;
 	for (const auto &[key, val] : map) {
 		keys.insert(key);
 	}
@@ -383,6 +388,11 @@ TEST_CASE("An illustrative example", "[search]")
 	search.build_tree(false);
 	search.label();
 	CHECK(search.get_root()->label == NodeLabel::TOP);
+	// The successors of each time successor are only computed once, all other nodes with the same
+	// time successor use the cached successors.
+	const auto successor_statistics = search.get_successor_cache_statistics();
+	CHECK(successor_statistics.num_hits > 0);
+	CHECK(successor_statistics.size == successor_statistics.num_misses);
 
 	visualization::search_tree_to_graphviz(*search.get_root()).render_to_file("example_search.dot");
 	visualization::ta_to_graphviz(ta).render_to_file("example_ta.dot");
@@ -414,6 +424,83 @@ TEST_CASE("Search in an ABConfiguration tree without solution", "[search]")
 	CHECK(search.get_root()->label == NodeLabel::BOTTOM);
 }
 
+TEST_CASE("Antichain pruning does not reuse labels of monotonic dominations", "[search]")
+{
+	TA ta{{"e", "c"}, Location{"l0"}, {Location{"l0"}, Location{"l1"}}};
+	ta.add_clock("x");
+	ta.add_transition(TATransition(Location{"l0"}, "e", Location{"l0"}));
+	ta.add_transition(TATransition(Location{"l1"}, "c", Location{"l1"}));
+	ta.add_transition(TATransition(
+	  Location{"l0"}, "c", Location{"l1"}, {{"x", AtomicClockConstraintT<std::greater<Time>>(1)}}));
+	logic::MTLFormula<std::string> e{AP("e")};
+	logic::MTLFormula<std::string> c{AP("c")};
+
+	logic::MTLFormula f   = logic::MTLFormula<std::string>::TRUE().until(e);
+	auto              ata = mtl_ata_translation::translate(f, {AP{"e"}, AP{"c"}});
+	TreeSearch        search(&ta, &ata, {"c"}, {"e"}, 2, true);
+	search.set_antichain_pruning(true);
+
+	// Start from a snapshot that contains the unexpanded root and a node that monotonically
+	// dominates the root, which stands for a node that has been labeled TOP somewhere else in the
+	// search graph.
+	const CanonicalABWord root_word = *std::begin(search.get_root()->words);
+	CanonicalABWord       dominating_word{root_word};
+	dominating_word.front().insert(ATARegionState{c, 0});
+	TreeSearch::Snapshot snapshot;
+	snapshot.K     = 2;
+	snapshot.words = {root_word, dominating_word};
+	snapshot.nodes.resize(2);
+	snapshot.nodes[0].words = {0};
+	snapshot.nodes[1].words = {1};
+	snapshot.nodes[1].label = NodeLabel::TOP;
+	snapshot.nodes[1].state = NodeState::GOOD;
+	snapshot.frontier       = {{0, 0}};
+
+	SECTION("A TOP label from a dominated ancestor is not reused")
+	{
+		// The node dominates one of its own ancestors, which only makes it TOP on that path.
+		snapshot.nodes[1].label_reason = search::LabelReason::MONOTONIC_DOMINATION;
+		search.restore_snapshot(snapshot);
+		search.build_tree(false);
+		CHECK(search.get_root()->label == NodeLabel::BOTTOM);
+		CHECK(search.get_root()->label_reason != search::LabelReason::ANTICHAIN_DOMINATION);
+		CHECK(search.get_antichain_statistics().num_top_prunings == 0);
+	}
+
+	SECTION("A TOP label that does not depend on the path is reused")
+	{
+		snapshot.nodes[1].label_reason = search::LabelReason::NO_ATA_SUCCESSOR;
+		search.restore_snapshot(snapshot);
+		search.build_tree(false);
+		CHECK(search.get_root()->label == NodeLabel::TOP);
+		CHECK(search.get_root()->label_reason == search::LabelReason::ANTICHAIN_DOMINATION);
+		CHECK(search.get_root()->state == NodeState::UNKNOWN);
+	}
+}
+
+TEST_CASE("Labels derived from path-dependent labels depend on the path", "[search]")
+{
+	const std::set<std::string> controller_actions{"c"};
+	const std::set<std::string> environment_actions{"e"};
+	auto                        dominating_node = create_test_node();
+	auto                        good_node       = create_test_node();
+	auto                        parent          = create_test_node();
+	auto                        other_parent    = create_test_node();
+	parent->add_child({0, "c"}, dominating_node.get());
+	other_parent->add_child({0, "c"}, good_node.get());
+	dominating_node->is_expanded              = true;
+	dominating_node->has_path_dependent_label = true;
+	dominating_node->set_label(NodeLabel::TOP);
+	good_node->is_expanded = true;
+	good_node->set_label(NodeLabel::TOP);
+	dominating_node->label_propagate(controller_actions, environment_actions);
+	good_node->label_propagate(controller_actions, environment_actions);
+	REQUIRE(parent->label == NodeLabel::TOP);
+	REQUIRE(other_parent->label == NodeLabel::TOP);
+	CHECK(parent->has_path_dependent_label);
+	CHECK(!other_parent->has_path_dependent_label);
+}
+
 TEST_CASE("Search in an ABConfiguration tree with a bad sub-tree", "[.][search]")
 {
 	TA ta{{"a", "b"}, Location{"l0"}, {Location{"l1"}}};
@@ -476,6 +563,14 @@ TEST_CASE("Invoke incremental labelling on a trivial example", "[search]")
 	INFO("Tree:\n" << *search.get_root());
 	// check trees for equivalence
 	CHECK(search.get_root()->label == search_incremental.get_root()->label);
+	TreeSearch search_terminate_early(&ta, &ata, {"c"}, {"e0", "e1"}, 2, true, true);
+	search_terminate_early.build_tree(false);
+	CHECK(search.get_root()->label == search_terminate_early.get_root()->label);
+	// Every node has either been expanded or its queue entry has been dropped.
+	for (const auto &[key, node] : search_terminate_early.get_nodes()) {
+		CHECK(!node->is_queued);
+	}
+	CHECK(search_terminate_early.get_frontier_statistics().max_queued_jobs > 0);
 	// TODO Fix tests that used to use the tree iterator
 	// auto searchTreeIt            = search.get_root()->begin();
 	// auto searchTreeIncrementalIt = search_incremental.get_root()->begin();
@@ -539,9 +634,9 @@ TEST_CASE("Single-step incremental labeling on constructed cases", "[search]")
 	ch2->label = NodeLabel::BOTTOM;
 	ch3->label = NodeLabel::BOTTOM;
 	// add children to tree
-	root->add_child({0, "a"}, ch1);
-	root->add_child({1, "x"}, ch2);
-	root->add_child({2, "x"}, ch3);
+	root->add_child({0, "a"}, ch1.get());
+	root->add_child({1, "x"}, ch2.get());
+	root->add_child({2, "x"}, ch3.get());
 
 	SECTION("Label tree: single-step propagate")
 	{
@@ -577,9 +672,9 @@ TEST_CASE("Single-step incremental labeling on constructed cases", "[search]")
 	// make the controller action the second one to be executable, reset tree
 	root.reset();
 	root = create_test_node();
-	root->add_child({0, "x"}, ch1);
-	root->add_child({1, "a"}, ch2);
-	root->add_child({2, "z"}, ch3);
+	root->add_child({0, "x"}, ch1.get());
+	root->add_child({1, "a"}, ch2.get());
+	root->add_child({2, "z"}, ch3.get());
 
 	SECTION("Label tree: single-step propagate with late controller action")
 	{
@@ -615,16 +710,16 @@ TEST_CASE("Multi-step incremental labeling on constructed cases", "[search]")
 	auto ch2 = create_test_node(dummyWords(1));
 	auto ch3 = create_test_node(dummyWords(2));
 	// add children to root node
-	root->add_child({0, "a"}, ch1);
-	root->add_child({1, "x"}, ch2);
-	root->add_child({2, "x"}, ch3);
+	root->add_child({0, "a"}, ch1.get());
+	root->add_child({1, "x"}, ch2.get());
+	root->add_child({2, "x"}, ch3.get());
 
 	// add second layer of children to make the first child ch1 an intermediate node
 	auto ch11 = create_test_node(dummyWords(3));
 	auto ch12 = create_test_node(dummyWords(4));
 	// Add to ch1.
-	ch1->add_child({0, "a"}, ch11);
-	ch1->add_child({1, "x"}, ch12);
+	ch1->add_child({0, "a"}, ch11.get());
+	ch1->add_child({1, "x"}, ch12.get());
 
 	SECTION("First good case")
 	{
@@ -686,7 +781,7 @@ TEST_CASE("Multi-step incremental labeling on constructed cases", "[search]")
 		ch12->label = NodeLabel::BOTTOM;
 		auto ch13   = create_test_node(dummyWords(6));
 		ch13->label = NodeLabel::TOP;
-		ch2->add_child({0, "a"}, ch13);
+		ch2->add_child({0, "a"}, ch13.get());
 		visualization::search_tree_to_graphviz(*root).render_to_file(
 		  "search_propagate_no_label_start.png");
 		// call to propagate on ch11 or ch12 should render ch1 as bottom but root should be unlabeled.
@@ -762,10 +857,41 @@ TEST_CASE("Check a node for unsatisfiable ATA configurations", "[search]")
 	        CanonicalABWord({{TARegionState{Location{"l0"}, "x", 0}, ATARegionState{a, 0}}})}}));
 }
 
+TEST_CASE("Release the words of a node", "[search]")
+{
+	search::WordInterningTable<Location, std::string> table;
+	const auto                                        words = dummyWords();
+	auto                                              node  = create_test_node(words);
+	auto                                              child = create_test_node(words);
+	node->add_child({0, "c"}, child.get());
+	REQUIRE(search::dominates_ancestor(child.get()));
+
+	std::vector<const search::PackedCanonicalABWord *> packed_words;
+	for (const auto &word : words) {
+		const auto id = table.intern(word);
+		CHECK(table.compact(id) > 0);
+		CHECK(table.compact(id) == 0);
+		packed_words.push_back(&table.get_packed_word(id));
+	}
+	node->release_words(packed_words, &table.get_symbol_table());
+	CHECK(node->has_released_words());
+	CHECK(node->words.empty());
+	CHECK(node->get_words() == words);
+	// The released words are compared in their packed form.
+	CHECK(search::dominates_ancestor(child.get()));
+	CHECK(search::is_monotonically_dominated(*node, *child));
+	CHECK(search::is_monotonically_dominated(*child, *node));
+	CHECK(!child->has_released_words());
+	CHECK(child->get_words() == words);
+	// Compacted words are still recognized when they are interned again.
+	CHECK(table.intern(words) == table.intern(node->get_words()));
+	CHECK(table.size() == words.size());
+}
+
 TEST_CASE("Search graph with self loops", "[search]")
 {
 	auto root = create_test_node();
-	root->add_child({1, "c"}, root);
+	root->add_child({1, "c"}, root.get());
 	std::set<std::string> controller_actions{"c"};
 	std::set<std::string> enviroment_actions{"e1", "e2"};
 	SECTION("Self-looping node with no children")
@@ -778,7 +904,7 @@ TEST_CASE("Search graph with self loops", "[search]")
 	{
 		auto child   = create_test_node(dummyWords());
 		child->label = NodeLabel::TOP;
-		root->add_child({0, "e2"}, child);
+		root->add_child({0, "e2"}, child.get());
 		child->label_propagate(controller_actions, enviroment_actions);
 		// Only reachable child is good, so the root should be good.
 		CHECK(root->label == NodeLabel::TOP);
@@ -787,7 +913,7 @@ TEST_CASE("Search graph with self loops", "[search]")
 	{
 		auto child   = create_test_node(dummyWords());
 		child->label = NodeLabel::BOTTOM;
-		root->add_child({0, "e2"}, child);
+		root->add_child({0, "e2"}, child.get());
 		child->label_propagate(controller_actions, enviroment_actions);
 		// Bad child is reachable by the environment.
 		CHECK(root->label == NodeLabel::BOTTOM);
@@ -796,7 +922,7 @@ TEST_CASE("Search graph with self loops", "[search]")
 	{
 		auto child   = create_test_node(dummyWords());
 		child->label = NodeLabel::BOTTOM;
-		root->add_child({2, "e2"}, child);
+		root->add_child({2, "e2"}, child.get());
 		child->label_propagate(controller_actions, enviroment_actions);
 		// We can avoid the action by indefinitely following the self loop.
 		CHECK(root->label == NodeLabel::TOP);
@@ -808,13 +934,151 @@ TEST_CASE("Search graph with loops", "[search]")
 	auto root = create_test_node();
 	auto c1   = create_test_node(dummyWords(0));
 	auto c1c1 = create_test_node(dummyWords(1));
-	root->add_child({1, "c"}, c1);
-	c1->add_child({1, "c"}, c1c1);
-	c1c1->add_child({1, "c"}, root);
+	root->add_child({1, "c"}, c1.get());
+	c1->add_child({1, "c"}, c1c1.get());
+	c1c1->add_child({1, "c"}, root.get());
 	const std::set<std::string> controller_actions{"c"};
 	const std::set<std::string> enviroment_actions{"e1", "e2"};
 	search::label_graph(root.get(), controller_actions, enviroment_actions);
 	CHECK(root->label == NodeLabel::TOP);
 }
 
+TEST_CASE("Search graph with a loop that the environment can leave", "[search]")
+{
+	// The environment can leave the loop to a bad node before the controller can continue the loop.
+	auto root = create_test_node();
+	auto c1   = create_test_node(dummyWords(0));
+	auto bad  = create_test_node(dummyWords(1));
+	root->add_child({1, "c"}, c1.get());
+	root->add_child({0, "e1"}, bad.get());
+	c1->add_child({1, "c"}, root.get());
+	bad->state = NodeState::BAD;
+	const std::set<std::string> controller_actions{"c"};
+	const std::set<std::string> enviroment_actions{"e1", "e2"};
+	search::label_graph(root.get(), controller_actions, enviroment_actions);
+	CHECK(root->label == NodeLabel::BOTTOM);
+	CHECK(c1->label == NodeLabel::BOTTOM);
+	CHECK(bad->label == NodeLabel::BOTTOM);
+}
+
+TEST_CASE("Label a deep search graph", "[search]")
+{
+	const std::set<std::string>        controller_actions{"c"};
+	const std::set<std::string>        enviroment_actions{"e"};
+	std::vector<std::shared_ptr<Node>> nodes{create_test_node()};
+	for (std::size_t i = 0; i < 200000; ++i) {
+		nodes.push_back(create_test_node());
+		nodes[i]->add_child({0, i % 2 == 0 ? "c" : "e"}, nodes.back().get());
+	}
+	SECTION("Without loops")
+	{
+		nodes.back()->state = NodeState::GOOD;
+		search::label_graph(nodes.front().get(), controller_actions, enviroment_actions);
+		CHECK(nodes.front()->label == NodeLabel::TOP);
+	}
+	SECTION("With a loop to the root")
+	{
+		nodes.back()->add_child({1, "e"}, nodes.front().get());
+		auto bad_child = create_test_node();
+		nodes.back()->add_child({0, "c"}, bad_child.get());
+		nodes.back()->get_children().at({0, "c"})->state = NodeState::BAD;
+		search::label_graph(nodes.front().get(), controller_actions, enviroment_actions);
+		CHECK(nodes.front()->label == NodeLabel::TOP);
+	}
+}
+
+TEST_CASE("Incremental labeling agrees with labeling the complete graph", "[search]")
+{
+	const std::set<std::string>    controller_actions{"c1", "c2"};
+	const std::set<std::string>    environment_actions{"e1", "e2"};
+	const std::vector<std::string> actions{"c1", "c2", "e1", "e2"};
+	const std::size_t              num_nodes = 40;
+	std::mt19937                   random_engine(GENERATE(range(0, 50)));
+	// Build the same random acyclic graph twice, once for each labeling method. Edges only go from
+	// nodes with a lower index to nodes with a higher index.
+	std::vector<std::shared_ptr<Node>> incremental_nodes;
+	std::vector<std::shared_ptr<Node>> complete_nodes;
+	for (std::size_t i = 0; i < num_nodes; ++i) {
+		incremental_nodes.push_back(create_test_node(dummyWords(i)));
+		complete_nodes.push_back(create_test_node(dummyWords(i)));
+	}
+	for (std::size_t i = 0; i + 1 < num_nodes; ++i) {
+		const auto num_children = std::uniform_int_distribution<std::size_t>(0, 4)(random_engine);
+		for (std::size_t j = 0; j < num_children; ++j) {
+			const auto child =
+			  std::uniform_int_distribution<std::size_t>(i + 1, num_nodes - 1)(random_engine);
+			const std::pair<RegionIndex, std::string> timed_action{
+			  std::uniform_int_distribution<RegionIndex>(0, 3)(random_engine),
+			  actions[std::uniform_int_distribution<std::size_t>(0, actions.size() - 1)(random_engine)]};
+			if (incremental_nodes[i]->get_children().count(timed_action) == 0) {
+				incremental_nodes[i]->add_child(timed_action, incremental_nodes[child].get());
+				complete_nodes[i]->add_child(timed_action, complete_nodes[child].get());
+			}
+		}
+	}
+	// Label the leaves randomly and propagate the labels in random order.
+	std::vector<std::size_t> leaves;
+	for (std::size_t i = 0; i < num_nodes; ++i) {
+		if (incremental_nodes[i]->get_children().empty()) {
+			leaves.push_back(i);
+			const bool is_good        = std::bernoulli_distribution(0.5)(random_engine);
+			complete_nodes[i]->state  = is_good ? NodeState::GOOD : NodeState::BAD;
+			incremental_nodes[i]->set_label(is_good ? NodeLabel::TOP : NodeLabel::BOTTOM);
+		}
+	}
+	std::shuffle(std::begin(leaves), std::end(leaves), random_engine);
+	for (const auto leaf : leaves) {
+		incremental_nodes[leaf]->label_propagate(controller_actions, environment_actions);
+	}
+	for (const auto &node : complete_nodes) {
+		search::label_graph(node.get(), controller_actions, environment_actions);
+	}
+	for (std::size_t i = 0; i < num_nodes; ++i) {
+		INFO("Node " << i);
+		CHECK(incremental_nodes[i]->label == complete_nodes[i]->label);
+	}
+}
+
+TEST_CASE("Concurrent labeling agrees with sequential labeling", "[search]")
+{
+	const std::set<std::string>    controller_actions{"c1", "c2"};
+	const std::set<std::string>    environment_actions{"e1", "e2"};
+	const std::vector<std::string> actions{"c1", "c2", "e1", "e2"};
+	const std::size_t              num_nodes = 200;
+	std::mt19937                   random_engine(GENERATE(range(0, 20)));
+	// Build the same random graph with loops twice.
+	std::vector<std::shared_ptr<Node>> sequential_nodes;
+	std::vector<std::shared_ptr<Node>> concurrent_nodes;
+	for (std::size_t i = 0; i < num_nodes; ++i) {
+		sequential_nodes.push_back(create_test_node());
+		concurrent_nodes.push_back(create_test_node());
+		if (std::bernoulli_distribution(0.1)(random_engine)) {
+			const auto state = std::bernoulli_distribution(0.5)(random_engine) ? NodeState::GOOD
+			                                                                   : NodeState::BAD;
+			sequential_nodes[i]->state = state;
+			concurrent_nodes[i]->state = state;
+		}
+	}
+	for (std::size_t i = 0; i < num_nodes; ++i) {
+		const auto num_children = std::uniform_int_distribution<std::size_t>(0, 3)(random_engine);
+		for (std::size_t j = 0; j < num_children; ++j) {
+			const auto child =
+			  std::uniform_int_distribution<std::size_t>(0, num_nodes - 1)(random_engine);
+			const std::pair<RegionIndex, std::string> timed_action{
+			  std::uniform_int_distribution<RegionIndex>(0, 3)(random_engine),
+			  actions[std::uniform_int_distribution<std::size_t>(0, actions.size() - 1)(random_engine)]};
+			if (sequential_nodes[i]->get_children().count(timed_action) == 0) {
+				sequential_nodes[i]->add_child(timed_action, sequential_nodes[child].get());
+				concurrent_nodes[i]->add_child(timed_action, concurrent_nodes[child].get());
+			}
+		}
+	}
+	search::label_graph(sequential_nodes[0].get(), controller_actions, environment_actions);
+	search::label_graph(concurrent_nodes[0].get(), controller_actions, environment_actions, 4);
+	for (std::size_t i = 0; i < num_nodes; ++i) {
+		INFO("Node " << i);
+		CHECK(sequential_nodes[i]->label == concurrent_nodes[i]->label);
+	}
+}
+
 } // namespace
@@ -0,0 +1,131 @@
+/***************************************************************************
+ *  test_search_proto.cpp - Tests for the search snapshot proto
+ *
+ *  Created:   Sun 18 Oct 00:05:47 CEST 2026
+ *  Copyright  2026  Till Hofmann <hofmann@kbsg.rwth-aachen.de>
+ *  SPDX-License-Identifier: LGPL-3.0-or-later
+ ****************************************************************************/
+
+
+#include "automata/ta.h"
+#include "mtl/MTLFormula.h"
+#include "mtl_ata_translation/translator.h"
+#include "railroad.h"
+#include "search/search.h"
+#include "search/search.pb.h"
+#include "search/search_proto.h"
+#include "search/search_tree.h"
+#include "search/ta_adapter.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <filesystem>
+#include <optional>
+#include <stdexcept>
+
+namespace {
+
+using namespace tacos;
+
+using AP         = logic::AtomicProposition<std::string>;
+using Snapshot   = search::ProductSearchSnapshot;
+using TreeSearch =
+  search::TreeSearch<automata::ta::Location<std::vector<std::string>>, std::string>;
+
+void
+check_equal(const Snapshot &actual, const Snapshot &expected)
+{
+	CHECK(actual.K == expected.K);
+	CHECK(actual.words == expected.words);
+	REQUIRE(actual.nodes.size() == expected.nodes.size());
+	for (std::size_t i = 0; i < actual.nodes.size(); ++i) {
+		const auto &node          = actual.nodes[i];
+		const auto &expected_node = expected.nodes[i];
+		CHECK(node.words == expected_node.words);
+		CHECK(node.state == expected_node.state);
+		CHECK(node.label == expected_node.label);
+		CHECK(node.label_reason == expected_node.label_reason);
+		CHECK(node.is_expanded == expected_node.is_expanded);
+		CHECK(node.min_total_region_increments == expected_node.min_total_region_increments);
+		REQUIRE(node.children.size() == expected_node.children.size());
+		for (std::size_t j = 0; j < node.children.size(); ++j) {
+			CHECK(node.children[j].increment == expected_node.children[j].increment);
+			CHECK(node.children[j].action == expected_node.children[j].action);
+			CHECK(node.children[j].child == expected_node.children[j].child);
+		}
+	}
+	REQUIRE(actual.frontier.size() == expected.frontier.size());
+	for (std::size_t i = 0; i < actual.frontier.size(); ++i) {
+		CHECK(actual.frontier[i].node == expected.frontier[i].node);
+		CHECK(actual.frontier[i].priority == expected.frontier[i].priority);
+	}
+}
+
+TEST_CASE("Convert search snapshots to protos", "[search][proto]")
+{
+	const auto &[plant, spec, controller_actions, environment_actions] = create_crossing_problem({2});
+	std::set<AP> actions;
+	std::set_union(begin(controller_actions),
+	               end(controller_actions),
+	               begin(environment_actions),
+	               end(environment_actions),
+	               inserter(actions, end(actions)));
+	auto               ata = mtl_ata_translation::translate(spec, actions);
+	const unsigned int K   = std::max(plant.get_largest_constant(), spec.get_largest_constant());
+	TreeSearch         search{&plant, &ata, controller_actions, environment_actions, K, true, false};
+	// Keep a snapshot with a non-empty frontier.
+	std::optional<Snapshot> snapshot;
+	search.set_snapshot_handler(std::chrono::seconds{0}, [&snapshot](Snapshot &&new_snapshot) {
+		if (!snapshot && new_snapshot.nodes.size() > 10) {
+			snapshot = std::move(new_snapshot);
+		}
+	});
+	search.build_tree(false);
+	REQUIRE(snapshot);
+	REQUIRE(!snapshot->frontier.empty());
+
+	SECTION("Convert a snapshot to a proto and back")
+	{
+		const auto snapshot_proto = search::snapshot_to_proto(*snapshot);
+		CHECK(snapshot_proto.nodes_size() == static_cast<int>(snapshot->nodes.size()));
+		CHECK(snapshot_proto.words_size() == static_cast<int>(snapshot->words.size()));
+		// The plant locations and clocks are stored once.
+		CHECK(snapshot_proto.clocks_size() == static_cast<int>(plant.get_clocks().size()));
+		check_equal(search::parse_proto(snapshot_proto), *snapshot);
+		const auto final_snapshot = search.create_snapshot();
+		check_equal(search::parse_proto(search::snapshot_to_proto(final_snapshot)), final_snapshot);
+	}
+
+	SECTION("Write a snapshot to a file and read it back")
+	{
+		const auto path = std::filesystem::temp_directory_path() / "tacos_test_search_snapshot.pb";
+		search::write_snapshot_to_file(*snapshot, path);
+		check_equal(search::read_snapshot_from_file(path), *snapshot);
+		std::filesystem::remove(path);
+		CHECK_THROWS_AS(search::read_snapshot_from_file(path), std::runtime_error);
+	}
+
+	SECTION("Invalid snapshot protos are rejected")
+	{
+		auto snapshot_proto = search::snapshot_to_proto(*snapshot);
+		SECTION("Invalid word index")
+		{
+			snapshot_proto.mutable_nodes(0)->set_words(0, snapshot_proto.words_size());
+		}
+		SECTION("Invalid child index")
+		{
+			snapshot_proto.mutable_nodes(0)->mutable_children(0)->set_child(snapshot_proto.nodes_size());
+		}
+		SECTION("Invalid action index")
+		{
+			snapshot_proto.mutable_nodes(0)->mutable_children(0)->set_action(
+			  snapshot_proto.actions_size());
+		}
+		SECTION("Invalid frontier entry")
+		{
+			snapshot_proto.mutable_frontier(0)->set_node(snapshot_proto.nodes_size());
+		}
+		CHECK_THROWS_AS(search::parse_proto(snapshot_proto), std::invalid_argument);
+	}
+}
+
+} // namespace
@@ -0,0 +1,95 @@
+/***************************************************************************
+ *  test_sharded_hash_map.cpp - Test the sharded concurrent hash map
+ *
+ *  Created:   Fri 16 Oct 14:41:09 CEST 2026
+ *  Copyright  2026  Till Hofmann <hofmann@kbsg.rwth-aachen.de>
+ *  SPDX-License-Identifier: LGPL-3.0-or-later
+ ****************************************************************************/
+
+#include "utilities/sharded_hash_map.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <memory>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using namespace tacos;
+
+using utilities::ShardedHashMap;
+
+TEST_CASE("Insert into a sharded hash map", "[threading][sharded_map]")
+{
+	ShardedHashMap<int, std::string, std::hash<int>, 4> map;
+	CHECK(map.empty());
+	CHECK(map.begin() == map.end());
+	{
+		const auto [value, is_new] = map.get_or_insert(1, [] { return "one"; });
+		CHECK(is_new);
+		CHECK(value == "one");
+	}
+	{
+		const auto [value, is_new] = map.get_or_insert(1, [] { return "uno"; });
+		CHECK(!is_new);
+		CHECK(value == "one");
+	}
+	map.get_or_insert(2, [] { return "two"; });
+	map.get_or_insert(5, [] { return "five"; });
+	CHECK(map.size() == 3);
+	CHECK(map.contains(2));
+	CHECK(!map.contains(3));
+	std::set<int> keys;
+	for (const auto &[key, value] : map) {
+		keys.insert(key);
+	}
+	CHECK(keys == std::set{1, 2, 5});
+
+	SECTION("Visit values under the shard lock")
+	{
+		int visited = 0;
+		CHECK(!map.get_or_insert(
+		  5, [] { return "cinco"; }, [&visited](std::string &value) {
+			  CHECK(value == "five");
+			  value = "FIVE";
+			  ++visited;
+		  }));
+		CHECK(visited == 1);
+		CHECK(map.get_or_insert(5, [] { return ""; }).first == "FIVE");
+	}
+}
+
+TEST_CASE("Concurrently insert into a sharded hash map", "[threading][sharded_map]")
+{
+	ShardedHashMap<int, std::unique_ptr<int>> map;
+	constexpr int                             num_threads = 8;
+	constexpr int                             num_keys    = 1000;
+	std::vector<std::thread>                  threads;
+	std::vector<int>                          num_inserted(num_threads, 0);
+	for (int t = 0; t < num_threads; ++t) {
+		threads.emplace_back([&map, &num_inserted, t] {
+			for (int i = 0; i < num_keys; ++i) {
+				if (map.get_or_insert(i, [i] { return std::make_unique<int>(i); }).second) {
+					++num_inserted[t];
+				}
+			}
+		});
+	}
+	for (auto &thread : threads) {
+		thread.join();
+	}
+	CHECK(map.size() == num_keys);
+	int total_inserted = 0;
+	for (const auto inserted : num_inserted) {
+		total_inserted += inserted;
+	}
+	// Each key must be inserted exactly once.
+	CHECK(total_inserted == num_keys);
+	for (const auto &[key, value] : map) {
+		CHECK(*value == key);
+	}
+}
+
+} // namespace
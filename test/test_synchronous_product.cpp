@@ -13,6 +13,7 @@
 #include "mtl/MTLFormula.h"
 #include "mtl_ata_translation/translator.h"
 #include "search/canonical_word.h"
+#include "search/domination_signature.h"
 #include "search/operators.h"
 #include "search/reg_a.h"
 #include "search/search_tree.h"
@@ -21,11 +22,17 @@
 #include "utilities/Interval.h"
 #include "utilities/numbers.h"
 
+#include <algorithm>
+#include <bitset>
 #include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <limits>
+#include <set>
 #include <sstream>
 #include <stdexcept>
 #include <string>
 #include <variant>
+#include <vector>
 
 namespace {
 
@@ -155,9 +162,18 @@ TEST_CASE("Comparison of ABRegionSymbols", "[canonical_word]")
 	      < ABRegionSymbol{ATARegionState{AP{"l0"}, 0}});
 	CHECK(ABRegionSymbol{TARegionState{Location{"l1"}, "x", 1}}
 	      < ABRegionSymbol{ATARegionState{AP{"l0"}, 0}});
-	CHECK(ABRegionSymbol{ATARegionState{AP{"s0"}, 0}} < ABRegionSymbol{ATARegionState{AP{"s1"}, 0}});
-	CHECK(
-	  !(ABRegionSymbol{ATARegionState{AP{"s1"}, 0}} < ABRegionSymbol{ATARegionState{AP{"s0"}, 0}}));
+	// Formulas are compared by their creation order.
+	const logic::MTLFormula<std::string> s0{AP{"s0"}};
+	const logic::MTLFormula<std::string> s1{AP{"s1"}};
+	const bool                           s0_first =
+	  logic::MTLFormula<std::string>::CreationOrder{}(s0, s1);
+	CHECK(s0_first == (s0.get_id() < s1.get_id()));
+	CHECK((ABRegionSymbol{ATARegionState{s0, 0}} < ABRegionSymbol{ATARegionState{s1, 0}})
+	      == s0_first);
+	CHECK((ABRegionSymbol{ATARegionState{s1, 0}} < ABRegionSymbol{ATARegionState{s0, 0}})
+	      != s0_first);
+	CHECK((ABRegionSymbol{ATARegionState{s0, 1}} < ABRegionSymbol{ATARegionState{s1, 0}})
+	      == s0_first);
 	CHECK(ABRegionSymbol{ATARegionState{AP{"s0"}, 0}} < ABRegionSymbol{ATARegionState{AP{"s0"}, 1}});
 	CHECK(
 	  !(ABRegionSymbol{ATARegionState{AP{"s0"}, 1}} < ABRegionSymbol{ATARegionState{AP{"s0"}, 0}}));
@@ -680,6 +696,101 @@ TEST_CASE("Get the next canonical word(s)", "[canonical_word]")
 	}
 }
 
+/** Check that the adapter computes the same successors from a word and from its candidate for all
+ * words that are reachable from the initial word, up to the given number of words. */
+template <typename Adapter, typename TA, typename ATA, typename Word>
+void
+check_successors_from_words(const TA          &ta,
+                            const ATA         &ata,
+                            const Word        &initial_word,
+                            RegionIndex        K,
+                            const std::size_t max_words = 200)
+{
+	std::set<Word>    visited;
+	std::vector<Word> queue{initial_word};
+	while (!queue.empty() && visited.size() < max_words) {
+		const auto word = queue.back();
+		queue.pop_back();
+		if (!visited.insert(word).second) {
+			continue;
+		}
+		for (const auto &[increment, time_successor] : get_time_successors(word, K)) {
+			// The order of successors with the same symbol may differ, so compare them as sets.
+			const auto successors = Adapter{}(ta, ata, time_successor, increment, K);
+			const auto candidate_successors =
+			  Adapter{}(ta, ata, search::get_candidate(time_successor), increment, K);
+			CHECK(successors.size() == candidate_successors.size());
+			CHECK(std::is_permutation(std::begin(successors),
+			                          std::end(successors),
+			                          std::begin(candidate_successors),
+			                          std::end(candidate_successors)));
+			for (const auto &[symbol, successor] : successors) {
+				queue.push_back(successor);
+			}
+		}
+	}
+	CHECK(visited.size() > 10);
+}
+
+TEST_CASE("Get the next canonical words directly from a word", "[canonical_word]")
+{
+	using TATransition = automata::ta::Transition<std::string, std::string>;
+	using TA           = automata::ta::TimedAutomaton<std::string, std::string>;
+	using automata::AtomicClockConstraintT;
+	TA ta{{Location{"s0"}, Location{"s1"}},
+	      {"a", "b", "c"},
+	      Location{"s0"},
+	      {Location{"s1"}},
+	      {"x", "y"},
+	      {TATransition(Location{"s0"},
+	                    "a",
+	                    Location{"s0"},
+	                    {{"x", AtomicClockConstraintT<std::greater<Time>>(1)}},
+	                    {"x"}),
+	       TATransition(Location{"s0"},
+	                    "b",
+	                    Location{"s1"},
+	                    {{"x", AtomicClockConstraintT<std::less_equal<Time>>(1)},
+	                     {"y", AtomicClockConstraintT<std::greater_equal<Time>>(2)}},
+	                    {"y"}),
+	       TATransition(Location{"s0"}, "b", Location{"s1"}),
+	       TATransition(Location{"s1"}, "c", Location{"s0"}, {}, {"x", "y"}),
+	       TATransition(Location{"s1"},
+	                    "a",
+	                    Location{"s1"},
+	                    {{"y", AtomicClockConstraintT<std::equal_to<Time>>(1)}})}};
+	const RegionIndex K = 2;
+
+	SECTION("with action constraints")
+	{
+		using MTLFormula = logic::MTLFormula<std::string>;
+		const MTLFormula a{AP("a")};
+		const MTLFormula b{AP("b")};
+		const MTLFormula c{AP("c")};
+		const auto       ata = mtl_ata_translation::translate(
+      a.until(b, logic::TimeInterval(1, 2)) || finally(c, logic::TimeInterval(0, 1)));
+		check_successors_from_words<search::get_next_canonical_words<TA, std::string, std::string>>(
+		  ta,
+		  ata,
+		  get_canonical_word(ta.get_initial_configuration(), ata.get_initial_configuration(), K),
+		  K);
+	}
+	SECTION("with location constraints")
+	{
+		using AP         = logic::AtomicProposition<TA::Location>;
+		using MTLFormula = logic::MTLFormula<TA::Location>;
+		const MTLFormula s0{AP(TA::Location{"s0"})};
+		const MTLFormula s1{AP(TA::Location{"s1"})};
+		const auto       ata = mtl_ata_translation::translate(s0.until(s1, logic::TimeInterval(1, 2)));
+		check_successors_from_words<
+		  search::get_next_canonical_words<TA, std::string, TA::Location, true>>(
+		  ta,
+		  ata,
+		  get_canonical_word(ta.get_initial_configuration(), ata.get_initial_configuration(), K),
+		  K);
+	}
+}
+
 TEST_CASE("reg_a", "[canonical_word]")
 {
 	CHECK(search::reg_a(CanonicalABWord({{TARegionState{Location{"s0"}, "c0", 0}}}))
@@ -788,16 +899,22 @@ TEST_CASE("Monotonic domination on nodes", "[canonical_word]")
 	  {{TARegionState{Location{"s0"}, "c0", 0}, ATARegionState{logic::MTLFormula{AP{"a"}}, 1}}})});
 	SECTION("Self domination")
 	{
-		n1->add_child({0, "a"}, n2);
-		n2->add_child({0, "a"}, n1);
+		n1->add_child({0, "a"}, n2.get());
+		n2->add_child({0, "a"}, n1.get());
 		// n1 mon.doms itself, but this is explicitly ignored.
 		CHECK(!search::dominates_ancestor(n1.get()));
 	}
 	SECTION("Ancestor domination")
 	{
-		n1->add_child({0, "a"}, n2);
-		n2->add_child({0, "a"}, n3);
-		CHECK(search::dominates_ancestor(n3.get()));
+		n1->add_child({0, "a"}, n2.get());
+		n2->add_child({0, "a"}, n3.get());
+		search::DominationStatistics statistics;
+		CHECK(search::dominates_ancestor(n3.get(), &statistics));
+		// The exact check is only done if the signature does not reject the ancestor.
+		CHECK(statistics.num_ancestors >= 1);
+		CHECK(statistics.num_ancestors
+		      == statistics.num_signature_rejections + statistics.num_exact_checks);
+		CHECK(statistics.num_dominations == 1);
 	}
 	SECTION("Domination via the right parent")
 	{
@@ -823,14 +940,14 @@ TEST_CASE("Monotonic domination on nodes", "[canonical_word]")
 		  std::make_shared<Node>(std::set{CanonicalABWord({{TARegionState{Location{"s0"}, "c0", 5}}})});
 		auto n6 = std::make_shared<Node>(std::set{CanonicalABWord(
 		  {{TARegionState{Location{"s1"}, "c0", 0}, ATARegionState{logic::MTLFormula{AP{"a"}}, 1}}})});
-		n1->add_child({0, "a"}, n2);
-		n1->add_child({0, "b"}, n3);
-		n2->add_child({0, "a"}, n4);
-		n3->add_child({0, "a"}, n5);
-		n5->add_child({0, "a"}, n6);
+		n1->add_child({0, "a"}, n2.get());
+		n1->add_child({0, "b"}, n3.get());
+		n2->add_child({0, "a"}, n4.get());
+		n3->add_child({0, "a"}, n5.get());
+		n5->add_child({0, "a"}, n6.get());
 		// No domination yet, as the link n4->n6 is missing.
 		CHECK(!search::dominates_ancestor(n6.get()));
-		n4->add_child({0, "a"}, n6);
+		n4->add_child({0, "a"}, n6.get());
 		// Now, n6 is dominating via n4->n2.
 		CHECK(search::dominates_ancestor(n6.get()));
 		// All the other nodes are not dominating.
@@ -842,6 +959,32 @@ TEST_CASE("Monotonic domination on nodes", "[canonical_word]")
 	}
 }
 
+TEST_CASE("Domination signatures", "[canonical_word]")
+{
+	const std::set<CanonicalABWord> words1{
+	  CanonicalABWord({{TARegionState{Location{"s0"}, "c0", 0}}}),
+	  CanonicalABWord({{TARegionState{Location{"s0"}, "c0", 1}}})};
+	const std::set<CanonicalABWord> words2{
+	  CanonicalABWord({{TARegionState{Location{"s0"}, "c0", 0},
+	                    ATARegionState{logic::MTLFormula{AP{"a"}}, 1}}})};
+	const std::set<CanonicalABWord> words3{
+	  CanonicalABWord({{TARegionState{Location{"s0"}, "c0", 1}},
+	                   {ATARegionState{logic::MTLFormula{AP{"a"}}, 3}}})};
+	REQUIRE(search::is_monotonically_dominated(words1, words2));
+	REQUIRE(search::is_monotonically_dominated(words1, words3));
+	REQUIRE(!search::is_monotonically_dominated(words2, words1));
+	const auto signature1 = search::get_domination_signature(words1);
+	const auto signature2 = search::get_domination_signature(words2);
+	const auto signature3 = search::get_domination_signature(words3);
+	// The signature must never reject a domination.
+	CHECK(search::may_be_monotonically_dominated(signature1, signature2));
+	CHECK(search::may_be_monotonically_dominated(signature1, signature3));
+	// Each symbol sets exactly one bit.
+	CHECK(std::bitset<64>(signature2).count() <= 2);
+	CHECK(search::get_domination_signature(std::set<CanonicalABWord>{})
+	      == std::numeric_limits<search::DominationSignature>::max());
+}
+
 TEST_CASE("Validate the region indices in a canonical word", "[canonical_word]")
 {
 	CHECK(is_valid_canonical_word(CanonicalABWord({{TARegionState{Location{"s0"}, "c0", 0}},
@@ -15,6 +15,9 @@
 #include <catch2/matchers/catch_matchers.hpp>
 #include <catch2/matchers/catch_matchers_string.hpp>
 #include <functional>
+#include <map>
+#include <memory>
+#include <vector>
 
 namespace {
 
@@ -51,6 +54,24 @@ TEST_CASE("Clock constraints with integers", "[ta]")
 	CHECK(GT(1).is_satisfied(2));
 }
 
+TEST_CASE("Clock constraints on region indices", "[ta]")
+{
+	using LT = AtomicClockConstraintT<std::less<Time>>;
+	using LE = AtomicClockConstraintT<std::less_equal<Time>>;
+	using EQ = AtomicClockConstraintT<std::equal_to<Time>>;
+	using GE = AtomicClockConstraintT<std::greater_equal<Time>>;
+	using GT = AtomicClockConstraintT<std::greater<Time>>;
+	// The regions 0, (0, 1), 1, (1, 2), 2, (2, 3), and the region beyond 2.
+	const std::vector<Time> candidates{0, 0.5, 1, 1.5, 2, 2.5, 3.5};
+	const std::vector<ClockConstraint> constraints{LT(1), LE(1), EQ(1), GE(1), GT(1), LT(2), GE(0)};
+	for (RegionIndex region_index = 0; region_index < candidates.size(); ++region_index) {
+		for (const auto &constraint : constraints) {
+			CHECK(is_satisfied_in_region(constraint, region_index)
+			      == is_satisfied(constraint, candidates[region_index]));
+		}
+	}
+}
+
 TEST_CASE("Comparison of TA configurations", "[ta]")
 {
 	CHECK(Configuration{Location{"l0"}, {{"x", Clock{0}}}}
@@ -269,6 +290,38 @@ TEST_CASE("Simple non-deterministic TA", "[ta]")
 	CHECK(ta.accepts_word({{"a", 1}, {"b", 2}}));
 }
 
+TEST_CASE("Symbol steps for all symbols", "[ta]")
+{
+	TimedAutomaton ta{{"a", "b", "c"}, Location{"s0"}, {Location{"s1"}}};
+	ta.add_clock("x");
+	ta.add_transition(Transition(Location{"s0"}, "a", Location{"s1"}, {}, {"x"}));
+	ta.add_transition(Transition(Location{"s0"}, "a", Location{"s0"}));
+	ta.add_transition(Transition(
+	  Location{"s0"}, "b", Location{"s1"}, {{"x", AtomicClockConstraintT<std::less<Time>>(1)}}));
+	ta.add_transition(Transition(Location{"s1"}, "c", Location{"s0"}));
+
+	using Successors = std::map<std::string, std::set<Configuration>>;
+	CHECK(ta.make_symbol_steps({Location{"s0"}, {{"x", 0.5}}})
+	      == Successors{{"a",
+	                     {Configuration{Location{"s0"}, {{"x", 0.5}}},
+	                      Configuration{Location{"s1"}, {{"x", 0}}}}},
+	                    {"b", {Configuration{Location{"s1"}, {{"x", 0.5}}}}}});
+	// The guard of the b-transition is not satisfied, so there is no b-successor.
+	CHECK(ta.make_symbol_steps({Location{"s0"}, {{"x", 1.5}}})
+	      == Successors{{"a",
+	                     {Configuration{Location{"s0"}, {{"x", 1.5}}},
+	                      Configuration{Location{"s1"}, {{"x", 0}}}}}});
+	CHECK(ta.make_symbol_steps({Location{"s1"}, {{"x", 1.5}}})
+	      == Successors{{"c", {Configuration{Location{"s0"}, {{"x", 1.5}}}}}});
+	// A copy of the TA has its own transition index.
+	const auto copy = std::make_unique<TimedAutomaton>(ta);
+	ta.add_transition(Transition(Location{"s1"}, "a", Location{"s1"}));
+	CHECK(copy->make_symbol_steps({Location{"s1"}, {{"x", 1.5}}})
+	      == Successors{{"c", {Configuration{Location{"s0"}, {{"x", 1.5}}}}}});
+	CHECK(copy->make_symbol_step({Location{"s0"}, {{"x", 0.5}}}, "b")
+	      == std::set{Configuration{Location{"s1"}, {{"x", 0.5}}}});
+}
+
 TEST_CASE("Non-determinstic TA with clocks", "[ta]")
 {
 	TimedAutomaton ta{{"a", "b"}, Location{"s0"}, {Location{"s1"}, Location{"s2"}}};
@@ -289,6 +342,24 @@ TEST_CASE("Non-determinstic TA with clocks", "[ta]")
 	CHECK(ta.accepts_word({{"a", 1}, {"b", 3}}));
 }
 
+TEST_CASE("Evaluate guards and resets on clocks that are added later", "[ta]")
+{
+	TimedAutomaton ta{{"a"}, Location{"s0"}, {Location{"s0"}}};
+	ta.add_clock("y");
+	ClockConstraint c = AtomicClockConstraintT<std::less<Time>>(2);
+	ta.add_transition(Transition(Location{"s0"}, "a", Location{"s0"}, {{"y", c}}, {"y"}));
+	// Adding a clock changes the IDs of the clocks, the transition must use the new IDs.
+	ta.add_clock("x");
+	CHECK(ta.get_initial_configuration() == Configuration{Location{"s0"}, {{"x", 0}, {"y", 0}}});
+	CHECK(ta.make_symbol_step({Location{"s0"}, {{"x", 3}, {"y", 1}}}, "a")
+	      == std::set{Configuration{Location{"s0"}, {{"x", 3}, {"y", 0}}}});
+	CHECK(ta.make_symbol_step({Location{"s0"}, {{"x", 1}, {"y", 3}}}, "a").empty());
+	// Valuations with other clocks than the TA's clocks are evaluated by clock name.
+	CHECK(ta.make_symbol_step({Location{"s0"}, {{"y", 1}}}, "a")
+	      == std::set{Configuration{Location{"s0"}, {{"y", 0}}}});
+	CHECK(ta.make_symbol_step({Location{"s0"}, {{"y", 3}, {"z", 0}}}, "a").empty());
+}
+
 TEST_CASE("Transitions must use the TA's alphabet, locations and clocks", "[ta]")
 {
 	TimedAutomaton ta{{"a", "b"}, Location{"s0"}, {Location{"s0"}}};
@@ -0,0 +1,76 @@
+/***************************************************************************
+ *  test_time_successor_cache.cpp - Test the cache of time successor chains
+ *
+ *  Created:   Sat 17 Oct 19:02:14 CEST 2026
+ *  Copyright  2026  Till Hofmann <hofmann@kbsg.rwth-aachen.de>
+ *  SPDX-License-Identifier: LGPL-3.0-or-later
+ ****************************************************************************/
+
+#include "automata/ta.h"
+#include "mtl/MTLFormula.h"
+#include "search/canonical_word.h"
+#include "search/synchronous_product.h"
+#include "search/time_successor_cache.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <set>
+#include <string>
+
+namespace {
+
+using namespace tacos;
+
+using ATARegionState     = search::ATARegionState<std::string>;
+using CanonicalABWord    = search::CanonicalABWord<automata::ta::Location<std::string>, std::string>;
+using Location           = automata::ta::Location<std::string>;
+using TARegionState      = search::PlantRegionState<Location>;
+using TimeSuccessorCache = search::TimeSuccessorCache<Location, std::string>;
+
+TEST_CASE("Cache time successors", "[search][time_successors]")
+{
+	const logic::MTLFormula a{logic::AtomicProposition<std::string>{"a"}};
+	const RegionIndex       K = 3;
+	const CanonicalABWord   word{{TARegionState{Location{"l0"}, "x", 0}, ATARegionState{a, 0}},
+                             {TARegionState{Location{"l0"}, "y", 1}}};
+	TimeSuccessorCache      cache{K};
+
+	const auto chain = cache.get_time_successors(word);
+	REQUIRE(chain->size() > 2);
+	CHECK(chain->front() == word);
+	CHECK(chain->back() == search::get_time_successor(chain->back(), K));
+	for (RegionIndex n = 0; n < chain->size() + 2; ++n) {
+		CHECK(cache.get_nth_time_successor(word, n) == search::get_nth_time_successor(word, n, K));
+	}
+	CHECK(cache.get_time_successor(word) == search::get_time_successor(word, K));
+	CHECK(cache.get_statistics().num_misses == 1);
+	CHECK(cache.get_statistics().num_hits == chain->size() + 3);
+	CHECK(cache.get_statistics().size == 1);
+
+	// The set of words has the same time successors with and without the cache.
+	const std::set<CanonicalABWord> node_words{
+	  word,
+	  CanonicalABWord{{TARegionState{Location{"l0"}, "x", 0}},
+	                  {TARegionState{Location{"l0"}, "y", 1}, ATARegionState{a, 3}}}};
+	CHECK(search::get_time_successors(node_words, cache)
+	      == search::get_time_successors(node_words, K));
+}
+
+TEST_CASE("Evict time successors from a full cache", "[search][time_successors]")
+{
+	TimeSuccessorCache cache{1, 16};
+	for (int i = 0; i < 64; ++i) {
+		cache.get_time_successors(
+		  CanonicalABWord{{TARegionState{Location{"l" + std::to_string(i)}, "x", 0}}});
+	}
+	const auto statistics = cache.get_statistics();
+	CHECK(statistics.num_misses == 64);
+	CHECK(statistics.num_hits == 0);
+	CHECK(statistics.size == 16);
+	CHECK(statistics.num_evictions == 48);
+	CHECK(statistics.get_hit_rate() == 0);
+	// An evicted chain is computed again.
+	cache.get_time_successors(CanonicalABWord{{TARegionState{Location{"l0"}, "x", 0}}});
+	CHECK(cache.get_statistics().num_misses == 65);
+}
+
+} // namespace
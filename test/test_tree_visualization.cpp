@@ -33,25 +33,28 @@ using search::NodeLabel;
 
 using Catch::Matchers::ContainsSubstring;
 
-auto
+/** Create a test graph. The nodes do not own their children, so all nodes are returned, the root
+ * is the last node. */
+std::vector<std::shared_ptr<Node>>
 create_test_graph()
 {
-	auto create_test_node =
-	  [](const std::set<CanonicalABWord>                                            &words,
-	     const std::map<std::pair<RegionIndex, std::string>, std::shared_ptr<Node>> &children = {}) {
+	std::vector<std::shared_ptr<Node>> nodes;
+	auto                               create_test_node =
+	  [&nodes](
+	    const std::set<CanonicalABWord>                                            &words,
+	    const std::map<std::pair<RegionIndex, std::string>, std::shared_ptr<Node>> &children = {}) {
 		  auto node          = std::make_shared<Node>(words);
 		  node->is_expanding = true;
 		  for (const auto &[action, child] : children) {
-			  node->add_child(action, child);
-			  child->parents = {node.get()};
+			  node->add_child(action, child.get());
 		  }
+		  nodes.push_back(node);
 		  return node;
 	  };
-	const logic::MTLFormula            a{logic::AtomicProposition<std::string>{"a"}};
-	const logic::MTLFormula            b{logic::AtomicProposition<std::string>{"b"}};
-	std::vector<std::shared_ptr<Node>> children;
-	auto                               n1c1 = create_test_node(
-    {{{TARegionState{Location{"l0"}, "x", 0}}, {TARegionState{Location{"l0"}, "y", 2}}}});
+	const logic::MTLFormula a{logic::AtomicProposition<std::string>{"a"}};
+	const logic::MTLFormula b{logic::AtomicProposition<std::string>{"b"}};
+	auto n1c1 = create_test_node(
+	  {{{TARegionState{Location{"l0"}, "x", 0}}, {TARegionState{Location{"l0"}, "y", 2}}}});
 	auto n1 = create_test_node({{{TARegionState{Location{"l0"}, "x", 0}},
 	                             {TARegionState{Location{"l0"}, "y", 1}}}},
 	                           {{{1, "d"}, n1c1}});
@@ -72,7 +75,7 @@ create_test_graph()
 	n2->label_reason   = LabelReason::NO_BAD_ENV_ACTION;
 	n3->label          = NodeLabel::BOTTOM;
 	n3->label_reason   = LabelReason::BAD_ENV_ACTION_FIRST;
-	return root;
+	return nodes;
 }
 std::string
 read_file(const std::filesystem::path &file)
@@ -85,8 +88,9 @@ read_file(const std::filesystem::path &file)
 
 TEST_CASE("Search tree visualization", "[search][visualization]")
 {
-	auto root  = create_test_graph();
-	auto graph = visualization::search_tree_to_graphviz(*root);
+	const auto nodes = create_test_graph();
+	const auto root  = nodes.back();
+	auto       graph = visualization::search_tree_to_graphviz(*root);
 	graph.render_to_file("test_tree_visualization.png");
 	const auto dot = graph.to_dot();
 
@@ -131,7 +135,8 @@ TEST_CASE("Search tree visualization", "[search][visualization]")
 
 TEST_CASE("Interactive visualization", "[visualization]")
 {
-	auto              root = create_test_graph();
+	const auto        nodes = create_test_graph();
+	const auto        root  = nodes.back();
 	std::stringstream input;
 	char              tmp_filename[] = "search_graph_XXXXXX.dot";
 	mkstemps(tmp_filename, 4);
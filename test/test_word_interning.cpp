@@ -0,0 +1,136 @@
+/***************************************************************************
+ *  test_word_interning.cpp - Test interning of canonical words
+ *
+ *  Created:   Fri 16 Oct 09:41:12 CEST 2026
+ *  Copyright  2026  Till Hofmann <hofmann@kbsg.rwth-aachen.de>
+ *  SPDX-License-Identifier: LGPL-3.0-or-later
+ ****************************************************************************/
+
+#include "automata/ta.h"
+#include "mtl/MTLFormula.h"
+#include "search/canonical_word.h"
+#include "search/word_interning.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <set>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+namespace {
+
+using namespace tacos;
+
+using ATARegionState  = search::ATARegionState<std::string>;
+using CanonicalABWord = search::CanonicalABWord<automata::ta::Location<std::string>, std::string>;
+using Location        = automata::ta::Location<std::string>;
+using TARegionState   = search::PlantRegionState<Location>;
+using search::WordId;
+using search::WordSetKey;
+using search::WordSetKeyHash;
+
+TEST_CASE("Intern canonical words", "[search][interning]")
+{
+	const logic::MTLFormula a{logic::AtomicProposition<std::string>{"a"}};
+	const logic::MTLFormula b{logic::AtomicProposition<std::string>{"b"}};
+	const CanonicalABWord   w1{{TARegionState{Location{"l0"}, "x", 0}, ATARegionState{a, 0}}};
+	const CanonicalABWord   w2{{TARegionState{Location{"l0"}, "x", 0}}, {ATARegionState{b, 1}}};
+	const CanonicalABWord   w3{{TARegionState{Location{"l1"}, "x", 2}, ATARegionState{a, 2}}};
+
+	search::WordInterningTable<Location, std::string> table;
+	const auto                                        id1 = table.intern(w1);
+	const auto                                        id2 = table.intern(w2);
+	CHECK(id1 != id2);
+	CHECK(table.intern(CanonicalABWord{w1}) == id1);
+	CHECK(table.intern(w2) == id2);
+	CHECK(table.size() == 2);
+	CHECK(table.get_word(id1) == w1);
+	CHECK(table.get_word(id2) == w2);
+
+	SECTION("Equal word sets get equal keys")
+	{
+		const auto k1 = table.intern(std::set<CanonicalABWord>{w1, w2});
+		const auto k2 = table.intern(std::set<CanonicalABWord>{w2, w1});
+		CHECK(k1 == k2);
+		CHECK(WordSetKeyHash{}(k1) == WordSetKeyHash{}(k2));
+		CHECK(k1.get_ids().size() == 2);
+		const auto k3 = table.intern(std::set<CanonicalABWord>{w1, w3});
+		CHECK(k1 != k3);
+		CHECK(table.size() == 3);
+		CHECK(k1 != table.intern(std::set<CanonicalABWord>{w1}));
+		CHECK(WordSetKey{} == table.intern(std::set<CanonicalABWord>{}));
+	}
+
+	SECTION("Compacted words are kept in packed form")
+	{
+		CHECK(table.compact(id1) > 0);
+		CHECK(table.compact(id1) == 0);
+		CHECK(table.get_word(id1) == w1);
+		CHECK(table.get_symbol_table().unpack(table.get_packed_word(id1)) == w1);
+		CHECK(table.intern(CanonicalABWord{w1}) == id1);
+		CHECK(table.intern(w2) == id2);
+		CHECK(table.intern(w3) != id1);
+		CHECK(table.size() == 3);
+	}
+
+	SECTION("Equal words have equal hashes")
+	{
+		CHECK(search::hash_word(w1) == search::hash_word(CanonicalABWord{w1}));
+		CHECK(search::hash_word(w1) != search::hash_word(w2));
+	}
+
+	SECTION("Many words get distinct IDs")
+	{
+		std::vector<WordId> ids;
+		for (RegionIndex region_index = 0; region_index < 1000; ++region_index) {
+			ids.push_back(table.intern(CanonicalABWord{{TARegionState{Location{"l0"}, "x", region_index}},
+			                                           {ATARegionState{a, region_index}}}));
+		}
+		CHECK(std::set<WordId>(std::begin(ids), std::end(ids)).size() == ids.size());
+		for (RegionIndex region_index = 0; region_index < 1000; ++region_index) {
+			const CanonicalABWord word{{TARegionState{Location{"l0"}, "x", region_index}},
+			                           {ATARegionState{a, region_index}}};
+			CHECK(table.intern(word) == ids[region_index]);
+			CHECK(table.get_word(ids[region_index]) == word);
+		}
+		CHECK(table.get_word(id1) == w1);
+	}
+
+	SECTION("Words can be interned concurrently")
+	{
+		constexpr std::size_t            num_threads = 4;
+		constexpr RegionIndex            num_words   = 500;
+		std::vector<std::vector<WordId>> ids(num_threads);
+		std::vector<std::thread>         threads;
+		for (std::size_t thread = 0; thread < num_threads; ++thread) {
+			threads.emplace_back([&table, &ids, &a, thread] {
+				for (RegionIndex region_index = 0; region_index < num_words; ++region_index) {
+					ids[thread].push_back(
+					  table.intern(CanonicalABWord{{TARegionState{Location{"l1"}, "y", region_index}},
+					                               {ATARegionState{a, region_index}}}));
+				}
+			});
+		}
+		for (auto &thread : threads) {
+			thread.join();
+		}
+		for (std::size_t thread = 1; thread < num_threads; ++thread) {
+			CHECK(ids[thread] == ids[0]);
+		}
+		CHECK(std::set<WordId>(std::begin(ids[0]), std::end(ids[0])).size() == num_words);
+		CHECK(table.size() == 2 + num_words);
+	}
+
+	SECTION("Keys can be used in hash tables")
+	{
+		std::unordered_set<WordSetKey, WordSetKeyHash> keys;
+		keys.insert(table.intern(std::set<CanonicalABWord>{w1, w2}));
+		keys.insert(table.intern(std::set<CanonicalABWord>{w2}));
+		CHECK(keys.size() == 2);
+		CHECK(keys.count(table.intern(std::set<CanonicalABWord>{w2, w1})) == 1);
+		CHECK(keys.count(table.intern(std::set<CanonicalABWord>{w3})) == 0);
+	}
+}
+
+} // namespace